@@ -45,6 +45,9 @@ size_t ComputationThreadPool::max_threads() const{
 WallDuration ComputationThreadPool::cpu_time() const{
     return m_core->cpu_time();
 }
+ComputationThreadPoolStats ComputationThreadPool::stats() const{
+    return m_core->stats();
+}
 void ComputationThreadPool::ensure_threads(size_t threads){
     m_core->ensure_threads(threads);
 }
@@ -61,6 +64,13 @@ void ComputationThreadPool::run_in_parallel(
     const std::function<void(size_t index)>& func,
     size_t start, size_t end,
     size_t block_size
+){
+    parallel_for(func, start, end, block_size);
+}
+void ComputationThreadPool::run_range_in_parallel(
+    ParallelForRangeRef func,
+    size_t start, size_t end,
+    size_t block_size
 ){
     m_core->run_in_parallel(func, start, end, block_size);
 }
@@ -16,6 +16,7 @@
 #ifndef PokemonAutomation_ComputationThreadPool_H
 #define PokemonAutomation_ComputationThreadPool_H
 
+#include <memory>
 #include <functional>
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/Containers/Pimpl.h"
@@ -26,6 +27,27 @@ class AsyncTask;
 class ComputationThreadPoolCore;
 
 
+//  Non-owning, non-allocating reference to a "void(size_t begin, size_t end)"
+//  callable. Used to pass parallel-for bodies through the Pimpl boundary.
+struct ParallelForRangeRef{
+    void* context;
+    void (*invoke)(void* context, size_t begin, size_t end);
+};
+
+
+struct ComputationThreadPoolStats{
+    //  # of tasks and parallel regions that were picked up by a worker.
+    uint64_t dispatches = 0;
+    //  Total time those spent waiting before a worker picked them up.
+    WallDuration queue_wait = WallDuration::zero();
+
+    //  # of parallel-for blocks that were run.
+    uint64_t blocks = 0;
+    //  # of those that were stolen by a worker rather than run by the caller.
+    uint64_t stolen_blocks = 0;
+};
+
+
 class ComputationThreadPool final{
 public:
     ComputationThreadPool(
@@ -38,6 +60,7 @@ public:
     size_t current_threads() const;
     size_t max_threads() const;
     WallDuration cpu_time() const;
+    ComputationThreadPoolStats stats() const;
 
     void ensure_threads(size_t threads);
 
@@ -58,12 +81,56 @@ public:
 
     //  Run function for all the indices [start, end).
     //  Lower indices are not allowed to block on higher indices.
+    //  The calling thread participates. Parallel regions may be nested.
     void run_in_parallel(
         const std::function<void(size_t index)>& func,
         size_t start, size_t end,
         size_t block_size = 0
     );
 
+    //  Same as above, but without type-erasing into an std::function.
+    //  Nothing is heap-allocated. Parallel regions may be nested.
+    template <typename Function>
+    void parallel_for(
+        Function&& func,
+        size_t start, size_t end,
+        size_t block_size = 0
+    ){
+        parallel_for_range(
+            [&func](size_t s, size_t e){
+                for (; s < e; s++){
+                    func(s);
+                }
+            },
+            start, end, block_size
+        );
+    }
+
+    //  Run "func(begin, end)" over blocks of [start, end).
+    template <typename RangeFunction>
+    void parallel_for_range(
+        RangeFunction&& func,
+        size_t start, size_t end,
+        size_t block_size = 0
+    ){
+        using FunctionType = std::remove_reference_t<RangeFunction>;
+        run_range_in_parallel(
+            ParallelForRangeRef{
+                (void*)std::addressof(func),
+                [](void* context, size_t s, size_t e){
+                    (*(FunctionType*)context)(s, e);
+                }
+            },
+            start, end, block_size
+        );
+    }
+
+    void run_range_in_parallel(
+        ParallelForRangeRef func,
+        size_t start, size_t end,
+        size_t block_size = 0
+    );
+
 
 private:
     Pimpl<ComputationThreadPoolCore> m_core;
@@ -5,6 +5,7 @@
  */
 
 #include "Common/Cpp/PanicDump.h"
+#include "SpinLock.h"
 #include "ReverseLockGuard.h"
 #include "ComputationThreadPoolCore.h"
 
@@ -16,6 +17,40 @@ namespace PokemonAutomation{
 
 
 
+struct ComputationThreadPoolCore::ParallelRegion{
+    ParallelForRangeRef func;
+    size_t start;
+    size_t end;
+    size_t block_size;
+    size_t blocks;
+    WallClock published;
+
+    //  Next block to be claimed. Lock-free.
+    std::atomic<size_t> next_block;
+
+    //  # of workers currently inside this region. Protected by the pool lock.
+    size_t helpers = 0;
+
+    SpinLock exception_lock;
+    std::exception_ptr exception;
+
+    //  Links for the active region list. Protected by the pool lock.
+    ParallelRegion* prev = nullptr;
+    ParallelRegion* next = nullptr;
+
+    ParallelRegion(ParallelForRangeRef p_func, size_t p_start, size_t p_end, size_t p_block_size)
+        : func(p_func)
+        , start(p_start)
+        , end(p_end)
+        , block_size(p_block_size)
+        , blocks((p_end - p_start + p_block_size - 1) / p_block_size)
+        , published(current_time())
+        , next_block(0)
+    {}
+};
+
+
+
 ComputationThreadPoolCore::ComputationThreadPoolCore(
     std::function<void()>&& new_thread_callback,
     size_t starting_threads,
@@ -23,8 +58,14 @@ ComputationThreadPoolCore::ComputationThreadPoolCore(
 )
     : m_new_thread_callback(std::move(new_thread_callback))
     , m_max_threads(max_threads == 0 ? std::thread::hardware_concurrency() : max_threads)
+    , m_regions(nullptr)
     , m_stopping(false)
     , m_busy_count(0)
+    , m_idle_count(0)
+    , m_dispatches(0)
+    , m_queue_wait(WallDuration::zero())
+    , m_blocks(0)
+    , m_stolen_blocks(0)
 {
     for (size_t c = 0; c < starting_threads; c++){
         spawn_thread();
@@ -40,8 +81,8 @@ ComputationThreadPoolCore::~ComputationThreadPoolCore(){
     for (ThreadData& thread : m_threads){
         thread.thread.join();
     }
-    for (auto& task : m_queue){
-        task->report_cancelled();
+    for (auto& item : m_queue){
+        item.task->report_cancelled();
     }
 }
 
@@ -55,6 +96,17 @@ WallDuration ComputationThreadPoolCore::cpu_time() const{
     }
     return ret;
 }
+ComputationThreadPoolStats ComputationThreadPoolCore::stats() const{
+    ComputationThreadPoolStats ret;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        ret.dispatches = m_dispatches;
+        ret.queue_wait = m_queue_wait;
+    }
+    ret.blocks = m_blocks.load(std::memory_order_relaxed);
+    ret.stolen_blocks = m_stolen_blocks.load(std::memory_order_relaxed);
+    return ret;
+}
 
 
 void ComputationThreadPoolCore::ensure_threads(size_t threads){
@@ -83,19 +135,8 @@ std::unique_ptr<AsyncTask> ComputationThreadPoolCore::blocking_dispatch(std::fun
         });
 
         //  Enqueue task.
-        m_queue.emplace_back(task.get())->report_started();
-        spawn_threads();
-
-#if 0
-        //  Use this thread to process the queue until our task is
-        while (!m_queue.empty() && !task->is_finished()){
-            AsyncTask* current = m_queue.front();
-            m_queue.pop_front();
-
-            ReverseLockGuard<std::mutex> lg0(m_lock);
-            current->run();
-        }
-#endif
+        m_queue.emplace_back(QueuedTask{task.get(), current_time()}).task->report_started();
+        spawn_threads(m_queue.size());
     }
 
 //    cout << "notify... " << endl;
@@ -115,9 +156,9 @@ std::unique_ptr<AsyncTask> ComputationThreadPoolCore::try_dispatch(std::function
         task.reset(new AsyncTask(std::move(func)));
 
         //  Enqueue task.
-        m_queue.emplace_back(task.get())->report_started();
+        m_queue.emplace_back(QueuedTask{task.get(), current_time()}).task->report_started();
 
-        spawn_threads();
+        spawn_threads(m_queue.size());
     }
 
     m_thread_cv.notify_one();
@@ -126,8 +167,38 @@ std::unique_ptr<AsyncTask> ComputationThreadPoolCore::try_dispatch(std::function
 }
 
 
+size_t ComputationThreadPoolCore::run_blocks(ParallelRegion& region) noexcept{
+    size_t ran = 0;
+    while (true){
+        size_t block = region.next_block.fetch_add(1, std::memory_order_relaxed);
+        if (block >= region.blocks){
+            return ran;
+        }
+        size_t s = region.start + block * region.block_size;
+        size_t e = std::min(s + region.block_size, region.end);
+        try{
+            region.func.invoke(region.func.context, s, e);
+        }catch (...){
+            //  Stop handing out the remaining blocks.
+            region.next_block.store(region.blocks, std::memory_order_relaxed);
+            WriteSpinLock lg(region.exception_lock);
+            if (!region.exception){
+                region.exception = std::current_exception();
+            }
+        }
+        ran++;
+    }
+}
+ComputationThreadPoolCore::ParallelRegion* ComputationThreadPoolCore::find_region() const{
+    for (ParallelRegion* region = m_regions; region != nullptr; region = region->next){
+        if (region->next_block.load(std::memory_order_relaxed) < region->blocks){
+            return region;
+        }
+    }
+    return nullptr;
+}
 void ComputationThreadPoolCore::run_in_parallel(
-    const std::function<void(size_t index)>& func,
+    ParallelForRangeRef func,
     size_t start, size_t end,
     size_t block_size
 ){
@@ -143,43 +214,56 @@ void ComputationThreadPoolCore::run_in_parallel(
         }
     }
 
-    size_t blocks = (total + block_size - 1) / block_size;
+    ParallelRegion region(func, start, end, block_size);
 
-    //  Prepare all the tasks.
-    std::vector<std::unique_ptr<AsyncTask>> tasks(blocks);
-    for (size_t c = 0; c < blocks; c++){
-        tasks[c].reset(new AsyncTask([=, &func]{
-            size_t s = start + c * block_size;
-            size_t e = std::min(s + block_size, end);
-//            cout << "Running: [" << s << "," << e << ")" << endl;
-            for (; s < e; s++){
-                func(s);
-            }
-        }));
+    //  Only one block. Don't bother with the workers.
+    if (region.blocks == 1){
+        m_blocks.fetch_add(1, std::memory_order_relaxed);
+        func.invoke(func.context, start, end);
+        return;
     }
 
+    //  Publish the region.
     {
-        //  Enqueue all the tasks.
-        std::unique_lock<std::mutex> lg(m_lock);
-        for (std::unique_ptr<AsyncTask>& task : tasks){
-            m_queue.emplace_back(task.get())->report_started();
-            m_thread_cv.notify_one();
+        std::lock_guard<std::mutex> lg(m_lock);
+        region.next = m_regions;
+        if (m_regions != nullptr){
+            m_regions->prev = &region;
+        }
+        m_regions = &region;
+
+        size_t helpers = std::min(region.blocks - 1, m_max_threads);
+        spawn_threads(helpers);
+        if (helpers >= m_idle_count){
+            m_thread_cv.notify_all();
+        }else{
+            for (size_t c = 0; c < helpers; c++){
+                m_thread_cv.notify_one();
+            }
         }
-        spawn_threads();
+    }
 
-        //  Use this thread to process the queue until our tasks are done.
-        while (!m_queue.empty() && !tasks.back()->is_finished()){
-            AsyncTask* task = m_queue.front();
-            m_queue.pop_front();
+    //  Work on our own region.
+    run_blocks(region);
+    m_blocks.fetch_add(region.blocks, std::memory_order_relaxed);
 
-            ReverseLockGuard<std::mutex> lg0(m_lock);
-            task->run();
+    //  Unpublish it and wait for the workers that are still inside it.
+    //  These are all running blocks that have already been claimed.
+    {
+        std::unique_lock<std::mutex> lg(m_lock);
+        if (region.prev != nullptr){
+            region.prev->next = region.next;
+        }else{
+            m_regions = region.next;
         }
+        if (region.next != nullptr){
+            region.next->prev = region.prev;
+        }
+        m_region_cv.wait(lg, [&]{ return region.helpers == 0; });
     }
 
-    //  Wait for everything to finish.
-    for (std::unique_ptr<AsyncTask>& task : tasks){
-        task->wait_and_rethrow_exceptions();
+    if (region.exception){
+        std::rethrow_exception(region.exception);
     }
 }
 
@@ -199,8 +283,9 @@ void ComputationThreadPoolCore::spawn_thread(){
         throw;
     }
 }
-void ComputationThreadPoolCore::spawn_threads(){
-    while (m_threads.size() < std::min(m_queue.size() + m_busy_count, m_max_threads)){
+void ComputationThreadPoolCore::spawn_threads(size_t pending){
+    //  Must call under lock.
+    while (m_threads.size() < std::min(pending + m_busy_count, m_max_threads)){
         spawn_thread();
     }
 }
@@ -216,24 +301,46 @@ void ComputationThreadPoolCore::thread_loop(ThreadData& data){
     std::unique_lock<std::mutex> lg(m_lock);
     m_busy_count++;
     while (!m_stopping){
+        //  Parallel regions first. Someone is actively waiting on them.
+        ParallelRegion* region = find_region();
+        if (region != nullptr){
+            region->helpers++;
+            m_dispatches++;
+            m_queue_wait += current_time() - region->published;
+            size_t ran;
+            {
+                ReverseLockGuard<std::mutex> lg0(m_lock);
+                ran = run_blocks(*region);
+                m_stolen_blocks.fetch_add(ran, std::memory_order_relaxed);
+            }
+            if (--region->helpers == 0){
+                m_region_cv.notify_all();
+            }
+            continue;
+        }
+
 //        cout << "m_queue... " << m_queue.size() << endl;
         if (m_queue.empty()){
             data.runtime.stop();
             m_busy_count--;
+            m_idle_count++;
             m_dispatch_cv.notify_all();
 //            cout << "waiting... " << m_busy_count << endl;
             m_thread_cv.wait(lg);
 //            cout << "waking... " << m_busy_count << endl;
+            m_idle_count--;
             m_busy_count++;
             data.runtime.start();
             continue;
         }
 
-        AsyncTask* task = m_queue.front();
+        QueuedTask item = m_queue.front();
         m_queue.pop_front();
+        m_dispatches++;
+        m_queue_wait += current_time() - item.enqueued;
 
         ReverseLockGuard<std::mutex> lg0(m_lock);
-        task->run();
+        item.task->run();
     }
 }
 
@@ -11,6 +11,14 @@
  *  Because the # of threads is capped, it is safe to spam this thread pool with
  *  lots of smaller tasks.
  *
+ *  Parallel regions ("run_in_parallel()") do not allocate per-block tasks.
+ *  The region lives on the caller's stack and is published to the workers.
+ *  Blocks are then claimed lock-free by whichever thread gets to them first:
+ *  the caller itself or any idle worker that steals into the region.
+ *
+ *  Since the caller always works on its own region and only ever waits for
+ *  blocks that are already running, nested regions cannot deadlock.
+ *
  */
 
 #ifndef PokemonAutomation_ComputationThreadPoolCore_H
@@ -23,6 +31,7 @@
 #include "Common/Cpp/CpuUtilization/CpuUtilization.h"
 #include "Common/Cpp/Stopwatch.h"
 #include "AsyncTask.h"
+#include "ComputationThreadPool.h"
 
 namespace PokemonAutomation{
 
@@ -46,6 +55,7 @@ public:
         return m_max_threads;
     }
     WallDuration cpu_time() const;
+    ComputationThreadPoolStats stats() const;
 
     void ensure_threads(size_t threads);
 //    void wait_for_everything();
@@ -63,10 +73,11 @@ public:
     //  "func" will be moved-from only on success.
     [[nodiscard]] std::unique_ptr<AsyncTask> try_dispatch(std::function<void()>& func);
 
-    //  Run function for all the indices [start, end).
+    //  Run "func" over all the indices [start, end) split into blocks.
     //  Lower indices are not allowed to block on higher indices.
+    //  Blocks may start nested regions.
     void run_in_parallel(
-        const std::function<void(size_t index)>& func,
+        ParallelForRangeRef func,
         size_t start, size_t end,
         size_t block_size = 0
     );
@@ -78,26 +89,48 @@ private:
         ThreadHandle handle;
         Stopwatch runtime;
     };
+    struct QueuedTask{
+        AsyncTask* task;
+        WallClock enqueued;
+    };
+    struct ParallelRegion;
 
     void spawn_thread();
-    void spawn_threads();
+    void spawn_threads(size_t pending);
     void thread_loop(ThreadData& data);
 
+    //  Must call under lock. Returns a region that still has unclaimed blocks.
+    ParallelRegion* find_region() const;
 
-private:
-    struct Data;
+    //  Claim and run blocks from "region" until there are none left.
+    //  Returns the # of blocks that were run.
+    static size_t run_blocks(ParallelRegion& region) noexcept;
 
+
+private:
     std::function<void()> m_new_thread_callback;
     size_t m_max_threads;
-    std::deque<AsyncTask*> m_queue;
+    std::deque<QueuedTask> m_queue;
+
+    //  Intrusive list of active parallel regions. The regions themselves are
+    //  owned by (and live on the stack of) the thread that started them.
+    ParallelRegion* m_regions;
 
     std::deque<ThreadData> m_threads;
 
     bool m_stopping;
     size_t m_busy_count;
+    size_t m_idle_count;
     mutable std::mutex m_lock;
     std::condition_variable m_thread_cv;
     std::condition_variable m_dispatch_cv;
+    std::condition_variable m_region_cv;
+
+    //  Stats. Protected by "m_lock".
+    uint64_t m_dispatches;
+    WallDuration m_queue_wait;
+    std::atomic<uint64_t> m_blocks;
+    std::atomic<uint64_t> m_stolen_blocks;
 };
 
 
@@ -0,0 +1,168 @@
+/*  Periodic Executor
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/PanicDump.h"
+#include "PeriodicScheduler.h"
+#include "PeriodicExecutor.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+PeriodicExecutor::PeriodicExecutor(
+    std::function<void()>&& new_thread_callback,
+    size_t max_threads
+)
+    : m_new_thread_callback(std::move(new_thread_callback))
+    , m_max_threads(max_threads)
+    , m_stopping(false)
+    , m_idle_threads(0)
+{
+    if (m_max_threads == 0){
+        m_max_threads = 1;
+    }
+}
+PeriodicExecutor::~PeriodicExecutor(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_thread_cv.notify_all();
+    }
+    for (std::thread& thread : m_threads){
+        thread.join();
+    }
+}
+size_t PeriodicExecutor::current_threads() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_threads.size();
+}
+
+
+void PeriodicExecutor::add_runner(PeriodicRunner& runner){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_runners.emplace(&runner, RunnerState{m_timeline.end()});
+}
+void PeriodicExecutor::remove_runner(PeriodicRunner& runner){
+    std::unique_lock<std::mutex> lg(m_lock);
+    auto iter = m_runners.find(&runner);
+    if (iter == m_runners.end()){
+        return;
+    }
+    m_remove_cv.wait(lg, [&]{ return !iter->second.running; });
+    if (iter->second.iter != m_timeline.end()){
+        m_timeline.erase(iter->second.iter);
+    }
+    m_runners.erase(iter);
+}
+void PeriodicExecutor::wake(PeriodicRunner& runner, SteadyClock when){
+    if (when == SteadyClock::max()){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_stopping){
+        return;
+    }
+    auto iter = m_runners.find(&runner);
+    if (iter == m_runners.end()){
+        return;
+    }
+    RunnerState& state = iter->second;
+
+    //  The worker running it will reschedule it when it's done.
+    if (state.running){
+        state.pending_wake = std::min(state.pending_wake, when);
+        return;
+    }
+
+    if (state.iter != m_timeline.end()){
+        if (state.iter->first <= when){
+            return;
+        }
+        m_timeline.erase(state.iter);
+    }
+    state.iter = m_timeline.emplace(when, &runner);
+
+    //  Only wake a worker if this is now the earliest event.
+    if (state.iter != m_timeline.begin()){
+        return;
+    }
+    try_spawn_thread();
+    m_thread_cv.notify_one();
+}
+
+
+void PeriodicExecutor::try_spawn_thread(){
+    //  Must call under lock.
+    if (m_idle_threads != 0){
+        return;
+    }
+    if (m_threads.size() >= m_max_threads || m_threads.size() >= m_runners.size()){
+        return;
+    }
+    m_threads.emplace_back(
+        run_with_catch,
+        "PeriodicExecutor::thread_loop()",
+        [this]{ thread_loop(); }
+    );
+}
+void PeriodicExecutor::thread_loop(){
+    if (m_new_thread_callback){
+        m_new_thread_callback();
+    }
+
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (!m_stopping){
+        if (m_timeline.empty()){
+            m_idle_threads++;
+            m_thread_cv.wait(lg);
+            m_idle_threads--;
+            continue;
+        }
+
+        auto next = m_timeline.begin();
+        SteadyClock now = current_steady_time();
+        if (now < next->first){
+            m_idle_threads++;
+            m_thread_cv.wait_until(lg, next->first);
+            m_idle_threads--;
+            continue;
+        }
+
+        PeriodicRunner& runner = *next->second;
+        RunnerState& state = m_runners.find(&runner)->second;
+        m_timeline.erase(next);
+        state.iter = m_timeline.end();
+        state.running = true;
+
+        //  More work is due. Make sure someone else picks it up.
+        if (!m_timeline.empty() && m_timeline.begin()->first <= now){
+            try_spawn_thread();
+            m_thread_cv.notify_one();
+        }
+
+        lg.unlock();
+        SteadyClock next_time = runner.run_next();
+        lg.lock();
+
+        state.running = false;
+        next_time = std::min(next_time, state.pending_wake);
+        state.pending_wake = SteadyClock::max();
+        if (next_time != SteadyClock::max()){
+            state.iter = m_timeline.emplace(next_time, &runner);
+        }
+        m_remove_cv.notify_all();
+    }
+}
+
+
+
+
+}
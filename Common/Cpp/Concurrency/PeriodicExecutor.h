@@ -0,0 +1,96 @@
+/*  Periodic Executor
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Shared executor that multiplexes many PeriodicRunners onto a small set
+ *  of worker threads.
+ *
+ *  Each runner is kept in a single timeline ordered by when its next event is
+ *  due. Workers sleep until the earliest runner is due, then run one event
+ *  from it and put it back into the timeline. A runner is never run by two
+ *  workers at once, so events of the same runner are still serialized.
+ *
+ *  Idle runners cost nothing but an entry in a map. Threads are spawned
+ *  lazily, only when all existing workers are busy. There are never more
+ *  threads than the thread limit or the # of runners, since a runner can
+ *  only occupy one thread at a time.
+ *
+ */
+
+#ifndef PokemonAutomation_PeriodicExecutor_H
+#define PokemonAutomation_PeriodicExecutor_H
+
+#include <functional>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+class PeriodicRunner;
+
+
+class PeriodicExecutor final{
+public:
+    PeriodicExecutor(
+        std::function<void()>&& new_thread_callback,
+        size_t max_threads
+    );
+    ~PeriodicExecutor();
+
+    size_t current_threads() const;
+    size_t max_threads() const{ return m_max_threads; }
+
+
+private:
+    friend class PeriodicRunner;
+
+    void add_runner(PeriodicRunner& runner);
+
+    //  Remove the runner. If it is currently running, wait for it to finish.
+    void remove_runner(PeriodicRunner& runner);
+
+    //  Make sure the runner will be run no later than "when".
+    void wake(PeriodicRunner& runner, SteadyClock when);
+
+
+private:
+    using Timeline = std::multimap<SteadyClock, PeriodicRunner*>;
+
+    struct RunnerState{
+        Timeline::iterator iter;
+        bool running = false;
+
+        //  Earliest wake-up requested while the runner was running.
+        SteadyClock pending_wake = SteadyClock::max();
+    };
+
+    //  Spawn another worker if all of them are busy and there is room.
+    void try_spawn_thread();
+    void thread_loop();
+
+
+private:
+    std::function<void()> m_new_thread_callback;
+    size_t m_max_threads;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_thread_cv;
+    std::condition_variable m_remove_cv;
+
+    bool m_stopping;
+    size_t m_idle_threads;
+    std::map<PeriodicRunner*, RunnerState> m_runners;
+    Timeline m_timeline;
+
+    std::deque<std::thread> m_threads;
+};
+
+
+
+
+}
+#endif
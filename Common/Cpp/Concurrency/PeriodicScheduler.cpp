@@ -16,8 +16,11 @@ namespace PokemonAutomation{
 size_t PeriodicScheduler::events() const{
     return m_events.size();
 }
-bool PeriodicScheduler::add_event(void* event, std::chrono::milliseconds period, WallClock start){
-    auto ret = m_events.emplace(event, PeriodicEvent{m_callback_id, period});
+bool PeriodicScheduler::add_event(
+    void* event, std::chrono::milliseconds period, SteadyClock start,
+    bool throttleable
+){
+    auto ret = m_events.emplace(event, PeriodicEvent{m_callback_id, period, throttleable});
     if (!ret.second){
         //  Already exists. Do nothing.
         return false;
@@ -38,14 +41,18 @@ void PeriodicScheduler::remove_event(void* event){
     //  No need to remove from scheduler since it will be skipped over automatically.
     m_events.erase(event);
 }
-WallClock PeriodicScheduler::next_event() const{
+SteadyClock PeriodicScheduler::next_event() const{
     auto iter = m_schedule.begin();
     if (iter == m_schedule.end()){
-        return WallClock::max();
+        return SteadyClock::max();
     }
     return iter->first;
 }
-void* PeriodicScheduler::request_next_event(WallClock timestamp){
+void* PeriodicScheduler::request_next_event(
+    SteadyClock timestamp,
+    bool* missed_deadline,
+    SteadyClock* scheduled
+){
     while (true){
         auto iter0 = m_schedule.begin();
 
@@ -67,10 +74,23 @@ void* PeriodicScheduler::request_next_event(WallClock timestamp){
             continue;
         }
 
+        const PeriodicEvent& periodic = iter1->second;
+        WallDuration period = periodic.period;
+        if (periodic.throttleable){
+            period *= m_throttle;
+        }
+
         //  Schedule the next event first so that we retain strong exception safety if it throws.
-        WallClock next = std::max(iter0->first + iter1->second.period, timestamp);
+        SteadyClock next = std::max(iter0->first + period, timestamp);
         m_schedule.emplace(next, iter0->second);
 
+        if (missed_deadline != nullptr){
+            *missed_deadline = timestamp - iter0->first >= period;
+        }
+        if (scheduled != nullptr){
+            *scheduled = iter0->first;
+        }
+
         //  Now remove the current event.
         m_schedule.erase(iter0);
 
@@ -104,32 +124,37 @@ private:
 
 
 
-PeriodicRunner::PeriodicRunner(AsyncDispatcher& dispatcher)
-    : m_dispatcher(dispatcher)
-    , m_pending_waits(0)
-{}
-bool PeriodicRunner::add_event(void* event, std::chrono::milliseconds period, WallClock start){
+PeriodicRunner::PeriodicRunner(PeriodicExecutor& executor)
+    : m_executor(executor)
+    , m_throttle(1)
+    , m_deadline_misses(0)
+    , m_is_back_to_back(false)
+    , m_queue_delay(WallDuration::zero())
+{
+    m_executor.add_runner(*this);
+}
+PeriodicRunner::~PeriodicRunner(){
+    m_executor.remove_runner(*this);
+}
+bool PeriodicRunner::add_event(
+    void* event, std::chrono::milliseconds period, SteadyClock start,
+    bool throttleable
+){
     throw_if_cancelled();
 
-    m_pending_waits++;
-    std::lock_guard<std::mutex> lg(m_lock);
-    m_pending_waits--;
-
-    //  Thread not started yet. Do this first for strong exception safety.
-    if (!m_runner){
-        m_runner = m_dispatcher.dispatch([this]{ thread_loop(); });
+    bool ret;
+    SteadyClock next;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        ret = m_scheduler.add_event(event, period, start, throttleable);
+        next = m_scheduler.next_event();
     }
-
-    bool ret = m_scheduler.add_event(event, period, start);
-    m_cv.notify_all();
+    m_executor.wake(*this, next);
     return ret;
 }
 void PeriodicRunner::remove_event(void* event){
-    m_pending_waits++;
     std::lock_guard<std::mutex> lg(m_lock);
-    m_pending_waits--;
     m_scheduler.remove_event(event);
-    m_cv.notify_all();
 
     if (m_scheduler.events() == 0){
         WriteSpinLock lg1(m_stats_lock);
@@ -140,65 +165,52 @@ bool PeriodicRunner::cancel(std::exception_ptr exception) noexcept{
     if (Cancellable::cancel(std::move(exception))){
         return true;
     }
-    std::lock_guard<std::mutex> lg(m_lock);
-    m_cv.notify_all();
+
+    //  Our next event may be far away. Have the executor run us now so that
+    //  it sees the cancellation and drops us from its timeline.
+    try{
+        m_executor.wake(*this, current_steady_time());
+    }catch (...){}
     return false;
 }
-void PeriodicRunner::thread_loop(){
-    bool is_back_to_back = false;
-    std::unique_lock<std::mutex> lg(m_lock);
-    WallClock last_check_timestamp = current_time();
-    WallDuration idle_since_last_check = WallDuration(0);
-    while (true){
-        if (cancelled()){
-            return;
-        }
-
-        //  If anyone is trying to get the lock, yield now.
-        if (m_pending_waits.load(std::memory_order_acquire) != 0){
-            m_cv.wait(lg, [this]{ return m_pending_waits.load(std::memory_order_acquire) == 0; });
-        }
-
-        WallClock now = current_time();
-
-        {
-            WriteSpinLock lg1(m_stats_lock);
-            m_utilization.push_event(now - last_check_timestamp - idle_since_last_check, now);
-        }
-        last_check_timestamp = now;
-        idle_since_last_check = WallDuration(0);
-//        cout << m_utilization.utilization() << endl;
+SteadyClock PeriodicRunner::run_next() noexcept{
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (cancelled()){
+        return SteadyClock::max();
+    }
 
-        void* event = m_scheduler.request_next_event(now);
+    SteadyClock now = current_steady_time();
 
-        //  Event is available now. Run it.
-        if (event != nullptr){
-            run(event, is_back_to_back);
-            is_back_to_back = true;
-            continue;
-        }
-        is_back_to_back = false;
+    m_scheduler.set_throttle(m_throttle.load(std::memory_order_relaxed));
 
-        //  Wait for next scheduled event.
-        WallClock next = m_scheduler.next_event();
+    bool missed_deadline = false;
+    SteadyClock scheduled = now;
+    void* event = m_scheduler.request_next_event(now, &missed_deadline, &scheduled);
 
-        if (cancelled()){
-            return;
+    //  Event is available now. Run it.
+    if (event != nullptr){
+        if (missed_deadline){
+            m_deadline_misses.fetch_add(1, std::memory_order_relaxed);
         }
+        m_queue_delay = now - scheduled;
+        run(event, m_is_back_to_back);
 
-        WallClock start = current_time();
-        if (next < WallClock::max()){
-            m_cv.wait_until(lg, next);
-        }else{
-            m_cv.wait(lg);
+        SteadyClock end = current_steady_time();
+        {
+            WriteSpinLock lg1(m_stats_lock);
+            m_utilization.push_event(end - now);
         }
-        WallClock end = current_time();
-        idle_since_last_check += end - start;
+        now = end;
     }
+
+    //  Back-to-back if the next event is already due.
+    SteadyClock next = m_scheduler.next_event();
+    m_is_back_to_back = event != nullptr && next <= now;
+    return next;
 }
 void PeriodicRunner::stop_thread(){
     PeriodicRunner::cancel(nullptr);
-    m_runner.reset();
+    m_executor.remove_runner(*this);
 }
 
 double PeriodicRunner::current_utilization() const{
@@ -4,6 +4,9 @@
  *
  *      Periodically call a set of callbacks at custom intervals.
  *
+ *  The runners do not own any threads. They are run by a PeriodicExecutor
+ *  which is shared by many runners.
+ *
  */
 
 #ifndef PokemonAutomation_PeriodicScheduler_H
@@ -17,7 +20,7 @@
 #include "Common/Cpp/EventRateTracker.h"
 #include "Common/Cpp/CancellableScope.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
-#include "AsyncDispatcher.h"
+#include "PeriodicExecutor.h"
 
 namespace PokemonAutomation{
 
@@ -31,21 +34,39 @@ public:
     size_t events() const;
 
     //  Returns true if event was successfully added.
-    bool add_event(void* event, std::chrono::milliseconds period, WallClock start = current_time());
+    //  If "throttleable" is true, the period of this event is multiplied by
+    //  the current throttle factor. (see "set_throttle()")
+    bool add_event(
+        void* event, std::chrono::milliseconds period, SteadyClock start = current_steady_time(),
+        bool throttleable = false
+    );
     void remove_event(void* event);
 
-    //  Returns the next scheduled event. If no events are scheduled, returns WallClock::max().
-    WallClock next_event() const;
+    //  Stretch the periods of all throttleable events by this factor.
+    //  Takes effect the next time each event is rescheduled.
+    void set_throttle(size_t factor){ m_throttle = factor == 0 ? 1 : factor; }
+
+    //  Returns the next scheduled event. If no events are scheduled, returns SteadyClock::max().
+    SteadyClock next_event() const;
 
     //  If an event is before the current timestamp, return it and reschedule for next period.
     //  If nothing is before the current timestamp, return nullptr.
-    void* request_next_event(WallClock timestamp = current_time());
+    //  If "missed_deadline" is not null, it is set to whether the returned
+    //  event is running a full period or more behind its schedule.
+    //  If "scheduled" is not null, it is set to the time the returned event
+    //  was scheduled for.
+    void* request_next_event(
+        SteadyClock timestamp = current_steady_time(),
+        bool* missed_deadline = nullptr,
+        SteadyClock* scheduled = nullptr
+    );
 
 private:
     //  "id" is needed to solve the ABA problem if the same pointer is removed/re-added.
     struct PeriodicEvent{
         uint64_t id;
         std::chrono::milliseconds period;
+        bool throttleable;
     };
     struct SingleEvent{
         uint64_t id;
@@ -54,8 +75,9 @@ private:
 
 private:
     uint64_t m_callback_id = 0;
+    size_t m_throttle = 1;
     std::map<void*, PeriodicEvent> m_events;
-    std::multimap<WallClock, SingleEvent> m_schedule;
+    std::multimap<SteadyClock, SingleEvent> m_schedule;
 };
 
 
@@ -68,13 +90,25 @@ private:
 //
 class PeriodicRunner : public Cancellable{
 public:
+    virtual ~PeriodicRunner();
     virtual bool cancel(std::exception_ptr exception) noexcept override;
 
     double current_utilization() const;
 
+    //  # of events that ran a full period or more behind schedule.
+    uint64_t deadline_misses() const{ return m_deadline_misses.load(std::memory_order_relaxed); }
+
+    //  Stretch the periods of throttleable events by this factor.
+    //  Safe to call from any thread, including from inside "run()".
+    void set_throttle(size_t factor){ m_throttle.store(factor, std::memory_order_relaxed); }
+    size_t throttle() const{ return m_throttle.load(std::memory_order_relaxed); }
+
 protected:
-    PeriodicRunner(AsyncDispatcher& dispatcher);
-    bool add_event(void* event, std::chrono::milliseconds period, WallClock start = current_time());
+    PeriodicRunner(PeriodicExecutor& executor);
+    bool add_event(
+        void* event, std::chrono::milliseconds period, SteadyClock start = current_steady_time(),
+        bool throttleable = false
+    );
     void remove_event(void* event);
 
     //  Run the event. "is_back_to_back" is true if there was no wait between
@@ -84,24 +118,36 @@ protected:
     //  is too slow to keep up.
     virtual void run(void* event, bool is_back_to_back) noexcept = 0;
 
+    //  How long the event that is currently running waited past the time it
+    //  was scheduled for. Only meaningful from inside "run()".
+    WallDuration queue_delay() const{ return m_queue_delay; }
+
 private:
-    void thread_loop();
+    friend class PeriodicExecutor;
+
+    //  Called by the executor. Run the next event if it is due.
+    //  Returns the time the next event is due.
+    SteadyClock run_next() noexcept;
+
 protected:
+    //  Stop running events. If an event is currently running, this will wait
+    //  for it to finish. Child classes must call this in their destructor.
     void stop_thread();
 
 private:
-    AsyncDispatcher& m_dispatcher;
+    PeriodicExecutor& m_executor;
+
+    std::atomic<size_t> m_throttle;
+    std::atomic<uint64_t> m_deadline_misses;
 
-    std::atomic<size_t> m_pending_waits;
     std::mutex m_lock;
-    std::condition_variable m_cv;
+    bool m_is_back_to_back;
+    WallDuration m_queue_delay;
 
     mutable SpinLock m_stats_lock;
     UtilizationTracker m_utilization;
 
     PeriodicScheduler m_scheduler;
-
-    std::unique_ptr<AsyncTask> m_runner;
 };
 
 
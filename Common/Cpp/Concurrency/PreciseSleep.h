@@ -0,0 +1,35 @@
+/*  Precise Sleep
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      OS sleeps and condition variable timeouts routinely overshoot by a
+ *  millisecond or more. For frame-perfect timing, wait until shortly before
+ *  the deadline and spin the rest of the way.
+ *
+ *  The coarse wait is left to the caller. It is usually a condition variable
+ *  so that the thread can still be woken up for new work.
+ *
+ *  Spinning burns a core. Only use this on dedicated threads.
+ *
+ */
+
+#ifndef PokemonAutomation_PreciseSleep_H
+#define PokemonAutomation_PreciseSleep_H
+
+#include "Common/Cpp/Time.h"
+#include "SpinPause.h"
+
+namespace PokemonAutomation{
+
+
+//  Spin until "deadline".
+inline void spin_until(SteadyClock deadline){
+    while (current_steady_time() < deadline){
+        pause();
+    }
+}
+
+
+
+}
+#endif
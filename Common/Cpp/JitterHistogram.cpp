@@ -0,0 +1,78 @@
+/*  Jitter Histogram
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <bit>
+#include "PrettyPrint.h"
+#include "JitterHistogram.h"
+
+namespace PokemonAutomation{
+
+
+
+WallDuration JitterHistogramSnapshot::mean_error() const{
+    uint64_t late = samples - early;
+    return late == 0 ? WallDuration::zero() : total_error / (WallDuration::rep)late;
+}
+WallDuration JitterHistogramSnapshot::percentile(double percentile) const{
+    if (samples == 0){
+        return WallDuration::zero();
+    }
+    uint64_t target = (uint64_t)(percentile * samples + 0.5);
+    uint64_t seen = early;
+    for (size_t c = 0; c < BUCKETS; c++){
+        seen += buckets[c];
+        if (seen >= target){
+            return c == BUCKETS - 1
+                ? max_error
+                : std::chrono::duration_cast<WallDuration>(std::chrono::microseconds((uint64_t)1 << c));
+        }
+    }
+    return max_error;
+}
+std::string JitterHistogramSnapshot::to_str() const{
+    auto to_us = [](WallDuration duration){
+        return tostr_fixed(std::chrono::duration<double, std::micro>(duration).count(), 0);
+    };
+    std::string str;
+    str += "n = " + std::to_string(samples);
+    str += ", mean = " + to_us(mean_error()) + "us";
+    str += ", p99 < " + to_us(percentile(0.99)) + "us";
+    str += ", max = " + to_us(max_error) + "us";
+    if (early != 0){
+        str += ", early = " + std::to_string(early);
+    }
+    return str;
+}
+
+
+
+void JitterHistogram::add(WallDuration error){
+    WriteSpinLock lg(m_lock);
+    m_data.samples++;
+    if (error < WallDuration::zero()){
+        m_data.early++;
+        return;
+    }
+
+    uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(error).count();
+    size_t bucket = std::min<size_t>(std::bit_width(us), JitterHistogramSnapshot::BUCKETS - 1);
+    m_data.buckets[bucket]++;
+
+    m_data.total_error += error;
+    m_data.max_error = std::max(m_data.max_error, error);
+}
+void JitterHistogram::clear(){
+    WriteSpinLock lg(m_lock);
+    m_data = JitterHistogramSnapshot();
+}
+JitterHistogramSnapshot JitterHistogram::snapshot() const{
+    ReadSpinLock lg(m_lock);
+    return m_data;
+}
+
+
+
+}
@@ -0,0 +1,65 @@
+/*  Jitter Histogram
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Tracks how far off actual event times are from when they were
+ *  requested. Errors are bucketed by powers of two in microseconds so the
+ *  histogram stays small regardless of the range.
+ *
+ */
+
+#ifndef PokemonAutomation_JitterHistogram_H
+#define PokemonAutomation_JitterHistogram_H
+
+#include <string>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Time.h"
+
+namespace PokemonAutomation{
+
+
+struct JitterHistogramSnapshot{
+    //  Bucket 0 holds late errors under 1us. Bucket i holds [2^(i-1), 2^i) us.
+    //  The last bucket holds everything larger.
+    static constexpr size_t BUCKETS = 24;
+
+    uint64_t samples = 0;
+
+    //  Events that fired before they were requested.
+    uint64_t early = 0;
+
+    uint64_t buckets[BUCKETS] = {};
+
+    WallDuration total_error = WallDuration::zero();
+    WallDuration max_error = WallDuration::zero();
+
+    bool empty() const{ return samples == 0; }
+    WallDuration mean_error() const;
+
+    //  Upper bound of the bucket that contains this percentile.
+    WallDuration percentile(double percentile) const;
+
+    std::string to_str() const;
+};
+
+
+//  Thread-safe. Recording is cheap enough to call on every event.
+class JitterHistogram{
+public:
+    void add(SteadyClock requested, SteadyClock actual){
+        add(actual - requested);
+    }
+    void add(WallDuration error);
+
+    void clear();
+    JitterHistogramSnapshot snapshot() const;
+
+private:
+    mutable SpinLock m_lock;
+    JitterHistogramSnapshot m_data;
+};
+
+
+
+}
+#endif
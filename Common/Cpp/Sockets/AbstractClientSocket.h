@@ -8,6 +8,7 @@
 #define PokemonAutomation_Sockets_AbstractClientSocket_H
 
 #include <string>
+#include <string_view>
 #include "Common/Compiler.h"
 #include "Common/Cpp/ListenerSet.h"
 
@@ -61,6 +62,21 @@ public:
 
     virtual size_t send(const void* data, size_t bytes) = 0;
 
+    //  Send multiple buffers back-to-back as if they were one. Implementations
+    //  that can will hand all of them to the OS in a single call so they go
+    //  out together instead of one packet per buffer.
+    virtual size_t send_gather(const std::string_view* buffers, size_t count){
+        size_t sent = 0;
+        for (size_t c = 0; c < count; c++){
+            size_t current = send(buffers[c].data(), buffers[c].size());
+            sent += current;
+            if (current < buffers[c].size()){
+                break;
+            }
+        }
+        return sent;
+    }
+
 
 protected:
     std::atomic<State> m_state;
@@ -14,8 +14,11 @@
 #include <thread>
 #include <condition_variable>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <poll.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include "AbstractClientSocket.h"
@@ -30,6 +33,11 @@ public:
         : m_socket(socket(AF_INET, SOCK_STREAM, 0))
     {
         fcntl(m_socket, F_SETFL, O_NONBLOCK);
+
+        //  Controller commands are small and latency sensitive. Don't let
+        //  Nagle hold them back waiting for more data.
+        int no_delay = 1;
+        setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
     }
 
     virtual ~ClientSocket_POSIX(){
@@ -110,8 +118,81 @@ public:
         return sent;
     }
 
+    virtual size_t send_gather(const std::string_view* buffers, size_t count) override{
+        if (m_socket == -1){
+            return 0;
+        }
+
+        constexpr size_t MAX_VECTORS = 64;
+        iovec vectors[MAX_VECTORS];
+        size_t sent = 0;
+
+        while (count > 0){
+            size_t current = std::min(count, MAX_VECTORS);
+            size_t bytes = 0;
+            for (size_t c = 0; c < current; c++){
+                vectors[c].iov_base = (void*)buffers[c].data();
+                vectors[c].iov_len = buffers[c].size();
+                bytes += buffers[c].size();
+            }
+            size_t current_sent = send_vectors(vectors, current);
+            sent += current_sent;
+            if (current_sent < bytes){
+                return sent;
+            }
+            buffers += current;
+            count -= current;
+        }
+        return sent;
+    }
+
 
 private:
+    //  Send with writev() semantics. "vectors" is modified to track progress.
+    size_t send_vectors(iovec* vectors, size_t count){
+        msghdr message{};
+        message.msg_iov = vectors;
+        message.msg_iovlen = count;
+
+        size_t sent = 0;
+        while (message.msg_iovlen > 0){
+            ssize_t current_sent = ::sendmsg(m_socket, &message, MSG_DONTWAIT);
+            if (current_sent != -1){
+                sent += current_sent;
+
+                //  Skip over whatever went out and retry the rest.
+                size_t bytes = current_sent;
+                while (message.msg_iovlen > 0 && bytes >= message.msg_iov->iov_len){
+                    bytes -= message.msg_iov->iov_len;
+                    message.msg_iov++;
+                    message.msg_iovlen--;
+                }
+                if (message.msg_iovlen > 0){
+                    message.msg_iov->iov_base = (char*)message.msg_iov->iov_base + bytes;
+                    message.msg_iov->iov_len -= bytes;
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lg(m_lock);
+            if (state() == State::DESTRUCTING){
+                break;
+            }
+
+            int error = errno;
+            switch (error){
+            case EAGAIN:
+                break;
+            default:
+                m_error = "POSIX Error Code: " + std::to_string(error);
+                return sent;
+            }
+
+            m_cv.wait_for(lg, std::chrono::milliseconds(1));
+        }
+        return sent;
+    }
+
     void thread_loop(const std::string& address, uint16_t port){
         try{
             thread_loop_internal(address, port);
@@ -214,10 +295,18 @@ Connected:
 //                case EWOULDBLOCK:
                     break;
                 default:
-                    std::unique_lock<std::mutex> lg(m_lock);
                     m_error = "POSIX Error Code: " + std::to_string(error);
                     return;
                 }
+
+                //  Nothing to read. Block until something arrives rather than
+                //  sleeping a fixed amount since that adds directly to the
+                //  round-trip time. The timeout bounds how long it takes to
+                //  notice close().
+                lg.unlock();
+                pollfd fd{m_socket, POLLIN, 0};
+                ::poll(&fd, 1, 10);
+                continue;
             }
 
             m_cv.wait_for(lg, std::chrono::milliseconds(1));
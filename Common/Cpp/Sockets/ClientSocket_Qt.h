@@ -84,6 +84,17 @@ public:
         return send_data.bytes_sent;
 #endif
     }
+    virtual size_t send_gather(const std::string_view* buffers, size_t count) override{
+        //  Everything is copied into one packet for the socket thread anyway.
+        //  Do it once for the whole batch.
+        std::string packet;
+        for (size_t c = 0; c < count; c++){
+            packet += buffers[c];
+        }
+        size_t bytes = packet.size();
+        emit internal_send(std::move(packet));
+        return bytes;
+    }
 
 
 signals:
@@ -98,6 +109,7 @@ private:
             &socket, &QTcpSocket::connected,
             &socket, [this]{
 //                cout << "connected()" << endl;
+                m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
                 m_state.store(State::CONNECTED, std::memory_order_release);
                 m_listeners.run_method_unique(&Listener::on_connect_finished, "");
             }
@@ -31,6 +31,11 @@ public:
             close_socket();
             return;
         }
+
+        //  Controller commands are small and latency sensitive. Don't let
+        //  Nagle hold them back waiting for more data.
+        BOOL no_delay = TRUE;
+        setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&no_delay, sizeof(no_delay));
     }
 
     virtual ~ClientSocket_WinSocket(){
@@ -21,6 +21,17 @@ using Seconds = std::chrono::seconds;
 inline WallClock current_time(){
     return std::chrono::system_clock::now();
 }
+
+
+//  Monotonic time. Unlike "WallClock", this never jumps when the system time
+//  is adjusted. Use this for anything that schedules or waits on intervals.
+//  It uses the same tick as "WallDuration" so durations mix freely.
+using SteadyClock = std::chrono::time_point<std::chrono::steady_clock, WallDuration>;
+
+inline SteadyClock current_steady_time(){
+    return std::chrono::time_point_cast<WallDuration>(std::chrono::steady_clock::now());
+}
+
 std::string current_time_to_str();
 
 
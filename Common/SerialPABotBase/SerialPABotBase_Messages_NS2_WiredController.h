@@ -34,6 +34,39 @@ typedef struct{
 } PABB_PACK pabb_Message_Command_NS2_WiredController_State;
 
 
+//
+//  Run of controller states in a single command. The device runs them back to
+//  back in order. Each state costs one seqnum/ack/queue slot less than sending
+//  it as its own "PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE".
+//
+//  Only supported if the device protocol version is at least
+//  "PABB_PROTOCOL_VERSION_NS2_WIRED_CONTROLLER_STATE_BATCH".
+//
+//  No released firmware implements this yet. The version and message ID are
+//  reserved for it. Until firmware at that version is added to
+//  "SUPPORTED_DEVICES()", no device can connect at it and the host always
+//  falls back to single-state commands.
+//
+//  Body is variable length:
+//      seqnum_t    seqnum
+//      uint8_t     count
+//      Followed by "count" entries of:
+//          uint16_t    milliseconds
+//          uint8_t     changed         Bit i is set if byte i of the report follows.
+//          uint8_t     bytes[]         The changed bytes of the report in order.
+//
+//  Each report is delta-encoded against the previous entry in the same
+//  message. The first entry is relative to the neutral state.
+//
+#define PABB_PROTOCOL_VERSION_NS2_WIRED_CONTROLLER_STATE_BATCH      2025101000
+#define PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE_BATCH           0x91
+#define PABB_NS2_WIRED_CONTROLLER_STATE_BATCH_MAX_BODY              (PABB_PROTOCOL_MAX_PACKET_SIZE - PABB_PROTOCOL_OVERHEAD)
+typedef struct{
+    seqnum_t seqnum;
+    uint8_t count;
+} PABB_PACK pabb_Message_Command_NS2_WiredController_StateBatch_Header;
+
+
 
 #ifdef __cplusplus
 }
@@ -16,5 +16,9 @@ const size_t NUM_FFT_SAMPLES = 1 << FFT_LENGTH_POWER_OF_TWO;
 //const int NUM_FFT_WINDOWS = 100;
 const size_t FFT_SLIDING_WINDOW_STEP = NUM_FFT_SAMPLES/4;
 
+//  All FFTs are computed at this sample rate regardless of the input device.
+//  Audio at other rates is resampled first.
+const size_t AUDIO_FFT_SAMPLE_RATE = 48000;
+
 
 #endif
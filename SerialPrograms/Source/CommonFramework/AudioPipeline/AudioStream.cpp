@@ -110,26 +110,16 @@ void AudioStreamToFloat::convert(void* out, const void* in, size_t count){
         if (m_volume_multiplier == 1.0){
             memcpy(out, in, count * m_frame_size);
         }else{
-            float volume_multiplier = m_volume_multiplier;
-            float* o = (float*)out;
-            const float* i = (float*)in;
-            size_t stop = count * m_samples_per_frame;
-            for (size_t c = 0; c < stop; c++){
-                o[c] = i[c] * volume_multiplier;
-            }
+            Kernels::AudioStreamConversion::scale_audio_float(
+                (float*)out, (const float*)in, count * m_samples_per_frame, m_volume_multiplier
+            );
         }
         break;
     case AudioSampleFormat::INVALID:
         break;
     }
     if (m_reverse_channels){
-        float* ptr = (float*)out;
-        for (size_t c = 0; c < count; c++){
-            float r0 = ptr[2*c + 0];
-            float r1 = ptr[2*c + 1];
-            ptr[2*c + 0] = r1;
-            ptr[2*c + 1] = r0;
-        }
+        Kernels::AudioStreamConversion::swap_audio_stereo_channels((float*)out, count);
     }
 }
 
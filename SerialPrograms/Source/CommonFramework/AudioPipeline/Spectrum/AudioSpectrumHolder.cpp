@@ -8,9 +8,14 @@
 #include <cmath>
 #include <cassert>
 #include <algorithm>
+#include "Common/Cpp/CpuId/CpuId.h"
 #include "CommonFramework/AudioPipeline/AudioConstants.h"
 #include "AudioSpectrumHolder.h"
 
+#ifdef PA_ARCH_x86
+#include <emmintrin.h>
+#endif
+
 #include <iostream>
 using std::cout;
 using std::endl;
@@ -136,23 +141,73 @@ void AudioSpectrumHolder::clear(){
 
 
 // TODO: move this to a common lib folder:
-PA_FORCE_INLINE uint32_t jetColorMap(float v){
-    if (v <= 0.f){
-        return combine_rgb(0,0,0);
-    }else if (v < 0.125f){
-//        return qRgb(0, 0, int((0.5f + 4.f * v) * 255.f));
-        return combine_rgb(0, 0, uint8_t((0.0f + 8.f * v) * 255.f));
-    }else if (v < 0.375f){
-        return combine_rgb(0, uint8_t((v - 0.125f)*1020.f), 255);
-    }else if (v < 0.625f){
-        uint8_t c = uint8_t((v - 0.375f) * 1020.f);
-        return combine_rgb(c, 255, 255-c);
-    }else if (v < 0.875f){
-        return combine_rgb(255, 255 - uint8_t((v-0.625f) * 1020.f), 0);
-    }else if (v <= 1.0){
-        return combine_rgb(255 - uint8_t((v-0.875)*1020.f), 0, 0);
-    }else{
-        return combine_rgb(255, 255, 255);
+//
+//  Jet color map. Each channel is a clamped min() of two ramps:
+//      [0, 0.125)      (0, 0, 8v)
+//      [0.125, 0.375)  (0, ramp up, 255)
+//      [0.375, 0.625)  (ramp up, 255, ramp down)
+//      [0.625, 0.875)  (255, ramp down, 0)
+//      [0.875, 1.0]    (ramp down, 0, 0)
+//      > 1.0           white
+//
+//  This is branchless so it can be done 4 at a time.
+//  Ramps are truncated before they are combined to round the same way as
+//  the per-value branches this replaces.
+PA_FORCE_INLINE int32_t jet_channel(float up, float down){
+    int32_t x = std::min((int32_t)up, 255 - (int32_t)down);
+    x = std::max(x, (int32_t)0);
+    x = std::min(x, (int32_t)255);
+    return x;
+}
+#ifdef PA_ARCH_x86
+PA_FORCE_INLINE __m128i jet_min_epi32(__m128i x, __m128i y){
+    __m128i gt = _mm_cmpgt_epi32(x, y);
+    return _mm_or_si128(_mm_and_si128(gt, y), _mm_andnot_si128(gt, x));
+}
+PA_FORCE_INLINE __m128i jet_channel(__m128 up, __m128 down){
+    __m128i x = jet_min_epi32(
+        _mm_cvttps_epi32(up),
+        _mm_sub_epi32(_mm_set1_epi32(255), _mm_cvttps_epi32(down))
+    );
+    x = _mm_andnot_si128(_mm_srai_epi32(x, 31), x);     //  max(x, 0)
+    x = jet_min_epi32(x, _mm_set1_epi32(255));
+    return x;
+}
+#endif
+static void jet_color_map(uint32_t* colors, const float* values, size_t length){
+    size_t c = 0;
+#ifdef PA_ARCH_x86
+    const __m128 scale = _mm_set1_ps(1020.f);
+    for (; c + 4 <= length; c += 4){
+        __m128 v = _mm_loadu_ps(values + c);
+        __m128 x = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.f)), _mm_set1_ps(2.f));
+        __m128i r = jet_channel(
+            _mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(0.375f)), scale),
+            _mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(0.875f)), scale)
+        );
+        __m128i g = jet_channel(
+            _mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(0.125f)), scale),
+            _mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(0.625f)), scale)
+        );
+        __m128i b = jet_channel(
+            _mm_mul_ps(x, _mm_set1_ps(2040.f)),
+            _mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(0.375f)), scale)
+        );
+        __m128i pixel = _mm_or_si128(_mm_slli_epi32(r, 16), _mm_slli_epi32(g, 8));
+        pixel = _mm_or_si128(pixel, b);
+        pixel = _mm_or_si128(pixel, _mm_set1_epi32(0xff000000));
+        pixel = _mm_or_si128(pixel, _mm_castps_si128(_mm_cmpgt_ps(v, _mm_set1_ps(1.0f))));
+        _mm_storeu_si128((__m128i*)(colors + c), pixel);
+    }
+#endif
+    for (; c < length; c++){
+        float v = values[c];
+        float x = std::min(std::max(v, -1.f), 2.f);
+        int32_t r = jet_channel((x - 0.375f) * 1020.f, (x - 0.875f) * 1020.f);
+        int32_t g = jet_channel((x - 0.125f) * 1020.f, (x - 0.625f) * 1020.f);
+        int32_t b = jet_channel(x * 2040.f, (x - 0.375f) * 1020.f);
+        uint32_t pixel = 0xff000000 | ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+        colors[c] = v > 1.0f ? 0xffffffff : pixel;
     }
 }
 
@@ -218,9 +273,13 @@ void AudioSpectrumHolder::push_spectrum(size_t sample_rate, std::shared_ptr<cons
             }
 
             m_last_spectrum.values[i] = mag;
-            m_last_spectrum.colors[i] = jetColorMap(mag);
             previous = mag;
         }
+        jet_color_map(
+            m_last_spectrum.colors.data(),
+            m_last_spectrum.values.data(),
+            m_freq_visualization_block_boundaries.size() - 1
+        );
 //        cout << "AudioSpectrumHolder::push_spectrum" << endl;
         m_spectrograph->push_spectrum(m_last_spectrum.colors.data());
         m_nextFFTWindowIndex = (m_nextFFTWindowIndex+1) % m_num_freq_windows;
@@ -290,11 +349,11 @@ AudioSpectrumHolder::SpectrumSnapshot AudioSpectrumHolder::get_last_spectrum() c
     std::lock_guard<std::mutex> lg(m_state_lock);
     return m_last_spectrum;
 }
-AudioSpectrumHolder::SpectrographSnapshot AudioSpectrumHolder::get_spectrograph() const{
+void AudioSpectrumHolder::update_spectrograph(SpectrographSnapshot& ret) const{
     std::lock_guard<std::mutex> lg(m_state_lock);
 
-    SpectrographSnapshot ret;
-    ret.image = m_spectrograph->to_image();
+    ret.oldest_column = m_spectrograph->sync_ring(ret.image, ret.synced);
+    ret.overlays.clear();
 
     //  Calculate overplay coordinates.
 
@@ -314,7 +373,7 @@ AudioSpectrumHolder::SpectrographSnapshot AudioSpectrumHolder::get_spectrograph(
     }
     if (oldestStamp == SIZE_MAX){
         // we have no valid windows in the spectrogram, so no overlays to render:
-        return ret;
+        return;
     }
     size_t newestStamp = m_freqVisStamps[(m_nextFFTWindowIndex + m_num_freq_windows - 1) % m_num_freq_windows];
     // size_t newestWindowID = m_num_freq_windows - 1;
@@ -340,7 +399,6 @@ AudioSpectrumHolder::SpectrographSnapshot AudioSpectrumHolder::get_spectrograph(
             color
         );
     }
-    return ret;
 }
 
 
@@ -55,11 +55,21 @@ public:
     };
     SpectrumSnapshot get_last_spectrum() const;
 
+    //  A viewer's copy of the spectrograph. Keep it around between calls to
+    //  "update_spectrograph()" so only the new spectrums need to be copied.
     struct SpectrographSnapshot{
+        //  Ring of spectrums, one per column. See "Spectrograph::sync_ring()".
         ImageRGB32 image;
+        uint64_t synced = 0;
+
+        //  The column of "image" that holds the oldest spectrum.
+        size_t oldest_column = 0;
+
+        //  <first window, number of windows, color>. Windows are counted from
+        //  the oldest one, not from the start of "image".
         std::vector<std::tuple<size_t, size_t, Color>> overlays;
     };
-    SpectrographSnapshot get_spectrograph() const;
+    void update_spectrograph(SpectrographSnapshot& snapshot) const;
 
 
 public:
@@ -7,17 +7,25 @@
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "Kernels/AbsFFT/Kernels_AbsFFT.h"
+#include "Kernels/AudioStreamConversion/AudioStreamConversion.h"
 #include "CommonFramework/AudioPipeline/AudioConstants.h"
+#include "CommonFramework/AudioPipeline/Tools/AudioResampler.h"
 #include "FFTStreamer.h"
 
 namespace PokemonAutomation{
 
 
+//  Most windows that are transformed together. Bounds the scratch space if a
+//  large block of audio arrives at once.
+const size_t MAX_FFT_BATCH = 8;
+
+
 
 std::unique_ptr<AudioFloatToFFT> make_FFT_streamer(AudioChannelFormat format){
     switch (format){
     case AudioChannelFormat::MONO_48000:
         return std::make_unique<AudioFloatToFFT>(48000, 1, false);
+    //  Resampled to 48000Hz before the FFT.
     case AudioChannelFormat::DUAL_44100:
         return std::make_unique<AudioFloatToFFT>(44100, 2, true);
     case AudioChannelFormat::DUAL_48000:
@@ -43,94 +51,72 @@ void AudioFloatToFFT::remove_listener(FFTListener& listener){
 }
 
 AudioFloatToFFT::AudioFloatToFFT(
-    size_t sample_rate,
+    size_t input_sample_rate,
     size_t samples_per_frame, bool average_pairs
 )
     : AudioFloatStreamListener(samples_per_frame)
-    , m_sample_rate(sample_rate)
+    , m_sample_rate(AUDIO_FFT_SAMPLE_RATE)
     , m_average(average_pairs)
-    , m_fft_sample_size(average_pairs ? 2 : 1)
-    , m_buffer(NUM_FFT_SAMPLES)
-    , m_buffered(NUM_FFT_SAMPLES)
-    , m_fft_input(NUM_FFT_SAMPLES)
+    , m_samples(NUM_FFT_SAMPLES, 0.f)
+    , m_fft_input(NUM_FFT_SAMPLES * MAX_FFT_BATCH)
+    , m_fft_output(NUM_FFT_SAMPLES / 2 * MAX_FFT_BATCH)
 {
     if (samples_per_frame == 0 || samples_per_frame > 2){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Channels must be 1 or 2.");
     }
-    memset(m_buffer.data(), 0, m_buffer.size() * sizeof(float));
+    if (input_sample_rate != AUDIO_FFT_SAMPLE_RATE){
+        m_resampler = std::make_unique<AudioResampler>(input_sample_rate, AUDIO_FFT_SAMPLE_RATE);
+    }
 }
 AudioFloatToFFT::~AudioFloatToFFT(){}
 void AudioFloatToFFT::on_samples(const float* data, size_t frames){
 //    cout << "objects = " << objects << endl;
-    const float* ptr = data;
-    while (frames > 0){
-        //  Figure out how much space we can write contiguously.
-        size_t block = m_buffer.size() - std::max(m_buffered, m_end);
-
-        //  Don't write more than we have.
-        block = std::min(block, frames);
-
-//        cout << "block = " << block << endl;
-
-        //  Write it.
-        convert(&m_buffer[m_end], ptr, block);
-        m_buffered += block;
-        m_end += block;
-        if (m_end == m_buffer.size()){
-            m_end = 0;
-        }
-        ptr += block * m_fft_sample_size;
-        frames -= block;
-
-        //  Buffer is full. Time to run FFT!
-        if (m_buffered == m_buffer.size()){
-//            cout << "run_fft()" << endl;
-            run_fft();
-            drop_from_front(FFT_SLIDING_WINDOW_STEP);
-        }
+    const float* mono = data;
+    if (m_average){
+        m_mono.resize(frames);
+        Kernels::AudioStreamConversion::average_audio_stereo_to_mono(m_mono.data(), data, frames);
+        mono = m_mono.data();
+    }
+    if (m_resampler){
+        m_resampled.clear();
+        m_resampler->push_samples(m_resampled, mono, frames);
+        mono = m_resampled.data();
+        frames = m_resampled.size();
     }
+    push_mono_samples(mono, frames);
 }
-void AudioFloatToFFT::convert(float* fft_input, const float* audio_stream, size_t frames){
-    if (!m_average){
-        memcpy(fft_input, audio_stream, frames * sizeof(float));
+void AudioFloatToFFT::push_mono_samples(const float* data, size_t frames){
+    if (frames == 0){
         return;
     }
-    for (size_t c = 0; c < frames; c++){
-        fft_input[c] = (audio_stream[2*c + 0] + audio_stream[2*c + 1]) * 0.5f;
-    }
+    m_samples.insert(m_samples.end(), data, data + frames);
+    run_ffts();
 }
-void AudioFloatToFFT::run_fft(){
-    float* ptr = m_fft_input.data();
-    size_t remaining = NUM_FFT_SAMPLES;
-    size_t index = m_start;
-    while (remaining > 0){
-        size_t block = std::min(remaining, m_buffer.size() - index);
-        memcpy(ptr, &m_buffer[index], block * sizeof(float));
-        ptr += block;
-        remaining -= block;
-        index += block;
-        if (index == m_buffer.size()){
-            index = 0;
+void AudioFloatToFFT::run_ffts(){
+    while (m_samples.size() >= NUM_FFT_SAMPLES){
+        //  Every window that is fully buffered. They overlap by all but one step.
+        size_t windows = (m_samples.size() - NUM_FFT_SAMPLES) / FFT_SLIDING_WINDOW_STEP + 1;
+        windows = std::min(windows, MAX_FFT_BATCH);
+
+        for (size_t c = 0; c < windows; c++){
+            memcpy(
+                &m_fft_input[c * NUM_FFT_SAMPLES],
+                &m_samples[c * FFT_SLIDING_WINDOW_STEP],
+                NUM_FFT_SAMPLES * sizeof(float)
+            );
         }
-    }
-    std::shared_ptr<AlignedVector<float>> out = std::make_unique<AlignedVector<float>>(NUM_FFT_SAMPLES / 2);
-    Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, out->data(), m_fft_input.data());
-    m_listeners.run_method_unique(
-        &FFTListener::on_fft,
-        m_sample_rate, out
-    );
-}
-void AudioFloatToFFT::drop_from_front(size_t frames){
-    if (frames >= m_buffered){
-        m_buffered = 0;
-        m_start = 0;
-        m_end = 0;
-        return;
-    }
-    m_buffered -= frames;
-    m_start += frames;
-    while (m_start >= m_buffer.size()){
-        m_start -= m_buffer.size();
+        Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, windows, m_fft_output.data(), m_fft_input.data());
+
+        for (size_t c = 0; c < windows; c++){
+            std::shared_ptr<AlignedVector<float>> out = std::make_unique<AlignedVector<float>>(NUM_FFT_SAMPLES / 2);
+            memcpy(out->data(), &m_fft_output[c * NUM_FFT_SAMPLES / 2], NUM_FFT_SAMPLES / 2 * sizeof(float));
+            m_listeners.run_method_unique(
+                &FFTListener::on_fft,
+                m_sample_rate, out
+            );
+        }
+
+        m_samples.erase(m_samples.begin(), m_samples.begin() + windows * FFT_SLIDING_WINDOW_STEP);
     }
 }
 
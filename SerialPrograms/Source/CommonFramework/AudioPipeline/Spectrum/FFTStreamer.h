@@ -8,11 +8,13 @@
 #define PokemonAutomation_AudioPipeline_FFTStreamer_H
 
 #include <memory>
+#include <vector>
 #include "Common/Cpp/ListenerSet.h"
 #include "CommonFramework/AudioPipeline/AudioStream.h"
 
 namespace PokemonAutomation{
 
+class AudioResampler;
 
 
 struct FFTListener{
@@ -22,6 +24,10 @@ struct FFTListener{
 
 
 //  Listen to an audio stream and compute FFTs on it.
+//
+//  Stereo input is averaged down to mono. Input that isn't at
+//  "AUDIO_FFT_SAMPLE_RATE" is resampled to it so the FFT bins always mean the
+//  same frequencies and templates only need to exist at one rate.
 class AudioFloatToFFT : public AudioFloatStreamListener{
 public:
     void add_listener(FFTListener& listener);
@@ -29,29 +35,31 @@ public:
 
 public:
     AudioFloatToFFT(
-        size_t sample_rate,
+        size_t input_sample_rate,   //  Sample rate after pairs are averaged.
         size_t samples_per_frame, bool average_pairs
     );
     virtual ~AudioFloatToFFT();
     virtual void on_samples(const float* data, size_t frames) override;
 
 private:
-    void convert(float* fft_input, const float* audio_stream, size_t frames);
-    void run_fft();
-    void drop_from_front(size_t frames);
+    void push_mono_samples(const float* data, size_t samples);
+    void run_ffts();
 
 private:
     size_t m_sample_rate;
 
     bool m_average;
-    size_t m_fft_sample_size;
+    std::vector<float> m_mono;
 
-    AlignedVector<float> m_buffer;
-    size_t m_buffered = 0;
-    size_t m_start = 0;
-    size_t m_end = 0;
+    std::unique_ptr<AudioResampler> m_resampler;
+    std::vector<float> m_resampled;
 
+    //  Mono samples that haven't been dropped by the sliding window yet.
+    std::vector<float> m_samples;
+
+    //  Scratch space for a batch of windows.
     AlignedVector<float> m_fft_input;
+    AlignedVector<float> m_fft_output;
 
     ListenerSet<FFTListener> m_listeners;
 };
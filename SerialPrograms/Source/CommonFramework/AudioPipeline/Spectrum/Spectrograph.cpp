@@ -4,6 +4,8 @@
  *
  */
 
+#include <string.h>
+#include <algorithm>
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "Spectrograph.h"
@@ -17,12 +19,17 @@ Spectrograph::Spectrograph(size_t buckets, size_t frames)
     , m_frames(frames)
     , m_current_index(0)
     , m_buffer(buckets * frames)
+    , m_columns_written(0)
 {
     memset(m_buffer.data(), 0, m_buffer.size() * sizeof(uint32_t));
 }
 
 void Spectrograph::clear(){
     memset(m_buffer.data(), 0, m_buffer.size() * sizeof(uint32_t));
+
+    //  Every column changed. Move the sync point far enough that everyone
+    //  resyncs everything.
+    m_columns_written += m_frames;
 }
 
 void Spectrograph::push_spectrum(const uint32_t* spectrum){
@@ -35,6 +42,41 @@ void Spectrograph::push_spectrum(const uint32_t* spectrum){
     if (m_current_index >= m_frames){
         m_current_index = 0;
     }
+    m_columns_written++;
+}
+size_t Spectrograph::sync_ring(ImageRGB32& ring, uint64_t& synced) const{
+    if (ring.width() != m_frames || ring.height() != m_buckets){
+        ring = ImageRGB32(m_frames, m_buckets);
+        synced = 0;
+    }
+
+    //  Range of ring columns to copy. It may wrap around.
+    size_t start = 0;
+    size_t count = m_frames;
+    uint64_t missing = m_columns_written - synced;
+    if (synced != 0 && synced <= m_columns_written && missing < m_frames){
+        start = (m_current_index + m_frames - (size_t)missing) % m_frames;
+        count = (size_t)missing;
+    }
+    synced = m_columns_written;
+    if (count == 0){
+        return m_current_index;
+    }
+
+    size_t first = std::min(count, m_frames - start);
+    size_t second = count - first;
+
+    size_t bytes_per_line = ring.bytes_per_row();
+    uint32_t* dst = ring.data();
+    const uint32_t* src = m_buffer.data();
+    for (size_t c = 0; c < m_buckets; c++){
+        memcpy(dst + start, src + start, first * sizeof(uint32_t));
+        memcpy(dst, src, second * sizeof(uint32_t));
+        src += m_frames;
+        dst = (uint32_t*)((char*)dst + bytes_per_line);
+    }
+
+    return m_current_index;
 }
 ImageRGB32 Spectrograph::to_image() const{
     ImageRGB32 image(m_frames, m_buckets);
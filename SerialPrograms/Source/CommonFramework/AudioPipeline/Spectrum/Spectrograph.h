@@ -5,6 +5,11 @@
  *      Holds a history of the most recent FFT spectrums as colors.
  *  This is used to render the spectrograph.
  *
+ *  The history is a ring of columns. Viewers keep their own copy of the ring
+ *  and use "sync_ring()" to copy only the columns that are new since their
+ *  last sync. They then draw it in two pieces split at the wrap-around
+ *  column instead of unrolling it into a new image every time.
+ *
  */
 
 #ifndef PokemonAutomation_AudioPipeline_Spectrograph_H
@@ -23,10 +28,22 @@ public:
     Spectrograph(size_t buckets_per_spectrum, size_t frames);
     ~Spectrograph();
 
+    size_t buckets() const{ return m_buckets; }
+    size_t frames() const{ return m_frames; }
+
     void clear();
 
     void push_spectrum(const uint32_t* spectrum);
 
+    //  Bring "ring" up to date. "ring" is a (frames x buckets) image in the
+    //  same wrap-around layout as this class. It is (re)allocated if it isn't
+    //  the right size. "synced" is the sync point of "ring" and is updated.
+    //  Start it at zero.
+    //
+    //  Returns the column of "ring" that holds the oldest spectrum.
+    size_t sync_ring(ImageRGB32& ring, uint64_t& synced) const;
+
+    //  Unroll the history into a new image with the oldest spectrum on the left.
     ImageRGB32 to_image() const;
 
 
@@ -35,6 +52,9 @@ private:
     size_t m_frames;
     size_t m_current_index;
     AlignedVector<uint32_t> m_buffer;
+
+    //  Number of columns written so far. Used as the sync point.
+    uint64_t m_columns_written;
 };
 
 
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <sstream>
 #include <QAudioFormat>
+#include "Kernels/AudioStreamConversion/AudioStreamConversion.h"
 #include "AudioFormatUtils.h"
 #include "AudioNormalization.h"
 
@@ -71,10 +72,22 @@ void convertSamplesToFloat(const QAudioFormat& format, const char* data, size_t
             normalize_type<int8_t>(format, data, len, out);
             return;
         case 16:
-            normalize_type<int16_t>(format, data, len, out);
+            if (format.byteOrder() == QAudioFormat::Endian::LittleEndian){
+                Kernels::AudioStreamConversion::convert_audio_sint16_to_float(
+                    out, reinterpret_cast<const int16_t*>(data), len/sizeof(int16_t), 1.0f
+                );
+            }else{
+                normalize_type<int16_t>(format, data, len, out);
+            }
             return;
         case 32:
-            normalize_type<int32_t>(format, data, len, out);
+            if (format.byteOrder() == QAudioFormat::Endian::LittleEndian){
+                Kernels::AudioStreamConversion::convert_audio_sint32_to_float(
+                    out, reinterpret_cast<const int32_t*>(data), len/sizeof(int32_t), 1.0f
+                );
+            }else{
+                normalize_type<int32_t>(format, data, len, out);
+            }
             return;
         default:
             break;
@@ -83,7 +96,10 @@ void convertSamplesToFloat(const QAudioFormat& format, const char* data, size_t
     case QAudioFormat::SampleType::UnSignedInt:
         switch(format.sampleSize()){
         case 8:
-            normalize_type<uint8_t>(format, data, len, out);
+            //  (x - 127) / 127, clamped. See the Qt6 UInt8 case below.
+            Kernels::AudioStreamConversion::convert_audio_uint8_to_float(
+                out, reinterpret_cast<const uint8_t*>(data), len/sizeof(uint8_t), 1.0f
+            );
             return;
         case 16:
             normalize_type<uint16_t>(format, data, len, out);
@@ -156,13 +172,21 @@ void convertSamplesToFloat(const QAudioFormat& format, const char* data, size_t
         memcpy(out, data, len);
         break;
     case QAudioFormat::SampleFormat::Int16:
-        normalize_audio_le<int16_t>(out, reinterpret_cast<const int16_t*>(data), len/sizeof(int16_t));
+        Kernels::AudioStreamConversion::convert_audio_sint16_to_float(
+            out, reinterpret_cast<const int16_t*>(data), len/sizeof(int16_t), 1.0f
+        );
         break;
     case QAudioFormat::SampleFormat::Int32:
-        normalize_audio_le<int32_t>(out, reinterpret_cast<const int32_t*>(data), len/sizeof(int32_t));
+        Kernels::AudioStreamConversion::convert_audio_sint32_to_float(
+            out, reinterpret_cast<const int32_t*>(data), len/sizeof(int32_t), 1.0f
+        );
         break;
     case QAudioFormat::SampleFormat::UInt8:
-        normalize_audio_le<uint8_t>(out, reinterpret_cast<const uint8_t*>(data), len/sizeof(uint8_t));
+        //  Same scaling as AudioStreamToFloat: (x - 127) / 127, clamped to 1.0.
+        //  This used to be x * 2/255 - 1 here.
+        Kernels::AudioStreamConversion::convert_audio_uint8_to_float(
+            out, reinterpret_cast<const uint8_t*>(data), len/sizeof(uint8_t), 1.0f
+        );
         break;
     default:
         std::cout << "Error: Unkwnon sample format in convertSamplesToFloat()" << std::endl;
@@ -0,0 +1,151 @@
+/*  Audio Resampler
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include "Common/Compiler.h"
+#include "Common/Cpp/Exceptions.h"
+#include "AudioResampler.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+const double PI = 3.14159265358979323846;
+
+//  Zeroth order modified Bessel function of the first kind.
+double bessel_i0(double x){
+    double sum = 1;
+    double term = 1;
+    double half_x_sqr = x * x / 4;
+    for (size_t k = 1; k < 64; k++){
+        term *= half_x_sqr / (double)(k * k);
+        sum += term;
+        if (term < sum * 1e-12){
+            break;
+        }
+    }
+    return sum;
+}
+
+//  Kaiser with beta = 8 gives around 80 dB of stop band attenuation.
+const double KAISER_BETA = 8.0;
+
+//  Put the cutoff a bit below the Nyquist frequency of the slower rate so that
+//  the transition band doesn't alias.
+const double CUTOFF_RATIO = 0.92;
+
+PA_FORCE_INLINE float dot_product(const float* x, const float* y, size_t length){
+    float sum0 = 0;
+    float sum1 = 0;
+    float sum2 = 0;
+    float sum3 = 0;
+    size_t lc = length / 4;
+    while (lc--){
+        sum0 += x[0] * y[0];
+        sum1 += x[1] * y[1];
+        sum2 += x[2] * y[2];
+        sum3 += x[3] * y[3];
+        x += 4;
+        y += 4;
+    }
+    length %= 4;
+    while (length--){
+        sum0 += x[0] * y[0];
+        x += 1;
+        y += 1;
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+}
+
+
+
+AudioResampler::AudioResampler(size_t input_sample_rate, size_t output_sample_rate, size_t taps_per_phase)
+    : m_input_sample_rate(input_sample_rate)
+    , m_output_sample_rate(output_sample_rate)
+    , m_taps(taps_per_phase)
+{
+    if (input_sample_rate == 0 || output_sample_rate == 0){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Sample rate cannot be zero.");
+    }
+    if (taps_per_phase == 0){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Must have at least one tap.");
+    }
+
+    size_t gcd = std::gcd(input_sample_rate, output_sample_rate);
+    m_up = output_sample_rate / gcd;
+    m_down = input_sample_rate / gcd;
+
+    //  Windowed sinc at the upsampled rate.
+    size_t length = m_up * m_taps;
+    double center = (double)(length - 1) / 2;
+    double cutoff = CUTOFF_RATIO * 0.5 * (double)std::min(input_sample_rate, output_sample_rate)
+        / (double)(input_sample_rate * m_up);
+    double window_scale = 1 / bessel_i0(KAISER_BETA);
+
+    m_filter.resize(length);
+    for (size_t phase = 0; phase < m_up; phase++){
+        float* coefficients = &m_filter[phase * m_taps];
+        double sum = 0;
+        for (size_t j = 0; j < m_taps; j++){
+            size_t k = phase + m_up * j;
+            double x = (double)k - center;
+            double sinc = x == 0 ? 1 : std::sin(2 * PI * cutoff * x) / (PI * x) / (2 * cutoff);
+            double r = x / (center + 1);
+            double window = bessel_i0(KAISER_BETA * std::sqrt(std::max(0., 1 - r * r))) * window_scale;
+            double h = sinc * window;
+            coefficients[m_taps - 1 - j] = (float)h;
+            sum += h;
+        }
+
+        //  Normalize every phase to unity DC gain. Otherwise a constant input
+        //  picks up a ripple at the phase rate.
+        for (size_t j = 0; j < m_taps; j++){
+            coefficients[j] = (float)(coefficients[j] / sum);
+        }
+    }
+
+    clear();
+}
+
+void AudioResampler::clear(){
+    m_input.assign(m_taps - 1, 0.f);
+    m_position = (m_taps - 1) * m_up;
+}
+
+void AudioResampler::push_samples(std::vector<float>& output, const float* input, size_t length){
+    m_input.insert(m_input.end(), input, input + length);
+
+    const float* samples = m_input.data();
+    size_t available = m_input.size();
+    while (true){
+        size_t base = m_position / m_up;
+        if (base >= available){
+            break;
+        }
+        size_t phase = m_position % m_up;
+        output.emplace_back(dot_product(
+            &m_filter[phase * m_taps],
+            samples + base + 1 - m_taps,
+            m_taps
+        ));
+        m_position += m_down;
+    }
+
+    //  Drop the input that no future output will touch.
+    size_t drop = m_position / m_up + 1 - m_taps;
+    drop = std::min(drop, available);
+    m_input.erase(m_input.begin(), m_input.begin() + drop);
+    m_position -= drop * m_up;
+}
+
+
+
+}
@@ -0,0 +1,60 @@
+/*  Audio Resampler
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Streaming polyphase resampler for a single channel of float samples.
+ *
+ *  The ratio between the two rates is reduced to "up / down". Conceptually the
+ *  input is upsampled by "up", low-pass filtered, then decimated by "down".
+ *  Only the filter phases that land on an output sample are ever evaluated.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_AudioResampler_H
+#define PokemonAutomation_AudioPipeline_AudioResampler_H
+
+#include <stddef.h>
+#include <vector>
+
+namespace PokemonAutomation{
+
+
+class AudioResampler{
+public:
+    AudioResampler(size_t input_sample_rate, size_t output_sample_rate, size_t taps_per_phase = 64);
+
+    size_t input_sample_rate() const{ return m_input_sample_rate; }
+    size_t output_sample_rate() const{ return m_output_sample_rate; }
+
+    //  Feed "length" input samples. Append all the output samples that can be
+    //  computed so far to "output". Output lags the input by about half of
+    //  "taps_per_phase" input samples.
+    void push_samples(std::vector<float>& output, const float* input, size_t length);
+
+    //  Forget all buffered input.
+    void clear();
+
+private:
+    size_t m_input_sample_rate;
+    size_t m_output_sample_rate;
+    size_t m_up;
+    size_t m_down;
+    size_t m_taps;
+
+    //  "m_up" phases of "m_taps" coefficients each. Each phase is stored
+    //  reversed so that it lines up with the input in memory order.
+    std::vector<float> m_filter;
+
+    //  Input samples that are still needed. Starts with "m_taps - 1" samples
+    //  of history.
+    std::vector<float> m_input;
+
+    //  Position of the next output sample in the upsampled domain, relative
+    //  to "m_input[0]".
+    size_t m_position;
+};
+
+
+
+}
+#endif
@@ -131,15 +131,36 @@ void AudioDisplayWidget::render_spectrograph(){
     const int widgetWidth = this->width();
     const int widgetHeight = this->height();
 
-    AudioSpectrumHolder::SpectrographSnapshot snapshot = m_session.spectrums().get_spectrograph();
+    AudioSpectrumHolder::SpectrographSnapshot& snapshot = m_spectrograph;
+    m_session.spectrums().update_spectrograph(snapshot);
+    if (!snapshot.image){
+        painter.fillRect(rect(), Qt::black);
+        return;
+    }
+
+    //  The image is a ring. Draw it in two pieces so that the oldest column
+    //  ends up on the left. Scaling is done by the painter on the fly.
     {
         QImage graph_image = snapshot.image.to_QImage_ref();
-        graph_image = graph_image.scaled(
-            widgetWidth, widgetHeight,
-            Qt::IgnoreAspectRatio,
-            Qt::SmoothTransformation
+        const double frames = (double)graph_image.width();
+        const double buckets = (double)graph_image.height();
+        const double oldest = (double)snapshot.oldest_column;
+        const double split = (frames - oldest) * widgetWidth / frames;
+
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.drawImage(
+            QRectF(0, 0, split, widgetHeight),
+            graph_image,
+            QRectF(oldest, 0, frames - oldest, buckets)
         );
-        painter.fillRect(rect(), graph_image);
+        if (oldest > 0){
+            painter.drawImage(
+                QRectF(split, 0, widgetWidth - split, widgetHeight),
+                graph_image,
+                QRectF(0, 0, oldest, buckets)
+            );
+        }
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
     }
 
     // Now render overlays:
@@ -55,6 +55,9 @@ private:
     int m_previous_height = 0;
     ValueDebouncer<int> m_debouncer;
 
+    //  Persistent copy of the spectrograph. Only new columns are copied in.
+    AudioSpectrumHolder::SpectrographSnapshot m_spectrograph;
+
     LifetimeSanitizer m_sanitizer;
 };
 
@@ -19,6 +19,7 @@
 #include "CommonFramework/Environment/Environment.h"
 #include "CommonFramework/Options/Environment/ThemeSelectorOption.h"
 #include "CommonFramework/Recording/StreamHistorySession.h"
+#include "CommonFramework/Tools/ImageDumpWriter.h"
 #include "ProgramDumper.h"
 #include "ErrorReports.h"
 
@@ -231,6 +232,10 @@ SendableErrorReport::SendableErrorReport(std::string directory)
 void SendableErrorReport::add_file(std::string filename){
     m_files.emplace_back(std::move(filename));
 }
+void SendableErrorReport::set_image(ImageRGB32 image){
+    m_image_owner = std::move(image);
+    m_image = m_image_owner;
+}
 
 void SendableErrorReport::save_report_json(Logger* logger) const{
     if (logger){
@@ -262,7 +267,7 @@ void SendableErrorReport::save_report_json(Logger* logger) const{
         std::string extension = m_image.width() > 1920
             ? ".jpg"
             : ".png";
-        if (m_image.save(m_directory + "Screenshot" + extension)){
+        if (save_image_fast(m_image, m_directory + "Screenshot" + extension)){
             report["Screenshot"] = "Screenshot" + extension;
         }
     }
@@ -393,6 +398,11 @@ std::unique_ptr<AsyncTask> send_all_unsent_reports(Logger& logger, bool allow_pr
 #endif
 }
 
+void save_and_send_report(Logger& logger, const SendableErrorReport& report){
+    report.save_report_json(&logger);
+    send_all_unsent_reports(logger, false);
+}
+
 void report_error(
     Logger* logger,
     const ProgramInfo& info,
@@ -109,6 +109,9 @@ public:
     // Add an additional file to be included in this error report
     void add_file(std::string filename);
 
+    // Replace the screenshot with one owned by this report.
+    void set_image(ImageRGB32 image);
+
     // Save an error report JSON "Report.json" in `directory()`:
     // Also save the image to the error report directory.
     void save_report_json(Logger* logger) const;
@@ -155,6 +158,11 @@ void send_reports(Logger& logger, const std::vector<std::string>& reports);
 // Returns: AsyncTask handle for background sending operation, or nullptr if not sending
 std::unique_ptr<AsyncTask> send_all_unsent_reports(Logger& logger, bool allow_prompt);
 
+// Save "report" by calling `save_report_json()`. Then call
+// `send_all_unsent_reports()` without prompting. These are the last steps of
+// `report_error()` for callers that build the report themselves.
+void save_and_send_report(Logger& logger, const SendableErrorReport& report);
+
 
 // Create and save a complete error report. This is the main entry point for error reporting.
 // Workflow:
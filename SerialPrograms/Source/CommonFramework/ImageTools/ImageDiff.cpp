@@ -111,5 +111,63 @@ double pixel_RMSD_masked(const ImageViewRGB32& reference, const ImageViewRGB32&
 
 
 
+double pixel_RMSD_scaled(const ImageViewRGB32& reference, const ImageViewRGB32& image, const FloatPixel& scale){
+    if (!image){
+        return 765; //  Max possible deviation.
+    }
+    if (reference.width() != image.width() || reference.height() != image.height()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching Dimensions");
+    }
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    Kernels::sum_sqr_deviation_scaled(
+        count, sumsqrs,
+        reference.width(), reference.height(),
+        reference.data(), reference.bytes_per_row(),
+        image.data(), image.bytes_per_row(),
+        (float)scale.r, (float)scale.g, (float)scale.b
+    );
+    return std::sqrt((double)sumsqrs / (double)count);
+}
+double pixel_RMSD_scaled(const ImageViewRGB32& reference, const ImageViewRGB32& image, Color background, const FloatPixel& scale){
+    if (!image){
+        return 765; //  Max possible deviation.
+    }
+    if (reference.width() != image.width() || reference.height() != image.height()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching Dimensions");
+    }
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    Kernels::sum_sqr_deviation_scaled(
+        count, sumsqrs,
+        reference.width(), reference.height(),
+        reference.data(), reference.bytes_per_row(),
+        image.data(), image.bytes_per_row(),
+        (uint32_t)background,
+        (float)scale.r, (float)scale.g, (float)scale.b
+    );
+    return std::sqrt((double)sumsqrs / (double)count);
+}
+double pixel_RMSD_masked_scaled(const ImageViewRGB32& reference, const ImageViewRGB32& image, const FloatPixel& scale){
+    if (!image){
+        return 765; //  Max possible deviation.
+    }
+    if (reference.width() != image.width() || reference.height() != image.height()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching Dimensions");
+    }
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    Kernels::sum_sqr_deviation_masked_scaled(
+        count, sumsqrs,
+        reference.width(), reference.height(),
+        reference.data(), reference.bytes_per_row(),
+        image.data(), image.bytes_per_row(),
+        (float)scale.r, (float)scale.g, (float)scale.b
+    );
+    return std::sqrt((double)sumsqrs / (double)count);
+}
+
+
+
 }
 }
@@ -58,6 +58,14 @@ double pixel_RMSD(const ImageViewRGB32& reference, const ImageViewRGB32& image,
 double pixel_RMSD_masked(const ImageViewRGB32& reference, const ImageViewRGB32& image);
 
 
+//  Same as the three above, but "reference" is brightness scaled by "scale"
+//  first. This gives the same result as calling "scale_brightness()" on a copy
+//  of "reference", but in one pass and without the copy.
+double pixel_RMSD_scaled(const ImageViewRGB32& reference, const ImageViewRGB32& image, const FloatPixel& scale);
+double pixel_RMSD_scaled(const ImageViewRGB32& reference, const ImageViewRGB32& image, Color background, const FloatPixel& scale);
+double pixel_RMSD_masked_scaled(const ImageViewRGB32& reference, const ImageViewRGB32& image, const FloatPixel& scale);
+
+
 
 }
 }
@@ -23,6 +23,7 @@
 //#include "Windows/DpiScaler.h"
 #include "Startup/SetupSettings.h"
 #include "Startup/NewVersionCheck.h"
+#include "Tools/ImageDumpWriter.h"
 #include "CommonFramework/VideoPipeline/Backends/CameraImplementations.h"
 #include "CommonTools/OCR/OCR_RawOCR.h"
 #include "Windows/MainWindow.h"
@@ -142,6 +143,10 @@ int main(int argc, char *argv[]){
         ret = application.exec();
     }
 
+    //  Finish writing the queued image dumps while the loggers and settings
+    //  are still alive.
+    global_image_dump_writer().stop();
+
     // Write program settings back to the json file.
     PERSISTENT_SETTINGS().write();
 
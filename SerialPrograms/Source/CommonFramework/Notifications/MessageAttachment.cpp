@@ -6,9 +6,13 @@
 
 #include <QDir>
 #include <QFile>
+#include <QBuffer>
+#include <QImage>
 #include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/GlobalServices.h"
 #include "MessageAttachment.h"
 
 namespace PokemonAutomation{
@@ -28,6 +32,7 @@ ImageAttachment::ImageAttachment(
 
 
 PendingFileSend::~PendingFileSend(){
+    m_encode_task.reset();
     if (m_filepath.empty()){
         return;
     }
@@ -46,6 +51,8 @@ PendingFileSend::PendingFileSend(const std::string& file, bool keep_file)
     : m_keep_file(keep_file)
     , m_extend_lifetime(false)
     , m_filepath(file)
+    , m_data_loaded(false)
+    , m_data_ok(false)
 {
     QFileInfo info(QString::fromStdString(file));
     m_filename = info.fileName().toStdString();
@@ -53,6 +60,8 @@ PendingFileSend::PendingFileSend(const std::string& file, bool keep_file)
 PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
     : m_keep_file(image.keep_file)
     , m_extend_lifetime(false)
+    , m_data_loaded(false)
+    , m_data_ok(false)
 {
     if (image.mode == ImageAttachmentMode::NO_SCREENSHOT){
         return;
@@ -67,6 +76,7 @@ PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
     case ImageAttachmentMode::NO_SCREENSHOT:
         break;
     case ImageAttachmentMode::JPG:
+    case ImageAttachmentMode::JPG_HALF:
         format = ".jpg";
         break;
     case ImageAttachmentMode::PNG:
@@ -76,22 +86,73 @@ PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
 
     m_filename = now_to_filestring() + format;
 
+    //  Temporary attachments stay in memory. Only kept files go to disk.
     if (image.keep_file){
         m_filepath = SCREENSHOTS_PATH() + m_filename;
-    }else{
-        m_filepath = GlobalSettings::instance().TEMP_FOLDER;
-        QDir().mkdir(QString::fromStdString(m_filepath));
-        m_filepath += m_filename;
     }
 
-    if (image.image.save(m_filepath)){
+    //  The caller's image may not outlive this call. So copy it here and do
+    //  the (much slower) encode on a worker.
+    m_encode_task = global_async_dispatcher().dispatch(
+        [this, mode = image.mode, copy = std::make_shared<const ImageRGB32>(image.image.copy())]() mutable{
+            encode_image(*copy, mode);
+            copy.reset();
+        }
+    );
+}
+void PendingFileSend::encode_image(const ImageViewRGB32& image, ImageAttachmentMode mode){
+    Logger& logger = global_logger_tagged();
+
+    ImageRGB32 scaled;
+    QImage qimage = image.to_QImage_ref();
+    if (mode == ImageAttachmentMode::JPG_HALF){
+        scaled = image.scale_to(image.width() / 2, image.height() / 2);
+        qimage = scaled.to_QImage_ref();
+    }
+
+    QByteArray bytes;
+    {
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::WriteOnly);
+        if (!qimage.save(&buffer, mode == ImageAttachmentMode::PNG ? "PNG" : "JPG")){
+            logger.log("Unable to encode screenshot: " + m_filename, COLOR_RED);
+            m_data_loaded = true;
+            return;
+        }
+    }
+    m_data.assign(bytes.constData(), bytes.size());
+    m_data_ok = true;
+    m_data_loaded = true;
+
+    if (m_filepath.empty()){
+        return;
+    }
+
+    QFile file(QString::fromStdString(m_filepath));
+    if (file.open(QIODevice::WriteOnly) && file.write(bytes) == bytes.size()){
         logger.log("Saved image to: " + m_filepath, COLOR_BLUE);
     }else{
         logger.log("Unable to save screenshot to: " + m_filepath, COLOR_RED);
-        m_filename.clear();
-        m_filepath.clear();
     }
 }
+const std::string* PendingFileSend::data(){
+    if (m_encode_task){
+        m_encode_task->wait_and_rethrow_exceptions();
+        return m_data_ok ? &m_data : nullptr;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (!m_data_loaded){
+        m_data_loaded = true;
+        QFile file(QString::fromStdString(m_filepath));
+        if (!m_filepath.empty() && file.open(QIODevice::ReadOnly)){
+            QByteArray bytes = file.readAll();
+            m_data.assign(bytes.constData(), bytes.size());
+            m_data_ok = true;
+        }
+    }
+    return m_data_ok ? &m_data : nullptr;
+}
 void PendingFileSend::extend_lifetime(){
     m_extend_lifetime.store(true, std::memory_order_release);
 }
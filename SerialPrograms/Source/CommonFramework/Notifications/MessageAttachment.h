@@ -9,12 +9,15 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/Options/ScreenshotFormatOption.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 
 namespace PokemonAutomation{
 
+class AsyncTask;
+
 
 struct ImageAttachment{
     ImageViewRGB32 image;
@@ -33,6 +36,10 @@ struct ImageAttachment{
 
 //  Represents a file that's in the process of being sent.
 //  If (keep_file = false), the file is automatically deleted after being sent.
+//
+//  Image attachments are encoded once on a worker thread into memory and
+//  shared by everything that sends them. They are only written to disk if
+//  (keep_file = true).
 class PendingFileSend{
 public:
     ~PendingFileSend();
@@ -41,19 +48,39 @@ public:
 //    PendingFileSend(Logger& logger, const std::string& text_attachment);
     PendingFileSend(Logger& logger, const ImageAttachment& image);
 
+    //  Empty if there is nothing to send.
     const std::string& filename() const{ return m_filename; }
+
+    //  Empty if the file only exists in memory.
     const std::string& filepath() const{ return m_filepath; }
     bool keep_file() const{ return m_keep_file; }
 
+    //  The contents of the file. Waits for the image to finish encoding.
+    //  Files on disk are read on the first call.
+    //  Returns null if the contents are unavailable. Thread-safe.
+    const std::string* data();
+
     //  Work around bug in Sleepy that destroys file before it's not needed anymore.
     void extend_lifetime();
 
+private:
+    void encode_image(const ImageViewRGB32& image, ImageAttachmentMode mode);
+
 private:
     bool m_keep_file;
     std::atomic<bool> m_extend_lifetime;
 //    QFile m_file;
     std::string m_filename;
     std::string m_filepath;
+
+    std::mutex m_lock;
+    bool m_data_loaded;
+    bool m_data_ok;
+    std::string m_data;
+
+    //  Declared last so it's the first to be destroyed. It must finish before
+    //  anything it writes to goes away.
+    std::unique_ptr<AsyncTask> m_encode_task;
 };
 
 
@@ -88,11 +88,14 @@ void send_raw_notification(
     const std::vector<std::pair<std::string, std::string>>& messages,
     const ImageAttachment& image
 ){
+    //  The image is still being encoded here, so the encode can still fail.
+    //  The senders check the attachment before sending and drop the embed's
+    //  reference to it if there is nothing to attach.
     bool hasImageFile = false;
     std::shared_ptr<PendingFileSend> file;
     if (image.image.width() > 0 && image.image.height() > 0){ // if image not empty
         file = std::make_shared<PendingFileSend>(logger, image);
-        hasImageFile = !file->filepath().empty();
+        hasImageFile = !file->filename().empty();
     };
 
     JsonObject embed;
@@ -0,0 +1,49 @@
+/* Performance Options
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <QDir>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/Globals.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonTools/InferencePivots/InferenceProfiler.h"
+#include "PerformanceOptions.h"
+
+namespace PokemonAutomation{
+
+
+
+void PerformanceOptions::on_press(){
+    Logger& logger = global_logger_tagged();
+    InferenceProfiler& profiler = InferenceProfiler::instance();
+
+    std::vector<InferenceProfileStats> stats = profiler.stats();
+    if (stats.empty()){
+        logger.log("Inference Profile: Nothing recorded. Is the profiler enabled?", COLOR_ORANGE);
+        return;
+    }
+    for (const InferenceProfileStats& item : stats){
+        std::string str = "Inference Profile: " + item.label;
+        str += "\n    Wall Time:    " + item.wall_time.to_str();
+        str += "\n    CPU Time:     " + item.cpu_time.to_str();
+        str += "\n    Frame Age:    " + item.snapshot_age.to_str();
+        str += "\n    Queue Delay:  " + item.queue_delay.to_str();
+        logger.log(str);
+    }
+
+    QDir().mkpath(DEBUG_PATH().c_str());
+    std::string path = DEBUG_PATH() + "InferenceProfile-" + now_to_filestring() + ".json";
+    try{
+        size_t runs = profiler.export_chrome_trace(path);
+        logger.log("Inference Profile: Saved " + std::to_string(runs) + " runs to: " + path, COLOR_BLUE);
+    }catch (Exception& e){
+        logger.log("Inference Profile: Unable to save trace: " + e.message(), COLOR_RED);
+    }
+}
+
+
+
+}
@@ -8,6 +8,10 @@
 #define PokemonAutomation_PerformanceOptions_H
 
 #include "Common/Cpp/Options/GroupOption.h"
+#include "Common/Cpp/Options/BooleanCheckBoxOption.h"
+#include "Common/Cpp/Options/ButtonOption.h"
+#include "Common/Cpp/Options/FloatingPointOption.h"
+#include "Common/Cpp/Options/SimpleIntegerOption.h"
 #include "Common/Cpp/Options/TimeDurationOption.h"
 #include "CommonFramework/Options/ThreadPoolOption.h"
 #include "ProcessPriorityOption.h"
@@ -16,8 +20,11 @@
 namespace PokemonAutomation{
 
 
-class PerformanceOptions : public GroupOption{
+class PerformanceOptions : public GroupOption, private ButtonListener{
 public:
+    ~PerformanceOptions(){
+        EXPORT_INFERENCE_PROFILE.remove_listener(static_cast<ButtonListener&>(*this));
+    }
     PerformanceOptions()
         : GroupOption(
             "Performance",
@@ -56,6 +63,41 @@ public:
             DEFAULT_PRIORITY_NORMAL_INFERENCE,
             1.0
         )
+        , INFERENCE_PIVOT_THREADS(
+            "<b>Inference Pivot Threads:</b><br>"
+            "Maximum # of threads that run the video and audio inference of all "
+            "consoles. Each console has one video and one audio pivot. No more "
+            "threads than pivots are ever started. "
+            "Set to zero to use the # of CPU cores.<br>"
+            "Takes effect the next time a program starts.",
+            LockMode::UNLOCK_WHILE_RUNNING,
+            0
+        )
+        , INFERENCE_CPU_BUDGET(
+            "<b>Inference CPU Budget:</b><br>"
+            "Fraction of the time that any one console's inference may keep its "
+            "thread busy, and fraction of the CPU cores that the inference of all "
+            "consoles may use together. When a console exceeds its share, its "
+            "non-critical detectors are run less often so that its time-critical "
+            "detectors stay on schedule. Other consoles are not slowed down. "
+            "Set to zero to disable throttling.",
+            LockMode::UNLOCK_WHILE_RUNNING,
+            0.75, 0, 1
+        )
+        , INFERENCE_PROFILER(
+            "<b>Inference Profiler:</b><br>"
+            "Record the wall time, CPU time, frame age and scheduling delay of "
+            "every inference callback. This has a small overhead. "
+            "Use the button below to save the most recent runs as a Chrome trace.",
+            LockMode::UNLOCK_WHILE_RUNNING,
+            false
+        )
+        , EXPORT_INFERENCE_PROFILE(
+            "<b>Export Inference Profile:</b><br>"
+            "Log per-callback statistics and save the recent runs to the debug folder. "
+            "Open the file with chrome://tracing or https://ui.perfetto.dev.",
+            "Export"
+        )
         , PRECISE_WAKE_MARGIN(
             "<b>Precise Wake Time Margin:</b><br>"
             "Some operations require a thread to wake up at a very precise time - "
@@ -76,10 +118,19 @@ public:
 
         PA_ADD_OPTION(REALTIME_THREAD_POOL);
         PA_ADD_OPTION(NORMAL_THREAD_POOL);
+        PA_ADD_OPTION(INFERENCE_PIVOT_THREADS);
+        PA_ADD_OPTION(INFERENCE_CPU_BUDGET);
+        PA_ADD_OPTION(INFERENCE_PROFILER);
+        PA_ADD_OPTION(EXPORT_INFERENCE_PROFILE);
 
         PA_ADD_OPTION(PRECISE_WAKE_MARGIN);
+
+        EXPORT_INFERENCE_PROFILE.add_listener(static_cast<ButtonListener&>(*this));
     }
 
+private:
+    virtual void on_press() override;
+
 public:
     ProcessorLevelOption PROCESSOR_LEVEL;
 
@@ -89,6 +140,10 @@ public:
 
     ThreadPoolOption REALTIME_THREAD_POOL;
     ThreadPoolOption NORMAL_THREAD_POOL;
+    SimpleIntegerOption<size_t> INFERENCE_PIVOT_THREADS;
+    FloatingPointOption INFERENCE_CPU_BUDGET;
+    BooleanCheckBoxOption INFERENCE_PROFILER;
+    ButtonOption EXPORT_INFERENCE_PROFILE;
 
     MicrosecondsOption PRECISE_WAKE_MARGIN;
 };
@@ -16,12 +16,14 @@ enum class ImageAttachmentMode{
     NO_SCREENSHOT,
     JPG,
     PNG,
+    JPG_HALF,
 };
 inline const EnumDropdownDatabase<ImageAttachmentMode>& ImageAttachmentMode_Database(){
     static EnumDropdownDatabase<ImageAttachmentMode> database({
         {ImageAttachmentMode::NO_SCREENSHOT,    "none", "No Screenshot."},
         {ImageAttachmentMode::JPG,              "jpg",  "Attach as .jpg."},
         {ImageAttachmentMode::PNG,              "png",  "Attach as .png."},
+        {ImageAttachmentMode::JPG_HALF,         "jpg-half", "Attach as .jpg at half resolution."},
     });
     return database;
 }
@@ -10,6 +10,7 @@
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/Logging/Logger.h"
+#include "ImageDumpWriter.h"
 
 namespace PokemonAutomation{
 
@@ -29,7 +30,9 @@ std::string dump_debug_image(
     create_debug_folder(path);
     std::string full_path = DEBUG_PATH() + path + "/" + now_to_filestring() + "-" + label + ".png";
     logger.log("Saving debug image to: " + full_path, COLOR_YELLOW);
-    image.save(full_path);
+    if (!global_image_dump_writer().save(logger, full_path, image)){
+        return "";
+    }
     return full_path;
 }
 
@@ -15,7 +15,9 @@ class ImageViewRGB32;
 class Logger;
 
 // Dump debug image to ./DebugDumps/`path`/<timestamp>-`label`.png
-// Return image path.
+// Return image path, or an empty string if the image was dropped.
+// The image is written in the background by "global_image_dump_writer()". It
+// is dropped if the writer is backed up.
 std::string dump_debug_image(
     Logger& logger,
     const std::string& path,
@@ -15,6 +15,8 @@
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/ErrorReports/ErrorReports.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "ImageDumpWriter.h"
 //#include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "ErrorDumper.h"
 //#include "ProgramEnvironment.h"
@@ -45,14 +47,41 @@ void dump_image(
     const ImageViewRGB32& image,
     const StreamHistorySession* stream_history
 ){
-    report_error(
+    //  The logs, video and dump need to be captured now. They must reflect
+    //  the moment of the error.
+    std::shared_ptr<SendableErrorReport> report = std::make_shared<SendableErrorReport>(
         &logger,
         program_info,
         label,
-        {},
-        image,
+        std::vector<std::pair<std::string, std::string>>(),
+        ImageViewRGB32(),
         stream_history
     );
+
+    //  If the writer is backed up, save the report right away without the
+    //  screenshot. The drop is logged by the writer.
+    ImageDumpWriter& writer = global_image_dump_writer();
+    std::string name = "ErrorReport-" + label;
+    size_t bytes = image.width() * image.height() * sizeof(uint32_t);
+    if (!writer.reserve(logger, name, bytes)){
+        save_and_send_report(logger, *report);
+        return;
+    }
+
+    //  The screenshot and the report file are written in the background.
+    try{
+        report->set_image(image.copy());
+    }catch (...){
+        writer.unreserve(bytes);
+        throw;
+    }
+    writer.enqueue(
+        std::move(name),
+        bytes,
+        [report = std::move(report)]{
+            save_and_send_report(global_logger_tagged(), *report);
+        }
+    );
 }
 void dump_image(
     Logger& logger,
@@ -30,8 +30,12 @@ std::string dump_image_alone(
 );
 #endif
 
-// Call CommonFramework/ErrorReports/ErrorReports.h:report_error() to create an error
-// report with image. Check the comments of report_error() for more details.
+// Create an error report with image the same way as
+// CommonFramework/ErrorReports/ErrorReports.h:report_error(). Check the comments
+// of report_error() for more details.
+// The screenshot and report file are written in the background by
+// "global_image_dump_writer()". If the writer is backed up, the report is
+// saved right away without the screenshot.
 void dump_image(
     Logger& logger,
     const ProgramInfo& program_info, const std::string& label,
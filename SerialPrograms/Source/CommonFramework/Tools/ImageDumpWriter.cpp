@@ -0,0 +1,179 @@
+/*  Image Dump Writer
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <memory>
+#include <QImage>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PanicDump.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "ImageDumpWriter.h"
+
+namespace PokemonAutomation{
+
+
+
+bool save_image_fast(const ImageViewRGB32& image, const std::string& path){
+    //  For PNG, Qt turns the quality into the zlib level as:
+    //      (100 - quality) * 9 / 91
+    //  80 gives level 1. The files are a bit bigger than the default level
+    //  but encode several times faster.
+    int quality = -1;
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".png") == 0){
+        quality = 80;
+    }
+    return image.to_QImage_ref().save(QString::fromStdString(path), nullptr, quality);
+}
+
+
+
+ImageDumpWriter::ImageDumpWriter(size_t max_pending_dumps, size_t max_pending_bytes)
+    : m_max_pending_dumps(max_pending_dumps)
+    , m_max_pending_bytes(max_pending_bytes)
+    , m_reserved(0)
+    , m_pending_bytes(0)
+    , m_busy(false)
+    , m_stopping(false)
+    , m_dropped(0)
+    , m_thread(run_with_catch, "ImageDumpWriter::thread_loop()", [this]{ thread_loop(); })
+{}
+ImageDumpWriter::~ImageDumpWriter(){
+    stop();
+}
+void ImageDumpWriter::stop(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    if (m_thread.joinable()){
+        m_thread.join();
+    }
+}
+
+
+bool ImageDumpWriter::reserve(Logger& logger, const std::string& name, size_t bytes){
+    const char* reason = nullptr;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        size_t pending = m_queue.size() + m_reserved + (m_busy ? 1 : 0);
+        if (m_stopping){
+            reason = "shutting down";
+        }else if (pending >= m_max_pending_dumps){
+            reason = "too many pending dumps";
+        }else if (pending != 0 && m_pending_bytes + bytes > m_max_pending_bytes){
+            //  A single oversized dump is still let through when nothing else
+            //  is pending.
+            reason = "too much pending data";
+        }
+
+        if (reason == nullptr){
+            m_reserved++;
+            m_pending_bytes += bytes;
+            return true;
+        }
+        m_dropped++;
+    }
+    logger.log("Dropped image dump (" + std::string(reason) + "): " + name, COLOR_ORANGE);
+    return false;
+}
+void ImageDumpWriter::unreserve(size_t bytes){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_reserved--;
+    m_pending_bytes -= bytes;
+    m_cv.notify_all();
+}
+void ImageDumpWriter::enqueue(std::string name, size_t bytes, std::function<void()>&& write){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_reserved--;
+    m_queue.emplace_back(Job{std::move(name), bytes, std::move(write)});
+    m_cv.notify_all();
+}
+
+
+bool ImageDumpWriter::save(
+    Logger& logger,
+    std::string path,
+    const ImageViewRGB32& image
+){
+    //  Check for room first. The copy is the expensive part.
+    size_t bytes = image.height() * image.width() * sizeof(uint32_t);
+    if (!reserve(logger, path, bytes)){
+        return false;
+    }
+    std::shared_ptr<const ImageRGB32> copy;
+    try{
+        copy = std::make_shared<const ImageRGB32>(image.copy());
+    }catch (...){
+        unreserve(bytes);
+        throw;
+    }
+    std::string name = path;
+    enqueue(
+        std::move(name),
+        bytes,
+        [path = std::move(path), image = std::move(copy)]{
+            if (!save_image_fast(*image, path)){
+                global_logger_tagged().log("Unable to save image dump: " + path, COLOR_RED);
+            }
+        }
+    );
+    return true;
+}
+void ImageDumpWriter::wait_for_all(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_cv.wait(lg, [this]{ return m_queue.empty() && m_reserved == 0 && !m_busy; });
+}
+uint64_t ImageDumpWriter::dropped() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_dropped;
+}
+
+
+void ImageDumpWriter::thread_loop(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (true){
+        if (m_queue.empty()){
+            //  Don't leave while a caller is still copying an image in.
+            if (m_stopping && m_reserved == 0){
+                return;
+            }
+            m_cv.wait(lg);
+            continue;
+        }
+
+        Job job = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_busy = true;
+
+        lg.unlock();
+        try{
+            job.write();
+        }catch (Exception& e){
+            global_logger_tagged().log("Image dump failed: " + job.name + ", Message: " + e.to_str(), COLOR_RED);
+        }catch (std::exception& e){
+            global_logger_tagged().log("Image dump failed: " + job.name + ", Message: " + e.what(), COLOR_RED);
+        }
+        job.write = nullptr;
+        lg.lock();
+
+        m_pending_bytes -= job.bytes;
+        m_busy = false;
+        m_cv.notify_all();
+    }
+}
+
+
+
+ImageDumpWriter& global_image_dump_writer(){
+    //  A burst of 1080p dumps is ~8MB each before compression.
+    static ImageDumpWriter writer(32, (size_t)256 << 20);
+    return writer;
+}
+
+
+
+}
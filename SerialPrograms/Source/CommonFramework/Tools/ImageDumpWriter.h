@@ -0,0 +1,107 @@
+/*  Image Dump Writer
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Write debug and error images on a background thread.
+ *
+ *  Image dumps happen in the middle of inference and error recovery. Encoding
+ *  and writing a full-resolution PNG inline stalls whatever thread made the
+ *  dump. So the image is copied and the write is queued instead.
+ *
+ *  The queue is bounded. When the disk can't keep up, new dumps are dropped
+ *  rather than blocking the caller.
+ *
+ */
+
+#ifndef PokemonAutomation_ImageDumpWriter_H
+#define PokemonAutomation_ImageDumpWriter_H
+
+#include <string>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace PokemonAutomation{
+
+class Logger;
+class ImageViewRGB32;
+
+
+//  Save "image" to "path" using settings that favor encode speed over file
+//  size. The format is picked from the extension.
+bool save_image_fast(const ImageViewRGB32& image, const std::string& path);
+
+
+class ImageDumpWriter{
+public:
+    ImageDumpWriter(size_t max_pending_dumps, size_t max_pending_bytes);
+
+    ~ImageDumpWriter();
+
+    //  Write everything still queued and stop the writer thread. New dumps are
+    //  dropped after this. Call this at shutdown while the loggers are still
+    //  alive.
+    void stop();
+
+    //  Copy "image" and queue it to be saved to "path". The image is only
+    //  copied if there is room for it. Returns false if the dump was dropped.
+    bool save(
+        Logger& logger,
+        std::string path,
+        const ImageViewRGB32& image
+    );
+
+    //  Queue a dump in two steps so that callers only do the expensive work of
+    //  capturing it if it won't be dropped.
+    //  "reserve()" makes room for a dump holding "bytes" of memory until it is
+    //  written. It returns false and logs the drop if there is no room.
+    //  "logger" is only used for that since it may not outlive the write.
+    //  Each successful reservation must be followed by either "enqueue()" to
+    //  queue "write" on the writer thread, or "unreserve()" to give it back.
+    //  "name" is only used for logging.
+    bool reserve(Logger& logger, const std::string& name, size_t bytes);
+    void unreserve(size_t bytes);
+    void enqueue(std::string name, size_t bytes, std::function<void()>&& write);
+
+    //  Wait until everything queued so far has been written.
+    void wait_for_all();
+
+    //  # of dumps dropped so far.
+    uint64_t dropped() const;
+
+
+private:
+    struct Job{
+        std::string name;
+        size_t bytes;
+        std::function<void()> write;
+    };
+
+    void thread_loop();
+
+private:
+    const size_t m_max_pending_dumps;
+    const size_t m_max_pending_bytes;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::deque<Job> m_queue;
+    size_t m_reserved;
+    size_t m_pending_bytes;
+    bool m_busy;
+    bool m_stopping;
+    uint64_t m_dropped;
+
+    std::thread m_thread;
+};
+
+
+//  main() stops this at shutdown.
+ImageDumpWriter& global_image_dump_writer();
+
+
+
+}
+#endif
@@ -4,8 +4,10 @@
  *
  */
 
+#include <thread>
 #include "Common/Cpp/Containers/Pimpl.tpp"
 #include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "Common/Cpp/Concurrency/PeriodicExecutor.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/ProgramSession.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
@@ -17,11 +19,23 @@
 namespace PokemonAutomation{
 
 
+//  Each console has a video and an audio pivot. The executor never spawns
+//  more threads than there are pivots, so a single console uses at most 2.
+//  With more consoles, the pivots share this many threads.
+size_t inference_executor_threads(){
+    size_t threads = GlobalSettings::instance().PERFORMANCE->INFERENCE_PIVOT_THREADS;
+    if (threads == 0){
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+    }
+    return threads;
+}
+
+
 struct ProgramEnvironmentData{
     const ProgramInfo& m_program_info;
 
     AsyncDispatcher m_realtime_dispatcher;
-    AsyncDispatcher m_realtime_inference_dispatcher;
+    PeriodicExecutor m_realtime_inference_executor;
 
     ProgramEnvironmentData(
         const ProgramInfo& program_info
@@ -33,11 +47,11 @@ struct ProgramEnvironmentData{
             },
             0
         )
-        , m_realtime_inference_dispatcher(
+        , m_realtime_inference_executor(
             [](){
                 GlobalSettings::instance().PERFORMANCE->INFERENCE_PIVOT_PRIORITY.set_on_this_thread(global_logger_tagged());
             },
-            0
+            inference_executor_threads()
         )
     {}
 };
@@ -66,8 +80,8 @@ const ProgramInfo& ProgramEnvironment::program_info() const{
 AsyncDispatcher& ProgramEnvironment::realtime_dispatcher(){
     return m_data->m_realtime_dispatcher;
 }
-AsyncDispatcher& ProgramEnvironment::realtime_inference_dispatcher(){
-    return m_data->m_realtime_inference_dispatcher;
+PeriodicExecutor& ProgramEnvironment::realtime_inference_executor(){
+    return m_data->m_realtime_inference_executor;
 }
 
 
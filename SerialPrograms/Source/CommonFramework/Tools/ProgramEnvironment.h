@@ -13,6 +13,7 @@
 namespace PokemonAutomation{
 
 class AsyncDispatcher;
+class PeriodicExecutor;
 class StatsTracker;
 class ProgramSession;
 struct ProgramInfo;
@@ -46,9 +47,9 @@ public:
     //  tolerate being delayed.
     AsyncDispatcher& realtime_dispatcher();
 
-    //  A high-priority dispatcher for inference where starvation may cause the
-    //  program to encounter issues.
-    AsyncDispatcher& realtime_inference_dispatcher();
+    //  A high-priority executor for the inference pivots where starvation may
+    //  cause the program to encounter issues. Shared by all the consoles.
+    PeriodicExecutor& realtime_inference_executor();
 
 public:
     //  Stats Management
@@ -24,7 +24,7 @@
 namespace PokemonAutomation{
 
 class CancellableScope;
-class AsyncDispatcher;
+class PeriodicExecutor;
 class Logger;
 class AudioFeed;
 class VideoFeed;
@@ -73,7 +73,7 @@ public:
 
 
 public:
-    void initialize_inference_threads(CancellableScope& scope, AsyncDispatcher& dispatcher);
+    void initialize_inference_threads(CancellableScope& scope, PeriodicExecutor& executor);
 
 
 private:
@@ -19,6 +19,8 @@
 //#include "Common/Cpp/Exceptions.h"
 //#include "Common/Cpp/Time.h"
 //#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/VideoPipeline/VideoPipelineOptions.h"
 #include "VideoFrameQt.h"
 #include "MediaServicesQt6.h"
 #include "CameraWidgetQt6.5.h"
@@ -154,6 +156,16 @@ CameraVideoSource::CameraVideoSource(
     m_capture_session.reset(new QMediaCaptureSession());
     m_capture_session->setCamera(&m_camera->camera());
 
+    m_video_sink.reset(new QVideoSink());
+    m_capture_session->setVideoSink(m_video_sink.get());
+    connect(
+        m_video_sink.get(), &QVideoSink::videoFrameChanged,
+        &m_camera->camera(), [this](const QVideoFrame& frame){
+            //  This runs on the QCamera's thread. So it is off the critical path.
+            on_frame(frame);
+        }
+    );
+
 #if 0
     connect(m_camera.get(), &QCamera::errorOccurred, this, [&](){
         if (m_camera->error() == QCamera::NoError){
@@ -168,27 +180,27 @@ CameraVideoSource::CameraVideoSource(
 }
 
 
-void CameraVideoSource::set_video_output(QGraphicsVideoItem& item){
-    if (m_capture_session == nullptr){
+void CameraVideoSource::on_frame(const QVideoFrame& frame){
+    WallClock now = current_time();
+    if (!m_last_frame.push_frame(frame, now)){
         return;
     }
-    if (m_capture_session->videoSink() == item.videoSink()){
+    report_source_frame(std::make_shared<VideoFrame>(now, frame));
+
+    std::lock_guard<std::mutex> lg(m_display_lock);
+    if (m_display_sink == nullptr){
         return;
     }
-    m_capture_session->setVideoOutput(&item);
-
-    connect(
-        item.videoSink(), &QVideoSink::videoFrameChanged,
-        &m_camera->camera(), [&](const QVideoFrame& frame){
-            //  This runs on the QCamera's thread. So it is off the critical path.
-
-            WallClock now = current_time();
-            if (!m_last_frame.push_frame(frame, now)){
-                return;
-            }
-            report_source_frame(std::make_shared<VideoFrame>(now, frame));
-        }
-    );
+    uint8_t max_fps = GlobalSettings::instance().VIDEO_PIPELINE->MAX_DISPLAY_FPS;
+    if (!m_display_limiter.push_frame(now, max_fps)){
+        return;
+    }
+    m_display_sink->setVideoFrame(frame);
+}
+void CameraVideoSource::set_display_sink(QVideoSink* sink){
+    std::lock_guard<std::mutex> lg(m_display_lock);
+    m_display_sink = sink;
+    m_display_limiter.reset();
 }
 
 
@@ -207,6 +219,9 @@ QWidget* CameraVideoSource::make_display_QtWidget(QWidget* parent){
 
 
 
+CameraVideoDisplay::~CameraVideoDisplay(){
+    m_source.set_display_sink(nullptr);
+}
 CameraVideoDisplay::CameraVideoDisplay(QWidget* parent, CameraVideoSource& source)
     : QWidget(parent)
     , m_source(source)
@@ -219,7 +234,7 @@ CameraVideoDisplay::CameraVideoDisplay(QWidget* parent, CameraVideoSource& sourc
     m_video.setSize(this->size());
     m_scene.setSceneRect(QRectF(QPointF(0, 0), this->size()));
     m_scene.addItem(&m_video);
-    source.set_video_output(m_video);
+    source.set_display_sink(m_video.videoSink());
 
     connect(
         &m_scene, &QGraphicsScene::changed,
@@ -11,7 +11,7 @@
 #if QT_VERSION_MAJOR == 6
 
 //#include <set>
-//#include <mutex>
+#include <mutex>
 #include <QCameraDevice>
 #include <QMediaCaptureSession>
 #include <QVideoFrame>
@@ -25,6 +25,7 @@
 #include "CommonFramework/VideoPipeline/CameraInfo.h"
 #include "QCameraThread.h"
 #include "QVideoFrameCache.h"
+#include "DisplayFrameLimiter.h"
 #include "SnapshotManager.h"
 #include "CameraImplementations.h"
 
@@ -118,7 +119,10 @@ public:
     virtual QWidget* make_display_QtWidget(QWidget* parent) override;
 
 private:
-    void set_video_output(QGraphicsVideoItem& item);
+    void on_frame(const QVideoFrame& frame);
+
+    //  Set where frames are forwarded for display. Null to stop.
+    void set_display_sink(QVideoSink* sink);
 
 
 private:
@@ -133,6 +137,12 @@ private:
 
     std::vector<Resolution> m_resolutions;
 
+    //  Frames always go to "m_video_sink" so inference sees all of them even
+    //  with no display. Only some of them are forwarded to the display.
+    std::mutex m_display_lock;
+    QVideoSink* m_display_sink = nullptr;
+    DisplayFrameLimiter m_display_limiter;
+
 
 private:
     QVideoFrameCache m_last_frame;
@@ -142,6 +152,7 @@ private:
 
 class CameraVideoDisplay : public QWidget{
 public:
+    ~CameraVideoDisplay();
     CameraVideoDisplay(QWidget* parent, CameraVideoSource& source);
 
 private:
@@ -0,0 +1,48 @@
+/*  Display Frame Limiter
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Decides which frames of a stream are forwarded to the screen when the
+ *  display frame rate is capped.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_DisplayFrameLimiter_H
+#define PokemonAutomation_VideoPipeline_DisplayFrameLimiter_H
+
+#include <stdint.h>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+
+
+class DisplayFrameLimiter{
+public:
+    void reset(){
+        m_last_shown = WallClock::min();
+    }
+
+    //  Returns true if the frame at "timestamp" should be shown. A "max_fps"
+    //  of zero means no limit.
+    bool push_frame(WallClock timestamp, uint8_t max_fps){
+        if (max_fps != 0){
+            //  Allow a little slack so that a source running at exactly the
+            //  limit isn't cut in half by timer jitter.
+            auto period = std::chrono::microseconds(1000000 / max_fps) * 9 / 10;
+            if (timestamp < m_last_shown + period){
+                return false;
+            }
+        }
+        m_last_shown = timestamp;
+        return true;
+    }
+
+private:
+    WallClock m_last_shown = WallClock::min();
+};
+
+
+
+}
+#endif
@@ -0,0 +1,48 @@
+/*  Controller Jitter Stats
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/PrettyPrint.h"
+#include "Controllers/ControllerSession.h"
+#include "ControllerJitterStats.h"
+
+namespace PokemonAutomation{
+
+
+ControllerJitterStat::ControllerJitterStat(ControllerSession& session)
+    : m_session(session)
+{}
+
+OverlayStatSnapshot ControllerJitterStat::get_current(){
+    JitterHistogramSnapshot jitter = m_session.state_change_jitter();
+    if (jitter.empty()){
+        return OverlayStatSnapshot();
+    }
+
+    auto to_ms = [](WallDuration duration){
+        return tostr_fixed(std::chrono::duration<double, std::milli>(duration).count(), 2);
+    };
+
+    WallDuration p99 = jitter.percentile(0.99);
+
+    //  A state change that is a full tick (8ms) late can drop a frame.
+    Color color = COLOR_WHITE;
+    if (p99 >= Milliseconds(8)){
+        color = COLOR_RED;
+    }else if (p99 >= Milliseconds(4)){
+        color = COLOR_ORANGE;
+    }else if (p99 >= Milliseconds(1)){
+        color = COLOR_YELLOW;
+    }
+
+    return OverlayStatSnapshot{
+        "Controller Jitter: p99 < " + to_ms(p99) + " ms, max " + to_ms(jitter.max_error) + " ms",
+        color
+    };
+}
+
+
+
+}
@@ -0,0 +1,32 @@
+/*  Controller Jitter Stats
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_ControllerJitterStats_H
+#define PokemonAutomation_ControllerJitterStats_H
+
+#include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
+
+namespace PokemonAutomation{
+
+class ControllerSession;
+
+
+//  Shows how late the controller's state changes are compared to when they
+//  were scheduled. Hidden for controllers that don't time on the host.
+class ControllerJitterStat : public OverlayStat{
+public:
+    ControllerJitterStat(ControllerSession& session);
+
+    virtual OverlayStatSnapshot get_current() override;
+
+private:
+    ControllerSession& m_session;
+};
+
+
+
+}
+#endif
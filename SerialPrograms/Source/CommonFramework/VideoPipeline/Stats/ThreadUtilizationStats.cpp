@@ -4,8 +4,7 @@
  *
  */
 
-//#include "Common/Cpp/PrettyPrint.h"
-#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
+#include "Common/Cpp/PrettyPrint.h"
 #include "ThreadUtilizationStats.h"
 
 //#include <iostream>
@@ -45,6 +44,7 @@ ThreadPoolUtilizationStat::ThreadPoolUtilizationStat(const ComputationThreadPool
     : m_thread_pool(thread_pool)
     , m_label(std::move(label))
     , m_last_clock(thread_pool.cpu_time())
+    , m_last_stats(thread_pool.stats())
     , m_printer((double)thread_pool.max_threads())
 {}
 
@@ -62,10 +62,28 @@ OverlayStatSnapshot ThreadPoolUtilizationStat::get_current(){
     }
     m_last_clock = clock;
 
-    return m_printer.get_snapshot(
+    OverlayStatSnapshot snapshot = m_printer.get_snapshot(
         m_label + " (x" + std::to_string(m_thread_pool.current_threads()) + "):",
         m_tracker.utilization()
     );
+
+    //  Queue wait and steal ratio since the last snapshot.
+    ComputationThreadPoolStats stats = m_thread_pool.stats();
+    uint64_t dispatches = stats.dispatches - m_last_stats.dispatches;
+    uint64_t blocks = stats.blocks - m_last_stats.blocks;
+    if (!snapshot.text.empty() && dispatches != 0){
+        WallDuration wait = (stats.queue_wait - m_last_stats.queue_wait) / dispatches;
+        snapshot.text += ", wait: " + std::to_string(
+            std::chrono::duration_cast<std::chrono::microseconds>(wait).count()
+        ) + " us";
+    }
+    if (!snapshot.text.empty() && blocks != 0){
+        double stolen = (double)(stats.stolen_blocks - m_last_stats.stolen_blocks) / blocks;
+        snapshot.text += ", stolen: " + tostr_fixed(stolen * 100, 0) + " %";
+    }
+    m_last_stats = stats;
+
+    return snapshot;
 }
 
 
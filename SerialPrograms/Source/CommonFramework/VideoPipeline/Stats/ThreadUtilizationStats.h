@@ -11,14 +11,12 @@
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/EventRateTracker.h"
 #include "Common/Cpp/CpuUtilization/CpuUtilization.h"
+#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
 
 namespace PokemonAutomation{
 
 
-class ComputationThreadPool;
-
-
 
 class ThreadUtilizationStat : public OverlayStat{
 public:
@@ -51,6 +49,7 @@ private:
     std::mutex m_lock;
     WallDuration m_last_clock;
     UtilizationTracker m_tracker;
+    ComputationThreadPoolStats m_last_stats;
 
     OverlayStatUtilizationPrinter m_printer;
 };
@@ -9,6 +9,8 @@
 #include <QLineEdit>
 #include <QMouseEvent>
 #include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/VideoPipeline/VideoPipelineOptions.h"
 #include "VideoDisplayWidget.h"
 #include "VideoDisplayWindow.h"
 
@@ -42,7 +44,7 @@ VideoDisplayWidget::VideoDisplayWidget(
 
     VideoSource* source = video_session.current_source();
     if (source){
-        m_video = source->make_display_QtWidget(this);
+        m_video = make_video_widget(*source);
         this->add_widget(*m_video);
     }
 
@@ -126,6 +128,22 @@ VideoDisplayWidget::~VideoDisplayWidget(){
     delete m_underlay;
 }
 
+QWidget* VideoDisplayWidget::make_video_widget(VideoSource& source){
+    if (GlobalSettings::instance().VIDEO_PIPELINE->SHOW_VIDEO){
+        return source.make_display_QtWidget(this);
+    }
+
+    //  The source keeps running without a display so inference still sees
+    //  every frame. Only the overlay is drawn.
+    QLabel* placeholder = new QLabel("Video display is turned off.", this);
+    placeholder->setAlignment(Qt::AlignCenter);
+    placeholder->setAutoFillBackground(true);
+    QPalette palette = placeholder->palette();
+    palette.setColor(QPalette::Window, Qt::black);
+    palette.setColor(QPalette::WindowText, Qt::gray);
+    placeholder->setPalette(palette);
+    return placeholder;
+}
 void VideoDisplayWidget::clear_video_source(){
     if (m_video){
         this->remove_widget(m_video);
@@ -136,7 +154,7 @@ void VideoDisplayWidget::clear_video_source(){
 void VideoDisplayWidget::post_startup(VideoSource* source){
     clear_video_source();
     if (source){
-        m_video = source->make_display_QtWidget(this);
+        m_video = make_video_widget(*source);
         this->add_widget(*m_video);
         set_aspect_ratio(source->current_resolution().aspect_ratio());
         m_overlay->raise();
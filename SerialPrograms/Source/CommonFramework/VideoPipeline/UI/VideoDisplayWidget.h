@@ -119,6 +119,9 @@ protected:
     virtual void resizeEvent(QResizeEvent* event) override;
 
 private:
+    //  Returns a placeholder instead of the source's display if the video
+    //  display is turned off.
+    QWidget* make_video_widget(VideoSource& source);
     void clear_video_source();
 
 private:
@@ -5,7 +5,9 @@
  */
 
 #include <QPainter>
+#include <QPaintEvent>
 #include <QResizeEvent>
+#include <QFontMetrics>
 #include "CommonFramework/GlobalServices.h"
 #include "VideoOverlayWidget.h"
 
@@ -36,12 +38,22 @@ VideoOverlayWidget::VideoOverlayWidget(QWidget& parent, VideoOverlaySession& ses
     , m_images(std::make_shared<std::vector<OverlayImage>>(session.images()))
     , m_log(std::make_shared<std::vector<OverlayLogLine>>(session.log_texts()))
 //    , m_stats(nullptr)
+    , m_refresh_pending(false)
+    , m_stats_render(
+        "VideoOverlayWidget::refresh_layers",
+        "ms", 1000,
+        std::chrono::seconds(10), 2000
+    )
     , m_stats_paint(
         "VideoOverlayWidget::paintEvent",
         "ms", 1000,
         std::chrono::seconds(10), 2000
     )
 {
+    for (bool& dirty : m_dirty){
+        dirty = true;
+    }
+
     setAttribute(Qt::WA_NoSystemBackground);
     setAttribute(Qt::WA_TranslucentBackground);
     setAttribute(Qt::WA_TransparentForMouseEvents);
@@ -54,31 +66,61 @@ VideoOverlayWidget::VideoOverlayWidget(QWidget& parent, VideoOverlaySession& ses
         detach();
         throw;
     }
+    async_update();
 }
 
+void VideoOverlayWidget::mark_dirty(Layer layer){
+    {
+        WriteSpinLock lg(m_lock, "VideoOverlay::mark_dirty()");
+        m_dirty[layer] = true;
+    }
+    async_update();
+}
 void VideoOverlayWidget::async_update(){
+    //  Only one refresh needs to be queued at a time. It picks up everything
+    //  that changed before it runs.
+    if (m_refresh_pending.exchange(true, std::memory_order_acq_rel)){
+        return;
+    }
+
     // by using QMetaObject::invokeMethod, we can call this->update() on a non-main thread
     // without trigger Qt crash, as normally this->update() can only be called on the main
     // thread.
-    QMetaObject::invokeMethod(this, [this]{ this->update(); });
+    QMetaObject::invokeMethod(this, [this]{ refresh_layers(); });
 }
 
 void VideoOverlayWidget::on_overlay_update_boxes(const std::shared_ptr<const std::vector<OverlayBox>>& boxes){
-    WriteSpinLock lg(m_lock, "VideoOverlay::update_boxes()");
-    m_boxes = boxes;
+    {
+        WriteSpinLock lg(m_lock, "VideoOverlay::update_boxes()");
+        m_boxes = boxes;
+        m_dirty[LAYER_BOXES] = true;
+    }
+    async_update();
 }
 void VideoOverlayWidget::on_overlay_update_text(const std::shared_ptr<const std::vector<OverlayText>>& texts){
-    WriteSpinLock lg(m_lock, "VideoOverlay::update_text()");
-    m_texts = texts;
+    {
+        WriteSpinLock lg(m_lock, "VideoOverlay::update_text()");
+        m_texts = texts;
+        m_dirty[LAYER_TEXT] = true;
+    }
+    async_update();
 }
 void VideoOverlayWidget::on_overlay_update_images(const std::shared_ptr<const std::vector<OverlayImage>>& images){
-    WriteSpinLock lg(m_lock, "VideoOverlay::update_images()");
-    m_images = images;
+    {
+        WriteSpinLock lg(m_lock, "VideoOverlay::update_images()");
+        m_images = images;
+        m_dirty[LAYER_IMAGES] = true;
+    }
+    async_update();
 }
 
 void VideoOverlayWidget::on_overlay_update_log(const std::shared_ptr<const std::vector<OverlayLogLine>>& logs){
-    WriteSpinLock lg(m_lock, "VideoOverlay::update_log_text()");
-    m_log = logs;
+    {
+        WriteSpinLock lg(m_lock, "VideoOverlay::update_log_text()");
+        m_log = logs;
+        m_dirty[LAYER_LOG] = true;
+    }
+    async_update();
 }
 #if 0
 void VideoOverlayWidget::update_log_background(const std::shared_ptr<const std::vector<VideoOverlaySession::Box>>& bg_boxes){
@@ -88,49 +130,183 @@ void VideoOverlayWidget::update_log_background(const std::shared_ptr<const std::
 #endif
 
 void VideoOverlayWidget::on_watchdog_timeout(){
-    QMetaObject::invokeMethod(this, [this]{ this->update(); });
+    //  The stats are polled. The layer is only re-rendered if they changed.
+    mark_dirty(LAYER_STATS);
 //    static int c = 0;
 //    cout << "VideoOverlayWidget::on_watchdog_timeout(): " << c++ << endl;
 }
 
 
-void VideoOverlayWidget::resizeEvent(QResizeEvent* event){}
+void VideoOverlayWidget::resizeEvent(QResizeEvent* event){
+    {
+        WriteSpinLock lg(m_lock, "VideoOverlay::resizeEvent()");
+        for (bool& dirty : m_dirty){
+            dirty = true;
+        }
+    }
+    m_last_stats.clear();
+    refresh_layers();
+}
 
-void VideoOverlayWidget::paintEvent(QPaintEvent*){
+void VideoOverlayWidget::paintEvent(QPaintEvent* event){
     WallClock time0 = current_time();
 
     QPainter painter(this);
-    {
-        WriteSpinLock lg(m_lock, "VideoOverlay::paintEvent()");
+    const QRect& area = event->rect();
+    for (const OverlayLayer& layer : m_layers){
+        QRect rect = layer.bounds & area;
+        if (rect.isEmpty()){
+            continue;
+        }
+        qreal ratio = layer.image.devicePixelRatio();
+        painter.drawImage(
+            QRectF(rect), layer.image,
+            QRectF(rect.x() * ratio, rect.y() * ratio, rect.width() * ratio, rect.height() * ratio)
+        );
+    }
+
+    WallClock time1 = current_time();
+    uint32_t microseconds = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+    m_stats_paint.report_data(m_session.logger(), microseconds);
+}
 
-        //  The order here is important since the latter ones will go on top
-        //  of the earlier ones.
-        if (m_session.enabled_images()){
-            render_images(painter);
+
+bool VideoOverlayWidget::layer_enabled(Layer layer) const{
+    switch (layer){
+    case LAYER_IMAGES:  return m_session.enabled_images();
+    case LAYER_BOXES:   return m_session.enabled_boxes();
+    case LAYER_TEXT:    return m_session.enabled_text();
+    case LAYER_LOG:     return m_session.enabled_log();
+    case LAYER_STATS:   return m_session.enabled_stats();
+    default:            return false;
+    }
+}
+
+static bool same_stats(const std::vector<OverlayStatSnapshot>& x, const std::vector<OverlayStatSnapshot>& y){
+    if (x.size() != y.size()){
+        return false;
+    }
+    for (size_t c = 0; c < x.size(); c++){
+        if (x[c].text != y[c].text || x[c].color != y[c].color){
+            return false;
         }
-        if (m_session.enabled_boxes()){
-            render_boxes(painter);
+    }
+    return true;
+}
+
+void VideoOverlayWidget::refresh_layers(){
+    WallClock time0 = current_time();
+
+    m_refresh_pending.store(false, std::memory_order_release);
+
+    //  Grab a consistent snapshot of what changed. Rendering happens outside
+    //  the lock so the threads updating the overlay are never blocked on it.
+    bool dirty[LAYER_COUNT];
+    std::shared_ptr<const std::vector<OverlayBox>> boxes;
+    std::shared_ptr<const std::vector<OverlayText>> texts;
+    std::shared_ptr<const std::vector<OverlayImage>> images;
+    std::shared_ptr<const std::vector<OverlayLogLine>> log;
+    {
+        WriteSpinLock lg(m_lock, "VideoOverlay::refresh_layers()");
+        for (size_t c = 0; c < LAYER_COUNT; c++){
+            dirty[c] = m_dirty[c];
+            m_dirty[c] = false;
         }
-        if (m_session.enabled_text()){
-            render_text(painter);
+        boxes = m_boxes;
+        texts = m_texts;
+        images = m_images;
+        log = m_log;
+    }
+
+    //  Every refresh also polls the stats. So the watchdog only needs to fire
+    //  when nothing else has refreshed the overlay for a while. The stats
+    //  layer is only re-rendered if they changed.
+    global_watchdog().delay(*this);
+    std::vector<OverlayStatSnapshot> stats;
+    if (m_session.enabled_stats()){
+        stats = m_session.stats();
+    }
+    dirty[LAYER_STATS] = !same_stats(stats, m_last_stats);
+    if (dirty[LAYER_STATS]){
+        m_last_stats = stats;
+    }
+
+    const QRect full(0, 0, this->width(), this->height());
+    const qreal ratio = this->devicePixelRatioF();
+    const QSize pixels = (QSizeF(full.size()) * ratio).toSize();
+
+    bool rendered = false;
+    for (size_t c = 0; c < LAYER_COUNT; c++){
+        if (!dirty[c]){
+            continue;
         }
-        if (m_session.enabled_log()){
-            render_log(painter);
+        rendered = true;
+
+        OverlayLayer& layer = m_layers[c];
+        QRect old_bounds = layer.bounds;
+        layer.bounds = QRect();
+
+        if (!layer_enabled((Layer)c) || pixels.isEmpty()){
+            //  Clear what was drawn so it doesn't come back when the layer
+            //  is re-enabled and its new bounds overlap the old ones.
+            if (!old_bounds.isEmpty() && !layer.image.isNull()){
+                QPainter painter(&layer.image);
+                painter.setCompositionMode(QPainter::CompositionMode_Source);
+                painter.fillRect(old_bounds, Qt::transparent);
+            }
+            this->update(old_bounds);
+            continue;
         }
-        if (m_session.enabled_stats()){
-            render_stats(painter);
+
+        //  Erase only what was drawn last time.
+        if (layer.image.size() != pixels || layer.image.devicePixelRatio() != ratio){
+            layer.image = QImage(pixels, QImage::Format_ARGB32_Premultiplied);
+            layer.image.setDevicePixelRatio(ratio);
+            layer.image.fill(Qt::transparent);
+        }else if (!old_bounds.isEmpty()){
+            QPainter painter(&layer.image);
+            painter.setCompositionMode(QPainter::CompositionMode_Source);
+            painter.fillRect(old_bounds, Qt::transparent);
         }
-    }
 
-    global_watchdog().delay(*this);
+        QRect bounds;
+        {
+            QPainter painter(&layer.image);
+            switch ((Layer)c){
+            case LAYER_IMAGES:
+                bounds = render_images(painter, *images);
+                break;
+            case LAYER_BOXES:
+                bounds = render_boxes(painter, *boxes);
+                break;
+            case LAYER_TEXT:
+                bounds = render_text(painter, *texts);
+                break;
+            case LAYER_LOG:
+                bounds = render_log(painter, *log);
+                break;
+            case LAYER_STATS:
+                bounds = render_stats(painter, stats);
+                break;
+            default:;
+            }
+        }
 
+        //  Pad for pen width and anti-aliasing.
+        layer.bounds = bounds.adjusted(-2, -2, 2, 2) & full;
+        this->update(old_bounds | layer.bounds);
+    }
+
+    if (!rendered){
+        return;
+    }
     WallClock time1 = current_time();
     uint32_t microseconds = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
-    m_stats_paint.report_data(m_session.logger(), microseconds);
+    m_stats_render.report_data(m_session.logger(), microseconds);
 }
 
 
-void VideoOverlayWidget::render_stats(QPainter& painter){
+QRect VideoOverlayWidget::render_stats(QPainter& painter, const std::vector<OverlayStatSnapshot>& lines){
     const double TEXT_SIZE = 0.018;
     const double ROW_HEIGHT = 0.025;
 
@@ -141,15 +317,17 @@ void VideoOverlayWidget::render_stats(QPainter& painter){
     int height = this->height();
     int start_x = (int)(width * 0.78);
 
-    std::vector<OverlayStatSnapshot> lines = m_session.stats();
+    if (lines.empty()){
+        return QRect();
+    }
 
-    painter.fillRect(
+    QRect bounds(
         start_x,
         0,
         width - start_x,
-        (int)(height * (lines.size() * ROW_HEIGHT + 0.02)),
-        box_color
+        (int)(height * (lines.size() * ROW_HEIGHT + 0.02))
     );
+    painter.fillRect(bounds, box_color);
 
     size_t c = 0;
     for (const auto& stat : lines){
@@ -162,15 +340,19 @@ void VideoOverlayWidget::render_stats(QPainter& painter){
         int x = start_x + width * 0.01;
         int y = height * ((c + 1) * ROW_HEIGHT + 0.005);
 
-        painter.drawText(QPoint(x, y), QString::fromStdString(stat.text));
+        QString text = QString::fromStdString(stat.text);
+        painter.drawText(QPoint(x, y), text);
+        bounds |= QFontMetrics(text_font).boundingRect(text).translated(x, y);
 
         c++;
     }
+    return bounds;
 }
-void VideoOverlayWidget::render_boxes(QPainter& painter){
+QRect VideoOverlayWidget::render_boxes(QPainter& painter, const std::vector<OverlayBox>& boxes){
     const int width = this->width();
     const int height = this->height();
-    for (const auto& item : *m_boxes){
+    QRect bounds;
+    for (const auto& item : boxes){
         QColor color = QColor((uint32_t)item.color);
         painter.setPen(color);
 //        cout << box->x << " " << box->y << ", " << box->width << " x " << box->height << endl;
@@ -196,6 +378,7 @@ void VideoOverlayWidget::render_boxes(QPainter& painter){
             xmax - xmin,
             ymax - ymin
         );
+        bounds |= QRect(xmin, ymin, xmax - xmin + 1, ymax - ymin + 1);
 
 
         //  Draw the label.
@@ -223,13 +406,14 @@ void VideoOverlayWidget::render_boxes(QPainter& painter){
             ymin += box_height;
         }
 
-        painter.fillRect(
+        QRect label_box(
             xmin,
             std::max(ymin - box_height, 0),
             box_width,
-            box_height,
-            color
+            box_height
         );
+        painter.fillRect(label_box, color);
+        bounds |= label_box;
 
         uint32_t red = ((uint32_t)item.color >> 16) & 0xff;
         uint32_t green = ((uint32_t)item.color >> 8) & 0xff;
@@ -242,13 +426,17 @@ void VideoOverlayWidget::render_boxes(QPainter& painter){
             painter.setPen(QColor(0xffffffff));
         }
 
-        painter.drawText(QPoint(xmin + padding_width, ymin - 2*padding_height), text);
+        QPoint position(xmin + padding_width, ymin - 2*padding_height);
+        painter.drawText(position, text);
+        bounds |= QFontMetrics(text_font).boundingRect(text).translated(position);
     }
+    return bounds;
 }
-void VideoOverlayWidget::render_text(QPainter& painter){
+QRect VideoOverlayWidget::render_text(QPainter& painter, const std::vector<OverlayText>& texts){
     const int width = this->width();
     const int height = this->height();
-    for (const auto& item: *m_texts){
+    QRect bounds;
+    for (const auto& item: texts){
         painter.setPen(QColor((uint32_t)item.color));
         QFont text_font = this->font();
         text_font.setPointSizeF(item.font_size * height / 100.0);
@@ -257,14 +445,18 @@ void VideoOverlayWidget::render_text(QPainter& painter){
         const int xmin = std::max((int)(width * item.x + 0.5), 1);
         const int ymin = std::max((int)(height * item.y + 0.5), 1);
 
-        painter.drawText(QPoint(xmin, ymin), QString::fromStdString(item.message));
+        QString text = QString::fromStdString(item.message);
+        painter.drawText(QPoint(xmin, ymin), text);
+        bounds |= QFontMetrics(text_font).boundingRect(text).translated(xmin, ymin);
     }
+    return bounds;
 }
-void VideoOverlayWidget::render_images(QPainter& painter){
+QRect VideoOverlayWidget::render_images(QPainter& painter, const std::vector<OverlayImage>& images){
     const double width = static_cast<double>(this->width());
     const double height = static_cast<double>(this->height());
 
-    for(const auto& image_overlay: *m_images){
+    QRect bounds;
+    for(const auto& image_overlay: images){
         QImage q_image = image_overlay.image.to_QImage_ref();
         // source rect is the entire portion of the q_image, in pixel units
         QRectF source_rect(0.0, 0.0, static_cast<double>(q_image.width()), static_cast<double>(q_image.height()));
@@ -276,11 +468,13 @@ void VideoOverlayWidget::render_images(QPainter& painter){
         const double target_height = height * image_overlay.box.height;
         QRectF target_rect(target_start_x, target_start_y, target_width, target_height);
         painter.drawImage(target_rect, q_image, source_rect);
+        bounds |= target_rect.toAlignedRect();
     }
+    return bounds;
 }
-void VideoOverlayWidget::render_log(QPainter& painter){
-    if (m_log->empty()){
-        return;
+QRect VideoOverlayWidget::render_log(QPainter& painter, const std::vector<OverlayLogLine>& log){
+    if (log.empty()){
+        return QRect();
     }
 
     const double LOG_MIN_X = 0.025;
@@ -296,6 +490,8 @@ void VideoOverlayWidget::render_log(QPainter& painter){
     int width = this->width();
     int height = this->height();
 
+    QRect bounds;
+
     //  Draw the box.
     {
         // set a semi-transparent dark color so that user can see the log lines while can also see
@@ -306,13 +502,14 @@ void VideoOverlayWidget::render_log(QPainter& painter){
         const int ymin = std::max((int)(height * (LOG_MAX_Y - log_bg_height) + 0.5), 1);
         const int box_width = (int)(width * LOG_WIDTH + 0.5);
         const int box_height = (int)(height * log_bg_height + 0.5);
-        painter.fillRect(xmin, ymin, box_width, box_height, box_color);
+        bounds = QRect(xmin, ymin, box_width, box_height);
+        painter.fillRect(bounds, box_color);
     }
 
     //  Draw the text lines.
     double x = LOG_MIN_X + LOG_BORDER_X;
     double y = LOG_MAX_Y - LOG_BORDER_Y;
-    for (const OverlayLogLine& item: *m_log){
+    for (const OverlayLogLine& item: log){
         painter.setPen(QColor((uint32_t)item.color));
         QFont text_font = this->font();
         text_font.setPointSizeF(height * LOG_FONT_SIZE);
@@ -321,10 +518,13 @@ void VideoOverlayWidget::render_log(QPainter& painter){
         const int xmin = std::max((int)(width * x + 0.5), 1);
         const int ymin = std::max((int)(height * y + 0.5), 1);
 
-        painter.drawText(QPoint(xmin, ymin), QString::fromStdString(item.message));
+        QString text = QString::fromStdString(item.message);
+        painter.drawText(QPoint(xmin, ymin), text);
+        bounds |= QFontMetrics(text_font).boundingRect(text).translated(xmin, ymin);
 
         y -= LOG_LINE_SPACING;
     }
+    return bounds;
 }
 
 
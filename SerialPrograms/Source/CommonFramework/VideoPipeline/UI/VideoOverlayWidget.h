@@ -7,7 +7,9 @@
 #ifndef PokemonAutomation_VideoPipeline_VideoOverlayWidget_H
 #define PokemonAutomation_VideoPipeline_VideoOverlayWidget_H
 
+#include <atomic>
 #include <QWidget>
+#include <QImage>
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Cpp/Concurrency/Watchdog.h"
 #include "CommonFramework/Tools/StatAccumulator.h"
@@ -35,15 +37,15 @@ private:
     //  Asynchronous changes to the overlays.
 
     // callback function from VideoOverlaySession on overlay boxes enabled
-    virtual void on_overlay_enabled_boxes (bool enabled) override{async_update();}
+    virtual void on_overlay_enabled_boxes (bool enabled) override{mark_dirty(LAYER_BOXES);}
     // callback function from VideoOverlaySession on overlay text enabled
-    virtual void on_overlay_enabled_text  (bool enabled) override{async_update();}
+    virtual void on_overlay_enabled_text  (bool enabled) override{mark_dirty(LAYER_TEXT);}
     // callback function from VideoOverlaySession on overlay images enabled
-    virtual void on_overlay_enabled_images(bool enabled) override{async_update();}
+    virtual void on_overlay_enabled_images(bool enabled) override{mark_dirty(LAYER_IMAGES);}
     // callback function from VideoOverlaySession on overlay log enabled
-    virtual void on_overlay_enabled_log   (bool enabled) override{async_update();}
+    virtual void on_overlay_enabled_log   (bool enabled) override{mark_dirty(LAYER_LOG);}
     // callback function from VideoOverlaySession on overlay stats enabled
-    virtual void on_overlay_enabled_stats (bool enabled) override{async_update();}
+    virtual void on_overlay_enabled_stats (bool enabled) override{mark_dirty(LAYER_STATS);}
 
     // callback function from VideoOverlaySession on overlay boxes updated
     virtual void on_overlay_update_boxes (const std::shared_ptr<const std::vector<OverlayBox>>& boxes) override;
@@ -61,7 +63,30 @@ private:
     virtual void paintEvent(QPaintEvent*) override;
 
 private:
-    // Call QWidget::update() to notify Qt to schedule a re-rendering of the overlay widget.
+    //  Each kind of overlay is pre-rendered into its own layer. A layer is
+    //  only re-rendered when its content changes and only the area it covered
+    //  before and after is repainted. "paintEvent()" just composites the
+    //  layers so it never renders anything or takes the lock.
+    //
+    //  Listed in drawing order. The latter ones go on top of the earlier ones.
+    enum Layer{
+        LAYER_IMAGES,
+        LAYER_BOXES,
+        LAYER_TEXT,
+        LAYER_LOG,
+        LAYER_STATS,
+        LAYER_COUNT,
+    };
+    struct OverlayLayer{
+        QImage image;
+        //  The area that was drawn on. Empty if nothing was drawn.
+        QRect bounds;
+    };
+
+    //  Mark a layer as needing to be re-rendered. Can be called from any thread.
+    void mark_dirty(Layer layer);
+
+    // Schedule "refresh_layers()" on the main thread.
     //
     // Threads other than the main thread may change video overlay, causing this VideoOverlayWidget, which
     // listens to video overlay change, to get called on the non-main thread.
@@ -69,26 +94,43 @@ private:
     // async_update() to avoid that.
     void async_update();
 
+    //  Re-render the dirty layers and schedule a repaint of what changed.
+    //  Must be called on the main thread.
+    void refresh_layers();
+    bool layer_enabled(Layer layer) const;
+
+    //  The render functions return the area they drew on.
+
     // render overlay stats
-    void render_stats  (QPainter& painter);
+    QRect render_stats  (QPainter& painter, const std::vector<OverlayStatSnapshot>& stats);
     // render overlay boxes
-    void render_boxes  (QPainter& painter);
+    QRect render_boxes  (QPainter& painter, const std::vector<OverlayBox>& boxes);
     // render overlay texts
-    void render_text   (QPainter& painter);
+    QRect render_text   (QPainter& painter, const std::vector<OverlayText>& texts);
     // render overlay images
-    void render_images (QPainter& painter);
+    QRect render_images (QPainter& painter, const std::vector<OverlayImage>& images);
     // render overlay log lines
-    void render_log    (QPainter& painter);
+    QRect render_log    (QPainter& painter, const std::vector<OverlayLogLine>& log);
 
 private:
     VideoOverlaySession& m_session;
 
+    //  Protects the content pointers and dirty flags. Only held long enough
+    //  to swap pointers.
     SpinLock m_lock;
     std::shared_ptr<const std::vector<OverlayBox>> m_boxes;
     std::shared_ptr<const std::vector<OverlayText>> m_texts;
     std::shared_ptr<const std::vector<OverlayImage>> m_images;
     std::shared_ptr<const std::vector<OverlayLogLine>> m_log;
+    bool m_dirty[LAYER_COUNT];
+
+    std::atomic<bool> m_refresh_pending;
+
+    //  Only accessed on the main thread.
+    OverlayLayer m_layers[LAYER_COUNT];
+    std::vector<OverlayStatSnapshot> m_last_stats;
 
+    PeriodicStatsReporterI32 m_stats_render;
     PeriodicStatsReporterI32 m_stats_paint;
 };
 
@@ -38,6 +38,22 @@ public:
             LockMode::UNLOCK_WHILE_RUNNING,
             5
         )
+        , SHOW_VIDEO(
+            "<b>Show Video:</b><br>"
+            "Display the video feed. Programs still see every frame when this is off. "
+            "Turn this off to save CPU/GPU when running many consoles that nobody is watching.<br>"
+            "Takes effect the next time the video is reset.",
+            LockMode::UNLOCK_WHILE_RUNNING,
+            true
+        )
+        , MAX_DISPLAY_FPS(
+            "<b>Max Display FPS:</b><br>"
+            "Repaint the video display at most this many times per second. Zero is unlimited.<br>"
+            "This only limits what is drawn on screen. Programs still see every frame.<br>"
+            "Only the \"Qt6.5: QGraphicsScene\" video framework supports this option.",
+            LockMode::UNLOCK_WHILE_RUNNING,
+            0
+        )
     {
         PA_ADD_OPTION(VIDEO_BACKEND);
 #if QT_VERSION_MAJOR == 5
@@ -45,6 +61,8 @@ public:
 #endif
 
         PA_ADD_OPTION(AUTO_RESET_SECONDS);
+        PA_ADD_OPTION(SHOW_VIDEO);
+        PA_ADD_OPTION(MAX_DISPLAY_FPS);
     }
 
 public:
@@ -54,6 +72,9 @@ public:
 #endif
 
     SimpleIntegerOption<uint8_t> AUTO_RESET_SECONDS;
+
+    BooleanCheckBoxOption SHOW_VIDEO;
+    SimpleIntegerOption<uint8_t> MAX_DISPLAY_FPS;
 };
 
 
@@ -40,7 +40,8 @@ InferenceSession::InferenceSession(
                 stream.video_inference_pivot().add_callback(
                     scope, &m_triggered,
                     visual_callback,
-                    callback.period > std::chrono::milliseconds(0) ? callback.period : default_video_period
+                    callback.period > std::chrono::milliseconds(0) ? callback.period : default_video_period,
+                    callback.priority
                 );
                 visual_callback.make_overlays(m_overlays);
                 break;
@@ -49,7 +50,8 @@ InferenceSession::InferenceSession(
                 stream.audio_inference_pivot().add_callback(
                     scope, &m_triggered,
                     static_cast<AudioInferenceCallback&>(*callback.callback),
-                    callback.period > std::chrono::milliseconds(0) ? callback.period : default_audio_period
+                    callback.period > std::chrono::milliseconds(0) ? callback.period : default_audio_period,
+                    callback.priority
                 );
                 break;
             }
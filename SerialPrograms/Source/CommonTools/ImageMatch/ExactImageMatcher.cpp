@@ -27,7 +27,7 @@ ExactImageMatcher::ExactImageMatcher(ImageRGB32 image)
 //    cout << m_stats.stddev.sum() << endl;
 }
 
-ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& image) const{
+FloatPixel ExactImageMatcher::template_brightness_scale(const ImageViewRGB32& image) const{
     FloatPixel image_brightness = pixel_average(image, m_image);
     FloatPixel scale = image_brightness / m_stats.average;
 
@@ -35,11 +35,7 @@ ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& im
     if (std::isnan(scale.g)) scale.g = 1.0;
     if (std::isnan(scale.b)) scale.b = 1.0;
     scale.bound(0.85, 1.15);
-
-    ImageRGB32 ret = m_image.copy();
-    scale_brightness(ret, scale);
-//    ret.save("test.png");
-    return ret;
+    return scale;
 }
 
 
@@ -53,16 +49,28 @@ double ExactImageMatcher::rmsd(const ImageViewRGB32& image) const{
 //    cout << "ExactImageMatcher::rmsd(): image = " << image.width() << " x " << image.height() << endl;
     ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
 //    cout << "ExactImageMatcher::rmsd(): scaled = " << scaled.width() << " x " << scaled.height() << endl;
-    ImageRGB32 reference = scale_template_brightness(scaled);
+    return rmsd_prescaled(scaled);
+}
+double ExactImageMatcher::rmsd_prescaled(const ImageViewRGB32& scaled) const{
+    if (!scaled){
+        return 1000.;
+    }
+    if (scaled.width() != m_image.width() || scaled.height() != m_image.height()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Image does not match template dimensions.");
+    }
+
+    FloatPixel scale = template_brightness_scale(scaled);
 
 #if 0
     static int c = 0;
-    image.save("test-" + std::to_string(c) + "-image.png");
+    ImageRGB32 reference = m_image.copy();
+    scale_brightness(reference, scale);
+    scaled.save("test-" + std::to_string(c) + "-image.png");
     reference.save("test-" + std::to_string(c) + "-sprite.png");
     c++;
 #endif
 
-    double rmsd = pixel_RMSD(reference, scaled);
+    double rmsd = pixel_RMSD_scaled(m_image, scaled, scale);
 //    cout << "rmsd = " << rmsd << endl;
     return rmsd;
 }
@@ -71,24 +79,25 @@ double ExactImageMatcher::rmsd(const ImageViewRGB32& image, Color background) co
         return 1000.;
     }
     ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
-    ImageRGB32 reference = scale_template_brightness(scaled);
+    FloatPixel scale = template_brightness_scale(scaled);
 
 #if 0
     static int c = 0;
+    ImageRGB32 reference = m_image.copy();
+    scale_brightness(reference, scale);
     scaled.save("test-" + std::to_string(c) + "-image.png");
     reference.save("test-" + std::to_string(c) + "-sprite.png");
     c++;
 #endif
 
-    return pixel_RMSD(reference, scaled, background);
+    return pixel_RMSD_scaled(m_image, scaled, background, scale);
 }
 double ExactImageMatcher::rmsd_masked(const ImageViewRGB32& image) const{
     if (!image){
         return 1000.;
     }
     ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
-    ImageRGB32 reference = scale_template_brightness(scaled);
-    return pixel_RMSD_masked(reference, scaled);
+    return pixel_RMSD_masked_scaled(m_image, scaled, template_brightness_scale(scaled));
 }
 
 
@@ -37,6 +37,10 @@ public:
     // The part of the image template where alpha is 0 is not used to compare with the corresponding
     // part in the input image.
     double rmsd(const ImageViewRGB32& image) const;
+    // Same as `rmsd(image)` but `scaled` must already have the template's dimensions.
+    // Use this when the same candidate is compared against several templates of the
+    // same size so that it only needs to be resized once.
+    double rmsd_prescaled(const ImageViewRGB32& scaled) const;
     // Resize image to match the shape of the image template, scale the template brightness to match
     // the input image, then compute their RMSD (root mean square deviation).
     // The part of the image template where alpha is 0 is replace with `background` color when comparing
@@ -53,9 +57,9 @@ public:
     const ImageRGB32& image_template() const { return m_image; }
 
 private:
-    // scale stored image template according to the brightness of `image`, assign
-    // the scaled template to `reference`.
-    ImageRGB32 scale_template_brightness(const ImageViewRGB32& image) const;
+    // Return how much to scale the template brightness by to match the brightness
+    // of `image`. The scaling itself is fused into the RMSD kernels.
+    FloatPixel template_brightness_scale(const ImageViewRGB32& image) const;
 
 protected:
     ImageRGB32 m_image;
@@ -49,7 +49,7 @@ ImageMatchResult SilhouetteDictionaryMatcher::match(
     }
 
     SpinLock lock;
-    GlobalThreadPools::normal_inference().run_in_parallel(
+    GlobalThreadPools::normal_inference().parallel_for(
         [&](size_t index){
             const auto& matcher = *m_database_vector[index];
             double alpha = matcher.second.rmsd_masked(image);
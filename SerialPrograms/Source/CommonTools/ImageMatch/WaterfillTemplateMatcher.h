@@ -21,6 +21,7 @@ namespace ImageMatch{
 class WaterfillTemplateMatcher{
 protected:
     using WaterfillObject = Kernels::Waterfill::WaterfillObject;
+    friend class WaterfillTemplateMatcherSet;
 
 public:
     WaterfillTemplateMatcher(WaterfillTemplateMatcher&&) = default;
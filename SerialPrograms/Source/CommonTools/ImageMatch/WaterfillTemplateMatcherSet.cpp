@@ -0,0 +1,130 @@
+/*  Waterfill Template Matcher Set
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <limits>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_Types.h"
+#include "WaterfillTemplateMatcherSet.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+
+WaterfillTemplateMatcherSet::WaterfillTemplateMatcherSet(std::vector<const WaterfillTemplateMatcher*> matchers)
+    : m_matchers(std::move(matchers))
+    , m_template_size_index(m_matchers.size())
+{
+    for (size_t c = 0; c < m_matchers.size(); c++){
+        const WaterfillTemplateMatcher* matcher = m_matchers[c];
+        if (matcher == nullptr){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Matcher is null.");
+        }
+
+        const ImageRGB32& image_template = matcher->image_template();
+        size_t width = image_template.width();
+        size_t height = image_template.height();
+
+        //  The check passes when:
+        //      lower <= (template_width * candidate_height) / (template_height * candidate_width) <= upper
+        //  which is:
+        //      template_aspect / upper <= candidate_width / candidate_height <= template_aspect / lower
+        double template_aspect = (double)width / height;
+        IndexEntry entry;
+        entry.min_aspect_ratio = template_aspect / matcher->m_aspect_ratio_upper * (1 - 1e-9);
+        entry.max_aspect_ratio = matcher->m_aspect_ratio_lower <= 0
+            ? std::numeric_limits<double>::infinity()
+            : template_aspect / matcher->m_aspect_ratio_lower * (1 + 1e-9);
+        entry.matcher_index = c;
+        m_index.emplace_back(entry);
+
+        auto iter = std::find(m_template_sizes.begin(), m_template_sizes.end(), std::pair<size_t, size_t>(width, height));
+        m_template_size_index[c] = iter - m_template_sizes.begin();
+        if (iter == m_template_sizes.end()){
+            m_template_sizes.emplace_back(width, height);
+        }
+    }
+
+    std::sort(
+        m_index.begin(), m_index.end(),
+        [](const IndexEntry& x, const IndexEntry& y){
+            return x.min_aspect_ratio < y.min_aspect_ratio;
+        }
+    );
+}
+
+
+void WaterfillTemplateMatcherSet::rmsd_precropped(
+    std::vector<double>& rmsds,
+    Resolution input_resolution,
+    const ImageViewRGB32& cropped_image,
+    const WaterfillObject& object
+) const{
+    rmsds.assign(m_matchers.size(), 99999.);
+    if (object.width() == 0 || object.height() == 0){
+        return;
+    }
+
+    //  Everything past the first template whose range starts above the
+    //  candidate's aspect ratio is out of range.
+    double aspect_ratio = (double)object.width() / object.height();
+    auto end = std::upper_bound(
+        m_index.begin(), m_index.end(), aspect_ratio,
+        [](double x, const IndexEntry& entry){
+            return x < entry.min_aspect_ratio;
+        }
+    );
+
+    //  Resized candidates, one per distinct template size. Built on first use.
+    std::vector<ImageRGB32> scaled(m_template_sizes.size());
+
+    double area_ratio = object.area_ratio();
+    for (auto iter = m_index.begin(); iter != end; ++iter){
+        if (aspect_ratio > iter->max_aspect_ratio){
+            continue;
+        }
+
+        size_t index = iter->matcher_index;
+        const WaterfillTemplateMatcher& matcher = *m_matchers[index];
+        if (!matcher.check_aspect_ratio(object.width(), object.height())){
+            continue;
+        }
+        if (!matcher.check_area_ratio(area_ratio)){
+            continue;
+        }
+        if (!cropped_image || !matcher.check_image(input_resolution, cropped_image)){
+            continue;
+        }
+
+        size_t size_index = m_template_size_index[index];
+        ImageRGB32& candidate = scaled[size_index];
+        if (!candidate){
+            const std::pair<size_t, size_t>& size = m_template_sizes[size_index];
+            candidate = cropped_image.scale_to(size.first, size.second);
+        }
+
+        rmsds[index] = matcher.m_matcher->rmsd_prescaled(candidate);
+    }
+}
+void WaterfillTemplateMatcherSet::rmsd_original(
+    std::vector<double>& rmsds,
+    Resolution input_resolution,
+    const ImageViewRGB32& original_image,
+    const WaterfillObject& object
+) const{
+    rmsd_precropped(
+        rmsds,
+        input_resolution,
+        extract_box_reference(original_image, object),
+        object
+    );
+}
+
+
+
+}
+}
@@ -0,0 +1,82 @@
+/*  Waterfill Template Matcher Set
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Match a waterfill object against several templates at once.
+ *
+ *  Calling "WaterfillTemplateMatcher::rmsd_precropped()" once per template
+ *  resizes the candidate for every template and runs the aspect ratio and area
+ *  ratio checks one template at a time. This class indexes the templates by
+ *  the range of candidate aspect ratios they accept so that each object only
+ *  visits the templates it can match. Templates of the same size share one
+ *  resized copy of the candidate.
+ *
+ *  The results are the same as calling "rmsd_precropped()" on each template.
+ *  Matchers that override "rmsd_precropped()" or "rmsd_original()" should not
+ *  be put in a set since those overrides are bypassed.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_WaterfillTemplateMatcherSet_H
+#define PokemonAutomation_CommonTools_WaterfillTemplateMatcherSet_H
+
+#include <vector>
+#include "WaterfillTemplateMatcher.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+class WaterfillTemplateMatcherSet{
+    using WaterfillObject = Kernels::Waterfill::WaterfillObject;
+
+public:
+    //  The matchers must outlive this class.
+    WaterfillTemplateMatcherSet(std::vector<const WaterfillTemplateMatcher*> matchers);
+
+    size_t size() const{ return m_matchers.size(); }
+    const WaterfillTemplateMatcher& operator[](size_t index) const{ return *m_matchers[index]; }
+
+    //  Compute the RMSD of the object against every template.
+    //  "rmsds" is resized to "size()". "rmsds[i]" is the same value that
+    //  "(*this)[i].rmsd_precropped()" would return.
+    void rmsd_precropped(
+        std::vector<double>& rmsds,
+        Resolution input_resolution,
+        const ImageViewRGB32& cropped_image,
+        const WaterfillObject& object
+    ) const;
+
+    //  Same as above, but crop "original_image" using the object's bounding box first.
+    void rmsd_original(
+        std::vector<double>& rmsds,
+        Resolution input_resolution,
+        const ImageViewRGB32& original_image,
+        const WaterfillObject& object
+    ) const;
+
+
+private:
+    struct IndexEntry{
+        //  Range of candidate width/height that passes the aspect ratio check.
+        //  Slightly widened. The exact check is still run on everything in range.
+        double min_aspect_ratio;
+        double max_aspect_ratio;
+        size_t matcher_index;
+    };
+
+    std::vector<const WaterfillTemplateMatcher*> m_matchers;
+
+    //  Sorted by "min_aspect_ratio".
+    std::vector<IndexEntry> m_index;
+
+    //  Distinct template dimensions and which of them each template uses.
+    std::vector<std::pair<size_t, size_t>> m_template_sizes;
+    std::vector<size_t> m_template_size_index;
+};
+
+
+
+}
+}
+#endif
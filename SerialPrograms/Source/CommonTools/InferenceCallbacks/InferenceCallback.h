@@ -17,6 +17,15 @@ enum class InferenceType{
     AUDIO,
 };
 
+//  How an inference callback is treated when the global inference CPU budget
+//  is exceeded. (see InferenceBudget.h)
+enum class InferencePriority{
+    //  The period of this callback may be stretched to save CPU.
+    NORMAL,
+    //  Time-critical. Always runs at its requested period.
+    CRITICAL,
+};
+
 //  Base class for an inference object to be called perioridically by
 //  inference routines in InferenceRoutines.h.
 class InferenceCallback{
@@ -56,17 +65,21 @@ struct PeriodicInferenceCallback{
     //  default inference period, which is set as a parameter to the inference
     //  routine.
     std::chrono::milliseconds period;
+    InferencePriority priority;
 
     PeriodicInferenceCallback()
         : callback(nullptr)
         , period(std::chrono::milliseconds(0))
+        , priority(InferencePriority::NORMAL)
     {}
     PeriodicInferenceCallback(
         InferenceCallback& p_callback,
-        std::chrono::milliseconds p_period = std::chrono::milliseconds(0)
+        std::chrono::milliseconds p_period = std::chrono::milliseconds(0),
+        InferencePriority p_priority = InferencePriority::NORMAL
     )
         : callback(&p_callback)
         , period(p_period)
+        , priority(p_priority)
     {
 #if 0
         if (period > std::chrono::milliseconds(0)){
@@ -6,6 +6,8 @@
 
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "InferenceBudget.h"
+#include "InferenceProfiler.h"
 #include "AudioInferencePivot.h"
 
 //#include <iostream>
@@ -40,21 +42,26 @@ struct AudioInferencePivot::PeriodicCallback{
 };
 
 
-AudioInferencePivot::AudioInferencePivot(CancellableScope& scope, AudioFeed& feed, AsyncDispatcher& dispatcher)
-    : PeriodicRunner(dispatcher)
+AudioInferencePivot::AudioInferencePivot(CancellableScope& scope, AudioFeed& feed, PeriodicExecutor& executor)
+    : PeriodicRunner(executor)
     , m_feed(feed)
+    , m_profile_id(InferenceProfiler::instance().add_pivot("Audio"))
 {
     attach(scope);
+    InferenceBudget::instance().add_pivot(*this);
 }
 AudioInferencePivot::~AudioInferencePivot(){
+    InferenceBudget::instance().remove_pivot(*this);
     detach();
     stop_thread();
+    InferenceProfiler::instance().remove_pivot(m_profile_id);
 }
 void AudioInferencePivot::add_callback(
     Cancellable& scope,
     std::atomic<InferenceCallback*>* set_when_triggered,
     AudioInferenceCallback& callback,
-    std::chrono::milliseconds period
+    std::chrono::milliseconds period,
+    InferencePriority priority
 ){
     WriteSpinLock lg(m_lock);
     auto iter = m_map.find(&callback);
@@ -67,7 +74,10 @@ void AudioInferencePivot::add_callback(
         std::forward_as_tuple(scope, set_when_triggered, callback, period)
     ).first;
     try{
-        PeriodicRunner::add_event(&iter->second, period);
+        PeriodicRunner::add_event(
+            &iter->second, period, current_steady_time(),
+            priority != InferencePriority::CRITICAL
+        );
     }catch (...){
         m_map.erase(iter);
         throw;
@@ -86,6 +96,7 @@ StatAccumulatorI32 AudioInferencePivot::remove_callback(AudioInferenceCallback&
 }
 void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
+    InferenceBudget::instance().update();
     try{
         std::vector<AudioSpectrum> spectrums;
 
@@ -103,10 +114,17 @@ void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
             callback.last_seqnum = spectrums[0].stamp;
         }
 
+        InferenceProfileTimer profile;
         WallClock time0 = current_time();
         bool stop = callback.callback.process_spectrums(spectrums, m_feed);
         WallClock time1 = current_time();
         callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+
+        //  Spectrums only carry a sequence number. There's no frame age.
+        profile.report(
+            m_profile_id, callback.callback.label(),
+            time0, time1, WallDuration::min(), queue_delay()
+        );
         if (stop){
             if (callback.set_when_triggered){
                 InferenceCallback* expected = nullptr;
@@ -121,7 +139,20 @@ void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
 
 
 OverlayStatSnapshot AudioInferencePivot::get_current(){
-    return m_printer.get_snapshot("Audio Pivot Utilization:", this->current_utilization());
+    OverlayStatSnapshot snapshot = m_printer.get_snapshot("Audio Pivot Utilization:", this->current_utilization());
+    if (snapshot.text.empty()){
+        return snapshot;
+    }
+    uint64_t misses = this->deadline_misses();
+    if (misses != 0){
+        snapshot.text += " (late: " + std::to_string(misses) + ")";
+    }
+    size_t throttle = this->throttle();
+    if (throttle > 1){
+        snapshot.text += " (throttled x" + std::to_string(throttle) + ")";
+        snapshot.color = COLOR_ORANGE;
+    }
+    return snapshot;
 }
 
 
@@ -21,7 +21,7 @@ class AudioFeed;
 
 class AudioInferencePivot final : public PeriodicRunner, public OverlayStat{
 public:
-    AudioInferencePivot(CancellableScope& scope, AudioFeed& feed, AsyncDispatcher& dispatcher);
+    AudioInferencePivot(CancellableScope& scope, AudioFeed& feed, PeriodicExecutor& executor);
     virtual ~AudioInferencePivot();
 
     //  If this callback returns true:
@@ -32,7 +32,8 @@ public:
         Cancellable& scope,
         std::atomic<InferenceCallback*>* set_when_triggered,
         AudioInferenceCallback& callback,
-        std::chrono::milliseconds period
+        std::chrono::milliseconds period,
+        InferencePriority priority = InferencePriority::NORMAL
     );
 
     //  Returns the latency stats for the callback. Units are microseconds.
@@ -46,6 +47,7 @@ private:
     struct PeriodicCallback;
 
     AudioFeed& m_feed;
+    uint64_t m_profile_id;
     SpinLock m_lock;
     std::map<AudioInferenceCallback*, PeriodicCallback> m_map;
 
@@ -0,0 +1,96 @@
+/*  Inference Budget
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include <thread>
+#include "Common/Cpp/Concurrency/PeriodicScheduler.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Options/Environment/PerformanceOptions.h"
+#include "InferenceBudget.h"
+
+namespace PokemonAutomation{
+
+
+const std::chrono::milliseconds INFERENCE_BUDGET_UPDATE_PERIOD(1000);
+
+
+InferenceBudget& InferenceBudget::instance(){
+    static InferenceBudget budget;
+    return budget;
+}
+InferenceBudget::InferenceBudget()
+    : m_next_update(SteadyClock::min().time_since_epoch().count())
+{}
+
+
+void InferenceBudget::add_pivot(PeriodicRunner& pivot){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_pivots.emplace_back(&pivot);
+    pivot.set_throttle(1);
+}
+void InferenceBudget::remove_pivot(PeriodicRunner& pivot){
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = std::find(m_pivots.begin(), m_pivots.end(), &pivot);
+    if (iter != m_pivots.end()){
+        m_pivots.erase(iter);
+    }
+}
+
+
+void InferenceBudget::update() noexcept{
+    SteadyClock now = current_steady_time();
+    if (now.time_since_epoch().count() < m_next_update.load(std::memory_order_relaxed)){
+        return;
+    }
+
+    //  Someone else is already doing it.
+    std::unique_lock<std::mutex> lg(m_lock, std::try_to_lock);
+    if (!lg.owns_lock()){
+        return;
+    }
+    m_next_update.store(
+        (now + INFERENCE_BUDGET_UPDATE_PERIOD).time_since_epoch().count(),
+        std::memory_order_relaxed
+    );
+
+    double fraction = GlobalSettings::instance().PERFORMANCE->INFERENCE_CPU_BUDGET;
+    if (fraction <= 0){
+        for (PeriodicRunner* pivot : m_pivots){
+            pivot->set_throttle(1);
+        }
+        return;
+    }
+    if (m_pivots.empty()){
+        return;
+    }
+    size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    double total_budget = fraction * (double)cores;
+    double share = total_budget / (double)m_pivots.size();
+
+    std::vector<double> utilizations;
+    double total = 0;
+    for (const PeriodicRunner* pivot : m_pivots){
+        utilizations.emplace_back(pivot->current_utilization());
+        total += utilizations.back();
+    }
+
+    for (size_t c = 0; c < m_pivots.size(); c++){
+        PeriodicRunner* pivot = m_pivots[c];
+        double utilization = utilizations[c];
+        size_t throttle = pivot->throttle();
+        if (utilization > fraction || (total > total_budget && utilization > share)){
+            throttle = std::min(throttle * 2, MAX_THROTTLE);
+        }else if (throttle > 1 && utilization * 2 < 0.75 * fraction && total + utilization < 0.75 * total_budget){
+            //  Only release if doubling the frequency would still leave headroom.
+            throttle /= 2;
+        }
+        pivot->set_throttle(throttle);
+    }
+}
+
+
+
+}
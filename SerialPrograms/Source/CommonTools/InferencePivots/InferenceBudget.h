@@ -0,0 +1,62 @@
+/*  Inference Budget
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Global CPU budget shared by the inference pivots of all consoles.
+ *
+ *  Each pivot registers itself here. Periodically, the utilization of the
+ *  registered pivots is compared against the budget set in the performance
+ *  options. The budget is exceeded if either:
+ *      1.  Any single pivot is busy more than the budget fraction of the time.
+ *          A pivot runs its callbacks one at a time, so a busy pivot falls
+ *          behind no matter how many cores are free.
+ *      2.  All pivots together use more than the budget fraction of the cores.
+ *
+ *  Each pivot is throttled on its own. A pivot is over budget if it is busier
+ *  than (1), or if (2) is exceeded and the pivot uses more than its even share
+ *  of the cores. When a pivot is over budget, the periods of its non-critical
+ *  inference callbacks are stretched so that its critical callbacks keep
+ *  running on time. Pivots that are within budget are left alone. The
+ *  throttle is released once there is room again.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_InferenceBudget_H
+#define PokemonAutomation_CommonTools_InferenceBudget_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+class PeriodicRunner;
+
+
+class InferenceBudget{
+public:
+    static constexpr size_t MAX_THROTTLE = 4;
+
+    static InferenceBudget& instance();
+
+    void add_pivot(PeriodicRunner& pivot);
+    void remove_pivot(PeriodicRunner& pivot);
+
+    //  Called by the pivots at the start of every callback run.
+    //  This is cheap and will only re-evaluate the budget once in a while.
+    void update() noexcept;
+
+private:
+    InferenceBudget();
+
+private:
+    std::mutex m_lock;
+    std::vector<PeriodicRunner*> m_pivots;
+    std::atomic<SteadyClock::rep> m_next_update;
+};
+
+
+
+}
+#endif
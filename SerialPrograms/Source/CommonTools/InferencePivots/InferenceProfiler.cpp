@@ -0,0 +1,279 @@
+/*  Inference Profiler
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include <QFile>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Options/Environment/PerformanceOptions.h"
+#include "InferenceProfiler.h"
+
+namespace PokemonAutomation{
+
+
+
+InferenceProfiler& InferenceProfiler::instance(){
+    static InferenceProfiler profiler;
+    return profiler;
+}
+bool InferenceProfiler::enabled() const{
+    return GlobalSettings::instance().PERFORMANCE->INFERENCE_PROFILER;
+}
+
+
+uint64_t InferenceProfiler::add_pivot(const char* pivot_name){
+    WriteSpinLock lg(m_lock);
+    uint64_t pivot_id = m_next_pivot_id++;
+    m_tracks[pivot_id].name = std::string(pivot_name) + " Pivot " + std::to_string(pivot_id);
+    return pivot_id;
+}
+void InferenceProfiler::remove_pivot(uint64_t pivot_id) noexcept{
+    WriteSpinLock lg(m_lock);
+    auto iter = m_tracks.find(pivot_id);
+    if (iter == m_tracks.end()){
+        return;
+    }
+    if (iter->second.events == 0){
+        m_tracks.erase(iter);
+    }else{
+        iter->second.alive = false;
+    }
+}
+
+
+void InferenceProfiler::record(
+    uint64_t pivot_id,
+    const std::string& label,
+    WallClock start, WallDuration wall_time, WallDuration cpu_time,
+    WallDuration snapshot_age, WallDuration queue_delay
+) noexcept{
+    //  Profiling must never take down the callback. Drop the sample if we're
+    //  out of memory.
+    try{
+        WriteSpinLock lg(m_lock);
+
+        auto iter = m_histograms.find(label);
+        if (iter == m_histograms.end()){
+            m_labels.emplace_back(label);
+            try{
+                iter = m_histograms.try_emplace(label, m_labels.size() - 1).first;
+            }catch (...){
+                m_labels.pop_back();
+                throw;
+            }
+        }
+        Histograms& histograms = iter->second;
+
+        //  Allocate the whole ring buffer up front so that the pivots never
+        //  reallocate it while holding the lock.
+        if (m_trace.capacity() < MAX_TRACE_EVENTS){
+            m_trace.reserve(MAX_TRACE_EVENTS);
+        }
+
+        //  Only happens if the pivot never called "add_pivot()". Give it a
+        //  track that goes away with its last run.
+        auto track = m_tracks.find(pivot_id);
+        if (track == m_tracks.end()){
+            track = m_tracks.try_emplace(pivot_id).first;
+            track->second.name = "Pivot " + std::to_string(pivot_id);
+            track->second.alive = false;
+        }
+
+        histograms.wall_time.add(wall_time);
+        if (cpu_time >= WallDuration::zero()){
+            histograms.cpu_time.add(cpu_time);
+        }
+        if (snapshot_age >= WallDuration::zero()){
+            histograms.snapshot_age.add(snapshot_age);
+        }
+        histograms.queue_delay.add(queue_delay);
+
+        TraceEvent event{
+            histograms.label_index, pivot_id,
+            start, wall_time, cpu_time, snapshot_age, queue_delay
+        };
+        track->second.events++;
+        if (m_trace.size() < MAX_TRACE_EVENTS){
+            m_trace.emplace_back(event);
+        }else{
+            //  Overwriting the oldest run. Drop its track if that was the last
+            //  run of a pivot that is gone.
+            auto old = m_tracks.find(m_trace[m_trace_next].track);
+            if (old != m_tracks.end() && --old->second.events == 0 && !old->second.alive){
+                m_tracks.erase(old);
+            }
+            m_trace[m_trace_next] = event;
+        }
+        m_trace_next = (m_trace_next + 1) % MAX_TRACE_EVENTS;
+    }catch (...){}
+}
+
+
+std::vector<InferenceProfileStats> InferenceProfiler::stats() const{
+    ReadSpinLock lg(m_lock);
+    std::vector<InferenceProfileStats> ret;
+    for (const auto& item : m_histograms){
+        ret.emplace_back(InferenceProfileStats{
+            item.first,
+            item.second.wall_time.snapshot(),
+            item.second.cpu_time.snapshot(),
+            item.second.snapshot_age.snapshot(),
+            item.second.queue_delay.snapshot(),
+        });
+    }
+    return ret;
+}
+void InferenceProfiler::clear(){
+    WriteSpinLock lg(m_lock);
+    m_histograms.clear();
+    m_labels.clear();
+    m_trace.clear();
+    m_trace_next = 0;
+    for (auto iter = m_tracks.begin(); iter != m_tracks.end();){
+        if (iter->second.alive){
+            iter->second.events = 0;
+            ++iter;
+        }else{
+            iter = m_tracks.erase(iter);
+        }
+    }
+}
+
+
+size_t InferenceProfiler::export_chrome_trace(const std::string& filename) const{
+    std::vector<std::string> labels;
+    std::map<uint64_t, std::string> tracks;
+    std::vector<TraceEvent> trace;
+    {
+        //  Copy everything out first. Building the JSON is too slow to do
+        //  while the pivots are waiting on the lock.
+        ReadSpinLock lg(m_lock);
+        labels = m_labels;
+        for (const auto& item : m_tracks){
+            tracks.emplace(item.first, item.second.name);
+        }
+        trace.reserve(m_trace.size());
+        for (size_t c = 0; c < m_trace.size(); c++){
+            //  Oldest first.
+            trace.emplace_back(m_trace[(m_trace_next + c) % m_trace.size()]);
+        }
+    }
+
+    auto to_us = [](WallDuration duration){
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+
+    //  Timestamps are relative to the oldest run so that they stay small.
+    WallClock origin = trace.empty() ? WallClock() : trace[0].start;
+    for (const TraceEvent& event : trace){
+        origin = std::min(origin, event.start);
+    }
+
+    JsonArray events;
+    {
+        JsonObject args;
+        args["name"] = "Inference Pivots";
+        JsonObject process;
+        process["name"] = "process_name";
+        process["ph"] = "M";
+        process["pid"] = 1;
+        process["args"] = std::move(args);
+        events.push_back(std::move(process));
+    }
+    for (const auto& track : tracks){
+        JsonObject args;
+        args["name"] = track.second;
+        JsonObject thread;
+        thread["name"] = "thread_name";
+        thread["ph"] = "M";
+        thread["pid"] = 1;
+        thread["tid"] = (int64_t)track.first;
+        thread["args"] = std::move(args);
+        events.push_back(std::move(thread));
+    }
+    for (const TraceEvent& event : trace){
+        JsonObject args;
+        if (event.cpu_time >= WallDuration::zero()){
+            args["cpu_us"] = to_us(event.cpu_time);
+        }
+        if (event.snapshot_age >= WallDuration::zero()){
+            args["snapshot_age_us"] = to_us(event.snapshot_age);
+        }
+        args["queue_delay_us"] = to_us(event.queue_delay);
+
+        JsonObject item;
+        item["name"] = labels[event.label];
+        item["cat"] = "inference";
+        item["ph"] = "X";
+        item["pid"] = 1;
+        item["tid"] = (int64_t)event.track;
+        item["ts"] = to_us(event.start - origin);
+        item["dur"] = to_us(event.wall_time);
+        item["args"] = std::move(args);
+        events.push_back(std::move(item));
+    }
+
+    JsonObject root;
+    root["traceEvents"] = std::move(events);
+    root["displayTimeUnit"] = "ms";
+
+    //  Not JsonObject::dump(filename). The trace viewers don't accept the BOM
+    //  that it writes.
+    std::string json = root.dump(-1);
+    QFile file(QString::fromStdString(filename));
+    if (!file.open(QFile::WriteOnly)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to create file.", filename);
+    }
+    if (file.write(json.c_str(), json.size()) != (int)json.size()){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write file.", filename);
+    }
+    file.close();
+
+    return trace.size();
+}
+
+
+
+InferenceProfileTimer::InferenceProfileTimer()
+    : m_enabled(InferenceProfiler::instance().enabled())
+    , m_cpu_start(WallDuration::min())
+{
+    if (m_enabled){
+        m_thread = current_thread_handle();
+        m_cpu_start = thread_cpu_time(m_thread);
+    }
+}
+void InferenceProfileTimer::report(
+    uint64_t pivot_id,
+    const std::string& label,
+    WallClock start, WallClock end,
+    WallDuration snapshot_age, WallDuration queue_delay
+) noexcept{
+    if (!m_enabled){
+        return;
+    }
+
+    //  thread_cpu_time() returns WallDuration::min() if it fails.
+    WallDuration cpu_time = WallDuration::min();
+    if (m_cpu_start != WallDuration::min()){
+        WallDuration cpu_end = thread_cpu_time(m_thread);
+        if (cpu_end != WallDuration::min()){
+            cpu_time = cpu_end - m_cpu_start;
+        }
+    }
+
+    InferenceProfiler::instance().record(
+        pivot_id, label,
+        start, end - start, cpu_time,
+        snapshot_age, queue_delay
+    );
+}
+
+
+
+}
@@ -0,0 +1,142 @@
+/*  Inference Profiler
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Per-callback timing for the inference pivots of all consoles.
+ *
+ *  When enabled in the performance options, every run of a visual or audio
+ *  callback records:
+ *      -   Wall time and CPU time spent inside the callback.
+ *      -   Snapshot age: How old the frame was when the callback looked at it.
+ *      -   Queue delay: How late the pivot got to the callback.
+ *
+ *  These are aggregated per callback label into fixed-size histograms. The
+ *  most recent runs are also kept in a fixed-size ring buffer which can be
+ *  exported as a Chrome trace. (open with chrome://tracing or Perfetto)
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_InferenceProfiler_H
+#define PokemonAutomation_CommonTools_InferenceProfiler_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/JitterHistogram.h"
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/CpuUtilization/CpuUtilization.h"
+
+namespace PokemonAutomation{
+
+
+struct InferenceProfileStats{
+    std::string label;
+    JitterHistogramSnapshot wall_time;
+    JitterHistogramSnapshot cpu_time;
+    JitterHistogramSnapshot snapshot_age;
+    JitterHistogramSnapshot queue_delay;
+};
+
+
+class InferenceProfiler{
+public:
+    static constexpr size_t MAX_TRACE_EVENTS = 65536;
+
+    static InferenceProfiler& instance();
+
+    bool enabled() const;
+
+    //  Each pivot gets its own track in the trace. Call "add_pivot()" when the
+    //  pivot is constructed and pass the returned id to "record()".
+    //  Call "remove_pivot()" when it is destroyed. Its track stays until its
+    //  last run falls out of the ring buffer.
+    uint64_t add_pivot(const char* pivot_name);
+    void remove_pivot(uint64_t pivot_id) noexcept;
+
+    //  Called by the pivots after running a callback.
+    //  Pass a negative "cpu_time" or "snapshot_age" if it isn't available.
+    void record(
+        uint64_t pivot_id,
+        const std::string& label,
+        WallClock start, WallDuration wall_time, WallDuration cpu_time,
+        WallDuration snapshot_age, WallDuration queue_delay
+    ) noexcept;
+
+    std::vector<InferenceProfileStats> stats() const;
+
+    //  Drop all histograms and buffered runs, and the tracks of pivots that
+    //  are gone.
+    void clear();
+
+    //  Write the buffered runs as a Chrome trace. Returns the # of runs written.
+    size_t export_chrome_trace(const std::string& filename) const;
+
+private:
+    InferenceProfiler() = default;
+
+private:
+    struct Histograms{
+        size_t label_index;
+        JitterHistogram wall_time;
+        JitterHistogram cpu_time;
+        JitterHistogram snapshot_age;
+        JitterHistogram queue_delay;
+
+        Histograms(size_t p_label_index)
+            : label_index(p_label_index)
+        {}
+    };
+    struct Track{
+        std::string name;
+        size_t events = 0;  //  # of runs in the ring buffer.
+        bool alive = true;  //  The pivot still exists.
+    };
+    struct TraceEvent{
+        size_t label;
+        uint64_t track;
+        WallClock start;
+        WallDuration wall_time;
+        WallDuration cpu_time;
+        WallDuration snapshot_age;
+        WallDuration queue_delay;
+    };
+
+    mutable SpinLock m_lock;
+
+    std::map<std::string, Histograms> m_histograms;
+    std::vector<std::string> m_labels;
+
+    uint64_t m_next_pivot_id = 0;
+    std::map<uint64_t, Track> m_tracks;
+
+    //  Ring buffer of the most recent runs.
+    std::vector<TraceEvent> m_trace;
+    size_t m_trace_next = 0;
+};
+
+
+
+//  Times a single run of a callback. Does nothing if the profiler is disabled.
+class InferenceProfileTimer{
+public:
+    InferenceProfileTimer();
+
+    void report(
+        uint64_t pivot_id,
+        const std::string& label,
+        WallClock start, WallClock end,
+        WallDuration snapshot_age, WallDuration queue_delay
+    ) noexcept;
+
+private:
+    bool m_enabled;
+    ThreadHandle m_thread;
+    WallDuration m_cpu_start;
+};
+
+
+
+}
+#endif
@@ -6,6 +6,8 @@
 
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "InferenceBudget.h"
+#include "InferenceProfiler.h"
 #include "VisualInferencePivot.h"
 
 #include <iostream>
@@ -40,21 +42,26 @@ struct VisualInferencePivot::PeriodicCallback{
 
 
 
-VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher)
-    : PeriodicRunner(dispatcher)
+VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, PeriodicExecutor& executor)
+    : PeriodicRunner(executor)
     , m_feed(feed)
+    , m_profile_id(InferenceProfiler::instance().add_pivot("Video"))
 {
     attach(scope);
+    InferenceBudget::instance().add_pivot(*this);
 }
 VisualInferencePivot::~VisualInferencePivot(){
+    InferenceBudget::instance().remove_pivot(*this);
     detach();
     stop_thread();
+    InferenceProfiler::instance().remove_pivot(m_profile_id);
 }
 void VisualInferencePivot::add_callback(
     Cancellable& scope,
     std::atomic<InferenceCallback*>* set_when_triggered,
     VisualInferenceCallback& callback,
-    std::chrono::milliseconds period
+    std::chrono::milliseconds period,
+    InferencePriority priority
 ){
     WriteSpinLock lg(m_lock);
     auto iter = m_map.find(&callback);
@@ -67,7 +74,10 @@ void VisualInferencePivot::add_callback(
         std::forward_as_tuple(scope, set_when_triggered, callback, period)
     ).first;
     try{
-        PeriodicRunner::add_event(&iter->second, period);
+        PeriodicRunner::add_event(
+            &iter->second, period, current_steady_time(),
+            priority != InferencePriority::CRITICAL
+        );
     }catch (...){
         m_map.erase(iter);
         throw;
@@ -86,6 +96,7 @@ StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback
 }
 void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
+    InferenceBudget::instance().update();
     try{
         //  Reuse the cached screenshot.
         if (!is_back_to_back || callback.last_timestamp == m_last.timestamp){
@@ -104,11 +115,16 @@ void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
             return;
         }
 
+        InferenceProfileTimer profile;
         WallClock time0 = current_time();
         bool stop = callback.callback.process_frame(m_last);
         WallClock time1 = current_time();
         callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
         callback.last_timestamp = m_last.timestamp;
+        profile.report(
+            m_profile_id, callback.callback.label(),
+            time0, time1, time0 - m_last.timestamp, queue_delay()
+        );
 
         if (stop){
             if (callback.set_when_triggered){
@@ -124,7 +140,20 @@ void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
 
 
 OverlayStatSnapshot VisualInferencePivot::get_current(){
-    return m_printer.get_snapshot("Video Pivot Utilization:", this->current_utilization());
+    OverlayStatSnapshot snapshot = m_printer.get_snapshot("Video Pivot Utilization:", this->current_utilization());
+    if (snapshot.text.empty()){
+        return snapshot;
+    }
+    uint64_t misses = this->deadline_misses();
+    if (misses != 0){
+        snapshot.text += " (late: " + std::to_string(misses) + ")";
+    }
+    size_t throttle = this->throttle();
+    if (throttle > 1){
+        snapshot.text += " (throttled x" + std::to_string(throttle) + ")";
+        snapshot.color = COLOR_ORANGE;
+    }
+    return snapshot;
 }
 
 
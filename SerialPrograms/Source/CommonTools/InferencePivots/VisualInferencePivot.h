@@ -22,7 +22,7 @@ class VideoFeed;
 
 class VisualInferencePivot final : public PeriodicRunner, public OverlayStat{
 public:
-    VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher);
+    VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, PeriodicExecutor& executor);
     virtual ~VisualInferencePivot();
 
     //  If this callback returns true:
@@ -33,7 +33,8 @@ public:
         Cancellable& scope,
         std::atomic<InferenceCallback*>* set_when_triggered,
         VisualInferenceCallback& callback,
-        std::chrono::milliseconds period
+        std::chrono::milliseconds period,
+        InferencePriority priority = InferencePriority::NORMAL
     );
 
     //  Returns the latency stats for the callback. Units are microseconds.
@@ -47,6 +48,7 @@ private:
     struct PeriodicCallback;
 
     VideoFeed& m_feed;
+    uint64_t m_profile_id;
     SpinLock m_lock;
     std::map<VisualInferenceCallback*, PeriodicCallback> m_map;
     VideoSnapshot m_last;
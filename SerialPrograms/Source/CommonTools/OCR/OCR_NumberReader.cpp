@@ -222,7 +222,7 @@ int read_number_waterfill_multifilter(
 
     SpinLock lock;
     std::map<int, uint8_t> candidates;
-    GlobalThreadPools::normal_inference().run_in_parallel(
+    GlobalThreadPools::normal_inference().parallel_for(
         [&](size_t index){
             std::pair<uint32_t, uint32_t> filter = filters[index];
 
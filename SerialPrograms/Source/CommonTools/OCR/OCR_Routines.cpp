@@ -38,7 +38,7 @@ StringMatchResult multifiltered_OCR(
     //  Run all the filters.
     SpinLock lock;
     StringMatchResult ret;
-    GlobalThreadPools::normal_inference().run_in_parallel(
+    GlobalThreadPools::normal_inference().parallel_for(
         [&](size_t index){
             const std::pair<ImageRGB32, size_t>& filtered = filtered_images[index];
 
@@ -10,6 +10,7 @@
 #include "Common/Compiler.h"
 #include "Common/Cpp/AbstractLogger.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/JitterHistogram.h"
 #include "Controllers/KeyboardInput/KeyboardEventHandler.h"
 #include "Common/Cpp/CancellableScope.h"
 
@@ -94,6 +95,13 @@ public:
 
     virtual bool is_ready() const = 0;
 
+    //  For controllers that time state changes on the host, how late each
+    //  state change was sent compared to when it was scheduled. Controllers
+    //  that leave the timing to the device return an empty histogram.
+    virtual JitterHistogramSnapshot state_change_jitter() const{
+        return JitterHistogramSnapshot();
+    }
+
 
 public:
     //
@@ -124,6 +124,13 @@ ControllerConnection& ControllerSession::connection() const{
 AbstractController* ControllerSession::controller() const{
     return m_controller.get();
 }
+JitterHistogramSnapshot ControllerSession::state_change_jitter() const{
+    ReadSpinLock lg(m_state_lock);
+    if (!m_controller){
+        return JitterHistogramSnapshot();
+    }
+    return m_controller->state_change_jitter();
+}
 
 
 
@@ -65,6 +65,8 @@ public:
     ControllerConnection& connection() const;
     AbstractController* controller() const;
 
+    JitterHistogramSnapshot state_change_jitter() const;
+
 
 public:
     //  Empty String: User input is allowed.
@@ -24,6 +24,7 @@ public:
     ControllerWithScheduler(Logger& logger)
         : m_logger(logger)
         , m_scheduler(logger, Milliseconds(4))
+        , m_accumulate_schedule(false)
     {}
 
     RecursiveThrottler& logging_throttler(){
@@ -35,8 +36,8 @@ public:
     //  Superscalar Commands (the "ssf" framework)
 
     void issue_barrier(const Cancellable* cancellable){
-        SuperscalarScheduler::Schedule schedule;
         std::lock_guard<std::mutex> lg0(m_issue_lock);
+        SuperscalarScheduler::Schedule& schedule = reset_schedule();
         {
             std::lock_guard<std::mutex> lg1(m_state_lock);
             m_scheduler.issue_wait_for_all(schedule);
@@ -47,8 +48,8 @@ public:
         }
     }
     void issue_nop(const Cancellable* cancellable, Milliseconds duration){
-        SuperscalarScheduler::Schedule schedule;
         std::lock_guard<std::mutex> lg0(m_issue_lock);
+        SuperscalarScheduler::Schedule& schedule = reset_schedule();
         {
             std::lock_guard<std::mutex> lg1(m_state_lock);
             if (cancellable){
@@ -65,8 +66,39 @@ public:
         }
     }
 
+    //  Replay a schedule that was compiled ahead of time.
+    //  The pipeline is drained before the replay starts.
+    void issue_compiled(const Cancellable* cancellable, const SuperscalarScheduler::Schedule& compiled){
+        std::lock_guard<std::mutex> lg0(m_issue_lock);
+        SuperscalarScheduler::Schedule& schedule = reset_schedule();
+        {
+            std::lock_guard<std::mutex> lg1(m_state_lock);
+            if (cancellable){
+                cancellable->throw_if_cancelled();
+            }
+            m_scheduler.issue_precompiled(schedule, compiled);
+        }
+        execute_schedule(cancellable, schedule);
+        execute_schedule(cancellable, compiled);
+        if (m_logging_throttler){
+            m_logger.log(
+                "issue_compiled(): states = " + std::to_string(compiled.size()),
+                COLOR_DARKGREEN
+            );
+        }
+    }
+
 
 protected:
+    //  Returns the reusable schedule buffer for the next issue.
+    //  Must be called under "m_issue_lock".
+    SuperscalarScheduler::Schedule& reset_schedule(){
+        if (!m_accumulate_schedule){
+            m_schedule.clear();
+        }
+        return m_schedule;
+    }
+
     virtual void execute_state(
         const Cancellable* cancellable,
         const SuperscalarScheduler::ScheduleEntry& entry
@@ -88,6 +120,14 @@ protected:
 
     SuperscalarScheduler m_scheduler;
 
+    //  Protected by "m_issue_lock". This is reused across issues so that
+    //  issuing a command doesn't allocate.
+    SuperscalarScheduler::Schedule m_schedule;
+
+    //  If set, "m_schedule" is never cleared and collects everything that is
+    //  issued. This is used to compile schedules ahead of time.
+    bool m_accumulate_schedule;
+
     //  If you need both of these locks, always acquire "m_issue_lock" first.
 
     //  This lock makes sure that only one command is issued at a time. It can
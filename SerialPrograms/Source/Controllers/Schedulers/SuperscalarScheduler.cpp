@@ -4,7 +4,8 @@
  *
  */
 
-//#include "Common/Cpp/Exceptions.h"
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Time.h"
 #include "SuperscalarScheduler.h"
 
@@ -15,13 +16,25 @@
 namespace PokemonAutomation{
 
 
+WallDuration SuperscalarScheduler::Schedule::total_duration() const{
+    WallDuration ret = WallDuration::zero();
+    for (const ScheduleEntry& entry : *this){
+        ret += entry.duration;
+    }
+    return ret;
+}
+
+
+
 SuperscalarScheduler::SuperscalarScheduler(
     Logger& logger,
     WallDuration flush_threshold
 )
     : m_logger(logger)
     , m_flush_threshold(flush_threshold)
+    , m_live_commands(MAX_RESOURCES)
 {
+    m_live_ids.reserve(MAX_RESOURCES);
     clear();
 }
 
@@ -29,62 +42,98 @@ SuperscalarScheduler::SuperscalarScheduler(
 void SuperscalarScheduler::clear() noexcept{
 //    SpinLockGuard lg(m_lock);
 //    m_logger.log("Clearing schedule...");
-    WallClock now = current_time();
+    SteadyClock now = current_steady_time();
     m_local_start = now;
     m_local_last_activity = now;
     m_device_issue_time = now;
     m_device_sent_time = now;
     m_max_free_time = now;
     m_state_changes.clear();
-    m_live_commands.clear();
+    m_state_changes_head = 0;
+    for (size_t id : m_live_ids){
+        m_live_commands[id].command.reset();
+    }
+    m_live_ids.clear();
     m_pending_clear = false;
 }
+void SuperscalarScheduler::clear(Schedule& schedule){
+    //  Entries already in "schedule" may still point to live resources.
+    for (size_t id : m_live_ids){
+        schedule.m_retired.emplace_back(std::move(m_live_commands[id].command));
+    }
+    m_live_ids.clear();
+    clear();
+}
 
-SuperscalarScheduler::State SuperscalarScheduler::current_live_commands(){
-    WallClock device_sent_time = m_device_sent_time;
-    State ret;
+void SuperscalarScheduler::current_live_commands(State& state) const{
+    SteadyClock device_sent_time = m_device_sent_time;
 //    cout << "device_sent_time = " << std::chrono::duration_cast<Milliseconds>(device_sent_time - m_local_start).count() << endl;
-    for (auto& item : m_live_commands){
-//        cout << "busy = " << std::chrono::duration_cast<Milliseconds>(item.second.busy_time - m_local_start).count()
-//             << ", done = " << std::chrono::duration_cast<Milliseconds>(item.second.done_time - m_local_start).count() << endl;
-        if (item.second.busy_time <= device_sent_time && device_sent_time < item.second.done_time){
-            ret.emplace_back(item.second.command);
+    for (size_t id : m_live_ids){
+        const Command& command = m_live_commands[id];
+//        cout << "busy = " << std::chrono::duration_cast<Milliseconds>(command.busy_time - m_local_start).count()
+//             << ", done = " << std::chrono::duration_cast<Milliseconds>(command.done_time - m_local_start).count() << endl;
+        if (command.busy_time <= device_sent_time && device_sent_time < command.done_time){
+            state.emplace_back(command.command.get());
         }
     }
-    return ret;
 }
-void SuperscalarScheduler::clear_finished_commands(){
-    WallClock device_sent_time = m_device_sent_time;
-    for (auto iter = m_live_commands.begin(); iter != m_live_commands.end();){
-//        cout << "device_sent_time = " << device_sent_time << ", free_time = " << iter->second.free_time << endl;
-        if (device_sent_time >= iter->second.free_time){
-            iter = m_live_commands.erase(iter);
+void SuperscalarScheduler::clear_finished_commands(Schedule& schedule){
+    SteadyClock device_sent_time = m_device_sent_time;
+    auto out = m_live_ids.begin();
+    for (size_t id : m_live_ids){
+        Command& command = m_live_commands[id];
+//        cout << "device_sent_time = " << device_sent_time << ", free_time = " << command.free_time << endl;
+        if (device_sent_time >= command.free_time){
+            schedule.m_retired.emplace_back(std::move(command.command));
         }else{
-            ++iter;
+            *out++ = id;
         }
     }
+    m_live_ids.erase(out, m_live_ids.end());
+}
+void SuperscalarScheduler::insert_state_change(SteadyClock timestamp){
+    //  Reclaim the consumed prefix once it gets large enough to matter.
+    if (m_state_changes_head >= 64 || m_state_changes_head == m_state_changes.size()){
+        m_state_changes.erase(m_state_changes.begin(), m_state_changes.begin() + m_state_changes_head);
+        m_state_changes_head = 0;
+    }
+
+    //  New timestamps almost always go at or near the end.
+    auto iter = m_state_changes.end();
+    auto begin = m_state_changes.begin() + m_state_changes_head;
+    while (iter != begin && iter[-1] > timestamp){
+        --iter;
+    }
+    if (iter != begin && iter[-1] == timestamp){
+        return;
+    }
+    m_state_changes.insert(iter, timestamp);
+}
+void SuperscalarScheduler::add_live_command(size_t resource_id){
+    auto iter = std::lower_bound(m_live_ids.begin(), m_live_ids.end(), resource_id);
+    if (iter == m_live_ids.end() || *iter != resource_id){
+        m_live_ids.insert(iter, resource_id);
+    }
 }
 bool SuperscalarScheduler::iterate_schedule(Schedule& schedule){
 //    cout << "----------------------------> " << m_state_changes.size() << endl;
 //    cout << "m_device_sent_time = " << std::chrono::duration_cast<Milliseconds>(m_device_sent_time - m_local_start) << endl;
 
-    if (m_state_changes.empty()){
+    if (m_state_changes_head == m_state_changes.size()){
 //        cout << "State is empty." << endl;
         m_device_sent_time = m_device_issue_time;
         return false;
     }
 
-    auto iter = m_state_changes.begin();
+    SteadyClock front = m_state_changes[m_state_changes_head];
 
-    WallClock next_state_change;
-    if (m_device_sent_time < *iter){
-        next_state_change = *iter;
+    SteadyClock next_state_change;
+    if (m_device_sent_time < front){
+        next_state_change = front;
     }else{
-        auto next = iter;
-        ++next;
-        next_state_change = next == m_state_changes.end()
+        next_state_change = m_state_changes_head + 1 == m_state_changes.size()
             ? m_device_issue_time
-            : *next;
+            : m_state_changes[m_state_changes_head + 1];
     }
 
     //  Things get complicated if we overshoot the issue time.
@@ -104,21 +153,19 @@ bool SuperscalarScheduler::iterate_schedule(Schedule& schedule){
     }
 
     //  Compute the resource state at this timestamp.
-    std::vector<std::shared_ptr<const SchedulerResource>> state = current_live_commands();
-    clear_finished_commands();
+    ScheduleEntry& entry = schedule.append();
+    entry.duration = duration;
+    current_live_commands(entry.state);
+    clear_finished_commands(schedule);
 
     m_device_sent_time = next_state_change;
-    if (next_state_change > *iter){
-        m_state_changes.erase(iter);
+    if (next_state_change > front){
+        m_state_changes_head++;
     }
 
-    ScheduleEntry& entry = schedule.emplace_back();
-    entry.duration = duration;
-    entry.state = std::move(state);
-
 //    SpinLockGuard lg(m_lock);
 
-    WallClock now = current_time();
+    SteadyClock now = current_steady_time();
     m_local_last_activity = now;
 
     //  If we are not dangling anything, we can return now.
@@ -167,7 +214,7 @@ void SuperscalarScheduler::process_schedule(Schedule& schedule){
 
 void SuperscalarScheduler::issue_wait_for_all(Schedule& schedule){
     if (m_pending_clear){
-        clear();
+        clear(schedule);
         return;
     }
 //    m_logger.log("issue_wait_for_all(): states = " + std::to_string(m_state_changes.size()), COLOR_DARKGREEN);
@@ -185,23 +232,23 @@ void SuperscalarScheduler::issue_nop(Schedule& schedule, WallDuration delay){
         return;
     }
     if (m_pending_clear){
-        clear();
+        clear(schedule);
     }
 //    cout << "issue_nop(): " << m_state_changes.size() << endl;
 //    cout << "issue_time = " << std::chrono::duration_cast<Milliseconds>((m_device_issue_time - m_local_start)).count()
 //         << ", sent_time = " << std::chrono::duration_cast<Milliseconds>((m_device_sent_time - m_local_start)).count()
 //         << ", max_free_time = " << std::chrono::duration_cast<Milliseconds>((m_max_free_time - m_local_start)).count()
 //         << endl;
-    WallClock next_issue_time = m_device_issue_time + delay;
-    m_state_changes.insert(next_issue_time);
+    SteadyClock next_issue_time = m_device_issue_time + delay;
+    insert_state_change(next_issue_time);
     m_device_issue_time = next_issue_time;
     m_max_free_time = std::max(m_max_free_time, m_device_issue_time);
-    m_local_last_activity = current_time();
+    m_local_last_activity = current_steady_time();
     process_schedule(schedule);
 }
 void SuperscalarScheduler::issue_wait_for_resource(Schedule& schedule, size_t resource_id){
     if (m_pending_clear){
-        clear();
+        clear(schedule);
         return;
     }
 //    cout << "wait_for_resource()" << endl;
@@ -211,31 +258,45 @@ void SuperscalarScheduler::issue_wait_for_resource(Schedule& schedule, size_t re
 //         << endl;
 
     //  Resource is not ready yet. Stall until it is.
-    auto iter = m_live_commands.find(resource_id);
-    if (iter != m_live_commands.end() && m_device_sent_time < iter->second.free_time){
-        m_device_issue_time = iter->second.free_time;
-        m_local_last_activity = current_time();
+    SteadyClock free_time = busy_until(resource_id);
+    if (m_device_sent_time < free_time){
+        m_device_issue_time = free_time;
+        m_local_last_activity = current_steady_time();
     }
 
     process_schedule(schedule);
 }
 void SuperscalarScheduler::issue_to_resource(
     Schedule& schedule,
-    std::shared_ptr<const SchedulerResource> resource,
+    std::unique_ptr<const SchedulerResource> resource,
     WallDuration delay, WallDuration hold, WallDuration cooldown
 ){
     if (m_pending_clear){
-        clear();
+        clear(schedule);
+    }
+
+    size_t id = resource->id;
+    if (id >= MAX_RESOURCES){
+        throw InternalProgramError(
+            &m_logger, PA_CURRENT_FUNCTION,
+            "Resource ID is out of range: " + std::to_string(id)
+        );
     }
+    Command& command = m_live_commands[id];
 
     //  Resource is busy. Stall until it is free.
-    auto ret = m_live_commands.try_emplace(resource->id);
-    if (!ret.second){
-//        cout << m_device_sent_time << " : " << ret.first->second.free_time << endl;
-        m_device_issue_time = std::max(m_device_issue_time, ret.first->second.free_time);
+    if (command.command){
+//        cout << m_device_sent_time << " : " << command.free_time << endl;
+        m_device_issue_time = std::max(m_device_issue_time, command.free_time);
         process_schedule(schedule);
     }
-    Command& command = ret.first->second;
+
+    //  The stall may or may not have retired the previous command.
+    if (command.command){
+        schedule.m_retired.emplace_back(std::move(command.command));
+    }else{
+        add_live_command(id);
+    }
 
     delay    = std::max(delay, WallDuration::zero());
     hold     = std::max(hold, WallDuration::zero());
@@ -251,11 +312,11 @@ void SuperscalarScheduler::issue_to_resource(
          << endl;
 #endif
 
-    WallClock release_time = m_device_issue_time + hold;
-    WallClock free_time = release_time + cooldown;
+    SteadyClock release_time = m_device_issue_time + hold;
+    SteadyClock free_time = release_time + cooldown;
 
-    m_state_changes.insert(m_device_issue_time);
-    m_state_changes.insert(release_time);
+    insert_state_change(m_device_issue_time);
+    insert_state_change(release_time);
 
     command.command = std::move(resource);
     command.busy_time = m_device_issue_time;
@@ -265,13 +326,35 @@ void SuperscalarScheduler::issue_to_resource(
     m_device_issue_time += delay;
     m_max_free_time = std::max(m_max_free_time, free_time);
     m_max_free_time = std::max(m_max_free_time, m_device_issue_time);
-    m_local_last_activity = current_time();
+    m_local_last_activity = current_steady_time();
 
     process_schedule(schedule);
 }
 
 
 
+void SuperscalarScheduler::issue_finalize(Schedule& schedule){
+    issue_wait_for_all(schedule);
+    clear(schedule);
+}
+void SuperscalarScheduler::issue_precompiled(Schedule& schedule, const Schedule& compiled){
+    //  Compiled schedules start from an idle pipeline.
+    issue_wait_for_all(schedule);
+
+    WallDuration duration = compiled.total_duration();
+    m_device_issue_time += duration;
+    m_device_sent_time = m_device_issue_time;
+    m_max_free_time = m_device_issue_time;
+    m_local_last_activity = current_steady_time();
+
+    //  Everything pending is now in the past.
+    m_state_changes.clear();
+    m_state_changes_head = 0;
+    clear_finished_commands(schedule);
+}
+
+
+
 
 
 
@@ -8,8 +8,7 @@
 #define PokemonAutomation_Controllers_SuperscalarScheduler_H
 
 #include <memory>
-#include <set>
-#include <map>
+#include <vector>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/AbstractLogger.h"
@@ -39,12 +38,60 @@ public:
 
 class SuperscalarScheduler{
 public:
-    using State = std::vector<std::shared_ptr<const SchedulerResource>>;
+    //  Resource ids must be less than this.
+    static constexpr size_t MAX_RESOURCES = 256;
+
+    using State = std::vector<const SchedulerResource*>;
     struct ScheduleEntry{
         WallDuration duration;
         State state;
     };
-    using Schedule = std::vector<ScheduleEntry>;
+
+    //  The output of the scheduler. The resources in "state" are kept alive by
+    //  either the scheduler or the schedule itself until the schedule is
+    //  cleared or destroyed.
+    //
+    //  Clearing a schedule keeps its buffers so it can be reused for the next
+    //  issue without allocating.
+    class Schedule{
+    public:
+        Schedule() = default;
+        Schedule(Schedule&&) = default;
+        Schedule& operator=(Schedule&&) = default;
+
+        bool empty() const{ return m_size == 0; }
+        size_t size() const{ return m_size; }
+        const ScheduleEntry& operator[](size_t index) const{ return m_entries[index]; }
+        const ScheduleEntry* begin() const{ return m_entries.data(); }
+        const ScheduleEntry* end() const{ return m_entries.data() + m_size; }
+
+        WallDuration total_duration() const;
+
+        void clear(){
+            m_size = 0;
+            m_retired.clear();
+        }
+
+    private:
+        friend class SuperscalarScheduler;
+
+        ScheduleEntry& append(){
+            if (m_size == m_entries.size()){
+                m_entries.emplace_back();
+            }
+            ScheduleEntry& entry = m_entries[m_size++];
+            entry.state.clear();
+            return entry;
+        }
+
+    private:
+        std::vector<ScheduleEntry> m_entries;
+        size_t m_size = 0;
+
+        //  Resources the scheduler is done with, but are still referenced by
+        //  the entries.
+        std::vector<std::unique_ptr<const SchedulerResource>> m_retired;
+    };
 
 public:
     SuperscalarScheduler(Logger& logger, WallDuration flush_threshold);
@@ -63,11 +110,10 @@ public:
     //  These are not thread-safe with each other.
     //
 
-    WallClock busy_until(size_t resource_id) const{
-        auto iter = m_live_commands.find(resource_id);
-        return iter != m_live_commands.end()
-            ? iter->second.free_time
-            : WallClock::min();
+    SteadyClock busy_until(size_t resource_id) const{
+        return resource_id < MAX_RESOURCES && m_live_commands[resource_id].command
+            ? m_live_commands[resource_id].free_time
+            : SteadyClock::min();
     }
 
     //  Wait until the pipeline has completely cleared and all resources have
@@ -85,15 +131,35 @@ public:
     //  Issue a resource with the specified timing parameters.
     void issue_to_resource(
         Schedule& schedule,
-        std::shared_ptr<const SchedulerResource> resource,
+        std::unique_ptr<const SchedulerResource> resource,
         WallDuration delay, WallDuration hold, WallDuration cooldown
     );
 
 
+public:
+    //  Precompiled Schedules
+    //
+    //  A schedule that is built once by issuing to a separate scheduler and
+    //  then finalized can be replayed any number of times.
+    //
+
+    //  Wait for everything to finish and hand over all remaining resources to
+    //  "schedule". The result is self-contained and the scheduler is reset.
+    void issue_finalize(Schedule& schedule);
+
+    //  Drain the pipeline into "schedule" and then advance the timeline past
+    //  "compiled" as if it had been issued here. The caller must execute
+    //  "schedule" followed by "compiled".
+    void issue_precompiled(Schedule& schedule, const Schedule& compiled);
+
+
 private:
     void clear() noexcept;
-    State current_live_commands();
-    void clear_finished_commands();
+    void clear(Schedule& schedule);
+    void current_live_commands(State& state) const;
+    void clear_finished_commands(Schedule& schedule);
+    void insert_state_change(SteadyClock timestamp);
+    void add_live_command(size_t resource_id);
     bool iterate_schedule(Schedule& schedule);
     void process_schedule(Schedule& schedule);
 
@@ -109,32 +175,39 @@ private:
 
     //  The construction time of this object. This is only used for debugging
     //  purposes since it lets you print wall times relative to this.
-    WallClock m_local_start;
+    SteadyClock m_local_start;
 
     //  Wall clock of the last time "m_device_issue_time" was last updated.
     //  This is used to decide when to gap the timeline.
-    WallClock m_local_last_activity;
+    SteadyClock m_local_last_activity;
 
     //  The current timestamp of what has been issued to the scheduler.
-    WallClock m_device_issue_time;
+    SteadyClock m_device_issue_time;
 
     //  The current timestamp of what has been sent to the device.
-    WallClock m_device_sent_time;
+    SteadyClock m_device_sent_time;
 
     //  Maximum of: m_live_commands[]->second.free_time
-    WallClock m_max_free_time;
+    SteadyClock m_max_free_time;
 
-    //  A set of all the scheduled state changes that will happen. Between
-    //  timestamps in this set, the state is constant.
-    std::set<WallClock> m_state_changes;
+    //  A sorted list of all the scheduled state changes that will happen.
+    //  Between these timestamps, the state is constant. Everything before
+    //  "m_state_changes_head" has already been consumed.
+    std::vector<SteadyClock> m_state_changes;
+    size_t m_state_changes_head;
 
     struct Command{
-        std::shared_ptr<const SchedulerResource> command;
-        WallClock busy_time;    //  Timestamp of when resource will be become busy.
-        WallClock done_time;    //  Timestamp of when resource will be done being busy.
-        WallClock free_time;    //  Timestamp of when resource can be used again.
+        std::unique_ptr<const SchedulerResource> command;
+        SteadyClock busy_time;    //  Timestamp of when resource will be become busy.
+        SteadyClock done_time;    //  Timestamp of when resource will be done being busy.
+        SteadyClock free_time;    //  Timestamp of when resource can be used again.
     };
-    std::map<size_t, Command> m_live_commands;
+
+    //  Indexed by resource id. A slot is live if "command" is set.
+    std::vector<Command> m_live_commands;
+
+    //  Ids of the live slots in sorted order.
+    std::vector<size_t> m_live_ids;
 };
 
 
@@ -257,7 +257,7 @@ void PABotBase::clear_all_active_commands(uint64_t seqnum){
                 PendingRequest& handle = ret.first->second;
                 handle.silent_remove = true;
                 handle.request = std::move(message);
-                handle.first_sent = current_time();
+                handle.first_sent = current_steady_time();
             }
         }
 
@@ -547,9 +547,9 @@ void PABotBase::retransmit_thread(){
     auto scope_check = m_sanitizer.check_scope();
 
 //    cout << "retransmit_thread()" << endl;
-    auto last_sent = current_time();
+    auto last_sent = current_steady_time();
     while (m_state.load(std::memory_order_acquire) == State::RUNNING){
-        auto now = current_time();
+        auto now = current_steady_time();
 
         if (now - last_sent < m_retransmit_delay){
             std::unique_lock<std::mutex> lg(m_sleep_lock);
@@ -576,7 +576,7 @@ void PABotBase::retransmit_thread(){
         //  Gather together all requests/commands. Sort them by seqnum and
         //  resend everything.
 
-        WallClock oldest = last_sent;
+        SteadyClock oldest = last_sent;
 
         std::map<uint64_t, const BotBaseMessage*> messages;
         for (auto& item : m_pending_requests){
@@ -604,7 +604,7 @@ void PABotBase::retransmit_thread(){
         for (auto& item : m_pending_requests){
             item.second.sanitizer.check_usage();
             if (item.second.state == AckState::NOT_ACKED &&
-                current_time() - item.second.first_sent >= m_retransmit_delay
+                current_steady_time() - item.second.first_sent >= m_retransmit_delay
             ){
                 send_message(item.second.request, true);
             }
@@ -612,14 +612,14 @@ void PABotBase::retransmit_thread(){
         for (auto& item : m_pending_commands){
             item.second.sanitizer.check_usage();
             if (item.second.state == AckState::NOT_ACKED &&
-                current_time() - item.second.first_sent >= m_retransmit_delay
+                current_steady_time() - item.second.first_sent >= m_retransmit_delay
             ){
                 send_message(item.second.request, true);
             }
         }
 #endif
 
-        last_sent = current_time();
+        last_sent = current_steady_time();
     }
 //    cout << "retransmit_thread() - exit" << endl;
 }
@@ -693,7 +693,7 @@ uint64_t PABotBase::try_issue_request(
 
     handle.silent_remove = silent_remove;
     handle.request = std::move(message);
-    handle.first_sent = current_time();
+    handle.first_sent = current_steady_time();
 
 #ifdef INTENTIONALLY_DROP_MESSAGES
     if (rand() % 10 != 0){
@@ -773,7 +773,7 @@ uint64_t PABotBase::try_issue_command(
 
     handle.silent_remove = silent_remove;
     handle.request = std::move(message);
-    handle.first_sent = current_time();
+    handle.first_sent = current_steady_time();
 
 #ifdef INTENTIONALLY_DROP_MESSAGES
     if (rand() % 10 != 0){
@@ -102,7 +102,7 @@ private:
         bool silent_remove;
         BotBaseMessage request;
         BotBaseMessage ack;
-        WallClock first_sent;
+        SteadyClock first_sent;
         LifetimeSanitizer sanitizer;
     };
     struct PendingCommand{
@@ -110,7 +110,7 @@ private:
         bool silent_remove;
         BotBaseMessage request;
         BotBaseMessage ack;
-        WallClock first_sent;
+        SteadyClock first_sent;
         LifetimeSanitizer sanitizer;
     };
 
@@ -0,0 +1,546 @@
+/*  PABotBase Emulator
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include "Common/CRC32.h"
+#include "Common/Cpp/PanicDump.h"
+#include "Common/SerialPABotBase/SerialPABotBase_Messages_HID_Keyboard.h"
+#include "Common/SerialPABotBase/SerialPABotBase_Messages_NS1_WirelessControllers.h"
+#include "Common/SerialPABotBase/SerialPABotBase_Messages_NS2_WiredController.h"
+#include "PABotBaseEmulator.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+std::string PABotBaseEmulatorStats::to_str() const{
+    std::string str;
+    str += "Packets (recv/sent/lost): " + std::to_string(packets_received);
+    str += " / " + std::to_string(packets_sent);
+    str += " / " + std::to_string(packets_lost);
+    str += ", Checksum Errors: " + std::to_string(checksum_errors);
+    str += ", Duplicates: " + std::to_string(duplicates);
+    str += ", Out of Order: " + std::to_string(out_of_order);
+    str += "\nCommands (executed/dropped): " + std::to_string(commands_executed);
+    str += " / " + std::to_string(commands_dropped);
+    str += ", Max Queue Depth: " + std::to_string(max_queue_depth);
+    str += ", Finish Retransmits: " + std::to_string(finish_retransmits);
+    str += ", Busy: " + std::to_string(std::chrono::duration_cast<Milliseconds>(busy_time).count()) + " ms";
+    return str;
+}
+
+
+
+//  Returns the duration of a command or false if the message is not a command
+//  the emulator knows about.
+static bool command_duration(uint8_t type, const char* body, size_t bytes, uint32_t& milliseconds){
+    switch (type){
+    case PABB_MSG_COMMAND_HID_KEYBOARD_STATE:
+    case PABB_MSG_COMMAND_NS1_WIRELESS_CONTROLLER_BUTTONS:
+    case PABB_MSG_COMMAND_NS1_WIRELESS_CONTROLLER_FULL_STATE:
+    case PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE:{
+        //  All single-state commands start with the seqnum followed by the
+        //  duration in milliseconds.
+        uint16_t ms;
+        if (bytes < sizeof(seqnum_t) + sizeof(ms)){
+            return false;
+        }
+        memcpy(&ms, body + sizeof(seqnum_t), sizeof(ms));
+        milliseconds = ms;
+        return true;
+    }
+    case PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE_BATCH:{
+        using Header = SerialPABotBase::pabb_Message_Command_NS2_WiredController_StateBatch_Header;
+        if (bytes < sizeof(Header)){
+            return false;
+        }
+        Header header;
+        memcpy(&header, body, sizeof(Header));
+
+        milliseconds = 0;
+        size_t index = sizeof(Header);
+        for (uint8_t c = 0; c < header.count; c++){
+            uint16_t ms;
+            if (index + sizeof(ms) + 1 > bytes){
+                return false;
+            }
+            memcpy(&ms, body + index, sizeof(ms));
+            uint8_t changed = (uint8_t)body[index + sizeof(ms)];
+            index += sizeof(ms) + 1;
+            for (; changed != 0; changed &= changed - 1){
+                index++;
+            }
+            milliseconds += ms;
+        }
+        return index <= bytes;
+    }
+    default:
+        return false;
+    }
+}
+
+
+
+PABotBaseEmulator::PABotBaseEmulator(Logger& logger, PABotBaseEmulatorConfig config)
+    : m_logger(logger)
+    , m_config(std::move(config))
+    , m_start(current_time())
+    , m_stopping(false)
+    , m_random(m_config.random_seed)
+    , m_link_free{m_start, m_start}
+    , m_last_arrival{m_start, m_start}
+    , m_expected_seqnum(0)
+    , m_device_seqnum(1)
+    , m_controller_id(m_config.controller_id)
+    , m_interrupt_on_next(false)
+{
+    m_thread = std::thread(
+        run_with_catch,
+        "PABotBaseEmulator::thread_loop()",
+        [this]{ thread_loop(); }
+    );
+}
+PABotBaseEmulator::~PABotBaseEmulator(){
+    stop();
+}
+void PABotBaseEmulator::stop(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    if (m_thread.joinable()){
+        m_thread.join();
+    }
+}
+PABotBaseEmulatorStats PABotBaseEmulator::stats() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_stats;
+}
+
+void PABotBaseEmulator::send(const void* data, size_t bytes){
+    std::lock_guard<std::mutex> lg(m_lock);
+    transmit(false, std::string((const char*)data, bytes));
+}
+
+
+
+void PABotBaseEmulator::transmit(bool to_host, std::string bytes){
+    WallClock now = current_time();
+
+    //  The wire is busy for the same time whether or not the packet survives.
+    WallClock& link_free = m_link_free[to_host];
+    WallClock start = std::max(now, link_free);
+    if (m_config.baud_rate != 0){
+        //  8N1: 10 bits per byte.
+        start += std::chrono::duration_cast<WallDuration>(
+            std::chrono::microseconds((uint64_t)bytes.size() * 10'000'000 / m_config.baud_rate)
+        );
+    }
+    link_free = start;
+
+    if (m_config.loss_rate > 0 &&
+        std::uniform_real_distribution<double>(0, 1)(m_random) < m_config.loss_rate
+    ){
+        m_stats.packets_lost++;
+        return;
+    }
+
+    WallClock arrival = start + m_config.latency;
+    if (m_config.jitter > Milliseconds::zero()){
+        arrival += std::chrono::duration_cast<WallDuration>(std::chrono::microseconds(
+            std::uniform_int_distribution<int64_t>(
+                0, std::chrono::duration_cast<std::chrono::microseconds>(m_config.jitter).count()
+            )(m_random)
+        ));
+    }
+
+    //  Serial links don't reorder.
+    arrival = std::max(arrival, m_last_arrival[to_host]);
+    m_last_arrival[to_host] = arrival;
+
+    m_link.emplace(arrival, Packet{to_host, std::move(bytes)});
+    m_cv.notify_all();
+}
+std::string PABotBaseEmulator::frame_message(uint8_t type, const void* body, size_t bytes){
+    size_t total_bytes = PABB_PROTOCOL_OVERHEAD + bytes;
+    std::string buffer;
+    buffer += (char)~(uint8_t)total_bytes;
+    buffer += (char)type;
+    buffer.append((const char*)body, bytes);
+    buffer += std::string(sizeof(uint32_t), 0);
+    pabb_crc32_write_to_message(&buffer[0], buffer.size());
+    return buffer;
+}
+void PABotBaseEmulator::send_to_host(uint8_t type, const void* body, size_t bytes){
+    m_stats.packets_sent++;
+    transmit(true, frame_message(type, body, bytes));
+}
+
+
+
+void PABotBaseEmulator::process_bytes(const std::string& bytes){
+    m_recv_buffer += bytes;
+
+    size_t index = 0;
+    while (index < m_recv_buffer.size()){
+        const char* ptr = m_recv_buffer.data() + index;
+        size_t available = m_recv_buffer.size() - index;
+
+        if (ptr[0] == 0){
+            index++;
+            continue;
+        }
+
+        uint8_t length = ~(uint8_t)ptr[0];
+        if (length < PABB_PROTOCOL_OVERHEAD || length > PABB_PROTOCOL_MAX_PACKET_SIZE){
+            index++;
+            continue;
+        }
+        if (length > available){
+            break;
+        }
+
+        uint32_t checksumA = pabb_crc32(0xffffffff, ptr, length - sizeof(uint32_t));
+        uint32_t checksumE;
+        memcpy(&checksumE, ptr + length - sizeof(uint32_t), sizeof(uint32_t));
+        if (checksumA != checksumE){
+            m_stats.checksum_errors++;
+            index++;
+            continue;
+        }
+
+        process_message((uint8_t)ptr[1], ptr + 2, length - PABB_PROTOCOL_OVERHEAD);
+        index += length;
+    }
+
+    m_recv_buffer.erase(0, index);
+}
+void PABotBaseEmulator::process_message(uint8_t type, const char* body, size_t bytes){
+    m_stats.packets_received++;
+
+    //  Host is acking one of our command finishes.
+    if (type == PABB_MSG_ACK_REQUEST){
+        pabb_MsgAckRequest ack;
+        if (bytes != sizeof(ack)){
+            return;
+        }
+        memcpy(&ack, body, sizeof(ack));
+        m_unacked_finishes.erase(ack.seqnum);
+        return;
+    }
+
+    if (!PABB_MSG_IS_REQUEST_OR_COMMAND(type)){
+        return;
+    }
+    seqnum_t seqnum;
+    if (bytes < sizeof(seqnum)){
+        pabb_MsgInfoInvalidMessage params;
+        params.message_length = (uint8_t)(PABB_PROTOCOL_OVERHEAD + bytes);
+        send_to_host(PABB_MSG_ERROR_INVALID_MESSAGE, params);
+        return;
+    }
+    memcpy(&seqnum, body, sizeof(seqnum));
+
+    if (type == PABB_MSG_SEQNUM_RESET){
+        m_expected_seqnum = seqnum + 1;
+        m_commands.clear();
+        m_unacked_finishes.clear();
+        m_interrupt_on_next = false;
+        pabb_MsgAckRequest ack;
+        ack.seqnum = seqnum;
+        send_to_host(PABB_MSG_ACK_REQUEST, ack);
+        return;
+    }
+
+    int32_t gap = (int32_t)(seqnum - m_expected_seqnum);
+
+    //  Ahead of what we expect. Something before it was lost.
+    if (gap > 0){
+        m_stats.out_of_order++;
+        return;
+    }
+
+    //  Retransmit of something we already processed. Ack it again.
+    if (gap < 0){
+        m_stats.duplicates++;
+        if (PABB_MSG_IS_COMMAND(type)){
+            pabb_MsgAckCommand ack;
+            ack.seqnum = seqnum;
+            send_to_host(PABB_MSG_ACK_COMMAND, ack);
+        }else{
+            process_request(type, seqnum, body, bytes, false);
+        }
+        return;
+    }
+
+    if (PABB_MSG_IS_COMMAND(type)){
+        if (process_command(type, seqnum, body, bytes)){
+            m_expected_seqnum++;
+        }
+    }else{
+        process_request(type, seqnum, body, bytes, true);
+        m_expected_seqnum++;
+    }
+}
+void PABotBaseEmulator::process_request(
+    uint8_t type, seqnum_t seqnum,
+    const char* body, size_t bytes,
+    bool first_time
+){
+    switch (type){
+    case PABB_MSG_REQUEST_PROTOCOL_VERSION:{
+        pabb_MsgAckRequestI32 ack;
+        ack.seqnum = seqnum;
+        ack.data = m_config.protocol_version;
+        send_to_host(PABB_MSG_ACK_REQUEST_I32, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_PROGRAM_VERSION:{
+        pabb_MsgAckRequestI32 ack;
+        ack.seqnum = seqnum;
+        ack.data = m_config.program_version;
+        send_to_host(PABB_MSG_ACK_REQUEST_I32, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_PROGRAM_ID:{
+        pabb_MsgAckRequestI8 ack;
+        ack.seqnum = seqnum;
+        ack.data = m_config.program_id;
+        send_to_host(PABB_MSG_ACK_REQUEST_I8, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_PROGRAM_NAME:{
+        std::string response((const char*)&seqnum, sizeof(seqnum));
+        response += m_config.program_name.substr(
+            0, PABB_PROTOCOL_MAX_PACKET_SIZE - PABB_PROTOCOL_OVERHEAD - sizeof(seqnum)
+        );
+        send_to_host(PABB_MSG_ACK_REQUEST_DATA, response.data(), response.size());
+        return;
+    }
+    case PABB_MSG_REQUEST_CONTROLLER_LIST:{
+        std::string response((const char*)&seqnum, sizeof(seqnum));
+        for (uint32_t id : m_config.controller_list){
+            if (response.size() + sizeof(id) > PABB_PROTOCOL_MAX_PACKET_SIZE - PABB_PROTOCOL_OVERHEAD){
+                break;
+            }
+            response.append((const char*)&id, sizeof(id));
+        }
+        send_to_host(PABB_MSG_ACK_REQUEST_DATA, response.data(), response.size());
+        return;
+    }
+    case PABB_MSG_REQUEST_QUEUE_SIZE:{
+        pabb_MsgAckRequestI8 ack;
+        ack.seqnum = seqnum;
+        ack.data = m_config.queue_size;
+        send_to_host(PABB_MSG_ACK_REQUEST_I8, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_READ_CONTROLLER_MODE:{
+        pabb_MsgAckRequestI32 ack;
+        ack.seqnum = seqnum;
+        ack.data = m_controller_id;
+        send_to_host(PABB_MSG_ACK_REQUEST_I32, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_CHANGE_CONTROLLER_MODE:
+    case PABB_MSG_REQUEST_RESET_TO_CONTROLLER:{
+        pabb_MsgRequestChangeControllerMode params;
+        if (bytes != sizeof(params)){
+            break;
+        }
+        memcpy(&params, body, sizeof(params));
+        if (first_time){
+            m_controller_id = params.controller_id;
+        }
+        pabb_MsgAckRequestI32 ack;
+        ack.seqnum = seqnum;
+        ack.data = m_controller_id;
+        send_to_host(PABB_MSG_ACK_REQUEST_I32, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_STOP:{
+        if (first_time){
+            m_commands.clear();
+            m_interrupt_on_next = false;
+        }
+        pabb_MsgAckRequest ack;
+        ack.seqnum = seqnum;
+        send_to_host(PABB_MSG_ACK_REQUEST, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_NEXT_CMD_INTERRUPT:{
+        if (first_time){
+            m_interrupt_on_next = true;
+        }
+        pabb_MsgAckRequest ack;
+        ack.seqnum = seqnum;
+        send_to_host(PABB_MSG_ACK_REQUEST, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_CLOCK:{
+        pabb_MsgAckRequestI32 ack;
+        ack.seqnum = seqnum;
+        ack.data = (uint32_t)std::chrono::duration_cast<Milliseconds>(current_time() - m_start).count();
+        send_to_host(PABB_MSG_ACK_REQUEST_I32, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_STATUS:{
+        //  Connected and ready.
+        pabb_MsgAckRequestI32 ack;
+        ack.seqnum = seqnum;
+        ack.data = 3;
+        send_to_host(PABB_MSG_ACK_REQUEST_I32, ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_READ_MAC_ADDRESS:{
+        const uint8_t MAC_ADDRESS[6] = {0x00, 0x00, 0x5e, 0x00, 0x53, 0x01};
+        std::string response((const char*)&seqnum, sizeof(seqnum));
+        response.append((const char*)MAC_ADDRESS, sizeof(MAC_ADDRESS));
+        send_to_host(PABB_MSG_ACK_REQUEST_DATA, response.data(), response.size());
+        return;
+    }
+    }
+
+    m_logger.log("PABotBaseEmulator: Unknown request type: " + std::to_string(type), COLOR_RED);
+    pabb_MsgInfoInvalidType params;
+    params.type = type;
+    send_to_host(PABB_MSG_ERROR_INVALID_TYPE, params);
+}
+bool PABotBaseEmulator::process_command(
+    uint8_t type, seqnum_t seqnum,
+    const char* body, size_t bytes
+){
+    //  Like the real firmware, don't recognize batches before the protocol
+    //  version that added them.
+    bool supported =
+        type != PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE_BATCH ||
+        m_config.protocol_version >= PABB_PROTOCOL_VERSION_NS2_WIRED_CONTROLLER_STATE_BATCH;
+
+    uint32_t milliseconds;
+    if (!supported || !command_duration(type, body, bytes, milliseconds)){
+        m_logger.log("PABotBaseEmulator: Unknown command type: " + std::to_string(type), COLOR_RED);
+        pabb_MsgInfoInvalidType params;
+        params.type = type;
+        send_to_host(PABB_MSG_ERROR_INVALID_TYPE, params);
+        return true;
+    }
+
+    if (m_commands.size() >= m_config.queue_size){
+        m_stats.commands_dropped++;
+        pabb_MsgInfoCommandDropped params;
+        params.seqnum = seqnum;
+        send_to_host(PABB_MSG_ERROR_COMMAND_DROPPED, params);
+        return false;
+    }
+
+    WallClock now = current_time();
+
+    //  Cut everything that's still running short.
+    if (m_interrupt_on_next){
+        m_interrupt_on_next = false;
+        for (QueuedCommand& command : m_commands){
+            command.end = std::min(command.end, now);
+        }
+    }
+
+    WallClock start = m_commands.empty()
+        ? now
+        : std::max(now, m_commands.back().end);
+    WallDuration duration = std::chrono::duration_cast<WallDuration>(
+        std::chrono::duration<double, std::milli>(milliseconds * m_config.time_scale)
+    );
+    m_commands.emplace_back(QueuedCommand{seqnum, start + duration});
+    m_stats.max_queue_depth = std::max(m_stats.max_queue_depth, m_commands.size());
+    m_stats.busy_time += duration;
+
+    pabb_MsgAckCommand ack;
+    ack.seqnum = seqnum;
+    send_to_host(PABB_MSG_ACK_COMMAND, ack);
+
+    m_cv.notify_all();
+    return true;
+}
+void PABotBaseEmulator::finish_command(){
+    QueuedCommand command = m_commands.front();
+    m_commands.pop_front();
+    m_stats.commands_executed++;
+
+    pabb_MsgRequestCommandFinished params;
+    params.seqnum = m_device_seqnum++;
+    params.seq_of_original_command = command.seqnum;
+    params.finish_time = (uint32_t)std::chrono::duration_cast<Milliseconds>(command.end - m_start).count();
+
+    //  Keep the message around in case the ack is lost.
+    std::string buffer = frame_message(PABB_MSG_REQUEST_COMMAND_FINISHED, &params, sizeof(params));
+    m_stats.packets_sent++;
+    transmit(true, buffer);
+    m_unacked_finishes[params.seqnum] = UnackedFinish{std::move(buffer), current_time()};
+}
+
+
+
+void PABotBaseEmulator::thread_loop(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (!m_stopping){
+        WallClock now = current_time();
+        WallClock next = WallClock::max();
+
+        //  Deliver packets that have arrived.
+        auto iter = m_link.begin();
+        if (iter != m_link.end()){
+            if (iter->first <= now){
+                Packet packet = std::move(iter->second);
+                m_link.erase(iter);
+                if (packet.to_host){
+                    //  The host may call back into send() from here.
+                    lg.unlock();
+                    on_recv(packet.bytes.data(), packet.bytes.size());
+                    lg.lock();
+                }else{
+                    process_bytes(packet.bytes);
+                }
+                continue;
+            }
+            next = std::min(next, iter->first);
+        }
+
+        //  Finish commands.
+        if (!m_commands.empty()){
+            if (m_commands.front().end <= now){
+                finish_command();
+                continue;
+            }
+            next = std::min(next, m_commands.front().end);
+        }
+
+        //  Resend finishes that weren't acked.
+        for (auto& item : m_unacked_finishes){
+            WallClock due = item.second.last_sent + m_config.retransmit_delay;
+            if (due <= now){
+                m_stats.packets_sent++;
+                m_stats.finish_retransmits++;
+                item.second.last_sent = now;
+                transmit(true, item.second.bytes);
+                due = now + m_config.retransmit_delay;
+            }
+            next = std::min(next, due);
+        }
+
+        if (next == WallClock::max()){
+            m_cv.wait(lg);
+        }else{
+            m_cv.wait_until(lg, next);
+        }
+    }
+}
+
+
+
+}
@@ -0,0 +1,174 @@
+/*  PABotBase Emulator
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      A software stand-in for a device running PABotBase. It plugs into
+ *  PABotBase in place of a serial port and speaks the protocol described in
+ *  "SerialPABotBase_Protocol.h".
+ *
+ *  The link is simulated with a configurable baud rate, latency, jitter and
+ *  packet loss in each direction. Commands are queued up to the configured
+ *  queue size and drained back-to-back in simulated time using the durations
+ *  inside the command messages.
+ *
+ *  This exists so that the host side of the protocol can be benchmarked and
+ *  stress-tested without hardware.
+ *
+ */
+
+#ifndef PokemonAutomation_PABotBaseEmulator_H
+#define PokemonAutomation_PABotBaseEmulator_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <random>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/AbstractLogger.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/SerialConnection/StreamInterface.h"
+#include "Common/SerialPABotBase/SerialPABotBase_Protocol.h"
+
+namespace PokemonAutomation{
+
+
+struct PABotBaseEmulatorConfig{
+    //  Link speed. Zero means infinitely fast.
+    uint32_t baud_rate = PABB_BAUD_RATE;
+
+    //  One-way latency of each packet. A random amount up to "jitter" is
+    //  added on top. Packets are never reordered.
+    Milliseconds latency = Milliseconds(1);
+    Milliseconds jitter = Milliseconds(0);
+
+    //  Probability that a packet is lost. Applied in each direction.
+    double loss_rate = 0;
+    uint32_t random_seed = 0;
+
+    //  How many commands the device can buffer. Extra commands are dropped.
+    uint8_t queue_size = PABB_DEVICE_MINIMUM_QUEUE_SIZE;
+
+    //  How fast commands drain relative to their requested durations.
+    //  1.0 is real time. 0 finishes every command immediately.
+    double time_scale = 1.0;
+
+    //  How long the device waits for the host to ack a command finish before
+    //  sending it again.
+    Milliseconds retransmit_delay = Milliseconds(100);
+
+    //  What the device reports about itself.
+    uint32_t protocol_version = 2025090400;
+    uint32_t program_version = 2025090400;
+    uint8_t program_id = 0;
+    std::string program_name = "PABotBase Emulator";
+    std::vector<uint32_t> controller_list;
+    uint32_t controller_id = 0;
+};
+
+
+struct PABotBaseEmulatorStats{
+    uint64_t packets_received = 0;
+    uint64_t packets_sent = 0;
+    uint64_t packets_lost = 0;
+    uint64_t checksum_errors = 0;
+
+    //  Requests/commands that were already processed. (host retransmits)
+    uint64_t duplicates = 0;
+
+    //  Requests/commands ahead of the expected seqnum. (an earlier one was lost)
+    uint64_t out_of_order = 0;
+
+    uint64_t commands_executed = 0;
+    uint64_t commands_dropped = 0;
+    size_t max_queue_depth = 0;
+
+    uint64_t finish_retransmits = 0;
+
+    //  Total simulated time spent running commands.
+    WallDuration busy_time = WallDuration::zero();
+
+    std::string to_str() const;
+};
+
+
+class PABotBaseEmulator : public StreamConnection{
+public:
+    PABotBaseEmulator(Logger& logger, PABotBaseEmulatorConfig config = PABotBaseEmulatorConfig());
+    virtual ~PABotBaseEmulator();
+
+    virtual void stop() override;
+    virtual void send(const void* data, size_t bytes) override;
+
+    PABotBaseEmulatorStats stats() const;
+
+
+private:
+    struct Packet{
+        bool to_host;
+        std::string bytes;
+    };
+    struct QueuedCommand{
+        seqnum_t seqnum;
+        WallClock end;
+    };
+    struct UnackedFinish{
+        std::string bytes;
+        WallClock last_sent;
+    };
+
+    static std::string frame_message(uint8_t type, const void* body, size_t bytes);
+
+    //  All of these must be called under "m_lock".
+    void transmit(bool to_host, std::string bytes);
+    void send_to_host(uint8_t type, const void* body, size_t bytes);
+    template <typename Params>
+    void send_to_host(uint8_t type, const Params& params){
+        send_to_host(type, &params, sizeof(params));
+    }
+
+    void process_bytes(const std::string& bytes);
+    void process_message(uint8_t type, const char* body, size_t bytes);
+    void process_request(uint8_t type, seqnum_t seqnum, const char* body, size_t bytes, bool first_time);
+    bool process_command(uint8_t type, seqnum_t seqnum, const char* body, size_t bytes);
+    void finish_command();
+
+    void thread_loop();
+
+
+private:
+    Logger& m_logger;
+    const PABotBaseEmulatorConfig m_config;
+    const WallClock m_start;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping;
+
+    std::minstd_rand m_random;
+
+    //  Link state.
+    std::multimap<WallClock, Packet> m_link;
+    WallClock m_link_free[2];
+    WallClock m_last_arrival[2];
+
+    //  Device state.
+    std::string m_recv_buffer;
+    seqnum_t m_expected_seqnum;
+    seqnum_t m_device_seqnum;
+    uint32_t m_controller_id;
+    bool m_interrupt_on_next;
+    std::deque<QueuedCommand> m_commands;
+    std::map<seqnum_t, UnackedFinish> m_unacked_finishes;
+
+    PABotBaseEmulatorStats m_stats;
+
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,182 @@
+/*  PABotBase Emulator Benchmark
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include <map>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Controllers/SerialPABotBase/SerialPABotBase_Routines_NS2_WiredController.h"
+#include "MessageSniffer.h"
+#include "PABotBase.h"
+#include "PABotBaseEmulatorBenchmark.h"
+
+namespace PokemonAutomation{
+
+
+std::vector<PABotBaseBenchmarkState> make_mashing_workload(size_t states, uint16_t milliseconds){
+    std::vector<PABotBaseBenchmarkState> ret(states);
+    for (size_t c = 0; c < states; c++){
+        ret[c].milliseconds = milliseconds;
+        ret[c].report = pabb_NintendoSwitch2_WiredController_State_NEUTRAL_STATE;
+        if (c % 2 == 0){
+            ret[c].report.buttons0 = 0x04;
+        }
+    }
+    return ret;
+}
+
+
+
+double PABotBaseBenchmarkResults::commands_per_second() const{
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds == 0 ? 0 : commands / seconds;
+}
+WallDuration PABotBaseBenchmarkResults::ack_latency_percentile(double percentile) const{
+    if (ack_latencies.empty()){
+        return WallDuration::zero();
+    }
+    std::vector<WallDuration> sorted = ack_latencies;
+    std::sort(sorted.begin(), sorted.end());
+    size_t index = (size_t)(percentile * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+std::string PABotBaseBenchmarkResults::to_str() const{
+    auto to_us = [](WallDuration duration){
+        return std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) + " us";
+    };
+
+    std::string str;
+    str += "States: " + std::to_string(states);
+    str += ", Commands: " + std::to_string(commands);
+    str += ", Elapsed: " + std::to_string(std::chrono::duration_cast<Milliseconds>(elapsed).count()) + " ms";
+    str += ", Commands/s: " + std::to_string(commands_per_second());
+    str += "\nAck Latency (p50/p90/p99/max): " + to_us(ack_latency_percentile(0.50));
+    str += " / " + to_us(ack_latency_percentile(0.90));
+    str += " / " + to_us(ack_latency_percentile(0.99));
+    str += " / " + to_us(ack_latency_percentile(1.00));
+    str += ", Retransmits: " + std::to_string(retransmits);
+    str += "\n" + device.to_str();
+    return str;
+}
+
+
+
+namespace{
+
+//  Watches the traffic to time how long each request/command takes to get
+//  acked. Sends and receives happen on different threads.
+class BenchmarkSniffer : public MessageSniffer{
+public:
+    virtual void on_send(const BotBaseMessage& message, bool is_retransmit) override{
+        if (!PABB_MSG_IS_REQUEST_OR_COMMAND(message.type) || message.body.size() < sizeof(seqnum_t)){
+            return;
+        }
+        seqnum_t seqnum;
+        memcpy(&seqnum, message.body.data(), sizeof(seqnum));
+
+        WriteSpinLock lg(m_lock);
+        if (is_retransmit){
+            m_retransmits++;
+        }else{
+            m_sent.emplace(seqnum, current_time());
+        }
+    }
+    virtual void on_recv(const BotBaseMessage& message) override{
+        if (!PABB_MSG_IS_ACK(message.type) || message.body.size() < sizeof(seqnum_t)){
+            return;
+        }
+        seqnum_t seqnum;
+        memcpy(&seqnum, message.body.data(), sizeof(seqnum));
+
+        WallClock now = current_time();
+        WriteSpinLock lg(m_lock);
+        auto iter = m_sent.find(seqnum);
+        if (iter == m_sent.end()){
+            return;
+        }
+        m_latencies.emplace_back(now - iter->second);
+        m_sent.erase(iter);
+    }
+
+    void finish(PABotBaseBenchmarkResults& results){
+        WriteSpinLock lg(m_lock);
+        results.ack_latencies = std::move(m_latencies);
+        results.retransmits = m_retransmits;
+    }
+
+private:
+    SpinLock m_lock;
+    std::map<seqnum_t, WallClock> m_sent;
+    std::vector<WallDuration> m_latencies;
+    uint64_t m_retransmits = 0;
+};
+
+}
+
+
+
+PABotBaseBenchmarkResults run_pabotbase_benchmark(
+    Logger& logger,
+    const PABotBaseEmulatorConfig& config,
+    const std::vector<PABotBaseBenchmarkState>& workload,
+    bool batched,
+    Milliseconds retransmit_delay
+){
+    PABotBaseBenchmarkResults results;
+    results.states = workload.size();
+
+    std::unique_ptr<PABotBaseEmulator> connection = std::make_unique<PABotBaseEmulator>(logger, config);
+    PABotBaseEmulator& emulator = *connection;
+
+    BenchmarkSniffer sniffer;
+    PABotBase botbase(logger, std::move(connection), nullptr, retransmit_delay);
+    botbase.set_sniffer(&sniffer);
+    botbase.connect();
+    botbase.set_queue_limit(config.queue_size);
+
+    WallClock start = current_time();
+    if (batched){
+        SerialPABotBase::DeviceRequest_NS2_WiredController_ControllerStateBatch batch;
+        for (const PABotBaseBenchmarkState& state : workload){
+            if (batch.try_append(state.milliseconds, state.report)){
+                continue;
+            }
+            botbase.issue_request(batch, nullptr);
+            results.commands++;
+            batch = SerialPABotBase::DeviceRequest_NS2_WiredController_ControllerStateBatch();
+            batch.try_append(state.milliseconds, state.report);
+        }
+        if (batch.size() != 0){
+            botbase.issue_request(batch, nullptr);
+            results.commands++;
+        }
+    }else{
+        for (const PABotBaseBenchmarkState& state : workload){
+            botbase.issue_request(
+                SerialPABotBase::DeviceRequest_NS2_WiredController_ControllerStateMs(
+                    state.milliseconds,
+                    state.report.buttons0 | ((uint16_t)state.report.buttons1 << 8),
+                    state.report.dpad_byte,
+                    state.report.left_joystick_x, state.report.left_joystick_y,
+                    state.report.right_joystick_x, state.report.right_joystick_y
+                ),
+                nullptr
+            );
+            results.commands++;
+        }
+    }
+    botbase.wait_for_all_requests();
+    results.elapsed = current_time() - start;
+
+    results.device = emulator.stats();
+    botbase.stop();
+    sniffer.finish(results);
+
+    return results;
+}
+
+
+
+}
@@ -0,0 +1,63 @@
+/*  PABotBase Emulator Benchmark
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Drives a real PABotBase against the emulator and measures throughput,
+ *  ack latency and retransmits for a stream of controller states.
+ *
+ */
+
+#ifndef PokemonAutomation_PABotBaseEmulatorBenchmark_H
+#define PokemonAutomation_PABotBaseEmulatorBenchmark_H
+
+#include <vector>
+#include "Common/SerialPABotBase/SerialPABotBase_Messages_NS2_WiredController.h"
+#include "PABotBaseEmulator.h"
+
+namespace PokemonAutomation{
+
+
+struct PABotBaseBenchmarkState{
+    uint16_t milliseconds;
+    pabb_NintendoSwitch2_WiredController_State report;
+};
+
+//  Alternates between pressing and releasing a button. This is the worst case
+//  for the link since every state is short.
+std::vector<PABotBaseBenchmarkState> make_mashing_workload(size_t states, uint16_t milliseconds);
+
+
+struct PABotBaseBenchmarkResults{
+    size_t states = 0;
+    size_t commands = 0;
+    WallDuration elapsed = WallDuration::zero();
+
+    //  Host-side time from first send to ack, one entry per request/command.
+    std::vector<WallDuration> ack_latencies;
+
+    //  Host-side retransmits.
+    uint64_t retransmits = 0;
+
+    PABotBaseEmulatorStats device;
+
+    double commands_per_second() const;
+    WallDuration ack_latency_percentile(double percentile) const;
+
+    std::string to_str() const;
+};
+
+//  Connects a PABotBase to a new emulator, sends the workload and waits for it
+//  to finish. If "batched" is set, states are packed into
+//  "PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE_BATCH" commands.
+PABotBaseBenchmarkResults run_pabotbase_benchmark(
+    Logger& logger,
+    const PABotBaseEmulatorConfig& config,
+    const std::vector<PABotBaseBenchmarkState>& workload,
+    bool batched,
+    Milliseconds retransmit_delay = Milliseconds(100)
+);
+
+
+
+}
+#endif
@@ -38,6 +38,11 @@ public:
     }
     BotBaseController* botbase();
 
+    //  Protocol version reported by the device. Zero if not connected yet.
+    uint32_t protocol_version() const{
+        return m_protocol;
+    }
+
     ControllerType refresh_controller_type();
 
 
@@ -4,6 +4,7 @@
  *
  */
 
+#include <string.h>
 #include <sstream>
 #include "Common/SerialPABotBase/SerialPABotBase_Messages_NS2_WiredController.h"
 #include "Controllers/SerialPABotBase/Connection/MessageConverter.h"
@@ -43,6 +44,39 @@ void register_message_converters_NS2_WiredController(){
             ss << ", RJ = (" << (int)params->report.right_joystick_x << "," << (int)params->report.right_joystick_y << ")";
 #endif
 
+            return ss.str();
+        }
+    );
+    register_message_converter(
+        PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE_BATCH,
+        [](const std::string& body){
+            //  Disable this by default since it's very spammy.
+            if (!GlobalSettings::instance().LOG_EVERYTHING){
+                return std::string();
+            }
+            std::ostringstream ss;
+            ss << "PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE_BATCH: ";
+            if (body.size() < sizeof(pabb_Message_Command_NS2_WiredController_StateBatch_Header)){ ss << "(invalid size)" << std::endl; return ss.str(); }
+            const auto* params = (const pabb_Message_Command_NS2_WiredController_StateBatch_Header*)body.c_str();
+            ss << "seqnum = " << (uint64_t)params->seqnum;
+            ss << ", count = " << (int)params->count;
+
+            //  Walk the entries to get the total duration.
+            uint64_t milliseconds = 0;
+            size_t index = sizeof(pabb_Message_Command_NS2_WiredController_StateBatch_Header);
+            for (uint8_t c = 0; c < params->count; c++){
+                if (index + sizeof(uint16_t) + 1 > body.size()){ ss << " (truncated)"; return ss.str(); }
+                uint16_t ms;
+                memcpy(&ms, body.data() + index, sizeof(uint16_t));
+                uint8_t changed = (uint8_t)body[index + sizeof(uint16_t)];
+                milliseconds += ms;
+                index += sizeof(uint16_t) + 1;
+                for (; changed; changed &= changed - 1){
+                    index++;
+                }
+            }
+            ss << ", milliseconds = " << milliseconds;
+
             return ss.str();
         }
     );
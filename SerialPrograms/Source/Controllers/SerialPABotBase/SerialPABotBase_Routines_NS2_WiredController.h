@@ -51,6 +51,62 @@ public:
 };
 
 
+class DeviceRequest_NS2_WiredController_ControllerStateBatch : public BotBaseRequest{
+public:
+    DeviceRequest_NS2_WiredController_ControllerStateBatch()
+        : BotBaseRequest(true)
+        , m_body(sizeof(pabb_Message_Command_NS2_WiredController_StateBatch_Header), 0)
+        , m_last(pabb_NintendoSwitch2_WiredController_State_NEUTRAL_STATE)
+    {}
+
+    size_t size() const{
+        return ((const pabb_Message_Command_NS2_WiredController_StateBatch_Header*)m_body.data())->count;
+    }
+
+    //  Append a state to the run. Returns false if it doesn't fit.
+    bool try_append(uint16_t milliseconds, const pabb_NintendoSwitch2_WiredController_State& report){
+        constexpr size_t REPORT_SIZE = sizeof(pabb_NintendoSwitch2_WiredController_State);
+        static_assert(REPORT_SIZE <= 8);
+
+        if (size() >= 255){
+            return false;
+        }
+
+        const uint8_t* last = (const uint8_t*)&m_last;
+        const uint8_t* current = (const uint8_t*)&report;
+
+        char entry[sizeof(uint16_t) + 1 + REPORT_SIZE];
+        memcpy(entry, &milliseconds, sizeof(uint16_t));
+        size_t length = sizeof(uint16_t) + 1;
+        uint8_t changed = 0;
+        for (size_t c = 0; c < REPORT_SIZE; c++){
+            if (current[c] != last[c]){
+                changed |= (uint8_t)1 << c;
+                entry[length++] = (char)current[c];
+            }
+        }
+        entry[sizeof(uint16_t)] = (char)changed;
+
+        if (m_body.size() + length > PABB_NS2_WIRED_CONTROLLER_STATE_BATCH_MAX_BODY){
+            return false;
+        }
+
+        m_body.append(entry, length);
+        ((pabb_Message_Command_NS2_WiredController_StateBatch_Header*)m_body.data())->count++;
+        m_last = report;
+        return true;
+    }
+
+    virtual BotBaseMessage message() const override{
+        return BotBaseMessage(PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE_BATCH, m_body);
+    }
+
+private:
+    std::string m_body;
+    pabb_NintendoSwitch2_WiredController_State m_last;
+};
+
+
 
 }
 }
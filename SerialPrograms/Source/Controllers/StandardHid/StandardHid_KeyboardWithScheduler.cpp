@@ -16,8 +16,8 @@ void KeyboardControllerWithScheduler::issue_key(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     KeyboardKey key
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         if (cancellable){
             cancellable->throw_if_cancelled();
@@ -43,8 +43,8 @@ void KeyboardControllerWithScheduler::issue_keys(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     const std::vector<KeyboardKey>& keys
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         if (cancellable){
             cancellable->throw_if_cancelled();
@@ -89,8 +89,8 @@ void SerialPABotBase_Keyboard::replace_on_next_command(){
 
 
 void SerialPABotBase_Keyboard::wait_for_all(const Cancellable* cancellable){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         m_logger.log("wait_for_all()", COLOR_DARKGREEN);
@@ -6,7 +6,6 @@
 
 #include <deque>
 #include <QString>
-#include <QFile>
 #include <QHttpMultiPart>
 #include <QEventLoop>
 #include <QNetworkAccessManager>
@@ -32,6 +31,40 @@ namespace DiscordWebhook{
 
 
 
+//  Image attachments are encoded after the embed that shows them is built.
+//  If the encode fails, the embed must not point to the missing attachment.
+void remove_embed_images(JsonValue& json, const std::string& filename){
+    JsonObject* obj = json.to_object();
+    if (obj == nullptr){
+        return;
+    }
+    JsonArray* embeds = obj->get_array("embeds");
+    if (embeds == nullptr){
+        return;
+    }
+    const std::string url = "attachment://" + filename;
+    for (JsonValue& item : *embeds){
+        JsonObject* embed = item.to_object();
+        if (embed == nullptr){
+            continue;
+        }
+        const JsonObject* image = embed->get_object("image");
+        const std::string* image_url = image == nullptr ? nullptr : image->get_string("url");
+        if (image_url == nullptr || *image_url != url){
+            continue;
+        }
+        JsonObject stripped;
+        for (auto& field : *embed){
+            if (field.first != "image"){
+                stripped[field.first] = std::move(field.second);
+            }
+        }
+        *embed = std::move(stripped);
+    }
+}
+
+
+
 DiscordWebhookSender::DiscordWebhookSender()
     : m_logger(global_logger_raw(), "DiscordWebhookSender")
     , m_stopping(false)
@@ -78,9 +111,14 @@ void DiscordWebhookSender::send(
             throttle();
             std::vector<DiscordFileAttachment> attachments;
             if (file){
-                attachments.emplace_back(
-                    DiscordFileAttachment{file->filename(), file->filepath()}
-                );
+                if (file->data() != nullptr){
+                    attachments.emplace_back(
+                        DiscordFileAttachment{file->filename(), file}
+                    );
+                }else{
+                    m_logger.log("Attachment is unavailable: " + file->filename(), COLOR_RED);
+                    remove_embed_images(*json, file->filename());
+                }
             }
             internal_send(url, *json, attachments);
             if (finish_callback){
@@ -111,9 +149,14 @@ void DiscordWebhookSender::send(
             throttle();
             std::vector<DiscordFileAttachment> attachments;
             for (auto& file : files){
-                attachments.emplace_back(
-                    DiscordFileAttachment{file->filename(), file->filepath()}
-                );
+                if (file->data() != nullptr){
+                    attachments.emplace_back(
+                        DiscordFileAttachment{file->filename(), file}
+                    );
+                }else{
+                    m_logger.log("Attachment is unavailable: " + file->filename(), COLOR_RED);
+                    remove_embed_images(*json, file->filename());
+                }
             }
             internal_send(url, *json, attachments);
             if (finish_callback){
@@ -212,13 +255,13 @@ void DiscordWebhookSender::internal_send(
         }
 
         std::vector<QHttpPart> file_parts;
-        std::deque<QFile> file_readers;
         file_parts.reserve(files.size());
         size_t c = 0;
         for (const auto& file : files){
-            QFile& reader = file_readers.emplace_back(QString::fromStdString(file.filepath));
-            if (!reader.open(QIODevice::ReadOnly)){
-                m_logger.log("File doesn't exist: " + file.filepath, COLOR_RED);
+            //  The data is owned by "file" which outlives the request.
+            const std::string* data = file.file->data();
+            if (data == nullptr){
+                m_logger.log("Attachment is unavailable: " + file.name, COLOR_RED);
                 continue;
             }
             QHttpPart& part = file_parts.emplace_back();
@@ -226,7 +269,7 @@ void DiscordWebhookSender::internal_send(
                 QNetworkRequest::ContentDispositionHeader,
                 QVariant(QString::fromStdString("application/octet-stream; name=file" + std::to_string(c) + "; filename=" + file.name))
             );
-            part.setBodyDevice(&reader);
+            part.setBody(QByteArray::fromRawData(data->data(), (qsizetype)data->size()));
             multiPart.append(part);
             c++;
         }
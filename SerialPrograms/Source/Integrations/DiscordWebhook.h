@@ -27,7 +27,7 @@ namespace DiscordWebhook{
 
 struct DiscordFileAttachment{
     std::string name;
-    std::string filepath;
+    std::shared_ptr<PendingFileSend> file;
 };
 
 
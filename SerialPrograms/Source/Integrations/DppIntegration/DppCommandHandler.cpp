@@ -94,17 +94,15 @@ void Handler::send_message(cluster& bot, embed& embed, const std::string& channe
     Handler::m_queue.add_event(delay > std::chrono::milliseconds(10000) ? std::chrono::milliseconds(0) : delay,
     [&bot, this, embed = std::move(embed), channel = channel, msg = msg, file = std::move(file)]() mutable {
         message m;
-        if (file != nullptr && !file->filepath().empty() && !file->filename().empty()){
-            std::string data;
-            std::string path = file->filepath();
-            try{
-                data = utility::read_file(path);
-                m.add_file(file->filename(), data);
-                if (path.find(".txt") == std::string::npos){
+        if (file != nullptr && !file->filename().empty()){
+            const std::string* data = file->data();
+            if (data != nullptr){
+                m.add_file(file->filename(), *data);
+                if (file->filename().find(".txt") == std::string::npos){
                     embed.set_image("attachment://" + file->filename());
                 }
-            }catch (dpp::exception e){
-                log_dpp("Exception thrown while reading screenshot data: " + (std::string)e.what(), "send_message()", ll_error);
+            }else{
+                log_dpp("Unable to read attachment: " + file->filename(), "send_message()", ll_error);
             }
         }
 
@@ -122,14 +120,13 @@ void Handler::send_message(cluster& bot, embed& embed, const std::string& channe
 
 void Handler::update_response(const dpp::command_source& src, dpp::embed& embed, const std::string& msg, std::shared_ptr<PendingFileSend> file){
     message m;
-    if (file != nullptr && !file->filepath().empty() && !file->filename().empty()){
-        std::string data;
-        try{
-            data = utility::read_file(file->filepath());
-            m.add_file(file->filename(), data);
+    if (file != nullptr && !file->filename().empty()){
+        const std::string* data = file->data();
+        if (data != nullptr){
+            m.add_file(file->filename(), *data);
             embed.set_image("attachment://" + file->filename());
-        }catch (dpp::exception e){
-            log_dpp("Exception thrown while reading screenshot data: " + (std::string)e.what(), "send_message()", ll_error);
+        }else{
+            log_dpp("Unable to read attachment: " + file->filename(), "update_response()", ll_error);
         }
     }
 
@@ -14,15 +14,26 @@ namespace AbsFFT{
 
 
 
-void fft_abs_Default(int k, float* abs, float* real);
-void fft_abs_x86_SSE41(int k, float* abs, float* real);
-void fft_abs_x86_AVX2(int k, float* abs, float* real);
+void fft_abs_Default(int k, size_t count, float* abs, float* real);
+void fft_abs_x86_SSE41(int k, size_t count, float* abs, float* real);
+void fft_abs_x86_AVX2(int k, size_t count, float* abs, float* real);
+void fft_abs_x86_AVX512(int k, size_t count, float* abs, float* real);
+void fft_abs_arm64_NEON(int k, size_t count, float* abs, float* real);
 
 
 void fft_abs(int k, float* abs, float* real){
+    fft_abs(k, 1, abs, real);
+}
+void fft_abs(int k, size_t count, float* abs, float* real){
     if (k <= 0){
         throw "FFT length must be at least 2^1.";
     }
+    if (count > 1 && k < 5){
+        throw "Batched FFT length must be at least 2^5.";
+    }
+    if (count == 0){
+        return;
+    }
     if ((size_t)abs & 63){
         throw "abs must be aligned to 64 bytes.";
     }
@@ -30,19 +41,31 @@ void fft_abs(int k, float* abs, float* real){
         throw "real must be aligned to 64 bytes.";
     }
 
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        fft_abs_x86_AVX512(k, count, abs, real);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_13_Haswell
     if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
-        fft_abs_x86_AVX2(k, abs, real);
+        fft_abs_x86_AVX2(k, count, abs, real);
         return;
     }
 #endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
-        fft_abs_x86_SSE41(k, abs, real);
+        fft_abs_x86_SSE41(k, count, abs, real);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        fft_abs_arm64_NEON(k, count, abs, real);
         return;
     }
 #endif
-    fft_abs_Default(k, abs, real);
+    fft_abs_Default(k, count, abs, real);
 }
 
 
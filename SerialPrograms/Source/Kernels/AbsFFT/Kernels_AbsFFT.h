@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_Kernels_AbsFFT_H
 #define PokemonAutomation_Kernels_AbsFFT_H
 
+#include <stddef.h>
 
 namespace PokemonAutomation{
 namespace Kernels{
@@ -25,6 +26,18 @@ namespace AbsFFT{
 //
 void fft_abs(int k, float* abs, float* real);
 
+//
+//  Same as above, but run "count" transforms of length 2^k at once.
+//
+//    - "real" holds the "count" inputs back to back. It has length count * 2^k.
+//    - "abs" receives the "count" outputs back to back. It has length count * 2^(k-1).
+//
+//  This saves the dispatch and twiddle table lookups for each transform and
+//  keeps the twiddles hot in cache across the batch. If "count > 1", "k"
+//  must be at least 5 so that every transform stays aligned.
+//
+void fft_abs(int k, size_t count, float* abs, float* real);
+
 
 
 }
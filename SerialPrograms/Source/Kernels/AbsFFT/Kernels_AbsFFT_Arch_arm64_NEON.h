@@ -0,0 +1,91 @@
+/*  ABS FFT Arch (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_AbsFFT_Arch_arm64_NEON_H
+#define PokemonAutomation_Kernels_AbsFFT_Arch_arm64_NEON_H
+
+#include <arm_neon.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AbsFFT{
+struct Context_arm64_NEON{
+
+
+using vtype = float32x4_t;
+
+static const int VECTOR_K = 2;
+static const size_t VECTOR_LENGTH = (size_t)1 << VECTOR_K;
+
+static const int BASE_COMPLEX_TRANSFORM_K = 4;
+static const size_t MIN_TABLE_WIDTH = 1;
+
+
+static PA_FORCE_INLINE vtype vset1(float x){
+    return vdupq_n_f32(x);
+}
+static PA_FORCE_INLINE vtype vneg(vtype x){
+    return vnegq_f32(x);
+}
+static PA_FORCE_INLINE vtype vadd(vtype x, vtype y){
+    return vaddq_f32(x, y);
+}
+static PA_FORCE_INLINE vtype vsub(vtype x, vtype y){
+    return vsubq_f32(x, y);
+}
+static PA_FORCE_INLINE vtype vmul(vtype x, vtype y){
+    return vmulq_f32(x, y);
+}
+static PA_FORCE_INLINE void cmul_pp(
+    vtype& Xr, vtype& Xi,
+    vtype Wr, vtype Wi
+){
+    vtype t0 = vmulq_f32(Xi, Wi);
+    vtype t1 = vmulq_f32(Xr, Wi);
+    Xr = vsubq_f32(vmulq_f32(Xr, Wr), t0);
+    Xi = vfmaq_f32(t1, Xi, Wr);
+}
+
+
+static PA_FORCE_INLINE vtype abs(vtype r, vtype i){
+    vtype r0 = vfmaq_f32(vmulq_f32(i, i), r, r);
+    return vsqrtq_f32(r0);
+}
+static PA_FORCE_INLINE void swap_odd(vtype& L, vtype& H){
+    //  Odd lanes trade places with the mirrored odd lane of the other vector.
+    const uint32x4_t ODD = vreinterpretq_u32_u64(vdupq_n_u64(0xffffffff00000000));
+    vtype r0 = vextq_f32(L, L, 2);
+    vtype r1 = vextq_f32(H, H, 2);
+    L = vbslq_f32(ODD, r1, L);
+    H = vbslq_f32(ODD, r0, H);
+}
+
+
+static PA_FORCE_INLINE void interleave_v0(
+    vtype& out0, vtype& out1,
+    vtype lo, vtype hi
+){
+    out0 = vzip1q_f32(lo, hi);
+    out1 = vzip2q_f32(lo, hi);
+}
+static PA_FORCE_INLINE void interleave_v1(
+    vtype& out0, vtype& out1,
+    vtype lo, vtype hi
+){
+    float64x2_t l = vreinterpretq_f64_f32(lo);
+    float64x2_t h = vreinterpretq_f64_f32(hi);
+    out0 = vreinterpretq_f32_f64(vzip1q_f64(l, h));
+    out1 = vreinterpretq_f32_f64(vzip2q_f64(l, h));
+}
+
+
+
+};
+}
+}
+}
+#endif
@@ -0,0 +1,90 @@
+/*  ABS FFT Arch (AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_AbsFFT_Arch_x86_AVX512_H
+#define PokemonAutomation_Kernels_AbsFFT_Arch_x86_AVX512_H
+
+#include <immintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AbsFFT{
+struct Context_x86_AVX512{
+
+
+using vtype = __m512;
+static const int VECTOR_K = 4;
+static const size_t VECTOR_LENGTH = (size_t)1 << VECTOR_K;
+
+static const int BASE_COMPLEX_TRANSFORM_K = 8;
+static const size_t MIN_TABLE_WIDTH = 1;
+
+
+static PA_FORCE_INLINE vtype vset1(float x){
+    return _mm512_set1_ps(x);
+}
+static PA_FORCE_INLINE vtype vneg(vtype x){
+    return _mm512_xor_ps(x, _mm512_set1_ps(-0.0));
+}
+static PA_FORCE_INLINE vtype vadd(vtype x, vtype y){
+    return _mm512_add_ps(x, y);
+}
+static PA_FORCE_INLINE vtype vsub(vtype x, vtype y){
+    return _mm512_sub_ps(x, y);
+}
+static PA_FORCE_INLINE vtype vmul(vtype x, vtype y){
+    return _mm512_mul_ps(x, y);
+}
+static PA_FORCE_INLINE void cmul_pp(
+    vtype& Xr, vtype& Xi,
+    vtype Wr, vtype Wi
+){
+    vtype t0 = _mm512_mul_ps(Xi, Wi);
+    vtype t1 = _mm512_mul_ps(Xr, Wi);
+    Xr = _mm512_fmsub_ps(Xr, Wr, t0);
+    Xi = _mm512_fmadd_ps(Xi, Wr, t1);
+}
+
+
+//  abs() and swap_odd() use full-mask forms for the same GCC 12 warning
+//  described above vtranspose() in the base transform.
+static PA_FORCE_INLINE vtype abs(vtype r, vtype i){
+    vtype r0 = _mm512_fmadd_ps(r, r, _mm512_mul_ps(i, i));
+    return _mm512_mask_sqrt_ps(r0, 0xffff, r0);
+}
+static PA_FORCE_INLINE void swap_odd(vtype& L, vtype& H){
+    const __m512i INDEX = _mm512_setr_epi32(0, 15, 2, 13, 4, 11, 6, 9, 8, 7, 10, 5, 12, 3, 14, 1);
+    vtype r0 = _mm512_mask_permutexvar_ps(L, 0xffff, INDEX, L);
+    vtype r1 = _mm512_mask_permutexvar_ps(H, 0xffff, INDEX, H);
+    L = _mm512_mask_blend_ps(0xaaaa, L, r1);
+    H = _mm512_mask_blend_ps(0xaaaa, H, r0);
+}
+
+
+static PA_FORCE_INLINE void interleave_v0(
+    vtype& out0, vtype& out1,
+    vtype lo, vtype hi
+){
+    out0 = _mm512_permutex2var_ps(lo, _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23), hi);
+    out1 = _mm512_permutex2var_ps(lo, _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31), hi);
+}
+static PA_FORCE_INLINE void interleave_v1(
+    vtype& out0, vtype& out1,
+    vtype lo, vtype hi
+){
+    __m512d l = _mm512_castps_pd(lo);
+    __m512d h = _mm512_castps_pd(hi);
+    out0 = _mm512_castpd_ps(_mm512_permutex2var_pd(l, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), h));
+    out1 = _mm512_castpd_ps(_mm512_permutex2var_pd(l, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), h));
+}
+
+
+};
+}
+}
+}
+#endif
@@ -0,0 +1,117 @@
+/*  ABS FFT Base Transform (x86 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_AbsFFT_BaseTransform_x86_AVX512_H
+#define PokemonAutomation_Kernels_AbsFFT_BaseTransform_x86_AVX512_H
+
+#include "Kernels_AbsFFT_Arch_x86_AVX512.h"
+#include "Kernels_AbsFFT_Butterflies.h"
+#include "Kernels_AbsFFT_ComplexVector.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AbsFFT{
+
+//  Uses the masked forms with a full mask because GCC 12 flags the "undefined"
+//  pass-through inside the plain unpack/shuffle_f32x4 intrinsics with
+//  -Wmaybe-uninitialized, which fails the -Werror build. Same instructions.
+PA_FORCE_INLINE void vtranspose(__m512 r[16]){
+    __m512 t[16];
+    for (size_t c = 0; c < 16; c += 2){
+        t[c + 0] = _mm512_mask_unpacklo_ps(r[c], 0xffff, r[c], r[c + 1]);
+        t[c + 1] = _mm512_mask_unpackhi_ps(r[c], 0xffff, r[c], r[c + 1]);
+    }
+
+    //  4x4 transpose within each 128-bit lane.
+    for (size_t c = 0; c < 16; c += 4){
+        r[c + 0] = _mm512_shuffle_ps(t[c + 0], t[c + 2], 68);
+        r[c + 1] = _mm512_shuffle_ps(t[c + 0], t[c + 2], 238);
+        r[c + 2] = _mm512_shuffle_ps(t[c + 1], t[c + 3], 68);
+        r[c + 3] = _mm512_shuffle_ps(t[c + 1], t[c + 3], 238);
+    }
+
+    //  4x4 transpose of the 128-bit lanes.
+    for (size_t c = 0; c < 4; c++){
+        __m512 a0 = _mm512_mask_shuffle_f32x4(r[c + 0], 0xffff, r[c + 0], r[c +  4], 0x88);
+        __m512 a1 = _mm512_mask_shuffle_f32x4(r[c + 0], 0xffff, r[c + 0], r[c +  4], 0xdd);
+        __m512 a2 = _mm512_mask_shuffle_f32x4(r[c + 8], 0xffff, r[c + 8], r[c + 12], 0x88);
+        __m512 a3 = _mm512_mask_shuffle_f32x4(r[c + 8], 0xffff, r[c + 8], r[c + 12], 0xdd);
+        t[c +  0] = _mm512_mask_shuffle_f32x4(a0, 0xffff, a0, a2, 0x88);
+        t[c +  4] = _mm512_mask_shuffle_f32x4(a1, 0xffff, a1, a3, 0x88);
+        t[c +  8] = _mm512_mask_shuffle_f32x4(a0, 0xffff, a0, a2, 0xdd);
+        t[c + 12] = _mm512_mask_shuffle_f32x4(a1, 0xffff, a1, a3, 0xdd);
+    }
+
+    for (size_t c = 0; c < 16; c++){
+        r[c] = t[c];
+    }
+}
+
+
+template <>
+void base_transform<Context_x86_AVX512>(const TwiddleTable<Context_x86_AVX512>& table, Context_x86_AVX512::vtype* T){
+    using Context = Context_x86_AVX512;
+
+    //  The first two radix-4 passes are across whole vectors.
+    Butterflies<Context>::reduce4(table, 8, T);
+    Butterflies<Context>::reduce4(table, 6, T +  0);
+    Butterflies<Context>::reduce4(table, 6, T +  8);
+    Butterflies<Context>::reduce4(table, 6, T + 16);
+    Butterflies<Context>::reduce4(table, 6, T + 24);
+
+    //  What remains is a 16-point transform inside each vector. Transpose so
+    //  that it becomes a transform across vectors.
+    __m512 r[16];
+    __m512 i[16];
+    for (size_t c = 0; c < 16; c++){
+        r[c] = T[2*c + 0];
+        i[c] = T[2*c + 1];
+    }
+    vtranspose(r);
+    vtranspose(i);
+
+    {
+        const vcomplex<Context>& w1 = table[3].w1[0];
+        const vcomplex<Context>& w2 = table[4].w1[0];
+        const vcomplex<Context>& w3 = table[4].w3[0];
+        Butterflies<Context>::butterfly4(
+            r[0], i[0],
+            r[4], i[4],
+            r[8], i[8],
+            r[12], i[12]
+        );
+        for (size_t c = 1; c < 4; c++){
+            Butterflies<Context>::butterfly4(
+                r[c +  0], i[c +  0],
+                r[c +  4], i[c +  4], Context::vset1(w1.real(c)), Context::vset1(w1.imag(c)),
+                r[c +  8], i[c +  8], Context::vset1(w2.real(c)), Context::vset1(w2.imag(c)),
+                r[c + 12], i[c + 12], Context::vset1(w3.real(c)), Context::vset1(w3.imag(c))
+            );
+        }
+    }
+    for (size_t c = 0; c < 16; c += 4){
+        Butterflies<Context>::butterfly4(
+            r[c + 0], i[c + 0],
+            r[c + 1], i[c + 1],
+            r[c + 2], i[c + 2],
+            r[c + 3], i[c + 3]
+        );
+    }
+
+    vtranspose(r);
+    vtranspose(i);
+    for (size_t c = 0; c < 16; c++){
+        T[2*c + 0] = r[c];
+        T[2*c + 1] = i[c];
+    }
+}
+
+
+
+}
+}
+}
+#endif
@@ -25,10 +25,10 @@ TwiddleTable<Context_Default>& global_table_Default(){
     static TwiddleTable<Context_Default> table(14);
     return table;
 }
-void fft_abs_Default(int k, float* abs, float* real){
+void fft_abs_Default(int k, size_t count, float* abs, float* real){
     TwiddleTable<Context_Default>& table = global_table_Default();
     table.ensure(k);
-    fft_abs(table, k, abs, real);
+    fft_abs_batch(table, k, count, abs, real);
 }
 
 
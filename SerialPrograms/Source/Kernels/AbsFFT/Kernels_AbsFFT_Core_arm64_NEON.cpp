@@ -0,0 +1,35 @@
+/*  ABS FFT (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include "Kernels_AbsFFT_Arch_arm64_NEON.h"
+#include "Kernels_AbsFFT_BaseTransform_arm64_NEON.h"
+#include "Kernels_AbsFFT_TwiddleTable.tpp"
+#include "Kernels_AbsFFT_FullTransform.tpp"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AbsFFT{
+
+
+
+TwiddleTable<Context_arm64_NEON>& global_table_arm64_NEON(){
+    static TwiddleTable<Context_arm64_NEON> table(14);
+    return table;
+}
+void fft_abs_arm64_NEON(int k, size_t count, float* abs, float* real){
+    TwiddleTable<Context_arm64_NEON>& table = global_table_arm64_NEON();
+    table.ensure(k);
+    fft_abs_batch(table, k, count, abs, real);
+}
+
+
+
+}
+}
+}
+#endif
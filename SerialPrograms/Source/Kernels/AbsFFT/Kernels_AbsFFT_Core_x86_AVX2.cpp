@@ -21,10 +21,10 @@ TwiddleTable<Context_x86_AVX2>& global_table_x86_AVX2(){
     static TwiddleTable<Context_x86_AVX2> table(14);
     return table;
 }
-void fft_abs_x86_AVX2(int k, float* abs, float* real){
+void fft_abs_x86_AVX2(int k, size_t count, float* abs, float* real){
     TwiddleTable<Context_x86_AVX2>& table = global_table_x86_AVX2();
     table.ensure(k);
-    fft_abs(table, k, abs, real);
+    fft_abs_batch(table, k, count, abs, real);
 }
 
 
@@ -21,10 +21,10 @@ TwiddleTable<Context_x86_SSE41>& global_table_x86_SSE41(){
     static TwiddleTable<Context_x86_SSE41> table(14);
     return table;
 }
-void fft_abs_x86_SSE41(int k, float* abs, float* real){
+void fft_abs_x86_SSE41(int k, size_t count, float* abs, float* real){
     TwiddleTable<Context_x86_SSE41>& table = global_table_x86_SSE41();
     table.ensure(k);
-    fft_abs(table, k, abs, real);
+    fft_abs_batch(table, k, count, abs, real);
 }
 
 
@@ -131,6 +131,17 @@ void fft_abs(const TwiddleTable<Context>& table, int k, float* abs, float* real)
 }
 
 
+template <typename Context>
+void fft_abs_batch(const TwiddleTable<Context>& table, int k, size_t count, float* abs, float* real){
+    size_t length = (size_t)1 << k;
+    for (size_t c = 0; c < count; c++){
+        fft_abs(table, k, abs, real);
+        abs += length / 2;
+        real += length;
+    }
+}
+
+
 
 
 
@@ -19,6 +19,9 @@ void convert_audio_sint16_to_float_Default(float* f, const int16_t* i, size_t le
 void convert_audio_float_to_sint16_Default(int16_t* i, const float* f, size_t length);
 void convert_audio_sint32_to_float_Default(float* f, const int32_t* i, size_t length, float output_multiplier);
 void convert_audio_float_to_sint32_Default(int32_t* i, const float* f, size_t length);
+void scale_audio_float_Default(float* out, const float* in, size_t length, float output_multiplier);
+void swap_audio_stereo_channels_Default(float* samples, size_t frames);
+void average_audio_stereo_to_mono_Default(float* out, const float* in, size_t frames);
 
 void convert_audio_uint8_to_float_x86_SSE41(float* f, const uint8_t* i, size_t length, float output_multiplier);
 void convert_audio_float_to_uint8_x86_SSE41(uint8_t* i, const float* f, size_t length);
@@ -26,6 +29,16 @@ void convert_audio_sint16_to_float_x86_SSE41(float* f, const int16_t* i, size_t
 void convert_audio_float_to_sint16_x86_SSE41(int16_t* i, const float* f, size_t length);
 void convert_audio_sint32_to_float_x86_SSE2(float* f, const int32_t* i, size_t length, float output_multiplier);
 void convert_audio_float_to_sint32_x86_SSE2(int32_t* i, const float* f, size_t length);
+void scale_audio_float_x86_SSE2(float* out, const float* in, size_t length, float output_multiplier);
+void swap_audio_stereo_channels_x86_SSE2(float* samples, size_t frames);
+void average_audio_stereo_to_mono_x86_SSE2(float* out, const float* in, size_t frames);
+
+void convert_audio_uint8_to_float_arm64_NEON(float* f, const uint8_t* i, size_t length, float output_multiplier);
+void convert_audio_sint16_to_float_arm64_NEON(float* f, const int16_t* i, size_t length, float output_multiplier);
+void convert_audio_sint32_to_float_arm64_NEON(float* f, const int32_t* i, size_t length, float output_multiplier);
+void scale_audio_float_arm64_NEON(float* out, const float* in, size_t length, float output_multiplier);
+void swap_audio_stereo_channels_arm64_NEON(float* samples, size_t frames);
+void average_audio_stereo_to_mono_arm64_NEON(float* out, const float* in, size_t frames);
 
 
 
@@ -36,6 +49,12 @@ void convert_audio_uint8_to_float(float* f, const uint8_t* i, size_t length, flo
         convert_audio_uint8_to_float_x86_SSE41(f, i, length, output_multiplier);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_uint8_to_float_arm64_NEON(f, i, length, output_multiplier);
+        return;
+    }
 #endif
     convert_audio_uint8_to_float_Default(f, i, length, output_multiplier);
 }
@@ -54,6 +73,12 @@ void convert_audio_sint16_to_float(float* f, const int16_t* i, size_t length, fl
         convert_audio_sint16_to_float_x86_SSE41(f, i, length, output_multiplier);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_sint16_to_float_arm64_NEON(f, i, length, output_multiplier);
+        return;
+    }
 #endif
     convert_audio_sint16_to_float_Default(f, i, length, output_multiplier);
 }
@@ -72,6 +97,12 @@ void convert_audio_sint32_to_float(float* f, const int32_t* i, size_t length, fl
         convert_audio_sint32_to_float_x86_SSE2(f, i, length, output_multiplier);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_audio_sint32_to_float_arm64_NEON(f, i, length, output_multiplier);
+        return;
+    }
 #endif
     convert_audio_sint32_to_float_Default(f, i, length, output_multiplier);
 }
@@ -85,6 +116,52 @@ void convert_audio_float_to_sint32(int32_t* i, const float* f, size_t length){
     convert_audio_float_to_sint32_Default(i, f, length);
 }
 
+void scale_audio_float(float* out, const float* in, size_t length, float output_multiplier){
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        scale_audio_float_x86_SSE2(out, in, length, output_multiplier);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        scale_audio_float_arm64_NEON(out, in, length, output_multiplier);
+        return;
+    }
+#endif
+    scale_audio_float_Default(out, in, length, output_multiplier);
+}
+void swap_audio_stereo_channels(float* samples, size_t frames){
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        swap_audio_stereo_channels_x86_SSE2(samples, frames);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        swap_audio_stereo_channels_arm64_NEON(samples, frames);
+        return;
+    }
+#endif
+    swap_audio_stereo_channels_Default(samples, frames);
+}
+void average_audio_stereo_to_mono(float* out, const float* in, size_t frames){
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        average_audio_stereo_to_mono_x86_SSE2(out, in, frames);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        average_audio_stereo_to_mono_arm64_NEON(out, in, frames);
+        return;
+    }
+#endif
+    average_audio_stereo_to_mono_Default(out, in, frames);
+}
+
 
 
 }
@@ -24,6 +24,15 @@ void convert_audio_float_to_sint16(int16_t* i, const float* f, size_t length);
 void convert_audio_sint32_to_float(float* f, const int32_t* i, size_t length, float output_multiplier);
 void convert_audio_float_to_sint32(int32_t* i, const float* f, size_t length);
 
+//  Float to float with a volume multiplier. "out" and "in" may be the same.
+void scale_audio_float(float* out, const float* in, size_t length, float output_multiplier);
+
+//  Swap the left and right samples of "frames" stereo frames in place.
+void swap_audio_stereo_channels(float* samples, size_t frames);
+
+//  Average each stereo frame down to one mono sample.
+void average_audio_stereo_to_mono(float* out, const float* in, size_t frames);
+
 
 
 
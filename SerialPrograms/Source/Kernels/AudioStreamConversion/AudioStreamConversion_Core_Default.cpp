@@ -70,6 +70,25 @@ void convert_audio_float_to_sint32_Default(int32_t* i, const float* f, size_t le
     }
 }
 
+void scale_audio_float_Default(float* out, const float* in, size_t length, float output_multiplier){
+    for (size_t c = 0; c < length; c++){
+        out[c] = in[c] * output_multiplier;
+    }
+}
+void swap_audio_stereo_channels_Default(float* samples, size_t frames){
+    for (size_t c = 0; c < frames; c++){
+        float r0 = samples[2*c + 0];
+        float r1 = samples[2*c + 1];
+        samples[2*c + 0] = r1;
+        samples[2*c + 1] = r0;
+    }
+}
+void average_audio_stereo_to_mono_Default(float* out, const float* in, size_t frames){
+    for (size_t c = 0; c < frames; c++){
+        out[c] = (in[2*c + 0] + in[2*c + 1]) * 0.5f;
+    }
+}
+
 
 
 
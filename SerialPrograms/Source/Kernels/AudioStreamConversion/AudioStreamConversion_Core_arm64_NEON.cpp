@@ -0,0 +1,153 @@
+/*  Audio Stream Conversion (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <arm_neon.h>
+#include <algorithm>
+#include "AudioStreamConversion.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AudioStreamConversion{
+
+
+
+void convert_audio_uint8_to_float_arm64_NEON(float* f, const uint8_t* i, size_t length, float output_multiplier){
+    const float32x4_t SCALE = vdupq_n_f32(output_multiplier / 127.f);
+    const float32x4_t SUB = vdupq_n_f32(output_multiplier);
+    size_t lc = length / 8;
+    while (lc--){
+        uint16x8_t i0 = vmovl_u8(vld1_u8(i));
+        float32x4_t f0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(i0)));
+        float32x4_t f1 = vcvtq_f32_u32(vmovl_high_u16(i0));
+        f0 = vsubq_f32(vmulq_f32(f0, SCALE), SUB);
+        f1 = vsubq_f32(vmulq_f32(f1, SCALE), SUB);
+        f0 = vminq_f32(vmaxq_f32(f0, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+        f1 = vminq_f32(vmaxq_f32(f1, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+        vst1q_f32(f + 0, f0);
+        vst1q_f32(f + 4, f1);
+        f += 8;
+        i += 8;
+    }
+
+    const float scale = output_multiplier / 127.f;
+    length %= 8;
+    while (length--){
+        float x = (float)i[0] * scale - output_multiplier;
+        x = std::max(x, -1.0f);
+        x = std::min(x, 1.0f);
+        f[0] = x;
+        f += 1;
+        i += 1;
+    }
+}
+
+void convert_audio_sint16_to_float_arm64_NEON(float* f, const int16_t* i, size_t length, float output_multiplier){
+    const float32x4_t SCALE = vdupq_n_f32(output_multiplier / 32767.f);
+    size_t lc = length / 8;
+    while (lc--){
+        int16x8_t i0 = vld1q_s16(i);
+        float32x4_t f0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(i0)));
+        float32x4_t f1 = vcvtq_f32_s32(vmovl_high_s16(i0));
+        f0 = vmulq_f32(f0, SCALE);
+        f1 = vmulq_f32(f1, SCALE);
+        f0 = vminq_f32(vmaxq_f32(f0, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+        f1 = vminq_f32(vmaxq_f32(f1, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+        vst1q_f32(f + 0, f0);
+        vst1q_f32(f + 4, f1);
+        f += 8;
+        i += 8;
+    }
+
+    const float scale = output_multiplier / 32767.f;
+    length %= 8;
+    while (length--){
+        float x = (float)i[0] * scale;
+        x = std::max(x, -1.0f);
+        x = std::min(x, 1.0f);
+        f[0] = x;
+        f += 1;
+        i += 1;
+    }
+}
+
+void convert_audio_sint32_to_float_arm64_NEON(float* f, const int32_t* i, size_t length, float output_multiplier){
+    const float32x4_t SCALE = vdupq_n_f32(output_multiplier / 2147483647.f);
+    size_t lc = length / 4;
+    while (lc--){
+        float32x4_t f0 = vcvtq_f32_s32(vld1q_s32(i));
+        f0 = vmulq_f32(f0, SCALE);
+        f0 = vminq_f32(vmaxq_f32(f0, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+        vst1q_f32(f, f0);
+        f += 4;
+        i += 4;
+    }
+
+    const float scale = output_multiplier / 2147483647.f;
+    length %= 4;
+    while (length--){
+        float x = (float)i[0] * scale;
+        x = std::max(x, -1.0f);
+        x = std::min(x, 1.0f);
+        f[0] = x;
+        f += 1;
+        i += 1;
+    }
+}
+
+void scale_audio_float_arm64_NEON(float* out, const float* in, size_t length, float output_multiplier){
+    size_t lc = length / 4;
+    while (lc--){
+        vst1q_f32(out, vmulq_n_f32(vld1q_f32(in), output_multiplier));
+        out += 4;
+        in += 4;
+    }
+
+    length %= 4;
+    while (length--){
+        out[0] = in[0] * output_multiplier;
+        out += 1;
+        in += 1;
+    }
+}
+void swap_audio_stereo_channels_arm64_NEON(float* samples, size_t frames){
+    size_t lc = frames / 2;
+    while (lc--){
+        vst1q_f32(samples, vrev64q_f32(vld1q_f32(samples)));
+        samples += 4;
+    }
+
+    if (frames % 2){
+        float r0 = samples[0];
+        samples[0] = samples[1];
+        samples[1] = r0;
+    }
+}
+void average_audio_stereo_to_mono_arm64_NEON(float* out, const float* in, size_t frames){
+    size_t lc = frames / 4;
+    while (lc--){
+        float32x4x2_t f0 = vld2q_f32(in);
+        vst1q_f32(out, vmulq_n_f32(vaddq_f32(f0.val[0], f0.val[1]), 0.5f));
+        out += 4;
+        in += 8;
+    }
+
+    frames %= 4;
+    while (frames--){
+        out[0] = (in[0] + in[1]) * 0.5f;
+        out += 1;
+        in += 2;
+    }
+}
+
+
+
+
+}
+}
+}
+#endif
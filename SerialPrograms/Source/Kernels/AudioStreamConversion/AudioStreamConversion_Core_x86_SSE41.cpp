@@ -181,6 +181,58 @@ void convert_audio_float_to_sint32_x86_SSE2(int32_t* i, const float* f, size_t l
     }
 }
 
+void scale_audio_float_x86_SSE2(float* out, const float* in, size_t length, float output_multiplier){
+    const __m128 SCALE = _mm_set1_ps(output_multiplier);
+    size_t lc = length / 4;
+    while (lc--){
+        _mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(in), SCALE));
+        out += 4;
+        in += 4;
+    }
+
+    length %= 4;
+    while (length--){
+        _mm_store_ss(out, _mm_mul_ss(_mm_load_ss(in), SCALE));
+        out += 1;
+        in += 1;
+    }
+}
+void swap_audio_stereo_channels_x86_SSE2(float* samples, size_t frames){
+    size_t lc = frames / 2;
+    while (lc--){
+        __m128 f0 = _mm_loadu_ps(samples);
+        f0 = _mm_shuffle_ps(f0, f0, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_ps(samples, f0);
+        samples += 4;
+    }
+
+    if (frames % 2){
+        float r0 = samples[0];
+        samples[0] = samples[1];
+        samples[1] = r0;
+    }
+}
+void average_audio_stereo_to_mono_x86_SSE2(float* out, const float* in, size_t frames){
+    const __m128 HALF = _mm_set1_ps(0.5f);
+    size_t lc = frames / 4;
+    while (lc--){
+        __m128 f0 = _mm_loadu_ps(in + 0);
+        __m128 f1 = _mm_loadu_ps(in + 4);
+        __m128 l = _mm_shuffle_ps(f0, f1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 r = _mm_shuffle_ps(f0, f1, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(out, _mm_mul_ps(_mm_add_ps(l, r), HALF));
+        out += 4;
+        in += 8;
+    }
+
+    frames %= 4;
+    while (frames--){
+        out[0] = (in[0] + in[1]) * 0.5f;
+        out += 1;
+        in += 2;
+    }
+}
+
 
 
 
@@ -0,0 +1,296 @@
+/*  Binary Image Morphology
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels_BinaryImage_Morphology.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+BinaryStructuringElement BinaryStructuringElement::rectangle(size_t width, size_t height){
+    return rectangle(width, height, width / 2, height / 2);
+}
+BinaryStructuringElement BinaryStructuringElement::rectangle(size_t width, size_t height, size_t anchor_x, size_t anchor_y){
+    BinaryStructuringElement ret(width, height, anchor_x, anchor_y);
+    for (char& bit : ret.m_bits){
+        bit = 1;
+    }
+    return ret;
+}
+BinaryStructuringElement BinaryStructuringElement::ellipse(size_t width, size_t height){
+    //  Same construction as cv::getStructuringElement(MORPH_ELLIPSE, ...).
+    //  A single row is only the center pixel. A single column is solid.
+    BinaryStructuringElement ret(width, height, width / 2, height / 2);
+    ptrdiff_t r = (ptrdiff_t)(height / 2);
+    ptrdiff_t c = (ptrdiff_t)(width / 2);
+    double inv_r2 = r == 0 ? 0 : 1. / ((double)r * r);
+    for (ptrdiff_t y = 0; y < (ptrdiff_t)height; y++){
+        ptrdiff_t dy = y - r;
+        if (dy < -r || dy > r){
+            continue;
+        }
+        ptrdiff_t dx = (ptrdiff_t)std::lround(c * std::sqrt((double)(r*r - dy*dy) * inv_r2));
+        ptrdiff_t x0 = std::max<ptrdiff_t>(c - dx, 0);
+        ptrdiff_t x1 = std::min<ptrdiff_t>(c + dx + 1, (ptrdiff_t)width);
+        for (ptrdiff_t x = x0; x < x1; x++){
+            ret.set(x, y, true);
+        }
+    }
+    return ret;
+}
+BinaryStructuringElement::BinaryStructuringElement(const std::vector<std::string>& rows, size_t anchor_x, size_t anchor_y)
+    : BinaryStructuringElement(rows.empty() ? 0 : rows[0].size(), rows.size(), anchor_x, anchor_y)
+{
+    for (size_t y = 0; y < m_height; y++){
+        const std::string& row = rows[y];
+        if (row.size() != m_width){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Structuring element rows must have the same length.");
+        }
+        for (size_t x = 0; x < m_width; x++){
+            set(x, y, row[x] == '1');
+        }
+    }
+}
+BinaryStructuringElement::BinaryStructuringElement(size_t width, size_t height, size_t anchor_x, size_t anchor_y)
+    : m_width(width)
+    , m_height(height)
+    , m_anchor_x(anchor_x)
+    , m_anchor_y(anchor_y)
+    , m_bits(width * height)
+{
+    if (width == 0 || height == 0){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Structuring element cannot be empty.");
+    }
+    if (anchor_x >= width || anchor_y >= height){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Structuring element anchor is out of bounds.");
+    }
+}
+std::string BinaryStructuringElement::dump() const{
+    std::string str;
+    for (size_t y = 0; y < m_height; y++){
+        for (size_t x = 0; x < m_width; x++){
+            str += get(x, y) ? '1' : '0';
+        }
+        str += "\n";
+    }
+    return str;
+}
+
+
+
+void binary_dilate_64x4_Default      (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_dilate_64x8_x64_SSE42    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_dilate_64x16_x64_AVX2    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_dilate_64x32_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_dilate_64x64_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_dilate_64x8_arm64_NEON   (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_dilate(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    switch (matrix.type()){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    case BinaryMatrixType::i64x64_x64_AVX512:
+        binary_dilate_64x64_x64_AVX512(matrix, element);
+        return;
+    case BinaryMatrixType::i64x32_x64_AVX512:
+        binary_dilate_64x32_x64_AVX512(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    case BinaryMatrixType::i64x16_x64_AVX2:
+        binary_dilate_64x16_x64_AVX2(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    case BinaryMatrixType::i64x8_x64_SSE42:
+        binary_dilate_64x8_x64_SSE42(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    case BinaryMatrixType::arm64x8_x64_NEON:
+        binary_dilate_64x8_arm64_NEON(matrix, element);
+        return;
+#endif
+    case BinaryMatrixType::i64x4_Default:
+        binary_dilate_64x4_Default(matrix, element);
+        return;
+    default:
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unsupported matrix format.");
+    }
+}
+
+
+void binary_erode_64x4_Default      (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_erode_64x8_x64_SSE42    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_erode_64x16_x64_AVX2    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_erode_64x32_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_erode_64x64_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_erode_64x8_arm64_NEON   (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_erode(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    switch (matrix.type()){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    case BinaryMatrixType::i64x64_x64_AVX512:
+        binary_erode_64x64_x64_AVX512(matrix, element);
+        return;
+    case BinaryMatrixType::i64x32_x64_AVX512:
+        binary_erode_64x32_x64_AVX512(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    case BinaryMatrixType::i64x16_x64_AVX2:
+        binary_erode_64x16_x64_AVX2(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    case BinaryMatrixType::i64x8_x64_SSE42:
+        binary_erode_64x8_x64_SSE42(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    case BinaryMatrixType::arm64x8_x64_NEON:
+        binary_erode_64x8_arm64_NEON(matrix, element);
+        return;
+#endif
+    case BinaryMatrixType::i64x4_Default:
+        binary_erode_64x4_Default(matrix, element);
+        return;
+    default:
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unsupported matrix format.");
+    }
+}
+
+
+void binary_open_64x4_Default      (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_open_64x8_x64_SSE42    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_open_64x16_x64_AVX2    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_open_64x32_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_open_64x64_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_open_64x8_arm64_NEON   (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_open(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    switch (matrix.type()){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    case BinaryMatrixType::i64x64_x64_AVX512:
+        binary_open_64x64_x64_AVX512(matrix, element);
+        return;
+    case BinaryMatrixType::i64x32_x64_AVX512:
+        binary_open_64x32_x64_AVX512(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    case BinaryMatrixType::i64x16_x64_AVX2:
+        binary_open_64x16_x64_AVX2(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    case BinaryMatrixType::i64x8_x64_SSE42:
+        binary_open_64x8_x64_SSE42(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    case BinaryMatrixType::arm64x8_x64_NEON:
+        binary_open_64x8_arm64_NEON(matrix, element);
+        return;
+#endif
+    case BinaryMatrixType::i64x4_Default:
+        binary_open_64x4_Default(matrix, element);
+        return;
+    default:
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unsupported matrix format.");
+    }
+}
+
+
+void binary_close_64x4_Default      (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_close_64x8_x64_SSE42    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_close_64x16_x64_AVX2    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_close_64x32_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_close_64x64_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_close_64x8_arm64_NEON   (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+void binary_close(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    switch (matrix.type()){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    case BinaryMatrixType::i64x64_x64_AVX512:
+        binary_close_64x64_x64_AVX512(matrix, element);
+        return;
+    case BinaryMatrixType::i64x32_x64_AVX512:
+        binary_close_64x32_x64_AVX512(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    case BinaryMatrixType::i64x16_x64_AVX2:
+        binary_close_64x16_x64_AVX2(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    case BinaryMatrixType::i64x8_x64_SSE42:
+        binary_close_64x8_x64_SSE42(matrix, element);
+        return;
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    case BinaryMatrixType::arm64x8_x64_NEON:
+        binary_close_64x8_arm64_NEON(matrix, element);
+        return;
+#endif
+    case BinaryMatrixType::i64x4_Default:
+        binary_close_64x4_Default(matrix, element);
+        return;
+    default:
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unsupported matrix format.");
+    }
+}
+
+
+void binary_hit_or_miss_64x4_Default      (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& hit, const BinaryStructuringElement& miss);
+void binary_hit_or_miss_64x8_x64_SSE42    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& hit, const BinaryStructuringElement& miss);
+void binary_hit_or_miss_64x16_x64_AVX2    (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& hit, const BinaryStructuringElement& miss);
+void binary_hit_or_miss_64x32_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& hit, const BinaryStructuringElement& miss);
+void binary_hit_or_miss_64x64_x64_AVX512  (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& hit, const BinaryStructuringElement& miss);
+void binary_hit_or_miss_64x8_arm64_NEON   (PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& hit, const BinaryStructuringElement& miss);
+void binary_hit_or_miss(
+    PackedBinaryMatrix_IB& matrix,
+    const BinaryStructuringElement& hit,
+    const BinaryStructuringElement& miss
+){
+    switch (matrix.type()){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    case BinaryMatrixType::i64x64_x64_AVX512:
+        binary_hit_or_miss_64x64_x64_AVX512(matrix, hit, miss);
+        return;
+    case BinaryMatrixType::i64x32_x64_AVX512:
+        binary_hit_or_miss_64x32_x64_AVX512(matrix, hit, miss);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    case BinaryMatrixType::i64x16_x64_AVX2:
+        binary_hit_or_miss_64x16_x64_AVX2(matrix, hit, miss);
+        return;
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    case BinaryMatrixType::i64x8_x64_SSE42:
+        binary_hit_or_miss_64x8_x64_SSE42(matrix, hit, miss);
+        return;
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    case BinaryMatrixType::arm64x8_x64_NEON:
+        binary_hit_or_miss_64x8_arm64_NEON(matrix, hit, miss);
+        return;
+#endif
+    case BinaryMatrixType::i64x4_Default:
+        binary_hit_or_miss_64x4_Default(matrix, hit, miss);
+        return;
+    default:
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unsupported matrix format.");
+    }
+}
+
+
+
+
+
+}
+}
@@ -0,0 +1,102 @@
+/*  Binary Image Morphology
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Binary morphology (dilate, erode, open, close, hit-or-miss) performed
+ *  directly on the packed binary matrices. This avoids expanding a matrix back
+ *  into an RGB image just to run it through OpenCV.
+ *
+ *  All operations are in-place and the matrix keeps its dimensions.
+ *  Pixels outside the matrix never affect the result. (dilate treats them as 0
+ *  and erode treats them as 1. This is the same as OpenCV's default border.)
+ *
+ *  Example Usage:
+ *
+ *      PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(...);
+ *
+ *      binary_dilate(matrix, BinaryStructuringElement::rectangle(3, 3));
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_BinaryImage_Morphology_H
+#define PokemonAutomation_Kernels_BinaryImage_Morphology_H
+
+#include <string>
+#include <vector>
+#include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  The shape used by the morphology operations.
+//  The anchor is the pixel of the element that lines up with the pixel being
+//  computed. Offsets into the element are relative to the anchor.
+class BinaryStructuringElement{
+public:
+    //  A solid "width x height" rectangle anchored at its center.
+    static BinaryStructuringElement rectangle(size_t width, size_t height);
+    static BinaryStructuringElement rectangle(size_t width, size_t height, size_t anchor_x, size_t anchor_y);
+
+    //  The ellipse inscribed in a "width x height" rectangle anchored at its center.
+    //  This is the same shape as OpenCV's MORPH_ELLIPSE.
+    static BinaryStructuringElement ellipse(size_t width, size_t height);
+
+    //  A custom shape. Each string is one row of the element. '1' marks a pixel
+    //  that is part of the element. Any other character is not.
+    //  All rows must have the same length.
+    BinaryStructuringElement(const std::vector<std::string>& rows, size_t anchor_x, size_t anchor_y);
+
+    BinaryStructuringElement(size_t width, size_t height, size_t anchor_x, size_t anchor_y);
+
+public:
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+    size_t anchor_x() const{ return m_anchor_x; }
+    size_t anchor_y() const{ return m_anchor_y; }
+
+    bool get(size_t x, size_t y) const{ return m_bits[x + y * m_width] != 0; }
+    void set(size_t x, size_t y, bool set){ m_bits[x + y * m_width] = set; }
+
+    std::string dump() const;
+
+private:
+    size_t m_width;
+    size_t m_height;
+    size_t m_anchor_x;
+    size_t m_anchor_y;
+    std::vector<char> m_bits;
+};
+
+
+
+//  A pixel is set if the element, placed with its anchor on any set pixel of
+//  the matrix, covers it.
+//  For symmetric elements this is the same as cv::dilate().
+void binary_dilate(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+
+//  A pixel is kept only if every pixel of the element, placed with its anchor
+//  on that pixel, covers a set pixel in the matrix.
+//  For symmetric elements this is the same as cv::erode().
+void binary_erode(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+
+//  Erode then dilate. Removes specks smaller than the element.
+void binary_open(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+
+//  Dilate then erode. Fills holes and gaps smaller than the element.
+void binary_close(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element);
+
+//  A pixel is set if every pixel of "hit" covers a set pixel and every pixel
+//  of "miss" covers a zero pixel. Each element is placed using its own anchor.
+void binary_hit_or_miss(
+    PackedBinaryMatrix_IB& matrix,
+    const BinaryStructuringElement& hit,
+    const BinaryStructuringElement& miss
+);
+
+
+
+
+}
+}
+#endif
@@ -0,0 +1,39 @@
+/*  Binary Image Morphology (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Kernels/BinaryMatrix/Kernels_BinaryMatrix_Arch_64xH_Default.h"
+#include "Kernels_BinaryImage_Morphology_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+void binary_dilate_64x4_Default(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    binary_dilate(static_cast<PackedBinaryMatrix_64x4_Default&>(matrix).get(), element);
+}
+void binary_erode_64x4_Default(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    binary_erode(static_cast<PackedBinaryMatrix_64x4_Default&>(matrix).get(), element);
+}
+void binary_open_64x4_Default(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    binary_open(static_cast<PackedBinaryMatrix_64x4_Default&>(matrix).get(), element);
+}
+void binary_close_64x4_Default(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    binary_close(static_cast<PackedBinaryMatrix_64x4_Default&>(matrix).get(), element);
+}
+void binary_hit_or_miss_64x4_Default(
+    PackedBinaryMatrix_IB& matrix,
+    const BinaryStructuringElement& hit,
+    const BinaryStructuringElement& miss
+){
+    binary_hit_or_miss(static_cast<PackedBinaryMatrix_64x4_Default&>(matrix).get(), hit, miss);
+}
+
+
+
+
+}
+}
@@ -0,0 +1,42 @@
+/*  Binary Image Morphology (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include "Kernels/BinaryMatrix/Kernels_BinaryMatrix_Arch_64x64_x64_AVX512.h"
+#include "Kernels_BinaryImage_Morphology_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+void binary_dilate_64x64_x64_AVX512(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    binary_dilate(static_cast<PackedBinaryMatrix_64x64_x64_AVX512&>(matrix).get(), element);
+}
+void binary_erode_64x64_x64_AVX512(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    binary_erode(static_cast<PackedBinaryMatrix_64x64_x64_AVX512&>(matrix).get(), element);
+}
+void binary_open_64x64_x64_AVX512(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    binary_open(static_cast<PackedBinaryMatrix_64x64_x64_AVX512&>(matrix).get(), element);
+}
+void binary_close_64x64_x64_AVX512(PackedBinaryMatrix_IB& matrix, const BinaryStructuringElement& element){
+    binary_close(static_cast<PackedBinaryMatrix_64x64_x64_AVX512&>(matrix).get(), element);
+}
+void binary_hit_or_miss_64x64_x64_AVX512(
+    PackedBinaryMatrix_IB& matrix,
+    const BinaryStructuringElement& hit,
+    const BinaryStructuringElement& miss
+){
+    binary_hit_or_miss(static_cast<PackedBinaryMatrix_64x64_x64_AVX512&>(matrix).get(), hit, miss);
+}
+
+
+
+
+}
+}
+#endif
@@ -0,0 +1,240 @@
+/*  Binary Image Morphology
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Everything here works on whole tiles. Shifting a matrix is done by OR'ing
+ *  each destination tile with the (up to) 4 source tiles that it overlaps,
+ *  using the tile's own SIMD shift routines. So the same code runs on every
+ *  tile format.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_BinaryImage_Morphology_Routines_H
+#define PokemonAutomation_Kernels_BinaryImage_Morphology_Routines_H
+
+#include <stddef.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+#include "Kernels_BinaryImage_Morphology.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+//  Zero everything outside the logical dimensions of the matrix.
+template <typename Matrix>
+void clear_padding(Matrix& matrix){
+    using Tile = typename Matrix::Tile;
+    size_t tile_width = matrix.tile_width();
+    size_t tile_height = matrix.tile_height();
+    if (tile_width == 0 || tile_height == 0){
+        return;
+    }
+    size_t wbits = matrix.width() - (tile_width - 1) * Tile::WIDTH;
+    size_t hbits = matrix.height() - (tile_height - 1) * Tile::HEIGHT;
+    for (size_t r = 0; r < tile_height; r++){
+        matrix.tile(tile_width - 1, r).clear_padding(wbits, Tile::HEIGHT);
+    }
+    for (size_t c = 0; c < tile_width; c++){
+        matrix.tile(c, tile_height - 1).clear_padding(Tile::WIDTH, hbits);
+    }
+}
+
+
+//  dest(x, y) |= src(x + shift_x, y + shift_y)
+//
+//  The two matrices may have different dimensions. Pixels that are outside
+//  "src" are zero.
+template <typename Matrix>
+void or_shifted(Matrix& dest, const Matrix& src, ptrdiff_t shift_x, ptrdiff_t shift_y){
+    using Tile = typename Matrix::Tile;
+    const ptrdiff_t TILE_WIDTH = Tile::WIDTH;
+    const ptrdiff_t TILE_HEIGHT = Tile::HEIGHT;
+
+    //  Split the shift into whole tiles and leftover bits. Round down so that
+    //  the leftover bits are never negative.
+    ptrdiff_t tile_shift_x = shift_x >= 0
+        ? shift_x / TILE_WIDTH
+        : -((TILE_WIDTH - 1 - shift_x) / TILE_WIDTH);
+    ptrdiff_t tile_shift_y = shift_y >= 0
+        ? shift_y / TILE_HEIGHT
+        : -((TILE_HEIGHT - 1 - shift_y) / TILE_HEIGHT);
+    size_t bit_shift_x = (size_t)(shift_x - tile_shift_x * TILE_WIDTH);
+    size_t bit_shift_y = (size_t)(shift_y - tile_shift_y * TILE_HEIGHT);
+
+    ptrdiff_t src_tile_width = (ptrdiff_t)src.tile_width();
+    ptrdiff_t src_tile_height = (ptrdiff_t)src.tile_height();
+    ptrdiff_t dest_tile_width = (ptrdiff_t)dest.tile_width();
+    ptrdiff_t dest_tile_height = (ptrdiff_t)dest.tile_height();
+
+    for (ptrdiff_t r = 0; r < dest_tile_height; r++){
+        ptrdiff_t src_y = r + tile_shift_y;
+        if (src_y + 1 < 0 || src_y >= src_tile_height){
+            continue;
+        }
+        bool upper = src_y >= 0;
+        bool lower = bit_shift_y != 0 && src_y + 1 < src_tile_height;
+
+        for (ptrdiff_t c = 0; c < dest_tile_width; c++){
+            ptrdiff_t src_x = c + tile_shift_x;
+            if (src_x + 1 < 0 || src_x >= src_tile_width){
+                continue;
+            }
+            bool left = src_x >= 0;
+            bool right = bit_shift_x != 0 && src_x + 1 < src_tile_width;
+
+            //  Same as submatrix(), but any of the 4 source tiles may be
+            //  off the edge.
+            Tile& tile = dest.tile(c, r);
+            if (upper && left){
+                src.tile(src_x, src_y).copy_to_shift_pp(tile, bit_shift_x, bit_shift_y);
+            }
+            if (upper && right){
+                src.tile(src_x + 1, src_y).copy_to_shift_np(tile, TILE_WIDTH - bit_shift_x, bit_shift_y);
+            }
+            if (lower && left){
+                src.tile(src_x, src_y + 1).copy_to_shift_pn(tile, bit_shift_x, TILE_HEIGHT - bit_shift_y);
+            }
+            if (lower && right){
+                src.tile(src_x + 1, src_y + 1).copy_to_shift_nn(tile, TILE_WIDTH - bit_shift_x, TILE_HEIGHT - bit_shift_y);
+            }
+        }
+    }
+
+    clear_padding(dest);
+}
+
+
+//  Returns "ret" where: ret(p) = OR of matrix(p - k * step) for k in [0, length).
+//  This takes log2(length) shifts.
+template <typename Matrix>
+Matrix dilate_line(const Matrix& matrix, ptrdiff_t step_x, ptrdiff_t step_y, size_t length){
+    Matrix ret = matrix;
+    size_t covered = 1;
+    while (covered < length){
+        ptrdiff_t shift = (ptrdiff_t)std::min(covered, length - covered);
+        Matrix next = ret;
+        or_shifted(next, ret, -shift * step_x, -shift * step_y);
+        ret = std::move(next);
+        covered += shift;
+    }
+    return ret;
+}
+
+
+//  out(p) |= OR of src(p + sign * offset) for every offset in the element.
+//  "sign" is -1 for dilation and +1 for erosion.
+//
+//  The element is split into horizontal runs. Rows that share the same run
+//  are dilated horizontally once, then the contiguous groups of those rows
+//  are dilated vertically. So a rectangle is only log2(w) + log2(h) shifts.
+template <typename Matrix>
+void or_element(Matrix& out, const Matrix& src, const BinaryStructuringElement& element, ptrdiff_t sign){
+    ptrdiff_t width = (ptrdiff_t)element.width();
+    ptrdiff_t height = (ptrdiff_t)element.height();
+    ptrdiff_t anchor_x = (ptrdiff_t)element.anchor_x();
+    ptrdiff_t anchor_y = (ptrdiff_t)element.anchor_y();
+
+    //  (start, length) of each run -> the rows that contain it.
+    std::map<std::pair<ptrdiff_t, ptrdiff_t>, std::vector<ptrdiff_t>> runs;
+    for (ptrdiff_t y = 0; y < height; y++){
+        ptrdiff_t x = 0;
+        while (x < width){
+            if (!element.get(x, y)){
+                x++;
+                continue;
+            }
+            ptrdiff_t start = x;
+            while (x < width && element.get(x, y)){
+                x++;
+            }
+            runs[{start, x - start}].emplace_back(y);
+        }
+    }
+    if (runs.empty()){
+        return;
+    }
+
+    //  Work in a frame that is large enough to hold every partial result.
+    //  Otherwise the intermediate runs would get clipped at the edges.
+    ptrdiff_t min_x = sign < 0 ? anchor_x - (width - 1) : -anchor_x;
+    ptrdiff_t min_y = sign < 0 ? anchor_y - (height - 1) : -anchor_y;
+    Matrix frame(src.width() + width - 1, src.height() + height - 1);
+    or_shifted(frame, src, min_x, min_y);
+
+    for (const auto& run : runs){
+        ptrdiff_t start = run.first.first;
+        size_t length = (size_t)run.first.second;
+        Matrix horizontal = dilate_line(frame, -sign, 0, length);
+
+        //  Where the first pixel of this run lands in the frame.
+        ptrdiff_t base_x = sign * (start - anchor_x) - min_x;
+
+        const std::vector<ptrdiff_t>& rows = run.second;
+        size_t c = 0;
+        while (c < rows.size()){
+            size_t stop = c + 1;
+            while (stop < rows.size() && rows[stop] == rows[stop - 1] + 1){
+                stop++;
+            }
+            ptrdiff_t base_y = sign * (rows[c] - anchor_y) - min_y;
+            Matrix vertical = dilate_line(horizontal, 0, -sign, stop - c);
+            or_shifted(out, vertical, base_x, base_y);
+            c = stop;
+        }
+    }
+}
+
+
+
+template <typename Matrix>
+void binary_dilate(Matrix& matrix, const BinaryStructuringElement& element){
+    Matrix out(matrix.width(), matrix.height());
+    or_element(out, matrix, element, -1);
+    matrix = std::move(out);
+}
+template <typename Matrix>
+void binary_erode(Matrix& matrix, const BinaryStructuringElement& element){
+    //  Erosion is the complement of dilating the complement. invert() leaves
+    //  the padding at zero, so pixels outside the matrix behave as ones.
+    matrix.invert();
+    Matrix out(matrix.width(), matrix.height());
+    or_element(out, matrix, element, +1);
+    out.invert();
+    matrix = std::move(out);
+}
+template <typename Matrix>
+void binary_open(Matrix& matrix, const BinaryStructuringElement& element){
+    binary_erode(matrix, element);
+    binary_dilate(matrix, element);
+}
+template <typename Matrix>
+void binary_close(Matrix& matrix, const BinaryStructuringElement& element){
+    binary_dilate(matrix, element);
+    binary_erode(matrix, element);
+}
+template <typename Matrix>
+void binary_hit_or_miss(
+    Matrix& matrix,
+    const BinaryStructuringElement& hit,
+    const BinaryStructuringElement& miss
+){
+    //  Eroding the complement by "miss" is the complement of OR'ing the
+    //  original. So the complement never needs to be built.
+    Matrix misses(matrix.width(), matrix.height());
+    or_element(misses, matrix, miss, +1);
+    misses.invert();
+
+    binary_erode(matrix, hit);
+    matrix &= misses;
+}
+
+
+
+
+}
+}
+#endif
@@ -23,7 +23,7 @@ PA_FORCE_INLINE void scale_brightness_x64_AVX2(
     __m256 scale
 ){
     size_t lc = width / 2;
-    do{
+    while (lc--){
         __m128i pixel = _mm_loadl_epi64((const __m128i*)image);
 
         __m256i pi = _mm256_cvtepu8_epi32(pixel);
@@ -44,7 +44,7 @@ PA_FORCE_INLINE void scale_brightness_x64_AVX2(
 
         _mm_storel_epi64((__m128i*)image, pixel);
         image += 2;
-    }while (--lc);
+    }
 
     if (width % 2){
         uint32_t pixel = image[0];
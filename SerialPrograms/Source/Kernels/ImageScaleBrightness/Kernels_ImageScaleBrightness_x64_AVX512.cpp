@@ -23,7 +23,7 @@ PA_FORCE_INLINE void scale_brightness_x64_AVX512(
     __m512 scale
 ){
     size_t lc = width / 4;
-    do{
+    while (lc--){
         __m128i pixel = _mm_loadu_si128((const __m128i*)image);
 
         __m512i pi = _mm512_cvtepu8_epi32(pixel);
@@ -36,7 +36,7 @@ PA_FORCE_INLINE void scale_brightness_x64_AVX512(
 
         _mm_storeu_si128((__m128i*)image, pixel);
         image += 4;
-    }while (--lc);
+    }
 
     if (width % 4){
         __mmask8 mask = ((uint32_t)1 << (width % 4)) - 1;
@@ -4,6 +4,7 @@
  *
  */
 
+#include <algorithm>
 #include "Common/Cpp/CpuId/CpuId.h"
 #include "Kernels_ImagePixelSumSqrDev.h"
 
@@ -43,6 +44,59 @@ void sum_sqr_deviation_x64_AVX512(
     const uint32_t* img, size_t img_bytes_per_line,
     uint32_t background
 );
+template <SumSquareMode mode>
+void sum_sqr_deviation_arm64_NEON(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_Default(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_x64_SSE41(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_x64_AVX2(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_x64_AVX512(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_arm64_NEON(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
 
 
 
@@ -89,6 +143,18 @@ void sum_sqr_deviation(
         );
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        sum_sqr_deviation_arm64_NEON<mode>(
+            count, sumsqrs,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            background
+        );
+        return;
+    }
 #endif
     sum_sqr_deviation_Default<mode>(
         count, sumsqrs,
@@ -100,6 +166,83 @@ void sum_sqr_deviation(
 }
 
 
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+){
+    //  Each ISA rounds the scaled channels the same way its "scale_brightness()"
+    //  does so that results don't change on any machine.
+    scaleR = std::max(scaleR, 0.0f);
+    scaleG = std::max(scaleG, 0.0f);
+    scaleB = std::max(scaleB, 0.0f);
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        sum_sqr_deviation_scaled_x64_AVX512<mode>(
+            count, sumsqrs,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            background,
+            scaleR, scaleG, scaleB
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        sum_sqr_deviation_scaled_x64_AVX2<mode>(
+            count, sumsqrs,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            background,
+            scaleR, scaleG, scaleB
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        sum_sqr_deviation_scaled_x64_SSE41<mode>(
+            count, sumsqrs,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            background,
+            scaleR, scaleG, scaleB
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        sum_sqr_deviation_scaled_arm64_NEON<mode>(
+            count, sumsqrs,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            background,
+            scaleR, scaleG, scaleB
+        );
+        return;
+    }
+#endif
+    sum_sqr_deviation_scaled_Default<mode>(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        background,
+        scaleR, scaleG, scaleB
+    );
+}
+
+
 void sum_sqr_deviation(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
@@ -143,6 +286,57 @@ void sum_sqr_deviation_masked(
 }
 
 
+void sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB
+){
+    sum_sqr_deviation_scaled<SumSquareMode::REFERENCE_ALPHA>(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        0,
+        scaleR, scaleG, scaleB
+    );
+}
+void sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+){
+    sum_sqr_deviation_scaled<SumSquareMode::USE_BACKGROUND>(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        background,
+        scaleR, scaleG, scaleB
+    );
+}
+void sum_sqr_deviation_masked_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB
+){
+    sum_sqr_deviation_scaled<SumSquareMode::ARBITRATE_ALPHAS>(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        0,
+        scaleR, scaleG, scaleB
+    );
+}
+
+
 
 }
 }
@@ -64,6 +64,39 @@ void sum_sqr_deviation_masked(
 );
 
 
+
+//
+//  Same as the above, but the RGB channels of every pixel in "ref" are first
+//  multiplied by "scaleR", "scaleG" and "scaleB".
+//
+//  The result is identical to running "scale_brightness()" on a copy of "ref"
+//  and passing the copy to the unscaled version. But it does it in a single
+//  pass without the copy.
+//
+void sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB
+);
+void sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+void sum_sqr_deviation_masked_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB
+);
+
+
 }
 }
 #endif
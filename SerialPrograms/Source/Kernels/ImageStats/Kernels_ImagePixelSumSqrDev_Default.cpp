@@ -5,6 +5,7 @@
  */
 
 #include <stdint.h>
+#include <algorithm>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Exceptions.h"
 #include "Kernels_ImagePixelSumSqrDev.h"
@@ -13,18 +14,47 @@ namespace PokemonAutomation{
 namespace Kernels{
 
 
-template <SumSquareMode mode>
+//  Same rounding as "scale_brightness_Default()".
+PA_FORCE_INLINE uint32_t scale_pixel_brightness_Default(
+    uint32_t pixel,
+    float scaleR, float scaleG, float scaleB
+){
+    float r = (float)((pixel >> 16) & 0x000000ff);
+    float g = (float)((pixel >> 8) & 0x000000ff);
+    float b = (float)(pixel & 0x000000ff);
+    r *= scaleR;
+    g *= scaleG;
+    b *= scaleB;
+
+    uint32_t r_u32 = std::min((uint32_t)r, (uint32_t)255);
+    uint32_t g_u32 = std::min((uint32_t)g, (uint32_t)255);
+    uint32_t b_u32 = std::min((uint32_t)b, (uint32_t)255);
+
+    pixel &= 0xff000000;
+    pixel |= r_u32 << 16;
+    pixel |= g_u32 << 8;
+    pixel |= b_u32;
+    return pixel;
+}
+
+
+template <SumSquareMode mode, bool scaled>
 PA_FORCE_INLINE void sum_sqr_deviation_Default(
     uint64_t& count, uint64_t& sumsqrs,
     uint16_t width,
     const uint32_t* ref, const uint32_t* img,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 ){
     uint32_t total = 0;
     for (size_t c = 0; c < width; c++){
         uint32_t r = ref[c];
         uint32_t i = img[c];
 
+        if (scaled){
+            r = scale_pixel_brightness_Default(r, scaleR, scaleG, scaleB);
+        }
+
         uint32_t alphaR = (int32_t)r >> 31;
 
         if (mode == SumSquareMode::REFERENCE_ALPHA){
@@ -78,9 +108,32 @@ void sum_sqr_deviation_Default(
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
     }
     for (size_t r = 0; r < height; r++){
-        sum_sqr_deviation_Default<mode>(
+        sum_sqr_deviation_Default<mode, false>(
+            count, sumsqrs,
+            (uint16_t)width, ref, img, background,
+            1, 1, 1
+        );
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+}
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_Default(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+){
+    if (width > 22017){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    for (size_t r = 0; r < height; r++){
+        sum_sqr_deviation_Default<mode, true>(
             count, sumsqrs,
-            (uint16_t)width, ref, img, background
+            (uint16_t)width, ref, img, background,
+            scaleR, scaleG, scaleB
         );
         ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
         img = (const uint32_t*)((const char*)img + img_bytes_per_line);
@@ -112,6 +165,33 @@ void sum_sqr_deviation_Default<SumSquareMode::ARBITRATE_ALPHAS>(
     const uint32_t* img, size_t img_bytes_per_line,
     uint32_t background
 );
+template
+void sum_sqr_deviation_scaled_Default<SumSquareMode::REFERENCE_ALPHA>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_Default<SumSquareMode::USE_BACKGROUND>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_Default<SumSquareMode::ARBITRATE_ALPHAS>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
 
 
 
@@ -0,0 +1,251 @@
+/*  Sum of Squares of Deviation (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <stdint.h>
+#include <arm_neon.h>
+#include "Common/Compiler.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels/Kernels_arm64_NEON.h"
+#include "Kernels/PartialWordAccess/Kernels_PartialWordAccess_arm64_NEON.h"
+#include "Kernels_ImagePixelSumSqrDev.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+template <SumSquareMode mode>
+PA_FORCE_INLINE void sum_sqr_deviation_arm64_NEON(
+    uint32x4_t& total, uint32x4_t& sum,
+    uint32x4_t r, uint32x4_t i,
+    uint32x4_t background
+){
+    uint32x4_t alphaR = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(r), 31));
+
+    if (mode == SumSquareMode::REFERENCE_ALPHA){
+        r = vandq_u32(r, alphaR);
+        i = vandq_u32(i, alphaR);
+    }
+    if (mode == SumSquareMode::USE_BACKGROUND){
+        r = vbslq_u32(alphaR, r, background);
+    }
+    if (mode == SumSquareMode::ARBITRATE_ALPHAS){
+        uint32x4_t alphaI = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(i), 31));
+        r = vandq_u32(r, alphaR);
+        i = vandq_u32(i, alphaI);
+        alphaI = veorq_u32(alphaI, alphaR);
+        r = vorrq_u32(r, alphaI);
+        i = vbicq_u32(i, alphaI);
+    }
+
+    //  Per-channel absolute difference with the alpha channel dropped.
+    uint8x16_t diff = vabdq_u8(vreinterpretq_u8_u32(r), vreinterpretq_u8_u32(i));
+    diff = vandq_u8(diff, vreinterpretq_u8_u32(vdupq_n_u32(0x00ffffff)));
+
+    //  Square to 16 bits, then pairwise add into the 32-bit accumulator.
+    uint16x8_t sqr_lo = vmull_u8(vget_low_u8(diff), vget_low_u8(diff));
+    uint16x8_t sqr_hi = vmull_high_u8(diff, diff);
+    sum = vpadalq_u16(sum, sqr_lo);
+    sum = vpadalq_u16(sum, sqr_hi);
+
+    total = vsubq_u32(total, alphaR);
+}
+
+
+//  Same rounding as "scale_brightness_arm64_NEON()".
+PA_FORCE_INLINE uint32x4_t scale_pixel_brightness_arm64_NEON(
+    uint32x4_t pixel,
+    float32x4_t scaleR, float32x4_t scaleG, float32x4_t scaleB
+){
+    const uint32x4_t mask = vdupq_n_u32(0xff);
+    const uint32x4_t max_brightness = vdupq_n_u32(255);
+
+    uint32x4_t b = vandq_u32(pixel, mask);
+    uint32x4_t g = vandq_u32(vshrq_n_u32(pixel, 8), mask);
+    uint32x4_t r = vandq_u32(vshrq_n_u32(pixel, 16), mask);
+    uint32x4_t a = vandq_u32(pixel, vdupq_n_u32(0xff000000));
+
+    b = vcvtq_u32_f32(vmulq_f32(vcvtq_f32_u32(b), scaleB));
+    g = vcvtq_u32_f32(vmulq_f32(vcvtq_f32_u32(g), scaleG));
+    r = vcvtq_u32_f32(vmulq_f32(vcvtq_f32_u32(r), scaleR));
+
+    b = vminq_u32(b, max_brightness);
+    g = vminq_u32(g, max_brightness);
+    r = vminq_u32(r, max_brightness);
+
+    uint32x4_t gb = vsliq_n_u32(b, g, 8);
+    uint32x4_t rgb = vsliq_n_u32(gb, r, 16);
+    return vorrq_u32(a, rgb);
+}
+
+
+template <SumSquareMode mode, bool scaled>
+PA_FORCE_INLINE void sum_sqr_deviation_arm64_NEON(
+    uint64_t& count, uint64_t& sumsqrs,
+    uint16_t width,
+    const uint32_t* ref, const uint32_t* img,
+    uint32x4_t background,
+    float32x4_t scaleR, float32x4_t scaleG, float32x4_t scaleB
+){
+    uint32x4_t total = vdupq_n_u32(0);
+    uint32x4_t sum = vdupq_n_u32(0);
+
+    size_t lc = width / 4;
+    for (size_t c = 0; c < lc; c++){
+        uint32x4_t r = vld1q_u32(ref);
+        uint32x4_t i = vld1q_u32(img);
+        if (scaled){
+            r = scale_pixel_brightness_arm64_NEON(r, scaleR, scaleG, scaleB);
+        }
+        sum_sqr_deviation_arm64_NEON<mode>(total, sum, r, i, background);
+        ref += 4;
+        img += 4;
+    }
+
+    //  Left-over pixels are loaded as zero which has zero alpha. So they
+    //  contribute nothing as long as the background is also zero.
+    size_t left = width % 4;
+    if (left){
+        PartialWordAccess_arm64_NEON loader(left * sizeof(uint32_t));
+        uint32x4_t r = vreinterpretq_u32_u8(loader.load(ref));
+        uint32x4_t i = vreinterpretq_u32_u8(loader.load(img));
+        if (scaled){
+            r = scale_pixel_brightness_arm64_NEON(r, scaleR, scaleG, scaleB);
+        }
+        background = vandq_u32(background, vreinterpretq_u32_u8(PartialWordAccess_arm64_NEON::create_front_mask(left * sizeof(uint32_t))));
+        sum_sqr_deviation_arm64_NEON<mode>(total, sum, r, i, background);
+    }
+
+    count += reduce32_arm64_NEON(total);
+    sumsqrs += reduce32_arm64_NEON(sum);
+}
+
+
+template <SumSquareMode mode, bool scaled>
+void sum_sqr_deviation_arm64_NEON(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+){
+    if (width > 22017){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    uint32x4_t vbackground = vdupq_n_u32(background);
+    float32x4_t vscaleR = vdupq_n_f32(scaleR);
+    float32x4_t vscaleG = vdupq_n_f32(scaleG);
+    float32x4_t vscaleB = vdupq_n_f32(scaleB);
+    for (size_t r = 0; r < height; r++){
+        sum_sqr_deviation_arm64_NEON<mode, scaled>(
+            count, sumsqrs,
+            (uint16_t)width, ref, img, vbackground,
+            vscaleR, vscaleG, vscaleB
+        );
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+}
+
+
+template <SumSquareMode mode>
+void sum_sqr_deviation_arm64_NEON(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+){
+    sum_sqr_deviation_arm64_NEON<mode, false>(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        background,
+        1, 1, 1
+    );
+}
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_arm64_NEON(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+){
+    sum_sqr_deviation_arm64_NEON<mode, true>(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        background,
+        scaleR, scaleG, scaleB
+    );
+}
+
+
+template
+void sum_sqr_deviation_arm64_NEON<SumSquareMode::REFERENCE_ALPHA>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template
+void sum_sqr_deviation_arm64_NEON<SumSquareMode::USE_BACKGROUND>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template
+void sum_sqr_deviation_arm64_NEON<SumSquareMode::ARBITRATE_ALPHAS>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template
+void sum_sqr_deviation_scaled_arm64_NEON<SumSquareMode::REFERENCE_ALPHA>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_arm64_NEON<SumSquareMode::USE_BACKGROUND>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_arm64_NEON<SumSquareMode::ARBITRATE_ALPHAS>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+
+
+
+
+}
+}
+#endif
@@ -147,6 +147,101 @@ void sum_sqr_deviation_x64_AVX2(
 }
 
 
+//  Same rounding as "scale_brightness_x64_AVX2()".
+PA_FORCE_INLINE __m256i scale_pixel_brightness_x64_AVX2(
+    __m256i pixel,
+    __m256 scaleR, __m256 scaleG, __m256 scaleB
+){
+    __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(pixel, _mm256_set1_epi32(0x000000ff)));
+    __m256 g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixel, 8), _mm256_set1_epi32(0x000000ff)));
+    __m256 r = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixel, 16), _mm256_set1_epi32(0x000000ff)));
+
+    b = _mm256_mul_ps(b, scaleB);
+    g = _mm256_mul_ps(g, scaleG);
+    r = _mm256_mul_ps(r, scaleR);
+
+    b = _mm256_max_ps(_mm256_min_ps(b, _mm256_set1_ps(255.)), _mm256_set1_ps(0.));
+    g = _mm256_max_ps(_mm256_min_ps(g, _mm256_set1_ps(255.)), _mm256_set1_ps(0.));
+    r = _mm256_max_ps(_mm256_min_ps(r, _mm256_set1_ps(255.)), _mm256_set1_ps(0.));
+
+    pixel = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+    pixel = _mm256_or_si256(pixel, _mm256_cvtps_epi32(b));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(_mm256_cvtps_epi32(g), 8));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(_mm256_cvtps_epi32(r), 16));
+    return pixel;
+}
+
+template <SumSquareMode mode>
+PA_FORCE_INLINE void sum_sqr_deviation_scaled_x64_AVX2(
+    uint64_t& count, uint64_t& sumsqrs,
+    uint16_t width,
+    const uint32_t* ref, const uint32_t* img,
+    __m256i background,
+    __m256 scaleR, __m256 scaleG, __m256 scaleB
+){
+    __m256i total = _mm256_setzero_si256();
+    __m256i sum = _mm256_setzero_si256();
+
+    const __m256i* ptrR = (const __m256i*)ref;
+    const __m256i* ptrI = (const __m256i*)img;
+
+    //  Unlike the unscaled version, there's no fallback for narrow images
+    //  since the default kernel rounds differently.
+    size_t lc = width / 8;
+    for (size_t c = 0; c < lc; c++){
+        __m256i r = _mm256_loadu_si256(ptrR);
+        __m256i i = _mm256_loadu_si256(ptrI);
+        r = scale_pixel_brightness_x64_AVX2(r, scaleR, scaleG, scaleB);
+        sum_sqr_deviation_x64_AVX2<mode>(total, sum, r, i, background);
+        ptrR++;
+        ptrI++;
+    }
+
+    if (width % 8){
+        __m256i mask = _mm256_cmpgt_epi32(
+            _mm256_set1_epi32(width % 8),
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+        );
+        __m256i r = _mm256_maskload_epi32((const int*)ptrR, mask);
+        __m256i i = _mm256_maskload_epi32((const int*)ptrI, mask);
+        r = scale_pixel_brightness_x64_AVX2(r, scaleR, scaleG, scaleB);
+
+        background = _mm256_and_si256(background, mask);
+        sum_sqr_deviation_x64_AVX2<mode>(total, sum, r, i, background);
+    }
+
+    count += reduce_add32_x64_AVX2(total);
+    sumsqrs += reduce_add32_x64_AVX2(sum);
+}
+
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_x64_AVX2(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+){
+    if (width > 22017){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    __m256i vbackground = _mm256_set1_epi32(background);
+    __m256 vscaleR = _mm256_set1_ps(scaleR);
+    __m256 vscaleG = _mm256_set1_ps(scaleG);
+    __m256 vscaleB = _mm256_set1_ps(scaleB);
+    for (size_t r = 0; r < height; r++){
+        sum_sqr_deviation_scaled_x64_AVX2<mode>(
+            count, sumsqrs,
+            (uint16_t)width, ref, img, vbackground,
+            vscaleR, vscaleG, vscaleB
+        );
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+}
+
+
 template
 void sum_sqr_deviation_x64_AVX2<SumSquareMode::REFERENCE_ALPHA>(
     uint64_t& count, uint64_t& sumsqrs,
@@ -171,6 +266,33 @@ void sum_sqr_deviation_x64_AVX2<SumSquareMode::ARBITRATE_ALPHAS>(
     const uint32_t* img, size_t img_bytes_per_line,
     uint32_t background
 );
+template
+void sum_sqr_deviation_scaled_x64_AVX2<SumSquareMode::REFERENCE_ALPHA>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_x64_AVX2<SumSquareMode::USE_BACKGROUND>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_x64_AVX2<SumSquareMode::ARBITRATE_ALPHAS>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
 
 
 
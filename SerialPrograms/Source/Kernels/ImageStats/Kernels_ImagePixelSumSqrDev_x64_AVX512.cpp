@@ -153,6 +153,97 @@ void sum_sqr_deviation_x64_AVX512(
 }
 
 
+//  Same rounding as "scale_brightness_x64_AVX512()".
+PA_FORCE_INLINE __m512i scale_pixel_brightness_x64_AVX512(
+    __m512i pixel,
+    __m512 scaleR, __m512 scaleG, __m512 scaleB
+){
+    __m512 b = _mm512_cvtepi32_ps(_mm512_and_si512(pixel, _mm512_set1_epi32(0x000000ff)));
+    __m512 g = _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(pixel, 8), _mm512_set1_epi32(0x000000ff)));
+    __m512 r = _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(pixel, 16), _mm512_set1_epi32(0x000000ff)));
+
+    b = _mm512_mul_ps(b, scaleB);
+    g = _mm512_mul_ps(g, scaleG);
+    r = _mm512_mul_ps(r, scaleR);
+
+    b = _mm512_max_ps(_mm512_min_ps(b, _mm512_set1_ps(255.)), _mm512_set1_ps(0.));
+    g = _mm512_max_ps(_mm512_min_ps(g, _mm512_set1_ps(255.)), _mm512_set1_ps(0.));
+    r = _mm512_max_ps(_mm512_min_ps(r, _mm512_set1_ps(255.)), _mm512_set1_ps(0.));
+
+    pixel = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+    pixel = _mm512_or_si512(pixel, _mm512_cvtps_epi32(b));
+    pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(_mm512_cvtps_epi32(g), 8));
+    pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(_mm512_cvtps_epi32(r), 16));
+    return pixel;
+}
+
+template <SumSquareMode mode>
+PA_FORCE_INLINE void sum_sqr_deviation_scaled_x64_AVX512(
+    uint64_t& count, uint64_t& sumsqrs,
+    uint16_t width,
+    const uint32_t* ref, const uint32_t* img,
+    __m512i background,
+    __m512 scaleR, __m512 scaleG, __m512 scaleB
+){
+    __m512i total = _mm512_setzero_si512();
+    __m512i sum = _mm512_setzero_si512();
+
+    const __m512i* ptrR = (const __m512i*)ref;
+    const __m512i* ptrI = (const __m512i*)img;
+
+    //  Unlike the unscaled version, there's no fallback for narrow images
+    //  since the default kernel rounds differently.
+    size_t lc = width / 16;
+    for (size_t c = 0; c < lc; c++){
+        __m512i r = _mm512_loadu_si512(ptrR);
+        __m512i i = _mm512_loadu_si512(ptrI);
+        r = scale_pixel_brightness_x64_AVX512(r, scaleR, scaleG, scaleB);
+        sum_sqr_deviation_x64_AVX512<mode>(total, sum, r, i, background);
+        ptrR++;
+        ptrI++;
+    }
+
+    if (width % 16){
+        __mmask16 mask = (((uint32_t)1 << (width % 16))) - 1;
+        __m512i r = _mm512_maskz_loadu_epi32(mask, ptrR);
+        __m512i i = _mm512_maskz_loadu_epi32(mask, ptrI);
+        r = scale_pixel_brightness_x64_AVX512(r, scaleR, scaleG, scaleB);
+        background = _mm512_maskz_mov_epi32(mask, background);
+        sum_sqr_deviation_x64_AVX512<mode>(total, sum, r, i, background);
+    }
+
+    count += _mm512_reduce_add_epi32(total);
+    sumsqrs += _mm512_reduce_add_epi32(sum);
+}
+
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_x64_AVX512(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+){
+    if (width > 22017){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    __m512i vbackground = _mm512_set1_epi32(background);
+    __m512 vscaleR = _mm512_set1_ps(scaleR);
+    __m512 vscaleG = _mm512_set1_ps(scaleG);
+    __m512 vscaleB = _mm512_set1_ps(scaleB);
+    for (size_t r = 0; r < height; r++){
+        sum_sqr_deviation_scaled_x64_AVX512<mode>(
+            count, sumsqrs,
+            (uint16_t)width, ref, img, vbackground,
+            vscaleR, vscaleG, vscaleB
+        );
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+}
+
+
 template
 void sum_sqr_deviation_x64_AVX512<SumSquareMode::REFERENCE_ALPHA>(
     uint64_t& count, uint64_t& sumsqrs,
@@ -177,6 +268,33 @@ void sum_sqr_deviation_x64_AVX512<SumSquareMode::ARBITRATE_ALPHAS>(
     const uint32_t* img, size_t img_bytes_per_line,
     uint32_t background
 );
+template
+void sum_sqr_deviation_scaled_x64_AVX512<SumSquareMode::REFERENCE_ALPHA>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_x64_AVX512<SumSquareMode::USE_BACKGROUND>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_x64_AVX512<SumSquareMode::ARBITRATE_ALPHAS>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
 
 
 
@@ -153,6 +153,102 @@ void sum_sqr_deviation_x64_SSE41(
 }
 
 
+//  Same rounding as "scale_brightness_x64_SSE41()".
+PA_FORCE_INLINE __m128i scale_pixel_brightness_x64_SSE41(
+    __m128i pixel,
+    __m128 scaleR, __m128 scaleG, __m128 scaleB
+){
+    __m128 b = _mm_cvtepi32_ps(_mm_and_si128(pixel, _mm_set1_epi32(0x000000ff)));
+    __m128 g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixel, 8), _mm_set1_epi32(0x000000ff)));
+    __m128 r = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixel, 16), _mm_set1_epi32(0x000000ff)));
+
+    b = _mm_mul_ps(b, scaleB);
+    g = _mm_mul_ps(g, scaleG);
+    r = _mm_mul_ps(r, scaleR);
+
+    b = _mm_max_ps(_mm_min_ps(b, _mm_set1_ps(255.)), _mm_set1_ps(0.));
+    g = _mm_max_ps(_mm_min_ps(g, _mm_set1_ps(255.)), _mm_set1_ps(0.));
+    r = _mm_max_ps(_mm_min_ps(r, _mm_set1_ps(255.)), _mm_set1_ps(0.));
+
+    pixel = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+    pixel = _mm_or_si128(pixel, _mm_cvtps_epi32(b));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(_mm_cvtps_epi32(g), 8));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(_mm_cvtps_epi32(r), 16));
+    return pixel;
+}
+
+template <SumSquareMode mode>
+PA_FORCE_INLINE void sum_sqr_deviation_scaled_x64_SSE41(
+    uint64_t& count, uint64_t& sumsqrs,
+    uint16_t width,
+    const uint32_t* ref, const uint32_t* img,
+    __m128i background,
+    __m128 scaleR, __m128 scaleG, __m128 scaleB
+){
+    __m128i total = _mm_setzero_si128();
+    __m128i sum = _mm_setzero_si128();
+
+    const __m128i* ptrR = (const __m128i*)ref;
+    const __m128i* ptrI = (const __m128i*)img;
+
+    //  Unlike the unscaled version, there's no fallback for narrow images
+    //  since the default kernel rounds differently.
+    size_t lc = width / 4;
+    for (size_t c = 0; c < lc; c++){
+        __m128i r = _mm_loadu_si128(ptrR);
+        __m128i i = _mm_loadu_si128(ptrI);
+        r = scale_pixel_brightness_x64_SSE41(r, scaleR, scaleG, scaleB);
+        sum_sqr_deviation_x64_SSE41<mode>(total, sum, r, i, background);
+        ptrR++;
+        ptrI++;
+    }
+
+    if (width % 4){
+        PartialWordAccess_x64_SSE41 loader(width * sizeof(uint32_t) % 16);
+        __m128i r = loader.load(ptrR);
+        __m128i i = loader.load(ptrI);
+        r = scale_pixel_brightness_x64_SSE41(r, scaleR, scaleG, scaleB);
+
+        __m128i mask = _mm_cmpgt_epi32(
+            _mm_set1_epi32(width % 4),
+            _mm_setr_epi32(0, 1, 2, 3)
+        );
+        background = _mm_and_si128(background, mask);
+        sum_sqr_deviation_x64_SSE41<mode>(total, sum, r, i, background);
+    }
+
+    count += reduce32_x64_SSE41(total);
+    sumsqrs += reduce32_x64_SSE41(sum);
+}
+
+template <SumSquareMode mode>
+void sum_sqr_deviation_scaled_x64_SSE41(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+){
+    if (width > 22017){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    __m128i vbackground = _mm_set1_epi32(background);
+    __m128 vscaleR = _mm_set1_ps(scaleR);
+    __m128 vscaleG = _mm_set1_ps(scaleG);
+    __m128 vscaleB = _mm_set1_ps(scaleB);
+    for (size_t r = 0; r < height; r++){
+        sum_sqr_deviation_scaled_x64_SSE41<mode>(
+            count, sumsqrs,
+            (uint16_t)width, ref, img, vbackground,
+            vscaleR, vscaleG, vscaleB
+        );
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+}
+
+
 template
 void sum_sqr_deviation_x64_SSE41<SumSquareMode::REFERENCE_ALPHA>(
     uint64_t& count, uint64_t& sumsqrs,
@@ -177,6 +273,33 @@ void sum_sqr_deviation_x64_SSE41<SumSquareMode::ARBITRATE_ALPHAS>(
     const uint32_t* img, size_t img_bytes_per_line,
     uint32_t background
 );
+template
+void sum_sqr_deviation_scaled_x64_SSE41<SumSquareMode::REFERENCE_ALPHA>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_x64_SSE41<SumSquareMode::USE_BACKGROUND>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_scaled_x64_SSE41<SumSquareMode::ARBITRATE_ALPHAS>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
 
 
 
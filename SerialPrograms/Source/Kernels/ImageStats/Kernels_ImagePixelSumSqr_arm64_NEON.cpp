@@ -0,0 +1,106 @@
+/*  Pixel Sum + Sum of Squares (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <stdint.h>
+#include <arm_neon.h>
+#include "Common/Compiler.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels/Kernels_arm64_NEON.h"
+#include "Kernels/PartialWordAccess/Kernels_PartialWordAccess_arm64_NEON.h"
+#include "Kernels_ImagePixelSumSqr.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct PixelSums_arm64_NEON{
+    uint32x4_t sumB = vdupq_n_u32(0);
+    uint32x4_t sumG = vdupq_n_u32(0);
+    uint32x4_t sumR = vdupq_n_u32(0);
+    uint32x4_t sumA = vdupq_n_u32(0);
+    uint32x4_t sqrB = vdupq_n_u32(0);
+    uint32x4_t sqrG = vdupq_n_u32(0);
+    uint32x4_t sqrR = vdupq_n_u32(0);
+
+    PA_FORCE_INLINE void add(uint32x4_t p, uint32x4_t m){
+        m = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(m), 31));
+        p = vandq_u32(p, m);
+
+        uint32x4_t r0 = vandq_u32(p, vdupq_n_u32(0x000000ff));
+        uint32x4_t r1 = vandq_u32(vshrq_n_u32(p, 8), vdupq_n_u32(0x000000ff));
+        uint32x4_t r2 = vandq_u32(vshrq_n_u32(p, 16), vdupq_n_u32(0x000000ff));
+
+        sumB = vaddq_u32(sumB, r0);
+        sumG = vaddq_u32(sumG, r1);
+        sumR = vaddq_u32(sumR, r2);
+        sumA = vsubq_u32(sumA, m);
+
+        sqrB = vmlaq_u32(sqrB, r0, r0);
+        sqrG = vmlaq_u32(sqrG, r1, r1);
+        sqrR = vmlaq_u32(sqrR, r2, r2);
+    }
+};
+
+
+PA_FORCE_INLINE void pixel_sum_sqr_arm64_NEON(
+    PixelSums& sums,
+    uint16_t width,
+    const uint32_t* image,
+    const uint32_t* alpha
+){
+    PixelSums_arm64_NEON row;
+
+    size_t lc = width / 4;
+    for (size_t c = 0; c < lc; c++){
+        row.add(vld1q_u32(image), vld1q_u32(alpha));
+        image += 4;
+        alpha += 4;
+    }
+
+    //  Left-over pixels are loaded with zero alpha so they are skipped.
+    size_t left = width % 4;
+    if (left){
+        PartialWordAccess_arm64_NEON loader(left * sizeof(uint32_t));
+        row.add(
+            vreinterpretq_u32_u8(loader.load(image)),
+            vreinterpretq_u32_u8(loader.load(alpha))
+        );
+    }
+
+    sums.count += reduce32_arm64_NEON(row.sumA);
+    sums.sumR += reduce32_arm64_NEON(row.sumR);
+    sums.sumG += reduce32_arm64_NEON(row.sumG);
+    sums.sumB += reduce32_arm64_NEON(row.sumB);
+    sums.sqrR += reduce32_arm64_NEON(row.sqrR);
+    sums.sqrG += reduce32_arm64_NEON(row.sqrG);
+    sums.sqrB += reduce32_arm64_NEON(row.sqrB);
+}
+void pixel_sum_sqr_arm64_NEON(
+    PixelSums& sums,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    const uint32_t* alpha, size_t alpha_bytes_per_row
+){
+    if (width == 0 || height == 0){
+        return;
+    }
+    if (width > 65535){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    for (size_t r = 0; r < height; r++){
+        pixel_sum_sqr_arm64_NEON(sums, (uint16_t)width, image, alpha);
+        image = (const uint32_t*)((const char*)image + image_bytes_per_row);
+        alpha = (const uint32_t*)((const char*)alpha + alpha_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
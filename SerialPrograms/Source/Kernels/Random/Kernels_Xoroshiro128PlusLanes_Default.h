@@ -0,0 +1,119 @@
+/*  Xoroshiro128+ Lanes (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Run several independent Xoroshiro128+ generators side by side.
+ *
+ *  Each lane produces exactly the same sequence as "Pokemon::Xoroshiro128Plus"
+ *  seeded with the same state. "next_int()" has the same rejection sampling as
+ *  "Xoroshiro128Plus::nextInt()". Since lanes can reject a different number of
+ *  times, each lane is only advanced until it accepts.
+ *
+ *  The vector versions have the same interface, so code written against this
+ *  can be instantiated once per instruction set.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_Xoroshiro128PlusLanes_Default_H
+#define PokemonAutomation_Kernels_Xoroshiro128PlusLanes_Default_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class Xoroshiro128PlusLanes_Default{
+public:
+    static constexpr size_t LANES = 1;
+    using Vector = uint64_t;
+    using Mask = bool;
+
+public:
+    PA_FORCE_INLINE Xoroshiro128PlusLanes_Default(const uint64_t s0[LANES], uint64_t s1)
+        : m_s0(s0[0])
+        , m_s1(s1)
+    {}
+
+    //  Returns a value in [0, bound) for every lane.
+    //  "power_mask" must be "nextPowerOfTwo(bound) - 1".
+    PA_FORCE_INLINE Vector next_int(Vector bound, Vector power_mask){
+        uint64_t result = next() & power_mask;
+        while (result >= bound){
+            result = next() & power_mask;
+        }
+        return result;
+    }
+
+    //  Same as above, but only for the lanes in "active". The other lanes are
+    //  not advanced and return zero.
+    PA_FORCE_INLINE Vector next_int(Mask active, Vector bound, Vector power_mask){
+        return active ? next_int(bound, power_mask) : 0;
+    }
+
+
+public:
+    static PA_FORCE_INLINE Vector broadcast(uint64_t x){
+        return x;
+    }
+    static PA_FORCE_INLINE Mask mask_none(){
+        return false;
+    }
+    static PA_FORCE_INLINE Mask mask_all(){
+        return true;
+    }
+    static PA_FORCE_INLINE Mask mask_and(Mask x, Mask y){
+        return x && y;
+    }
+    static PA_FORCE_INLINE Mask mask_andnot(Mask x, Mask y){
+        return !x && y;
+    }
+    static PA_FORCE_INLINE Mask cmplt(Vector x, Vector y){
+        return x < y;
+    }
+
+    static PA_FORCE_INLINE Vector bitwise_and(Vector x, Vector y){
+        return x & y;
+    }
+    template <int shift>
+    static PA_FORCE_INLINE Vector shift_right(Vector x){
+        return x >> shift;
+    }
+
+    //  Returns "table[index]" for every lane.
+    static PA_FORCE_INLINE Vector gather_u32(const uint32_t* table, Vector index){
+        return table[index];
+    }
+    static PA_FORCE_INLINE void store(uint64_t data[LANES], Vector x){
+        data[0] = x;
+    }
+
+
+private:
+    static PA_FORCE_INLINE uint64_t rotl(uint64_t x, int k){
+        return (x << k) | (x >> (64 - k));
+    }
+    PA_FORCE_INLINE uint64_t next(){
+        const uint64_t s0 = m_s0;
+        uint64_t s1 = m_s1;
+        const uint64_t result = s0 + s1;
+
+        s1 ^= s0;
+        m_s0 = rotl(s0, 24) ^ s1 ^ (s1 << 16);
+        m_s1 = rotl(s1, 37);
+
+        return result;
+    }
+
+private:
+    uint64_t m_s0;
+    uint64_t m_s1;
+};
+
+
+
+}
+}
+#endif
@@ -0,0 +1,116 @@
+/*  Xoroshiro128+ Lanes (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  See "Kernels_Xoroshiro128PlusLanes_Default.h" for documentation.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_Xoroshiro128PlusLanes_x64_AVX2_H
+#define PokemonAutomation_Kernels_Xoroshiro128PlusLanes_x64_AVX2_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class Xoroshiro128PlusLanes_x64_AVX2{
+public:
+    static constexpr size_t LANES = 4;
+    using Vector = __m256i;
+    using Mask = __m256i;
+
+public:
+    PA_FORCE_INLINE Xoroshiro128PlusLanes_x64_AVX2(const uint64_t s0[LANES], uint64_t s1)
+        : m_s0(_mm256_loadu_si256((const __m256i*)s0))
+        , m_s1(_mm256_set1_epi64x(s1))
+    {}
+
+    //  All values involved are far below 2^63, so signed compares are fine.
+    PA_FORCE_INLINE Vector next_int(Vector bound, Vector power_mask){
+        return next_int(mask_all(), bound, power_mask);
+    }
+    PA_FORCE_INLINE Vector next_int(Mask active, Vector bound, Vector power_mask){
+        __m256i result = _mm256_setzero_si256();
+        while (!_mm256_testz_si256(active, active)){
+            __m256i x = _mm256_and_si256(next(active), power_mask);
+            __m256i accept = _mm256_and_si256(active, _mm256_cmpgt_epi64(bound, x));
+            result = _mm256_blendv_epi8(result, x, accept);
+            active = _mm256_andnot_si256(accept, active);
+        }
+        return result;
+    }
+
+
+public:
+    static PA_FORCE_INLINE Vector broadcast(uint64_t x){
+        return _mm256_set1_epi64x(x);
+    }
+    static PA_FORCE_INLINE Mask mask_none(){
+        return _mm256_setzero_si256();
+    }
+    static PA_FORCE_INLINE Mask mask_all(){
+        return _mm256_set1_epi32(-1);
+    }
+    static PA_FORCE_INLINE Mask mask_and(Mask x, Mask y){
+        return _mm256_and_si256(x, y);
+    }
+    static PA_FORCE_INLINE Mask mask_andnot(Mask x, Mask y){
+        return _mm256_andnot_si256(x, y);
+    }
+    static PA_FORCE_INLINE Mask cmplt(Vector x, Vector y){
+        return _mm256_cmpgt_epi64(y, x);
+    }
+
+    static PA_FORCE_INLINE Vector bitwise_and(Vector x, Vector y){
+        return _mm256_and_si256(x, y);
+    }
+    template <int shift>
+    static PA_FORCE_INLINE Vector shift_right(Vector x){
+        return _mm256_srli_epi64(x, shift);
+    }
+
+    static PA_FORCE_INLINE Vector gather_u32(const uint32_t* table, Vector index){
+        return _mm256_cvtepu32_epi64(_mm256_i64gather_epi32((const int*)table, index, 4));
+    }
+    static PA_FORCE_INLINE void store(uint64_t data[LANES], Vector x){
+        _mm256_storeu_si256((__m256i*)data, x);
+    }
+
+
+private:
+    template <int k>
+    static PA_FORCE_INLINE __m256i rotl(__m256i x){
+        return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+    }
+
+    //  Advance only the lanes in "active". Returns the output of every lane.
+    PA_FORCE_INLINE __m256i next(__m256i active){
+        __m256i s0 = m_s0;
+        __m256i s1 = m_s1;
+        __m256i result = _mm256_add_epi64(s0, s1);
+
+        s1 = _mm256_xor_si256(s1, s0);
+        s0 = _mm256_xor_si256(rotl<24>(s0), _mm256_xor_si256(s1, _mm256_slli_epi64(s1, 16)));
+        s1 = rotl<37>(s1);
+
+        m_s0 = _mm256_blendv_epi8(m_s0, s0, active);
+        m_s1 = _mm256_blendv_epi8(m_s1, s1, active);
+
+        return result;
+    }
+
+private:
+    __m256i m_s0;
+    __m256i m_s1;
+};
+
+
+
+}
+}
+#endif
@@ -0,0 +1,110 @@
+/*  Xoroshiro128+ Lanes (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  See "Kernels_Xoroshiro128PlusLanes_Default.h" for documentation.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_Xoroshiro128PlusLanes_x64_AVX512_H
+#define PokemonAutomation_Kernels_Xoroshiro128PlusLanes_x64_AVX512_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class Xoroshiro128PlusLanes_x64_AVX512{
+public:
+    static constexpr size_t LANES = 8;
+    using Vector = __m512i;
+    using Mask = __mmask8;
+
+public:
+    PA_FORCE_INLINE Xoroshiro128PlusLanes_x64_AVX512(const uint64_t s0[LANES], uint64_t s1)
+        : m_s0(_mm512_loadu_si512(s0))
+        , m_s1(_mm512_set1_epi64(s1))
+    {}
+
+    PA_FORCE_INLINE Vector next_int(Vector bound, Vector power_mask){
+        return next_int(mask_all(), bound, power_mask);
+    }
+    PA_FORCE_INLINE Vector next_int(Mask active, Vector bound, Vector power_mask){
+        __m512i result = _mm512_setzero_si512();
+        while (active){
+            __m512i x = _mm512_and_si512(next(active), power_mask);
+            __mmask8 accept = _mm512_mask_cmplt_epu64_mask(active, x, bound);
+            result = _mm512_mask_mov_epi64(result, accept, x);
+            active &= ~accept;
+        }
+        return result;
+    }
+
+
+public:
+    static PA_FORCE_INLINE Vector broadcast(uint64_t x){
+        return _mm512_set1_epi64(x);
+    }
+    static PA_FORCE_INLINE Mask mask_none(){
+        return 0;
+    }
+    static PA_FORCE_INLINE Mask mask_all(){
+        return 0xff;
+    }
+    static PA_FORCE_INLINE Mask mask_and(Mask x, Mask y){
+        return x & y;
+    }
+    static PA_FORCE_INLINE Mask mask_andnot(Mask x, Mask y){
+        return ~x & y;
+    }
+    static PA_FORCE_INLINE Mask cmplt(Vector x, Vector y){
+        return _mm512_cmplt_epu64_mask(x, y);
+    }
+
+    static PA_FORCE_INLINE Vector bitwise_and(Vector x, Vector y){
+        return _mm512_and_si512(x, y);
+    }
+    template <int shift>
+    static PA_FORCE_INLINE Vector shift_right(Vector x){
+        return _mm512_srli_epi64(x, shift);
+    }
+
+    static PA_FORCE_INLINE Vector gather_u32(const uint32_t* table, Vector index){
+        return _mm512_cvtepu32_epi64(_mm512_i64gather_epi32(index, table, 4));
+    }
+    static PA_FORCE_INLINE void store(uint64_t data[LANES], Vector x){
+        _mm512_storeu_si512(data, x);
+    }
+
+
+private:
+    //  Advance only the lanes in "active". Returns the output of every lane.
+    PA_FORCE_INLINE __m512i next(__mmask8 active){
+        __m512i s0 = m_s0;
+        __m512i s1 = m_s1;
+        __m512i result = _mm512_add_epi64(s0, s1);
+
+        s1 = _mm512_xor_si512(s1, s0);
+        s0 = _mm512_ternarylogic_epi64(_mm512_rol_epi64(s0, 24), s1, _mm512_slli_epi64(s1, 16), 0x96);
+        s1 = _mm512_rol_epi64(s1, 37);
+
+        m_s0 = _mm512_mask_mov_epi64(m_s0, active, s0);
+        m_s1 = _mm512_mask_mov_epi64(m_s1, active, s1);
+
+        return result;
+    }
+
+private:
+    __m512i m_s0;
+    __m512i m_s1;
+};
+
+
+
+}
+}
+#endif
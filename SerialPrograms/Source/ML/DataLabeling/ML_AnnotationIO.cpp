@@ -9,9 +9,12 @@
 #include <iostream>
 #include <map>
 #include <sstream>
+#include <string.h>
 #include <QDirIterator>
 #include <QDir>
+#include <QFile>
 #include <QMessageBox>
+#include <onnxruntime_cxx_api.h>
 
 #include "Common/Cpp/Json/JsonTools.h"
 #include "Common/Cpp/Json/JsonArray.h"
@@ -29,15 +32,34 @@ using std::cout, std::endl;
 namespace PokemonAutomation{
 namespace ML{
 
+//  Float16 embedding files start with this tag instead of the channel count
+//  used by the original float32 format. It can never be a valid channel count.
+const uint32_t EMBEDDING_FP16_MAGIC = 0x36314D45;   //  "EM16"
+
+
 // save the image embedding as a file with path <image_filepath>.embedding
-void save_image_embedding_to_disk(const std::string& image_filepath, const std::vector<float>& embedding){
+void save_image_embedding_to_disk(
+    const std::string& image_filepath, const std::vector<float>& embedding,
+    bool half_precision
+){
     const std::string embedding_path = image_filepath + ".embedding";
     std::ofstream fout(embedding_path, std::ios::binary);
+    if (half_precision){
+        fout.write(reinterpret_cast<const char*>(&EMBEDDING_FP16_MAGIC), sizeof(EMBEDDING_FP16_MAGIC));
+    }
     // write embedding shape
     fout.write(reinterpret_cast<const char*>(&SAM_EMBEDDER_OUTPUT_N_CHANNELS), sizeof(SAM_EMBEDDER_OUTPUT_N_CHANNELS));
     fout.write(reinterpret_cast<const char*>(&SAM_EMBEDDER_OUTPUT_IMAGE_SIZE), sizeof(SAM_EMBEDDER_OUTPUT_IMAGE_SIZE));
     fout.write(reinterpret_cast<const char*>(&SAM_EMBEDDER_OUTPUT_IMAGE_SIZE), sizeof(SAM_EMBEDDER_OUTPUT_IMAGE_SIZE));
-    fout.write(reinterpret_cast<const char*>(embedding.data()), sizeof(float) * embedding.size());
+    if (half_precision){
+        std::vector<Ort::Float16_t> half(embedding.size());
+        for (size_t i = 0; i < embedding.size(); i++){
+            half[i] = Ort::Float16_t(embedding[i]);
+        }
+        fout.write(reinterpret_cast<const char*>(half.data()), sizeof(Ort::Float16_t) * half.size());
+    }else{
+        fout.write(reinterpret_cast<const char*>(embedding.data()), sizeof(float) * embedding.size());
+    }
     fout.close();
     std::cout << "Saved image embedding as " << embedding_path << std::endl;
 }
@@ -45,28 +67,68 @@ void save_image_embedding_to_disk(const std::string& image_filepath, const std::
 
 bool load_image_embedding(const std::string& image_filepath, std::vector<float>& image_embedding){
     std::string emebdding_path = image_filepath + ".embedding";
-    std::ifstream fin(emebdding_path, std::ios::binary);
-    if (!fin.is_open()){
+    QFile file(QString::fromStdString(emebdding_path));
+    if (!file.open(QIODevice::ReadOnly)){
         std::cout << "No embedding for image " << image_filepath << std::endl;
         return false;
     }
 
+    const size_t file_size = (size_t)file.size();
+    const uchar* data = file.map(0, file.size());
+    if (data == nullptr){
+        std::string err_msg = "Unable to map image embedding file " + emebdding_path;
+        std::cerr << err_msg << std::endl;
+        throw std::runtime_error(err_msg);
+    }
+
+    size_t offset = 0;
+    auto read_header = [&](void* value){
+        if (offset + sizeof(int) > file_size){
+            return;
+        }
+        memcpy(value, data + offset, sizeof(int));
+        offset += sizeof(int);
+    };
+
+    uint32_t tag = 0;
+    read_header(&tag);
+    const bool half_precision = tag == EMBEDDING_FP16_MAGIC;
     int embedding_n_channels = 0, embedding_height = 0, emebedding_width = 0;
-    fin.read(reinterpret_cast<char*>(&embedding_n_channels), sizeof(int));
-    fin.read(reinterpret_cast<char*>(&embedding_height), sizeof(int));
-    fin.read(reinterpret_cast<char*>(&emebedding_width), sizeof(int));
+    if (half_precision){
+        read_header(&embedding_n_channels);
+    }else{
+        memcpy(&embedding_n_channels, &tag, sizeof(int));
+    }
+    read_header(&embedding_height);
+    read_header(&emebedding_width);
 
     std::cout << "Image embedding shape [" << embedding_n_channels << ", " << embedding_height
-              << ", " << emebedding_width << "]" << std::endl;
+              << ", " << emebedding_width << "]" << (half_precision ? " float16" : "") << std::endl;
     if (embedding_n_channels <= 0 || embedding_height <= 0 || emebedding_width <= 0){
         std::string err_msg = "Image embedding wrong dimension from " + emebdding_path;
         std::cerr << err_msg << std::endl;
         throw std::runtime_error(err_msg);
     }
 
-    const int size = embedding_n_channels * embedding_height * emebedding_width;
+    const size_t size = (size_t)embedding_n_channels * embedding_height * emebedding_width;
+    const size_t element_size = half_precision ? sizeof(Ort::Float16_t) : sizeof(float);
+    if (offset + size * element_size > file_size){
+        std::string err_msg = "Image embedding file truncated: " + emebdding_path;
+        std::cerr << err_msg << std::endl;
+        throw std::runtime_error(err_msg);
+    }
+
     image_embedding.resize(size);
-    fin.read(reinterpret_cast<char*>(image_embedding.data()), sizeof(float) * size);
+    if (half_precision){
+        const uint16_t* half = reinterpret_cast<const uint16_t*>(data + offset);
+        for (size_t i = 0; i < size; i++){
+            uint16_t bits;
+            memcpy(&bits, half + i, sizeof(uint16_t));
+            image_embedding[i] = Ort::Float16_t::FromBits(bits).ToFloat();
+        }
+    }else{
+        memcpy(image_embedding.data(), data + offset, sizeof(float) * size);
+    }
     std::cout << "Loaded image embedding from " << emebdding_path << std::endl;
     return true;
 }
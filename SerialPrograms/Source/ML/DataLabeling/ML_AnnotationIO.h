@@ -17,10 +17,17 @@ namespace ML{
 // Load pre-computed image embedding from disk
 // Return true if there is the embedding file.
 // The embedding is stored in a file in the same folder as the image, having the same name but with a suffix ".embedding".
+// Both the float32 and the float16 embedding formats are accepted. The file is memory-mapped
+// instead of read into a buffer, but the values are still copied (and for float16, expanded)
+// into "image_embedding" since the SAM decoder takes float32 input.
 bool load_image_embedding(const std::string& image_filepath, std::vector<float>& image_embedding);
 
 // Save the image embedding as a file with path <image_filepath>.embedding.
-void save_image_embedding_to_disk(const std::string& image_filepath, const std::vector<float>& embedding);
+// half_precision: store the embedding as float16, using half the disk space.
+void save_image_embedding_to_disk(
+    const std::string& image_filepath, const std::vector<float>& embedding,
+    bool half_precision = false
+);
 
 // Find image paths stored in a folder. The search can be recursive into child folders or not.
 std::vector<std::string> find_images_in_folder(const std::string& folder_path, bool recursive);
@@ -7,13 +7,18 @@
 
 #include <QDir>
 #include <QDirIterator>
+#include <atomic>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <condition_variable>
 #include <QMessageBox>
 #include <onnxruntime_cxx_api.h>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
 #include "3rdParty/ONNX/OnnxToolsPA.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 #include "CommonFramework/Globals.h"
 #include "ML/Models/ML_ONNXRuntimeHelpers.h"
 #include "ML_SegmentAnythingModelConstants.h"
@@ -24,8 +29,8 @@ namespace PokemonAutomation{
 namespace ML{
 
 
-SAMEmbedderSession::SAMEmbedderSession(const std::string& model_path)
-    : m_session_options{create_session_options(ML_MODEL_CACHE_PATH() + "SAMEmbedder/")}
+SAMEmbedderSession::SAMEmbedderSession(const std::string& model_path, int intra_op_threads)
+    : m_session_options{create_session_options(ML_MODEL_CACHE_PATH() + "SAMEmbedder/", intra_op_threads)}
     , session{create_session(m_env, m_session_options, model_path, ML_MODEL_CACHE_PATH() + "SAMEmbedder/")}
     , memory_info{Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU)}
     , input_names{session.GetInputNames()}
@@ -176,7 +181,94 @@ void SAMSession::run(
 }
 
 
-void compute_embeddings_for_folder(const std::string& embedding_model_path, const std::string& image_folder_path){
+namespace{
+
+//  Blocking FIFO with a capacity limit that connects the stages of the
+//  embedding pipeline.
+template <typename Type>
+class BoundedQueue{
+public:
+    BoundedQueue(size_t capacity)
+        : m_capacity(std::max<size_t>(capacity, 1))
+    {}
+
+    //  Block until there is space. Returns false if the queue was closed.
+    bool push(Type item){
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_cv.wait(lg, [this]{ return m_closed || m_queue.size() < m_capacity; });
+        if (m_closed){
+            return false;
+        }
+        m_queue.emplace_back(std::move(item));
+        m_cv.notify_all();
+        return true;
+    }
+
+    //  Block until there is an item. Returns false if the queue is closed and drained.
+    bool pop(Type& item){
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_cv.wait(lg, [this]{ return m_closed || !m_queue.empty(); });
+        if (m_queue.empty()){
+            return false;
+        }
+        item = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_cv.notify_all();
+        return true;
+    }
+
+    void close(){
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_closed = true;
+        m_cv.notify_all();
+    }
+
+private:
+    const size_t m_capacity;
+    bool m_closed = false;
+    std::deque<Type> m_queue;
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+};
+
+struct DecodedImage{
+    std::string path;
+    cv::Mat image;
+};
+struct ComputedEmbedding{
+    std::string path;
+    std::vector<float> embedding;
+};
+
+
+//  Load an image and resize it to the embedder input shape in RGB order.
+//  Returns an error message on failure.
+std::string load_image_for_embedding(const std::string& image_path, cv::Mat& resized_mat){
+    cv::Mat image_bgr = cv::imread(image_path);
+    if (image_bgr.empty()){
+        return "Cannot open image file " + image_path + ". Probably not an actual image?";
+    }
+    cv::Mat image;
+    if (image_bgr.channels() == 4){
+        cv::cvtColor(image_bgr, image, cv::COLOR_BGRA2RGB);
+    } else if (image_bgr.channels() == 3){
+        cv::cvtColor(image_bgr, image, cv::COLOR_BGR2RGB);
+    } else{
+        return "Image " + image_path + " has " + std::to_string(image_bgr.channels()) + " channels. Only support 3 or 4 channels.";
+    }
+
+    // resize to the shape for the ML model input
+    cv::resize(image, resized_mat, cv::Size(SAM_EMBEDDER_INPUT_IMAGE_WIDTH, SAM_EMBEDDER_INPUT_IMAGE_HEIGHT));
+    return "";
+}
+
+}
+
+
+void compute_embeddings_for_folder(
+    const std::string& embedding_model_path, const std::string& image_folder_path,
+    const EmbeddingComputeOptions& options
+){
     const bool recursive_search = true;
     std::vector<std::string> all_image_paths = find_images_in_folder(image_folder_path, recursive_search);
     if (all_image_paths.size() == 0){
@@ -200,47 +292,161 @@ void compute_embeddings_for_folder(const std::string& embedding_model_path, cons
         return;
     }
 
-    SAMEmbedderSession embedding_session(embedding_model_path);
-    std::vector<float> output_image_embedding;
-    for (size_t i = 0; i < all_image_paths.size(); i++){
-        const auto& image_path = all_image_paths[i];
-        std::cout << (i+1) << "/" << all_image_paths.size() << ": ";
+    std::vector<std::string> image_paths;
+    for (const std::string& image_path : all_image_paths){
         const std::string embedding_path = image_path + ".embedding";
         if (std::filesystem::exists(embedding_path)){
             std::cout << "skip already computed embedding " << embedding_path << "." << std::endl;
             continue;
         }
-        std::cout << "computing embedding for " << image_path << "..." << std::endl;
-        cv::Mat image_bgr = cv::imread(image_path);
-        if (image_bgr.empty()){
-            std::cerr << "Error: image empty. Probably the file is not an image?" << std::endl;
-            QMessageBox box;
-            box.warning(nullptr, "Unable To Open Image",
-                QString::fromStdString("Cannot open image file " + image_path + ". Probably not an actual image?"));
-            return;
-        }
-        cv::Mat image;
-        if (image_bgr.channels() == 4){
-            cv::cvtColor(image_bgr, image, cv::COLOR_BGRA2RGB);
-        } else if (image_bgr.channels() == 3){
-            cv::cvtColor(image_bgr, image, cv::COLOR_BGR2RGB);
-        } else{
-            std::cerr << "Error: wrong image channels. Only work with RGB or RGBA images." << std::endl;
-            QMessageBox box;
-            box.warning(nullptr, "Wrong Image Channels",
-                QString::fromStdString("Image has " + std::to_string(image_bgr.channels()) + " channels. Only support 3 or 4 channels."));
-            return;
+        image_paths.emplace_back(image_path);
+    }
+    if (image_paths.empty()){
+        std::cout << "Done computing embeddings for images in folder " << image_folder_path << "." << std::endl;
+        return;
+    }
+
+    const size_t decode_threads = std::max<size_t>(options.decode_threads, 1);
+    const size_t num_sessions = std::min(std::max<size_t>(options.sessions, 1), image_paths.size());
+
+    std::vector<std::unique_ptr<SAMEmbedderSession>> sessions;
+    for (size_t i = 0; i < num_sessions; i++){
+        sessions.emplace_back(std::make_unique<SAMEmbedderSession>(embedding_model_path, options.intra_op_threads));
+    }
+
+    //  Pipeline:
+    //      decode workers -> decoded queue -> embedder sessions -> write queue -> writer
+    BoundedQueue<DecodedImage> decoded_queue(options.prefetch_images);
+    BoundedQueue<ComputedEmbedding> write_queue(num_sessions + 1);
+
+    std::atomic<size_t> next_image(0);
+    std::atomic<size_t> decoders_left(decode_threads);
+    std::atomic<size_t> sessions_left(num_sessions);
+    std::atomic<size_t> finished(0);
+    std::mutex error_lock;
+    std::vector<std::string> errors;
+    auto report_error = [&](std::string message){
+        std::cerr << "Error: " << message << std::endl;
+        std::lock_guard<std::mutex> lg(error_lock);
+        errors.emplace_back(std::move(message));
+    };
+
+    //  If any stage throws, close both queues so that no other stage is left
+    //  waiting on it. The exception is rethrown from its task and picked up
+    //  by wait_and_rethrow_exceptions() below.
+    auto abort_pipeline = [&]{
+        decoded_queue.close();
+        write_queue.close();
+    };
+
+    AsyncDispatcher dispatcher(nullptr, decode_threads + num_sessions + 1);
+    std::vector<std::unique_ptr<AsyncTask>> tasks;
+
+    for (size_t c = 0; c < decode_threads; c++){
+        tasks.emplace_back(dispatcher.dispatch([&]{
+            std::exception_ptr exception;
+            try{
+                while (true){
+                    size_t index = next_image.fetch_add(1);
+                    if (index >= image_paths.size()){
+                        break;
+                    }
+                    DecodedImage item;
+                    item.path = image_paths[index];
+                    std::string error = load_image_for_embedding(item.path, item.image);
+                    if (!error.empty()){
+                        report_error(std::move(error));
+                        continue;
+                    }
+                    if (!decoded_queue.push(std::move(item))){
+                        break;
+                    }
+                }
+            }catch (...){
+                exception = std::current_exception();
+                abort_pipeline();
+            }
+            if (decoders_left.fetch_sub(1) == 1){
+                decoded_queue.close();
+            }
+            if (exception){
+                std::rethrow_exception(exception);
+            }
+        }));
+    }
+
+    for (size_t c = 0; c < num_sessions; c++){
+        SAMEmbedderSession& session = *sessions[c];
+        tasks.emplace_back(dispatcher.dispatch([&]{
+            std::exception_ptr exception;
+            try{
+                DecodedImage item;
+                while (decoded_queue.pop(item)){
+                    std::cout << "computing embedding for " << item.path << "..." << std::endl;
+                    ComputedEmbedding output;
+                    output.path = std::move(item.path);
+                    try{
+                        session.run(item.image, output.embedding);
+                    }catch (const std::exception& e){
+                        report_error("Failed to compute embedding for " + output.path + ": " + e.what());
+                        continue;
+                    }
+                    if (!write_queue.push(std::move(output))){
+                        break;
+                    }
+                }
+            }catch (...){
+                exception = std::current_exception();
+                abort_pipeline();
+            }
+            if (sessions_left.fetch_sub(1) == 1){
+                write_queue.close();
+            }
+            if (exception){
+                std::rethrow_exception(exception);
+            }
+        }));
+    }
+
+    tasks.emplace_back(dispatcher.dispatch([&]{
+        try{
+            ComputedEmbedding item;
+            while (write_queue.pop(item)){
+                save_image_embedding_to_disk(item.path, item.embedding, options.half_precision);
+                size_t done = finished.fetch_add(1) + 1;
+                std::cout << done << "/" << image_paths.size() << ": done " << item.path << std::endl;
+            }
+        }catch (...){
+            abort_pipeline();
+            throw;
         }
+    }));
 
-        cv::Mat resized_mat;  // resize to the shape for the ML model input
-        cv::resize(image, resized_mat, cv::Size(SAM_EMBEDDER_INPUT_IMAGE_WIDTH, SAM_EMBEDDER_INPUT_IMAGE_HEIGHT));
+    //  Let every stage finish before rethrowing so that none of them are
+    //  still using the queues when they go out of scope.
+    std::exception_ptr exception;
+    for (std::unique_ptr<AsyncTask>& task : tasks){
+        try{
+            task->wait_and_rethrow_exceptions();
+        }catch (...){
+            if (!exception){
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception){
+        std::rethrow_exception(exception);
+    }
 
-        output_image_embedding.clear();
-        embedding_session.run(resized_mat, output_image_embedding);
-        save_image_embedding_to_disk(image_path, output_image_embedding);
+    if (!errors.empty()){
+        std::string message = std::to_string(errors.size()) + " image(s) failed:\n";
+        for (size_t i = 0; i < errors.size() && i < 10; i++){
+            message += errors[i] + "\n";
+        }
+        QMessageBox box;
+        box.warning(nullptr, "Unable To Compute Some Embeddings", QString::fromStdString(message));
     }
     std::cout << "Done computing embeddings for images in folder " << image_folder_path << "." << std::endl;
-
 }
 
 }
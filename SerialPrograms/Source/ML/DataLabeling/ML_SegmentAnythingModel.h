@@ -21,14 +21,32 @@ namespace PokemonAutomation{
 namespace ML{
 
 
+struct EmbeddingComputeOptions{
+    // Number of threads that load and resize images ahead of the embedder.
+    size_t decode_threads = 2;
+    // Max number of decoded images waiting for an embedder session.
+    size_t prefetch_images = 8;
+    // Number of embedder sessions running in parallel. Each session loads its own copy of the model.
+    size_t sessions = 1;
+    // CPU threads used by ONNX Runtime inside each session. 0 lets ONNX Runtime choose.
+    int intra_op_threads = 0;
+    // Store embeddings as float16 to halve the file size.
+    bool half_precision = false;
+};
+
 // Compute embeddings for all images in a folder. Only support .png, .jpg and .jpeg filename extensions so far.
+// Image decoding, embedding and file writing run in a pipeline on separate threads.
 // This can be very slow!
-void compute_embeddings_for_folder(const std::string& embedding_model_path, const std::string& image_folder_path);
+void compute_embeddings_for_folder(
+    const std::string& embedding_model_path, const std::string& image_folder_path,
+    const EmbeddingComputeOptions& options = EmbeddingComputeOptions()
+);
 
 
 class SAMEmbedderSession{
 public:
-    SAMEmbedderSession(const std::string& model_path);
+    // intra_op_threads: CPU threads used by ONNX Runtime inside this session. 0 lets ONNX Runtime choose.
+    SAMEmbedderSession(const std::string& model_path, int intra_op_threads = 0);
 
     // Given an image of shape SAM_EMBEDDER_INPUT_IMAGE_WIDTH x SAM_EMBEDDER_INPUT_IMAGE_HEIGHT, RGB channel order,
     // compute its image embedding as a vector<float> of size [SAM_EMBEDDER_OUTPUT_SIZE]
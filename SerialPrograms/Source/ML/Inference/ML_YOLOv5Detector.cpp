@@ -7,8 +7,6 @@
 #include <filesystem>
 #include <iostream>
 #include <QMessageBox>
-#include <opencv2/imgproc.hpp>
-#include <opencv2/imgcodecs.hpp>
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
@@ -25,12 +23,14 @@ namespace ML{
 
 YOLOv5Detector::~YOLOv5Detector() = default;
 
-YOLOv5Detector::YOLOv5Detector()
+YOLOv5Detector::YOLOv5Detector(int intra_op_threads, int inter_op_threads)
 {
     const std::string sam_model_path = RESOURCE_PATH() + "ML/yolov5.onnx";
     std::vector<std::string> labels = {"Bidoof"};
     if (std::filesystem::exists(sam_model_path)){
-        m_yolo_session = std::make_unique<YOLOv5Session>(sam_model_path, std::move(labels));
+        m_yolo_session = std::make_unique<YOLOv5Session>(
+            sam_model_path, std::move(labels), intra_op_threads, inter_op_threads
+        );
     } else{
         std::cerr << "Error: no such YOLOv5 model path " << sam_model_path << "." << std::endl;
         QMessageBox box;
@@ -44,12 +44,8 @@ bool YOLOv5Detector::detect(const ImageViewRGB32& screen){
         return false;
     }
 
-    cv::Mat frame_mat_bgra = screen.to_opencv_Mat();
-    cv::Mat frame_mat_rgb;
-    cv::cvtColor(frame_mat_bgra, frame_mat_rgb, cv::COLOR_BGRA2RGB);
-    
     m_output_boxes.clear();
-    m_yolo_session->run(frame_mat_rgb, m_output_boxes);
+    m_yolo_session->run(screen, m_output_boxes);
 
     return m_output_boxes.size() > 0;
 }
@@ -23,7 +23,9 @@ namespace ML{
 
 class YOLOv5Detector : public StaticScreenDetector{
 public:
-    YOLOv5Detector();
+    // intra_op_threads, inter_op_threads: CPU thread counts for the ONNX Runtime
+    //   session. 0 lets ONNX Runtime choose.
+    YOLOv5Detector(int intra_op_threads = 0, int inter_op_threads = 0);
     virtual ~YOLOv5Detector();
 
     virtual void make_overlays(VideoOverlaySet& items) const override {}
@@ -41,8 +41,21 @@ std::string create_file_hash(const std::string& filepath){
 }
 
 
-Ort::SessionOptions create_session_options(const std::string& model_cache_path){
+Ort::SessionOptions create_session_options(
+    const std::string& model_cache_path,
+    int intra_op_threads,
+    int inter_op_threads
+){
     Ort::SessionOptions so;
+    if (intra_op_threads > 0){
+        so.SetIntraOpNumThreads(intra_op_threads);
+    }
+    if (inter_op_threads > 0){
+        so.SetInterOpNumThreads(inter_op_threads);
+        if (inter_op_threads > 1){
+            so.SetExecutionMode(ExecutionMode::ORT_PARALLEL);
+        }
+    }
     std::cout << "Set potential model cache path in session options: " << model_cache_path << std::endl;
 #if __APPLE__
     // create session using Apple ML acceleration library CoreML
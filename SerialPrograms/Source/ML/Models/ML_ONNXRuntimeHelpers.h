@@ -23,7 +23,16 @@ namespace ML{
 //
 // model_cache_path: the path to store model caches. This path is better
 //   to be unique for each model for easier file management.
-Ort::SessionOptions create_session_options(const std::string& model_cache_path);
+// intra_op_threads: number of CPU threads used to parallelize inside one operator.
+//   0 lets ONNX Runtime choose (one per physical core).
+// inter_op_threads: number of CPU threads used to run independent operators in
+//   parallel. 0 lets ONNX Runtime choose. Setting it above 1 switches the session
+//   to parallel execution mode.
+Ort::SessionOptions create_session_options(
+    const std::string& model_cache_path,
+    int intra_op_threads = 0,
+    int inter_op_threads = 0
+);
 
 
 // Create an ONNX Session. It will also update the model cache on macOS if necessary.
@@ -7,11 +7,14 @@
 
 
 #include <string>
+#include <cmath>
+#include <algorithm>
 //#include <iostream>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/dnn.hpp>
 #include "3rdParty/ONNX/OnnxToolsPA.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "ML/Models/ML_ONNXRuntimeHelpers.h"
 #include "ML_YOLOv5Model.h"
 
@@ -19,53 +22,74 @@ namespace PokemonAutomation{
 namespace ML{
 
 
-std::tuple<int, int, double, double> resize_image_with_border(
-    const cv::Mat& input_image,
-    cv::Mat& output_image,
-    int target_width, int target_height,
-    cv::Scalar border_color = cv::Scalar(0,0,0)
-){
-    int original_width = input_image.cols;
-    int original_height = input_image.rows;
+void YOLOv5Session::Letterbox::update(size_t width, size_t height, size_t target_size){
+    if (width == source_width && height == source_height){
+        return;
+    }
 
-    double scale_x = static_cast<double>(target_width) / original_width;
-    double scale_y = static_cast<double>(target_height) / original_height;
+    double scale_x = static_cast<double>(target_size) / width;
+    double scale_y = static_cast<double>(target_size) / height;
     double scale = std::min(scale_x, scale_y);
 
-    int new_width = static_cast<int>(original_width * scale);
-    int new_height = static_cast<int>(original_height * scale);
-    new_width = std::min(new_width, target_width);
-    new_height = std::min(new_height, target_height);
+    size_t resized_width = std::min(static_cast<size_t>(width * scale), target_size);
+    size_t resized_height = std::min(static_cast<size_t>(height * scale), target_size);
 
-    if (new_width == 0 || new_height == 0){
-        throw std::runtime_error("Input Image too small: " + std::to_string(original_width) + " x " + std::to_string(original_height));
+    if (resized_width == 0 || resized_height == 0){
+        throw std::runtime_error("Input Image too small: " + std::to_string(width) + " x " + std::to_string(height));
     }
 
-    cv::Mat resized_image;
-    cv::resize(input_image, resized_image, cv::Size(new_width, new_height), 0, 0, cv::INTER_LINEAR); // INTER_AREA for shrinking
-
-    int border_top = (target_height - new_height) / 2;
-    int border_bottom = target_height - new_height - border_top;
-    int border_left = (target_width - new_width) / 2;
-    int border_right = target_width - new_width - border_left;
-
-    cv::copyMakeBorder(resized_image, output_image, border_top, border_bottom, border_left, border_right, cv::BORDER_CONSTANT, border_color);
-
-    return std::make_tuple(
-        border_left, border_top,
-        1.0 / new_width, 1.0 / new_height
-    );
+    source_width = width;
+    source_height = height;
+    new_width = resized_width;
+    new_height = resized_height;
+    border_left = (target_size - new_width) / 2;
+    border_top = (target_size - new_height) / 2;
+
+    //  Same sample positions as cv::resize() with INTER_LINEAR.
+    auto build = [](
+        std::vector<uint32_t>& i0, std::vector<uint32_t>& i1, std::vector<float>& w,
+        size_t source, size_t target
+    ){
+        i0.resize(target);
+        i1.resize(target);
+        w.resize(target);
+        double ratio = static_cast<double>(source) / target;
+        for (size_t c = 0; c < target; c++){
+            double f = (c + 0.5) * ratio - 0.5;
+            double s = std::floor(f);
+            f -= s;
+            if (s < 0){
+                s = 0;
+                f = 0;
+            }
+            if (s >= static_cast<double>(source - 1)){
+                s = static_cast<double>(source - 1);
+                f = 0;
+            }
+            i0[c] = static_cast<uint32_t>(s);
+            i1[c] = std::min(i0[c] + 1, static_cast<uint32_t>(source - 1));
+            w[c] = static_cast<float>(f);
+        }
+    };
+    build(x0, x1, wx, width, new_width);
+    build(y0, y1, wy, height, new_height);
 }
 
 
-YOLOv5Session::YOLOv5Session(const std::string& model_path, std::vector<std::string> label_names)
+YOLOv5Session::YOLOv5Session(
+    const std::string& model_path, std::vector<std::string> label_names,
+    int intra_op_threads, int inter_op_threads
+)
 : m_label_names(std::move(label_names))
-, m_session_options(create_session_options(ML_MODEL_CACHE_PATH() + "YOLOv5"))
+, m_session_options(create_session_options(ML_MODEL_CACHE_PATH() + "YOLOv5", intra_op_threads, inter_op_threads))
 , m_session{create_session(m_env, m_session_options, model_path, ML_MODEL_CACHE_PATH() + "YOLOv5")}
 , m_memory_info{Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU)}
 , m_input_names{m_session.GetInputNames()}
 , m_output_names{m_session.GetOutputNames()}
 , m_model_input(3*YOLO5_INPUT_IMAGE_SIZE*YOLO5_INPUT_IMAGE_SIZE)
+, m_input_tensor(nullptr)
+, m_output_tensor(nullptr)
+, m_io_binding(m_session)
 {
     if (m_session.GetOutputCount() != 1){
         throw std::runtime_error("YOLOv5 model does not have the correct output count, found count " + std::to_string(m_session.GetOutputCount()));
@@ -79,53 +103,141 @@ YOLOv5Session::YOLOv5Session(const std::string& model_path, std::vector<std::str
     if (output_dims[2] - 5 != static_cast<int>(m_label_names.size())){
         throw std::runtime_error(
             "YOLOv5 model has " + std::to_string(output_dims[2]-5) + 
-            " output labels but YOLOv5Session was initialized with " + std::to_string(label_names.size()) + " labels"
+            " output labels but YOLOv5Session was initialized with " + std::to_string(m_label_names.size()) + " labels"
         );
     }
     m_model_output.resize(YOLO5_NUM_CANDIDATES * m_output_shape[2]);
+
+    m_input_tensor = create_tensor<float>(m_memory_info, m_model_input, m_input_shape);
+    m_output_tensor = create_tensor<float>(m_memory_info, m_model_output, m_output_shape);
+    m_io_binding.BindInput(m_input_names[0].c_str(), m_input_tensor);
+    m_io_binding.BindOutput(m_output_names[0].c_str(), m_output_tensor);
 }
 
+
+//  Letterbox-resize the source image into the model input tensor.
+//
+//  "interpolate_row(y, r, g, b)" horizontally resamples source row "y" into
+//  "new_width" floats per channel. The vertical blend, normalization to
+//  [0, 1] and the CHW layout are done here. Two source rows are kept so that
+//  consecutive output rows that share a source row do not resample it again.
+template <typename RowInterpolator>
+void YOLOv5Session::fill_model_input(RowInterpolator&& interpolate_row){
+    const size_t size = YOLO5_INPUT_IMAGE_SIZE;
+    const size_t plane = size * size;
+    const size_t width = m_letterbox.new_width;
+    const float scale = 1.0f / 255;
+
+    m_row_top.resize(3 * width);
+    m_row_bottom.resize(3 * width);
+
+    size_t top_id = (size_t)-1;
+    size_t bottom_id = (size_t)-1;
+    for (size_t r = 0; r < m_letterbox.new_height; r++){
+        size_t y0 = m_letterbox.y0[r];
+        size_t y1 = m_letterbox.y1[r];
+        if (top_id != y0){
+            if (bottom_id == y0){
+                std::swap(m_row_top, m_row_bottom);
+                std::swap(top_id, bottom_id);
+            }else{
+                float* row = m_row_top.data();
+                interpolate_row(y0, row, row + width, row + 2*width);
+                top_id = y0;
+            }
+        }
+        if (bottom_id != y1){
+            float* row = m_row_bottom.data();
+            interpolate_row(y1, row, row + width, row + 2*width);
+            bottom_id = y1;
+        }
+
+        const float wy = m_letterbox.wy[r];
+        const size_t offset = (m_letterbox.border_top + r) * size + m_letterbox.border_left;
+        for (size_t c = 0; c < 3; c++){
+            const float* t = m_row_top.data() + c * width;
+            const float* b = m_row_bottom.data() + c * width;
+            float* out = m_model_input.data() + c * plane + offset;
+            for (size_t x = 0; x < width; x++){
+                out[x] = (t[x] + (b[x] - t[x]) * wy) * scale;
+            }
+        }
+    }
+}
+
+
 // input: rgb color order
 void YOLOv5Session::run(const cv::Mat& input_image, std::vector<YOLOv5Session::DetectionBox>& output_boxes){
     CV_Assert(input_image.depth() == CV_8U);
     CV_Assert(input_image.channels() == 3);
 
-    cv::Mat image_resized;
-
-    int x_shift = 0, y_shift = 0;
-    double x_scale = 1.0, y_scale = 1.0;
-    std::tie(x_shift, y_shift, x_scale, y_scale) = resize_image_with_border(input_image, image_resized,
-        YOLO5_INPUT_IMAGE_SIZE, YOLO5_INPUT_IMAGE_SIZE, cv::Scalar(114, 114, 114));
+    size_t old_width = m_letterbox.new_width;
+    size_t old_height = m_letterbox.new_height;
+    m_letterbox.update(input_image.cols, input_image.rows, YOLO5_INPUT_IMAGE_SIZE);
+    if (old_width != m_letterbox.new_width || old_height != m_letterbox.new_height){
+        //  The border never changes for a given input size. Fill it once.
+        std::fill(m_model_input.begin(), m_model_input.end(), 114.0f / 255);
+    }
 
-    // Declare a destination Mat for float32
-    cv::Mat image_float;
+    const uint32_t* x0 = m_letterbox.x0.data();
+    const uint32_t* x1 = m_letterbox.x1.data();
+    const float* wx = m_letterbox.wx.data();
+    const size_t width = m_letterbox.new_width;
+    fill_model_input([&](size_t y, float* r, float* g, float* b){
+        const uint8_t* row = input_image.ptr<uint8_t>((int)y);
+        for (size_t x = 0; x < width; x++){
+            const uint8_t* p0 = row + 3 * (size_t)x0[x];
+            const uint8_t* p1 = row + 3 * (size_t)x1[x];
+            float w = wx[x];
+            r[x] = p0[0] + (p1[0] - p0[0]) * w;
+            g[x] = p0[1] + (p1[1] - p0[1]) * w;
+            b[x] = p0[2] + (p1[2] - p0[2]) * w;
+        }
+    });
 
-    // Convert the uint8_image to image_float
-    // The third argument (alpha) is a scaling factor.
-    // For normalization to [0.0, 1.0], use 1.0 / 255.0.
-    // For retaining original values (0-255), use 1.0.
-    image_resized.convertTo(image_float, CV_32F, 1.0 / 255.0); 
+    run_session(output_boxes);
+}
+void YOLOv5Session::run(const ImageViewRGB32& image, std::vector<YOLOv5Session::DetectionBox>& output_boxes){
+    size_t old_width = m_letterbox.new_width;
+    size_t old_height = m_letterbox.new_height;
+    m_letterbox.update(image.width(), image.height(), YOLO5_INPUT_IMAGE_SIZE);
+    if (old_width != m_letterbox.new_width || old_height != m_letterbox.new_height){
+        std::fill(m_model_input.begin(), m_model_input.end(), 114.0f / 255);
+    }
 
-    for (int c = 0, i = 0; c < 3; c++) {
-        for (int row = 0; row < image_float.rows; row++) {
-            for (int col = 0; col < image_float.cols; col++) {
-                float pixel_value = image_float.at<cv::Vec3f>(row, col)[c];
-                m_model_input[i++] = pixel_value;
-            }
+    const uint32_t* x0 = m_letterbox.x0.data();
+    const uint32_t* x1 = m_letterbox.x1.data();
+    const float* wx = m_letterbox.wx.data();
+    const size_t width = m_letterbox.new_width;
+    const char* data = (const char*)image.data();
+    const size_t bytes_per_row = image.bytes_per_row();
+    fill_model_input([&](size_t y, float* r, float* g, float* b){
+        const uint32_t* row = (const uint32_t*)(data + y * bytes_per_row);
+        for (size_t x = 0; x < width; x++){
+            uint32_t p0 = row[x0[x]];
+            uint32_t p1 = row[x1[x]];
+            float w = wx[x];
+            float r0 = (float)((p0 >> 16) & 0xff);
+            float g0 = (float)((p0 >>  8) & 0xff);
+            float b0 = (float)(p0 & 0xff);
+            r[x] = r0 + ((float)((p1 >> 16) & 0xff) - r0) * w;
+            g[x] = g0 + ((float)((p1 >>  8) & 0xff) - g0) * w;
+            b[x] = b0 + ((float)(p1 & 0xff) - b0) * w;
         }
-    }
+    });
+
+    run_session(output_boxes);
+}
 
-    auto input_tensor = create_tensor<float>(m_memory_info, m_model_input, m_input_shape);
-    auto output_tensor = create_tensor<float>(m_memory_info, m_model_output, m_output_shape);
 
-    const char* input_name_c = m_input_names[0].data();
-    const char* output_name_c = m_output_names[0].data();
+void YOLOv5Session::run_session(std::vector<YOLOv5Session::DetectionBox>& output_boxes){
     // auto start = std::chrono::steady_clock::now();
-    m_session.Run(m_run_options, &input_name_c, &input_tensor, 1, &output_name_c, &output_tensor, 1);
+    m_session.Run(m_run_options, m_io_binding);
     // auto end = std::chrono::steady_clock::now();
     // auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
     // std::cout << "Yolov5 inference time: " << milliseconds << " ms" << std::endl;
 
+    const float SCORE_THRESHOLD = 0.2f;
     const size_t cand_size = m_label_names.size() + 5;
 
     std::vector<cv::Rect> pixel_boxes;
@@ -134,32 +246,44 @@ void YOLOv5Session::run(const cv::Mat& input_image, std::vector<YOLOv5Session::D
     std::vector<size_t> labels;
 
     for(int i = 0; i < YOLO5_NUM_CANDIDATES; i++){
-        float cx = m_model_output[cand_size*i];
-        float cy = m_model_output[cand_size*i+1];
-        float w = m_model_output[cand_size*i+2];
-        float h = m_model_output[cand_size*i+3];
-        float sc = m_model_output[cand_size*i+4];
+        const float* cand = m_model_output.data() + cand_size*i;
+        float sc = cand[4];
 
         float max_score = 0.0;
         size_t pred_label = 0;  // predicted label
         for(size_t j_label = 0; j_label < m_label_names.size(); j_label++){
-            float score = m_model_output[cand_size*i+5+j_label];
+            float score = cand[5+j_label];
             if (score > max_score){
                 max_score = score;
                 pred_label = j_label;
             }
         }
-        scores.push_back(max_score * sc); // sc is like a global confidence scale?
+
+        //  NMSBoxes() drops everything at or below the score threshold anyway.
+        //  Skip them here so only the few real candidates are collected.
+        float final_score = max_score * sc; // sc is like a global confidence scale?
+        if (!(final_score > SCORE_THRESHOLD)){
+            continue;
+        }
+
+        float cx = cand[0];
+        float cy = cand[1];
+        float w = cand[2];
+        float h = cand[3];
+        scores.push_back(final_score);
         pixel_boxes.emplace_back((int)(cx - w / 2 + 0.5), (int)(cy - h / 2 + 0.5), int(w + 0.5), int(h + 0.5));
-        indices.push_back(i);
         labels.push_back(pred_label);
     }
 
-    cv::dnn::NMSBoxes(pixel_boxes, scores, 0.2f, 0.45f, indices);
+    cv::dnn::NMSBoxes(pixel_boxes, scores, SCORE_THRESHOLD, 0.45f, indices);
 
     // std::cout << "num found pixel_boxes " << indices.size() << std::endl;
     // return;
 
+    const double x_shift = (double)m_letterbox.border_left;
+    const double y_shift = (double)m_letterbox.border_top;
+    const double x_scale = 1.0 / m_letterbox.new_width;
+    const double y_scale = 1.0 / m_letterbox.new_height;
     for (int index : indices)
     {
         // Note the model predicts on (640x640) images, we need to convert the detected pixel_boxes back to
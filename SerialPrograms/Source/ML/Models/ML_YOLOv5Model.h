@@ -12,7 +12,14 @@
 #include <onnxruntime_cxx_api.h>
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 
+namespace cv{
+    class Mat;
+}
+
 namespace PokemonAutomation{
+
+class ImageViewRGB32;
+
 namespace ML{
 
 
@@ -24,12 +31,49 @@ public:
         size_t label_idx;
     };
 
-    YOLOv5Session(const std::string& model_path, std::vector<std::string> label_names);
+    // intra_op_threads, inter_op_threads: CPU thread counts passed to ONNX Runtime.
+    //   0 lets ONNX Runtime choose. See `create_session_options()`.
+    YOLOv5Session(
+        const std::string& model_path, std::vector<std::string> label_names,
+        int intra_op_threads = 0, int inter_op_threads = 0
+    );
 
+    // input: rgb color order
     void run(const cv::Mat& input_image, std::vector<DetectionBox>& detections);
 
+    // Run directly on a video frame. The letterbox resize, padding, normalization
+    // and HWC -> CHW transpose are done in one pass that writes straight into the
+    // model input tensor. No intermediate cv::Mat is created.
+    void run(const ImageViewRGB32& image, std::vector<DetectionBox>& detections);
+
     const std::string& label_name(size_t idx) const { return m_label_names[idx]; }
     
+private:
+    //  Precomputed bilinear sampling tables for the letterbox resize.
+    //  Rebuilt only when the input resolution changes.
+    struct Letterbox{
+        size_t source_width = 0;
+        size_t source_height = 0;
+        size_t new_width = 0;
+        size_t new_height = 0;
+        size_t border_left = 0;
+        size_t border_top = 0;
+
+        std::vector<uint32_t> x0;
+        std::vector<uint32_t> x1;
+        std::vector<float> wx;
+        std::vector<uint32_t> y0;
+        std::vector<uint32_t> y1;
+        std::vector<float> wy;
+
+        void update(size_t width, size_t height, size_t target_size);
+    };
+
+    template <typename RowInterpolator>
+    void fill_model_input(RowInterpolator&& interpolate_row);
+
+    void run_session(std::vector<DetectionBox>& detections);
+
 private:
     const int YOLO5_INPUT_IMAGE_SIZE = 640;
     const int YOLO5_NUM_CANDIDATES = 25200;
@@ -48,6 +92,18 @@ private:
 
     std::vector<float> m_model_input;
     std::vector<float> m_model_output;
+
+    //  Tensors are views over the buffers above. They are bound once so
+    //  each run reuses the same input and output memory.
+    Ort::Value m_input_tensor;
+    Ort::Value m_output_tensor;
+    Ort::IoBinding m_io_binding;
+
+    Letterbox m_letterbox;
+
+    //  Scratch buffers reused across runs.
+    std::vector<float> m_row_top;
+    std::vector<float> m_row_bottom;
 };
 
 
@@ -418,7 +418,10 @@ void LabelImages::remove_segmentation_exclusion_point(double x, double y){
 void LabelImages::compute_embeddings_for_folder(const std::string& image_folder_path){
     std::string embedding_model_path = RESOURCE_PATH() + "ML/sam_embedder_cpu.onnx";
     std::cout << "Use SAM Embedding model " << embedding_model_path << std::endl;
-    ML::compute_embeddings_for_folder(embedding_model_path, image_folder_path);
+    // Embeddings are only read back by this program. Store them as float16 to halve the disk usage.
+    ML::EmbeddingComputeOptions options;
+    options.half_precision = true;
+    ML::compute_embeddings_for_folder(embedding_model_path, image_folder_path, options);
 }
 
 void LabelImages::delete_selected_annotation(){
@@ -4,6 +4,8 @@
  * 
  */
 
+#include "CommonFramework/Logging/Logger.h"
+#include "NintendoSwitch/Controllers/NintendoSwitch_ControllerWithScheduler.h"
 #include "NintendoSwitch/Programs/NintendoSwitch_GameEntry.h"
 #include "NintendoSwitch_Commands_Routines.h"
 #include "NintendoSwitch_Commands_PushButtons.h"
@@ -17,6 +19,19 @@ namespace PokemonAutomation{
 namespace NintendoSwitch{
 
 
+//  The fail-safe tail of "close_game_from_home()". This is run on every game
+//  reset so it is only scheduled once.
+const SuperscalarScheduler::Schedule& close_game_failsafe_schedule(){
+    static const SuperscalarScheduler::Schedule schedule = []{
+        ProControllerScheduleCompiler compiler(global_logger_tagged());
+        compiler.issue_mash_button(nullptr, 400ms, BUTTON_X);
+        compiler.issue_mash_button(nullptr, 2800ms, BUTTON_B);
+        return compiler.compile();
+    }();
+    return schedule;
+}
+
+
 void close_game_from_home(ConsoleHandle& console, ProControllerContext& context){
     ensure_at_home(console, context);
 
@@ -34,8 +49,8 @@ void close_game_from_home(ConsoleHandle& console, ProControllerContext& context)
     go_home(console, context);                      // - Does nothing.          |  - goes back to home screen.
 
     // fail-safe against button drops and unexpected error messages.
-    pbf_mash_button(context, BUTTON_X, 50);
-    pbf_mash_button(context, BUTTON_B, 350);
+    // (mash X for 50 ticks, then mash B for 350 ticks)
+    ssf_issue_compiled(context, close_game_failsafe_schedule());
 }
 
 void close_game_from_home(ConsoleHandle& console, JoyconContext& context){
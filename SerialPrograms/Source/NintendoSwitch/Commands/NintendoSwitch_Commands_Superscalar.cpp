@@ -117,6 +117,9 @@ void ssf_mash_AZs(ProControllerContext& context, uint16_t ticks){
 void ssf_mash_AZs(ProControllerContext& context, Milliseconds duration){
     context->issue_mash_AZs(&context, duration);
 }
+void ssf_issue_compiled(ProControllerContext& context, const SuperscalarScheduler::Schedule& schedule){
+    context->issue_compiled(&context, schedule);
+}
 void ssf_issue_scroll(
     ProControllerContext& context,
     DpadPosition direction,
@@ -73,6 +73,10 @@ void ssf_mash_AZs       (ProControllerContext& context, uint16_t ticks);
 void ssf_mash_AZs       (ProControllerContext& context, Milliseconds duration);
 
 
+//  Replay a schedule built with "ProControllerScheduleCompiler".
+void ssf_issue_compiled(ProControllerContext& context, const SuperscalarScheduler::Schedule& schedule);
+
+
 //  Diagonal scrolling seems to count as seperate events for each direction.
 //  In other words, they don't work.
 #define SSF_SCROLL_UP           DPAD_UP
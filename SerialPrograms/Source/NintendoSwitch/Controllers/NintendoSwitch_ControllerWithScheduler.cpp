@@ -21,8 +21,8 @@ void ControllerWithScheduler::issue_buttons(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     Button button
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -62,8 +62,8 @@ void ControllerWithScheduler::issue_dpad(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     DpadPosition position
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -91,8 +91,8 @@ void ControllerWithScheduler::issue_left_joystick(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     uint8_t x, uint8_t y
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -120,8 +120,8 @@ void ControllerWithScheduler::issue_right_joystick(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     uint8_t x, uint8_t y
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -153,8 +153,8 @@ void ControllerWithScheduler::issue_gyro(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     int16_t value
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -188,8 +188,8 @@ void ControllerWithScheduler::issue_full_controller_state(
     uint8_t left_x, uint8_t left_y,
     uint8_t right_x, uint8_t right_y
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -370,9 +370,9 @@ void ControllerWithScheduler::issue_system_scroll(
 
     ThrottleScope scope(m_logging_throttler);
 
-    WallClock dpad = m_scheduler.busy_until((size_t)SwitchResource::DPAD);
-    WallClock left_joystick = m_scheduler.busy_until((size_t)SwitchResource::JOYSTICK_LEFT);
-    WallClock right_joystick = m_scheduler.busy_until((size_t)SwitchResource::JOYSTICK_RIGHT);
+    SteadyClock dpad = m_scheduler.busy_until((size_t)SwitchResource::DPAD);
+    SteadyClock left_joystick = m_scheduler.busy_until((size_t)SwitchResource::JOYSTICK_LEFT);
+    SteadyClock right_joystick = m_scheduler.busy_until((size_t)SwitchResource::JOYSTICK_RIGHT);
 
     do{
         if (dpad <= left_joystick && dpad <= right_joystick){
@@ -284,6 +284,45 @@ public:
 
 
 
+//
+//  Records the commands issued to it instead of sending them anywhere. The
+//  result can be replayed on a real controller with "issue_compiled()".
+//
+//  Use this for fixed button sequences that are run often so the scheduling
+//  is only done once.
+//
+class ProControllerScheduleCompiler : public ControllerWithScheduler{
+public:
+    ProControllerScheduleCompiler(Logger& logger)
+        : ControllerWithScheduler(logger)
+    {
+        m_accumulate_schedule = true;
+    }
+
+    //  Finish everything that has been issued and return it. The compiler is
+    //  reset and can be reused.
+    SuperscalarScheduler::Schedule compile(){
+        std::lock_guard<std::mutex> lg0(m_issue_lock);
+        std::lock_guard<std::mutex> lg1(m_state_lock);
+        m_scheduler.issue_finalize(m_schedule);
+        SuperscalarScheduler::Schedule ret = std::move(m_schedule);
+        m_schedule = SuperscalarScheduler::Schedule();
+        return ret;
+    }
+
+private:
+    virtual void execute_state(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::ScheduleEntry& entry
+    ) override{}
+    virtual void execute_schedule(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::Schedule& schedule
+    ) override{}
+};
+
+
+
 
 }
 }
@@ -12,6 +12,7 @@
 #include "Common/Cpp/Containers/Pimpl.h"
 #include "Controllers/ControllerTypes.h"
 #include "Controllers/Controller.h"
+#include "Controllers/Schedulers/SuperscalarScheduler.h"
 #include "NintendoSwitch_ControllerButtons.h"
 
 //#include <iostream>
@@ -221,6 +222,19 @@ public:
         DpadPosition direction  //  Diagonals not allowed.
     ) = 0;
 
+    //
+    //  Replay a schedule that was compiled ahead of time with
+    //  "ProControllerScheduleCompiler". This is the same as issuing all the
+    //  commands that were used to build it, but without the per-command
+    //  scheduling overhead.
+    //
+    //  This will wait until the controller is fully idle before it starts.
+    //
+    virtual void issue_compiled(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::Schedule& schedule
+    ) = 0;
+
 
 public:
     //  Keyboard Input
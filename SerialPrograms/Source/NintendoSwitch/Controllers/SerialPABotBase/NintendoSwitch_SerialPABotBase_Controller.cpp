@@ -63,8 +63,8 @@ void SerialPABotBase_Controller::replace_on_next_command(){
 
 
 void SerialPABotBase_Controller::wait_for_all(const Cancellable* cancellable){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
 
@@ -36,6 +36,9 @@ SerialPABotBase_WiredController::SerialPABotBase_WiredController(
         connection
     )
     , m_controller_type(controller_type)
+    , m_supports_state_batch(
+        connection.protocol_version() >= PABB_PROTOCOL_VERSION_NS2_WIRED_CONTROLLER_STATE_BATCH
+    )
 {
     using namespace SerialPABotBase;
 
@@ -62,6 +65,10 @@ SerialPABotBase_WiredController::SerialPABotBase_WiredController(
         throw SerialProtocolException(logger, PA_CURRENT_FUNCTION, "Failed to set controller type.");
     }
 
+    if (m_supports_state_batch){
+        logger.log("Device supports batched controller states.");
+    }
+
     m_status_thread.reset(new SerialPABotBase::ControllerStatusThread(
         connection, *this
     ));
@@ -77,19 +84,18 @@ void SerialPABotBase_WiredController::stop(){
 
 
 
-void SerialPABotBase_WiredController::execute_state(
-    const Cancellable* cancellable,
+pabb_NintendoSwitch2_WiredController_State SerialPABotBase_WiredController::entry_to_report(
     const SuperscalarScheduler::ScheduleEntry& entry
-){
-    if (!is_ready()){
-        throw InvalidConnectionStateException(error_string());
-    }
-
+) const{
     SwitchControllerState controller_state;
     for (auto& item : entry.state){
         static_cast<const SwitchCommand&>(*item).apply(controller_state);
     }
-
+    return state_to_report(controller_state);
+}
+pabb_NintendoSwitch2_WiredController_State SerialPABotBase_WiredController::state_to_report(
+    const SwitchControllerState& controller_state
+){
     int dpad_x = 0;
     int dpad_y = 0;
     uint16_t buttons = 0;
@@ -165,6 +171,27 @@ void SerialPABotBase_WiredController::execute_state(
     }
     dpad_byte |= dpad;
 
+    pabb_NintendoSwitch2_WiredController_State report;
+    report.buttons0 = (uint8_t)buttons;
+    report.buttons1 = (uint8_t)(buttons >> 8);
+    report.dpad_byte = dpad_byte;
+    report.left_joystick_x = controller_state.left_stick_x;
+    report.left_joystick_y = controller_state.left_stick_y;
+    report.right_joystick_x = controller_state.right_stick_x;
+    report.right_joystick_y = controller_state.right_stick_y;
+    return report;
+}
+void SerialPABotBase_WiredController::execute_state(
+    const Cancellable* cancellable,
+    const SuperscalarScheduler::ScheduleEntry& entry
+){
+    if (!is_ready()){
+        throw InvalidConnectionStateException(error_string());
+    }
+
+    pabb_NintendoSwitch2_WiredController_State report = entry_to_report(entry);
+    uint16_t buttons = report.buttons0 | ((uint16_t)report.buttons1 << 8);
+
     //  Divide the controller state into smaller chunks that fit into the report
     //  duration.
     Milliseconds time_left = std::chrono::duration_cast<Milliseconds>(entry.duration);
@@ -175,15 +202,52 @@ void SerialPABotBase_WiredController::execute_state(
             SerialPABotBase::DeviceRequest_NS2_WiredController_ControllerStateMs(
                 (uint16_t)current.count(),
                 buttons,
-                dpad_byte,
-                controller_state.left_stick_x, controller_state.left_stick_y,
-                controller_state.right_stick_x, controller_state.right_stick_y
+                report.dpad_byte,
+                report.left_joystick_x, report.left_joystick_y,
+                report.right_joystick_x, report.right_joystick_y
             ),
             cancellable
         );
         time_left -= current;
     }
 }
+void SerialPABotBase_WiredController::execute_schedule(
+    const Cancellable* cancellable,
+    const SuperscalarScheduler::Schedule& schedule
+){
+    //  Old firmware or nothing to coalesce.
+    if (!m_supports_state_batch || schedule.size() < 2){
+        ControllerWithScheduler::execute_schedule(cancellable, schedule);
+        return;
+    }
+
+    if (!is_ready()){
+        throw InvalidConnectionStateException(error_string());
+    }
+
+    using SerialPABotBase::DeviceRequest_NS2_WiredController_ControllerStateBatch;
+
+    DeviceRequest_NS2_WiredController_ControllerStateBatch batch;
+    for (const SuperscalarScheduler::ScheduleEntry& entry : schedule){
+        pabb_NintendoSwitch2_WiredController_State report = entry_to_report(entry);
+
+        //  Divide the controller state into smaller chunks that fit into the
+        //  report duration.
+        Milliseconds time_left = std::chrono::duration_cast<Milliseconds>(entry.duration);
+        while (time_left > Milliseconds::zero()){
+            Milliseconds current = std::min(time_left, 65535ms);
+            if (!batch.try_append((uint16_t)current.count(), report)){
+                m_serial->issue_request(batch, cancellable);
+                batch = DeviceRequest_NS2_WiredController_ControllerStateBatch();
+                batch.try_append((uint16_t)current.count(), report);
+            }
+            time_left -= current;
+        }
+    }
+    if (batch.size() > 0){
+        m_serial->issue_request(batch, cancellable);
+    }
+}
 
 
 
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_NintendoSwitch_SerialPABotBase_WiredControllerNS1_H
 #define PokemonAutomation_NintendoSwitch_SerialPABotBase_WiredControllerNS1_H
 
+#include "Common/ControllerStates/NintendoSwitch2_WiredController_State.h"
 #include "Controllers/SerialPABotBase/SerialPABotBase_StatusThread.h"
 #include "NintendoSwitch/NintendoSwitch_Settings.h"
 #include "NintendoSwitch/Controllers/NintendoSwitch_ProController.h"
@@ -37,6 +38,11 @@ public:
     ~SerialPABotBase_WiredController();
     void stop();
 
+    //  Convert a controller state into the report that is sent to the device.
+    static pabb_NintendoSwitch2_WiredController_State state_to_report(
+        const SwitchControllerState& controller_state
+    );
+
     virtual Logger& logger() override{
         return m_logger;
     }
@@ -217,6 +223,12 @@ public:
     ) override{
         ControllerWithScheduler::issue_system_scroll(cancellable, delay, hold, cooldown, direction);
     }
+    virtual void issue_compiled(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::Schedule& schedule
+    ) override{
+        ControllerWithScheduler::issue_compiled(cancellable, schedule);
+    }
 
 
 private:
@@ -229,14 +241,24 @@ private:
     PA_FORCE_INLINE Type milliseconds_to_ticks_8ms(Type milliseconds){
         return milliseconds / 8 + (milliseconds % 8 + 7) / 8;
     }
+    pabb_NintendoSwitch2_WiredController_State entry_to_report(
+        const SuperscalarScheduler::ScheduleEntry& entry
+    ) const;
     virtual void execute_state(
         const Cancellable* cancellable,
         const SuperscalarScheduler::ScheduleEntry& entry
     ) override;
 
+    //  If the device supports it, pack consecutive states into batch messages.
+    virtual void execute_schedule(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::Schedule& schedule
+    ) override;
+
 
 private:
     const ControllerType m_controller_type;
+    bool m_supports_state_batch;
     std::unique_ptr<SerialPABotBase::ControllerStatusThread> m_status_thread;
 };
 
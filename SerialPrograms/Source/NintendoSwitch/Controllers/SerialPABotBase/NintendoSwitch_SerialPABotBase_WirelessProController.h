@@ -207,6 +207,12 @@ public:
     ) override{
         ControllerWithScheduler::issue_system_scroll(cancellable, delay, hold, cooldown, direction);
     }
+    virtual void issue_compiled(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::Schedule& schedule
+    ) override{
+        ControllerWithScheduler::issue_compiled(cancellable, schedule);
+    }
 
 
 private:
@@ -8,6 +8,8 @@
 #define PokemonAutomation_Sysbotbase3_ControllerState_H
 
 #include <stdint.h>
+#include <string.h>
+#include <string_view>
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -70,6 +72,30 @@ struct Sysbotbase3_ControllerCommand{
 
 
 
+//  A preformatted "cqControllerState <hex>\r\n" line. The prefix and line
+//  ending are written once. Each command only overwrites the hex payload.
+struct Sysbotbase3_ControllerStateLine{
+    static constexpr std::string_view PREFIX = "cqControllerState ";
+    static constexpr size_t SIZE = PREFIX.size() + 64 + 2;
+
+    char text[SIZE];
+
+    Sysbotbase3_ControllerStateLine(){
+        memcpy(text, PREFIX.data(), PREFIX.size());
+        text[SIZE - 2] = '\r';
+        text[SIZE - 1] = '\n';
+    }
+
+    void set(const Sysbotbase3_ControllerCommand& command){
+        command.write_to_hex(text + PREFIX.size());
+    }
+    std::string_view view() const{
+        return std::string_view(text, SIZE);
+    }
+};
+
+
+
 
 }
 }
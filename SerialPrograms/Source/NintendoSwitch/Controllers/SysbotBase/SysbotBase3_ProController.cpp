@@ -8,7 +8,6 @@
 //#include "Common/Cpp/Concurrency/ReverseLockGuard.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "Controllers/JoystickTools.h"
-#include "SysbotBase3_ControllerState.h"
 #include "SysbotBase3_ProController.h"
 
 //#include <iostream>
@@ -29,8 +28,10 @@ ProController_SysbotBase3::ProController_SysbotBase3(
     , m_connection(connection)
     , m_stopping(false)
     , m_pending_replace(false)
+    , m_send_replace(false)
     , m_next_seqnum(1)
     , m_next_expected_seqnum_ack(1)
+    , m_pending_lines(0)
 {
     if (!connection.is_ready()){
         return;
@@ -82,8 +83,8 @@ void ProController_SysbotBase3::replace_on_next_command(){
     m_logger.log("replace_on_next_command(): Command Queue Size = " + std::to_string(queued), COLOR_DARKGREEN);
 }
 void ProController_SysbotBase3::wait_for_all(const Cancellable* cancellable){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
 
@@ -115,28 +116,9 @@ void ProController_SysbotBase3::wait_for_all(const Cancellable* cancellable){
 
 
 void ProController_SysbotBase3::on_message(const std::string& message){
-    const std::string TOKEN = "cqCommandFinished";
-    auto pos = message.find(TOKEN);
-    if (pos == std::string::npos){
-        return;
-    }
-
-    const char* ptr = message.c_str();
-    ptr += pos;
-    ptr += TOKEN.size();
     uint64_t parsed;
-    while (true){
-        char ch = *ptr;
-        switch (ch){
-        case '\0':
-            return;
-        case ' ':
-        case '\t':
-            ptr++;
-            continue;
-        }
-        parsed = std::atoll(ptr);
-        break;
+    if (!SysbotBase::parse_command_finished(message, parsed)){
+        return;
     }
 
     std::lock_guard<std::mutex> lg(m_state_lock);
@@ -176,17 +158,9 @@ void ProController_SysbotBase3::on_message(const std::string& message){
     m_cv.notify_all();
 }
 
-void ProController_SysbotBase3::execute_state(
-    const Cancellable* cancellable,
-    const SuperscalarScheduler::ScheduleEntry& entry
-){
-    if (cancellable){
-        cancellable->throw_if_cancelled();
-    }
-    if (m_stopping){
-        throw InvalidConnectionStateException("");
-    }
+namespace{
 
+Sysbotbase3_ControllerState convert_state(const SuperscalarScheduler::ScheduleEntry& entry){
     SwitchControllerState controller_state;
     for (auto& item : entry.state){
         static_cast<const SwitchCommand&>(*item).apply(controller_state);
@@ -248,51 +222,118 @@ void ProController_SysbotBase3::execute_state(
         right_y = JoystickTools::linear_float_to_s16(fy);
     }
 
-    std::string message;
+    Sysbotbase3_ControllerState state;
+    state.buttons = nx_button;
+    state.left_joystick_x = left_x;
+    state.left_joystick_y = left_y;
+    state.right_joystick_x = right_x;
+    state.right_joystick_y = right_y;
+    return state;
+}
+
+}
+
+
+void ProController_SysbotBase3::queue_state(
+    std::unique_lock<std::mutex>& lg,
+    const Cancellable* cancellable,
+    const SuperscalarScheduler::ScheduleEntry& entry
+){
+    if (cancellable){
+        cancellable->throw_if_cancelled();
+    }
+    if (m_stopping){
+        throw InvalidConnectionStateException("");
+    }
+
     if (m_pending_replace){
+        //  The replace applies to everything already sent. Don't let it
+        //  swallow lines that are still waiting to go out.
+        flush_states();
         m_pending_replace = false;
+        m_send_replace = true;
         m_next_expected_seqnum_ack = m_next_seqnum;
-        message += "cqReplaceOnNext\r\n";
     }
 
-    //  Wait until there is space.
-    std::unique_lock<std::mutex> lg(m_state_lock);
-    m_cv.wait(lg, [this, cancellable]{
-        if (cancellable && cancellable->cancelled()){
-            return true;
+    //  Wait until there is space. Anything still pending must go out first
+    //  since those are the acks we are waiting for.
+    if (m_next_seqnum - m_next_expected_seqnum_ack >= QUEUE_SIZE){
+        flush_states();
+        m_cv.wait(lg, [this, cancellable]{
+            if (cancellable && cancellable->cancelled()){
+                return true;
+            }
+            return m_stopping || m_next_seqnum - m_next_expected_seqnum_ack < QUEUE_SIZE;
+        });
+        if (cancellable){
+            cancellable->throw_if_cancelled();
         }
-        return m_stopping || m_next_seqnum - m_next_expected_seqnum_ack < QUEUE_SIZE;
-    });
-
-    if (cancellable){
-        cancellable->throw_if_cancelled();
+        if (m_stopping){
+            throw InvalidConnectionStateException("");
+        }
+    }
+    if (m_pending_lines == m_lines.size()){
+        flush_states();
     }
 
     Sysbotbase3_ControllerCommand command;
     command.milliseconds = std::chrono::duration_cast<Milliseconds>(entry.duration).count();
     command.seqnum = m_next_seqnum++;
-    command.state.buttons = nx_button;
-    command.state.left_joystick_x = left_x;
-    command.state.left_joystick_y = left_y;
-    command.state.right_joystick_x = right_x;
-    command.state.right_joystick_y = right_y;
-
-    {
-        std::string command_message;
-        command_message.resize(64);
-        command.write_to_hex(command_message.data());
-        message += "cqControllerState " + command_message + "\r\n";
+    command.state = convert_state(entry);
+    m_lines[m_pending_lines++].set(command);
+}
+void ProController_SysbotBase3::flush_states(){
+    static constexpr std::string_view REPLACE_ON_NEXT = "cqReplaceOnNext\r\n";
+
+    std::string_view parts[QUEUE_SIZE + 1];
+    size_t count = 0;
+    if (m_send_replace){
+        m_send_replace = false;
+        parts[count++] = REPLACE_ON_NEXT;
+    }
+    for (size_t c = 0; c < m_pending_lines; c++){
+        parts[count++] = m_lines[c].view();
+    }
+    m_pending_lines = 0;
+    if (count == 0){
+        return;
     }
 
-    m_connection.write_data(message);
-
-    //  Do not log the contents of the command due to privacy concerns.
+    //  Do not log the contents of the commands due to privacy concerns.
     //  (people entering passwords)
-#if 0
-    if (GlobalSettings::instance().LOG_EVERYTHING){
-        m_logger.log("sys-botbase3: " + message);
+    m_connection.write_data(parts, count);
+}
+
+
+void ProController_SysbotBase3::execute_state(
+    const Cancellable* cancellable,
+    const SuperscalarScheduler::ScheduleEntry& entry
+){
+    std::unique_lock<std::mutex> lg(m_state_lock);
+    try{
+        queue_state(lg, cancellable, entry);
+    }catch (...){
+        flush_states();
+        throw;
     }
-#endif
+    flush_states();
+}
+void ProController_SysbotBase3::execute_schedule(
+    const Cancellable* cancellable,
+    const SuperscalarScheduler::Schedule& schedule
+){
+    //  Encode the whole schedule and send it in as few writes as possible.
+    //  Flushes early only when the command queue is full.
+    std::unique_lock<std::mutex> lg(m_state_lock);
+    try{
+        for (const SuperscalarScheduler::ScheduleEntry& entry : schedule){
+            queue_state(lg, cancellable, entry);
+        }
+    }catch (...){
+        flush_states();
+        throw;
+    }
+    flush_states();
 }
 
 
@@ -8,10 +8,12 @@
 #ifndef PokemonAutomation_NintendoSwitch_ProController_SysbotBase3_H
 #define PokemonAutomation_NintendoSwitch_ProController_SysbotBase3_H
 
+#include <array>
 #include "NintendoSwitch/NintendoSwitch_Settings.h"
 //#include "NintendoSwitch/Controllers/NintendoSwitch_VirtualControllerState.h"
 #include "NintendoSwitch/Controllers/NintendoSwitch_ProController.h"
 #include "NintendoSwitch/Controllers/NintendoSwitch_ControllerWithScheduler.h"
+#include "SysbotBase3_ControllerState.h"
 #include "SysbotBase_Connection.h"
 
 namespace PokemonAutomation{
@@ -198,6 +200,12 @@ public:
     ) override{
         ControllerWithScheduler::issue_system_scroll(cancellable, delay, hold, cooldown, direction);
     }
+    virtual void issue_compiled(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::Schedule& schedule
+    ) override{
+        ControllerWithScheduler::issue_compiled(cancellable, schedule);
+    }
 
 
 public:
@@ -218,6 +226,22 @@ private:
         const Cancellable* cancellable,
         const SuperscalarScheduler::ScheduleEntry& entry
     ) override;
+    virtual void execute_schedule(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::Schedule& schedule
+    ) override;
+
+    //  Encode "entry" into the next pending line. Waits for space in the
+    //  command queue if needed. Must be called under "m_state_lock".
+    void queue_state(
+        std::unique_lock<std::mutex>& lg,
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::ScheduleEntry& entry
+    );
+
+    //  Send all pending lines in a single write.
+    //  Must be called under "m_state_lock".
+    void flush_states();
 
 
 private:
@@ -225,9 +249,14 @@ private:
 
     bool m_stopping;
     bool m_pending_replace;
+    bool m_send_replace;
     uint64_t m_next_seqnum;
     uint64_t m_next_expected_seqnum_ack;
 
+    //  Encoded commands that haven't been sent yet.
+    std::array<Sysbotbase3_ControllerStateLine, QUEUE_SIZE> m_lines;
+    size_t m_pending_lines;
+
     std::condition_variable m_cv;
 };
 
@@ -4,6 +4,7 @@
  *
  */
 
+#include <charconv>
 #include <QEventLoop>
 #include "Common/Cpp/Time.h"
 //#include "CommonFramework/Logging/Logger.h"
@@ -45,6 +46,23 @@ bool parse_ip_and_port(const std::string& str, QHostAddress& address, int& port)
 
 
 
+bool parse_command_finished(std::string_view message, uint64_t& seqnum){
+    constexpr std::string_view TOKEN = "cqCommandFinished";
+    if (message.size() <= TOKEN.size() || message.compare(0, TOKEN.size(), TOKEN) != 0){
+        return false;
+    }
+
+    const char* ptr = message.data() + TOKEN.size();
+    const char* end = message.data() + message.size();
+    while (ptr < end && (*ptr == ' ' || *ptr == '\t')){
+        ptr++;
+    }
+    return std::from_chars(ptr, end, seqnum).ec == std::errc();
+}
+
+
+
+
 TcpSysbotBase_Connection::TcpSysbotBase_Connection(
     Logger& logger,
     const std::string& url
@@ -99,11 +117,15 @@ TcpSysbotBase_Connection::~TcpSysbotBase_Connection(){
 }
 
 
-void TcpSysbotBase_Connection::write_data(const std::string& data){
+void TcpSysbotBase_Connection::write_data(std::string_view data){
     WriteSpinLock lg(m_send_lock, "TcpSysbotBase_Connection::write_data()");
 //    cout << "Sending: " << data << endl;
     m_socket.send(data.data(), data.size());
 }
+void TcpSysbotBase_Connection::write_data(const std::string_view* parts, size_t count){
+    WriteSpinLock lg(m_send_lock, "TcpSysbotBase_Connection::write_data()");
+    m_socket.send_gather(parts, count);
+}
 
 
 std::string pretty_print(uint64_t x){
@@ -184,16 +206,10 @@ void TcpSysbotBase_Connection::on_receive_data(const void* data, size_t bytes){
                 continue;
             }
             if (ch != '\n'){
-                m_receive_buffer.emplace_back(ch);
+                m_receive_buffer += ch;
                 continue;
             }
-            process_message(
-                std::string(
-                    m_receive_buffer.begin(),
-                    m_receive_buffer.end()
-                ),
-                now
-            );
+            process_message(m_receive_buffer, now);
             m_receive_buffer.clear();
         }
 
@@ -208,6 +224,13 @@ void TcpSysbotBase_Connection::process_message(const std::string& message, WallC
 
     m_listeners.run_method_unique(&Listener::on_message, message);
 
+    //  Command acks are the bulk of the traffic and are handled entirely by the
+    //  listeners.
+    uint64_t seqnum;
+    if (parse_command_finished(message, seqnum)){
+        return;
+    }
+
     //  Version #
     std::string str = message;
     if (str.find('.') != std::string::npos){
@@ -7,7 +7,7 @@
 #ifndef PokemonAutomation_Controllers_SysbotBase_Connection_H
 #define PokemonAutomation_Controllers_SysbotBase_Connection_H
 
-#include <deque>
+#include <string_view>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
@@ -22,6 +22,11 @@ namespace PokemonAutomation{
 namespace SysbotBase{
 
 
+//  Parse a "cqCommandFinished <seqnum>" reply. Returns false if the message is
+//  something else.
+bool parse_command_finished(std::string_view message, uint64_t& seqnum);
+
+
 class TcpSysbotBase_Connection : public ControllerConnection, private ClientSocket::Listener{
 public:
     struct Listener{
@@ -46,7 +51,10 @@ public:
         return m_supports_command_queue.load(std::memory_order_relaxed);
     }
 
-    void write_data(const std::string& data);
+    void write_data(std::string_view data);
+
+    //  Send several pieces back-to-back in one socket call.
+    void write_data(const std::string_view* parts, size_t count);
 
 private:
     void thread_loop();
@@ -71,7 +79,7 @@ private:
     uint64_t m_ping_seqnum = 0;
     std::map<uint64_t, WallClock> m_active_pings;
 
-    std::deque<char> m_receive_buffer;
+    std::string m_receive_buffer;
 
     SpinLock m_send_lock;
     std::mutex m_lock;
@@ -4,8 +4,11 @@
  *
  */
 
+#include <string.h>
+#include <algorithm>
+#include <charconv>
 #include "Common/Cpp/Exceptions.h"
-#include "Common/Cpp/Concurrency/SpinPause.h"
+#include "Common/Cpp/Concurrency/PreciseSleep.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Options/Environment/PerformanceOptions.h"
 #include "Controllers/JoystickTools.h"
@@ -30,7 +33,7 @@ ProController_SysbotBase::ProController_SysbotBase(
     , m_stopping(false)
     , m_replace_on_next(false)
     , m_command_queue(QUEUE_SIZE)
-    , m_next_state_change(WallClock::max())
+    , m_next_state_change(SteadyClock::max())
 {
     if (!connection.is_ready()){
         return;
@@ -61,7 +64,7 @@ void ProController_SysbotBase::cancel_all_commands(){
 //    cout << "ProController_SysbotBase::cancel_all_commands()" << endl;
     std::lock_guard<std::mutex> lg(m_state_lock);
     size_t queue_size = m_command_queue.size();
-    m_next_state_change = WallClock::min();
+    m_next_state_change = SteadyClock::min();
     m_command_queue.clear();
     m_cv.notify_all();
     m_scheduler.clear_on_next();
@@ -79,8 +82,8 @@ void ProController_SysbotBase::replace_on_next_command(){
 
 void ProController_SysbotBase::wait_for_all(const Cancellable* cancellable){
 //    cout << "ProController_SysbotBase::wait_for_all - Enter()" << endl;
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = reset_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         m_logger.log("wait_for_all(): Command Queue Size = " + std::to_string(m_command_queue.size()), COLOR_DARKGREEN);
@@ -90,7 +93,7 @@ void ProController_SysbotBase::wait_for_all(const Cancellable* cancellable){
 
     std::unique_lock<std::mutex> lg1(m_state_lock);
     m_cv.wait(lg1, [this]{
-        return m_next_state_change == WallClock::max() || m_replace_on_next;
+        return m_next_state_change == SteadyClock::max() || m_replace_on_next;
     });
     if (cancellable){
         cancellable->throw_if_cancelled();
@@ -128,13 +131,13 @@ void ProController_SysbotBase::execute_state(
 //        cout << "executing replace" << endl;
         m_replace_on_next = false;
         m_command_queue.clear();
-        m_next_state_change = WallClock::min();
+        m_next_state_change = SteadyClock::min();
         m_cv.notify_all();
     }
 
     //  Enqueuing into empty+idle queue.
-    if (m_next_state_change == WallClock::max()){
-        m_next_state_change = WallClock::min();
+    if (m_next_state_change == SteadyClock::max()){
+        m_next_state_change = SteadyClock::min();
         m_cv.notify_all();
     }
 
@@ -169,28 +172,49 @@ void ProController_SysbotBase::send_diff(
 
     //  These need to match:
     //  https://github.com/olliz0r/sys-botbase/blob/master/sys-botbase/source/util.c#L145
-    static const std::vector<std::pair<Button, std::string>> BUTTON_MAP{
-        {BUTTON_Y, "Y"},
-        {BUTTON_B, "B"},
-        {BUTTON_A, "A"},
-        {BUTTON_X, "X"},
-        {BUTTON_L, "L"},
-        {BUTTON_R, "R"},
-        {BUTTON_ZL, "ZL"},
-        {BUTTON_ZR, "ZR"},
-        {BUTTON_MINUS, "MINUS"},
-        {BUTTON_PLUS, "PLUS"},
-        {BUTTON_LCLICK, "LSTICK"},
-        {BUTTON_RCLICK, "RSTICK"},
-        {BUTTON_HOME, "HOME"},
-        {BUTTON_CAPTURE, "CAPTURE"},
-        {BUTTON_UP, "DU"},
-        {BUTTON_RIGHT, "DR"},
-        {BUTTON_DOWN, "DD"},
-        {BUTTON_LEFT, "DL"},
+    //
+    //  The full command lines are preformatted so that nothing needs to be
+    //  built per button.
+    struct ButtonCommand{
+        Button button;
+        std::string_view press;
+        std::string_view release;
+    };
+    static constexpr ButtonCommand BUTTON_MAP[] = {
+        {BUTTON_Y,       "press Y\r\n",       "release Y\r\n"},
+        {BUTTON_B,       "press B\r\n",       "release B\r\n"},
+        {BUTTON_A,       "press A\r\n",       "release A\r\n"},
+        {BUTTON_X,       "press X\r\n",       "release X\r\n"},
+        {BUTTON_L,       "press L\r\n",       "release L\r\n"},
+        {BUTTON_R,       "press R\r\n",       "release R\r\n"},
+        {BUTTON_ZL,      "press ZL\r\n",      "release ZL\r\n"},
+        {BUTTON_ZR,      "press ZR\r\n",      "release ZR\r\n"},
+        {BUTTON_MINUS,   "press MINUS\r\n",   "release MINUS\r\n"},
+        {BUTTON_PLUS,    "press PLUS\r\n",    "release PLUS\r\n"},
+        {BUTTON_LCLICK,  "press LSTICK\r\n",  "release LSTICK\r\n"},
+        {BUTTON_RCLICK,  "press RSTICK\r\n",  "release RSTICK\r\n"},
+        {BUTTON_HOME,    "press HOME\r\n",    "release HOME\r\n"},
+        {BUTTON_CAPTURE, "press CAPTURE\r\n", "release CAPTURE\r\n"},
+        {BUTTON_UP,      "press DU\r\n",      "release DU\r\n"},
+        {BUTTON_RIGHT,   "press DR\r\n",      "release DR\r\n"},
+        {BUTTON_DOWN,    "press DD\r\n",      "release DD\r\n"},
+        {BUTTON_LEFT,    "press DL\r\n",      "release DL\r\n"},
     };
 
-    std::string message;
+    //  Large enough for every button to change plus both sticks.
+    char message[512];
+    size_t message_size = 0;
+    auto append = [&](std::string_view str){
+        memcpy(message + message_size, str.data(), str.size());
+        message_size += str.size();
+    };
+    auto append_stick = [&](std::string_view prefix, int16_t x, int16_t y){
+        append(prefix);
+        message_size = std::to_chars(message + message_size, message + sizeof(message), x).ptr - message;
+        message[message_size++] = ' ';
+        message_size = std::to_chars(message + message_size, message + sizeof(message), y).ptr - message;
+        append("\r\n");
+    };
 
 
     //  Merge the dpad states.
@@ -212,17 +236,13 @@ void ProController_SysbotBase::send_diff(
 
     if (old_buttons != new_buttons){
         for (const auto& button : BUTTON_MAP){
-            ButtonFlagType mask = (ButtonFlagType)button.first;
+            ButtonFlagType mask = (ButtonFlagType)button.button;
             bool before = (ButtonFlagType)old_buttons & mask;
             bool after = (ButtonFlagType)new_buttons & mask;
             if (before == after){
                 continue;
             }
-            if (after){
-                message += "press " + button.second + "\r\n";
-            }else{
-                message += "release " + button.second + "\r\n";
-            }
+            append(after ? button.press : button.release);
         }
     }
 
@@ -236,11 +256,7 @@ void ProController_SysbotBase::send_diff(
         int16_t ix = JoystickTools::linear_float_to_s16(fx);
         int16_t iy = JoystickTools::linear_float_to_s16(fy);
 //        cout << "ix = " << ix << ", iy = " << iy << endl;
-        message += "setStick LEFT ";
-        message += std::to_string(ix);
-        message += " ";
-        message += std::to_string(iy);
-        message += "\r\n";
+        append_stick("setStick LEFT ", ix, iy);
     }
     if (old_state.right_x != new_state.right_x ||
         old_state.right_y != new_state.right_y
@@ -250,25 +266,21 @@ void ProController_SysbotBase::send_diff(
         JoystickTools::clip_magnitude(fx, fy);
         int16_t ix = JoystickTools::linear_float_to_s16(fx);
         int16_t iy = JoystickTools::linear_float_to_s16(fy);
-        message += "setStick RIGHT ";
-        message += std::to_string(ix);
-        message += " ";
-        message += std::to_string(iy);
-        message += "\r\n";
+        append_stick("setStick RIGHT ", ix, iy);
     }
 
-    if (message.empty()){
+    if (message_size == 0){
         return;
     }
 
-//    cout << message << endl;
-    m_connection.write_data(message);
+//    cout << std::string_view(message, message_size) << endl;
+    m_connection.write_data(std::string_view(message, message_size));
 
     //  Do not log the contents of the command due to privacy concerns.
     //  (people entering passwords)
 #if 0
     if (GlobalSettings::instance().LOG_EVERYTHING){
-        m_logger.log("sys-botbase: " + message);
+        m_logger.log("sys-botbase: " + std::string(message, message_size));
     }
 #endif
 }
@@ -282,19 +294,22 @@ void ProController_SysbotBase::thread_body(){
 
     std::unique_lock<std::mutex> lg(m_state_lock);
     while (!m_stopping.load(std::memory_order_relaxed)){
-        WallClock now = current_time();
+        SteadyClock now = current_steady_time();
 
         //  State change.
         if (now >= m_next_state_change){
+            if (m_next_state_change != SteadyClock::min()){
+                m_jitter.add(m_next_state_change, now);
+            }
             if (m_command_queue.empty()){
                 send_diff(current_state, ProControllerState());
                 current_state.clear();
-                m_next_state_change = WallClock::max();
+                m_next_state_change = SteadyClock::max();
             }else{
                 Command& command = m_command_queue.front();
                 send_diff(current_state, command.state);
                 current_state = command.state;
-                if (m_next_state_change == WallClock::min()){
+                if (m_next_state_change == SteadyClock::min()){
                     m_next_state_change = now;
                 }
                 m_next_state_change += command.duration;
@@ -304,8 +319,14 @@ void ProController_SysbotBase::thread_body(){
             continue;
         }
 
+        //  Spin the rest of the way. Release the lock so that the issuing
+        //  threads aren't blocked while we do it. Spin in short slices so that
+        //  a cancel, replace or stop that moves the deadline is seen.
         if (now + EARLY_WAKE >= m_next_state_change){
-            pause();
+            SteadyClock deadline = std::min(m_next_state_change, now + SPIN_RECHECK_INTERVAL);
+            lg.unlock();
+            spin_until(deadline);
+            lg.lock();
             continue;
         }
 
@@ -9,6 +9,7 @@
 #define PokemonAutomation_NintendoSwitch_ProController_SysbotBase_H
 
 #include <condition_variable>
+#include "Common/Cpp/JitterHistogram.h"
 #include "Common/Cpp/Containers/CircularBuffer.h"
 #include "NintendoSwitch/NintendoSwitch_Settings.h"
 #include "NintendoSwitch/Controllers/NintendoSwitch_VirtualControllerState.h"
@@ -30,6 +31,10 @@ public:
 
     static constexpr size_t QUEUE_SIZE = 4;
 
+    //  While spinning for a state change, the dispatch thread rechecks the
+    //  queue this often. This is how long a cancel or replace can go unseen.
+    static constexpr std::chrono::microseconds SPIN_RECHECK_INTERVAL{100};
+
 
 public:
     ProController_SysbotBase(
@@ -212,6 +217,18 @@ public:
     ) override{
         ControllerWithScheduler::issue_system_scroll(cancellable, delay, hold, cooldown, direction);
     }
+    virtual void issue_compiled(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::Schedule& schedule
+    ) override{
+        ControllerWithScheduler::issue_compiled(cancellable, schedule);
+    }
+
+
+public:
+    virtual JitterHistogramSnapshot state_change_jitter() const override{
+        return m_jitter.snapshot();
+    }
 
 
 private:
@@ -239,9 +256,11 @@ private:
     };
     CircularBuffer<Command> m_command_queue;
 
-    //  WallClock::max() means the queue is empty.
-    //  WallClock::min() means the state has suddently changed.
-    WallClock m_next_state_change;
+    //  SteadyClock::max() means the queue is empty.
+    //  SteadyClock::min() means the state has suddently changed.
+    SteadyClock m_next_state_change;
+
+    JitterHistogram m_jitter;
 
     std::condition_variable m_cv;
     std::thread m_dispatch_thread;
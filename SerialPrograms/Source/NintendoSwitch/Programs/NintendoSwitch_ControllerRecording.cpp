@@ -0,0 +1,358 @@
+/*  Controller Recording
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Controllers/ControllerTypeStrings.h"
+#include "NintendoSwitch/Controllers/NintendoSwitch_VirtualControllerState.h"
+#include "NintendoSwitch_ControllerRecording.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+
+
+
+namespace{
+
+const char MAGIC[4] = {'P', 'A', 'C', 'R'};
+constexpr uint8_t VERSION = 1;
+
+enum : uint8_t{
+    FLAG_NEUTRAL        =   1 << 0,
+    FLAG_BUTTONS        =   1 << 1,
+    FLAG_DPAD           =   1 << 2,
+    FLAG_LEFT_STICK     =   1 << 3,
+    FLAG_RIGHT_STICK    =   1 << 4,
+    FLAG_ALL            =   (1 << 5) - 1,
+};
+
+uint64_t zigzag_encode(int64_t x){
+    return ((uint64_t)x << 1) ^ (uint64_t)(x >> 63);
+}
+int64_t zigzag_decode(uint64_t x){
+    return (int64_t)(x >> 1) ^ -(int64_t)(x & 1);
+}
+
+void write_varint(std::ostream& stream, uint64_t x){
+    while (x >= 0x80){
+        stream.put((char)(x | 0x80));
+        x >>= 7;
+    }
+    stream.put((char)x);
+}
+
+//  These return false if the stream ends first.
+bool read_varint(std::istream& stream, uint64_t& x){
+    x = 0;
+    for (int shift = 0; shift < 64; shift += 7){
+        int ch = stream.get();
+        if (ch == std::char_traits<char>::eof()){
+            return false;
+        }
+        x |= (uint64_t)(ch & 0x7f) << shift;
+        if ((ch & 0x80) == 0){
+            return true;
+        }
+    }
+    throw ParseException("Invalid varint in controller recording.");
+}
+bool read_u8(std::istream& stream, uint8_t& x){
+    int ch = stream.get();
+    if (ch == std::char_traits<char>::eof()){
+        return false;
+    }
+    x = (uint8_t)ch;
+    return true;
+}
+
+bool is_joycon(ControllerClass controller_class){
+    return controller_class == ControllerClass::NintendoSwitch_LeftJoycon
+        || controller_class == ControllerClass::NintendoSwitch_RightJoycon;
+}
+
+}
+
+
+
+bool ControllerRecordingEntry::same_state(const ControllerRecordingEntry& x) const{
+    if (is_neutral || x.is_neutral){
+        return is_neutral == x.is_neutral;
+    }
+    return buttons == x.buttons
+        && dpad == x.dpad
+        && left_x == x.left_x
+        && left_y == x.left_y
+        && right_x == x.right_x
+        && right_y == x.right_y;
+}
+
+ControllerRecordingEntry make_recording_entry(const ControllerState& state){
+    ControllerRecordingEntry entry;
+    if (state.is_neutral()){
+        return entry;
+    }
+    if (const ProControllerState* pro = dynamic_cast<const ProControllerState*>(&state)){
+        entry.is_neutral = false;
+        entry.buttons = pro->buttons;
+        entry.dpad = pro->dpad;
+        entry.left_x = pro->left_x;
+        entry.left_y = pro->left_y;
+        entry.right_x = pro->right_x;
+        entry.right_y = pro->right_y;
+    }else if (const JoyconState* joycon = dynamic_cast<const JoyconState*>(&state)){
+        entry.is_neutral = false;
+        entry.buttons = joycon->buttons;
+        entry.left_x = joycon->joystick_x;
+        entry.left_y = joycon->joystick_y;
+    }
+    return entry;
+}
+
+
+
+ControllerRecordingWriter::ControllerRecordingWriter(const std::string& filename, ControllerClass controller_class)
+    : m_filename(filename)
+    , m_file(filename, std::ios::binary | std::ios::trunc)
+{
+    if (!m_file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file for writing.", filename);
+    }
+
+    const std::string& slug = CONTROLLER_CLASS_STRINGS().get_string(controller_class);
+    m_file.write(MAGIC, sizeof(MAGIC));
+    m_file.put((char)VERSION);
+    m_file.put((char)slug.size());
+    m_file.write(slug.data(), slug.size());
+}
+void ControllerRecordingWriter::append(const ControllerRecordingEntry& entry){
+    uint8_t flags = 0;
+    if (entry.is_neutral){
+        flags |= FLAG_NEUTRAL;
+    }else{
+        if (entry.buttons != m_previous.buttons)    flags |= FLAG_BUTTONS;
+        if (entry.dpad != m_previous.dpad)          flags |= FLAG_DPAD;
+        if (entry.left_x != m_previous.left_x ||
+            entry.left_y != m_previous.left_y
+        ){
+            flags |= FLAG_LEFT_STICK;
+        }
+        if (entry.right_x != m_previous.right_x ||
+            entry.right_y != m_previous.right_y
+        ){
+            flags |= FLAG_RIGHT_STICK;
+        }
+        m_previous = entry;
+    }
+
+    m_file.put((char)flags);
+    write_varint(m_file, zigzag_encode(entry.duration_in_ms));
+    if (flags & FLAG_BUTTONS){
+        write_varint(m_file, (ButtonFlagType)entry.buttons);
+    }
+    if (flags & FLAG_DPAD){
+        m_file.put((char)entry.dpad);
+    }
+    if (flags & FLAG_LEFT_STICK){
+        m_file.put((char)entry.left_x);
+        m_file.put((char)entry.left_y);
+    }
+    if (flags & FLAG_RIGHT_STICK){
+        m_file.put((char)entry.right_x);
+        m_file.put((char)entry.right_y);
+    }
+}
+void ControllerRecordingWriter::close(){
+    m_file.flush();
+    if (!m_file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write to file.", m_filename);
+    }
+    m_file.close();
+}
+
+
+
+ControllerRecordingReader::ControllerRecordingReader(const std::string& filename)
+    : m_filename(filename)
+    , m_file(filename, std::ios::binary)
+    , m_controller_class(ControllerClass::None)
+{
+    if (!m_file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file.", filename);
+    }
+
+    char magic[sizeof(MAGIC)];
+    m_file.read(magic, sizeof(magic));
+    uint8_t version;
+    uint8_t slug_length;
+    if (!m_file ||
+        memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !read_u8(m_file, version) ||
+        !read_u8(m_file, slug_length)
+    ){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Not a controller recording.", filename);
+    }
+    if (version != VERSION){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unsupported recording version: " + std::to_string(version), filename);
+    }
+
+    std::string slug(slug_length, '\0');
+    m_file.read(slug.data(), slug_length);
+    if (!m_file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Recording header is truncated.", filename);
+    }
+    m_controller_class = CONTROLLER_CLASS_STRINGS().get_enum(slug);
+    m_first_entry = m_file.tellg();
+}
+bool ControllerRecordingReader::next(ControllerRecordingEntry& entry){
+    uint8_t flags;
+    uint64_t duration;
+    if (!read_u8(m_file, flags) || !read_varint(m_file, duration)){
+        return false;
+    }
+    if (flags & ~FLAG_ALL){
+        throw ParseException("Invalid entry flags in controller recording: " + std::to_string(flags));
+    }
+
+    if (flags & FLAG_NEUTRAL){
+        entry = ControllerRecordingEntry();
+        entry.duration_in_ms = zigzag_decode(duration);
+        return true;
+    }
+
+    ControllerRecordingEntry current = m_previous;
+    current.is_neutral = false;
+    current.duration_in_ms = zigzag_decode(duration);
+    if (flags & FLAG_BUTTONS){
+        uint64_t buttons;
+        if (!read_varint(m_file, buttons)){
+            return false;
+        }
+        current.buttons = (Button)buttons;
+    }
+    if (flags & FLAG_DPAD){
+        uint8_t dpad;
+        if (!read_u8(m_file, dpad)){
+            return false;
+        }
+        if (dpad > DPAD_NONE){
+            throw ParseException("Invalid dpad in controller recording: " + std::to_string(dpad));
+        }
+        current.dpad = (DpadPosition)dpad;
+    }
+    if (flags & FLAG_LEFT_STICK){
+        if (!read_u8(m_file, current.left_x) || !read_u8(m_file, current.left_y)){
+            return false;
+        }
+    }
+    if (flags & FLAG_RIGHT_STICK){
+        if (!read_u8(m_file, current.right_x) || !read_u8(m_file, current.right_y)){
+            return false;
+        }
+    }
+
+    m_previous = current;
+    entry = current;
+    return true;
+}
+void ControllerRecordingReader::rewind(){
+    m_file.clear();
+    m_file.seekg(m_first_entry);
+    m_previous = ControllerRecordingEntry();
+}
+
+
+
+bool is_controller_recording_file(const std::string& filename){
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    file.read(magic, sizeof(magic));
+    return file && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+
+
+JsonValue controller_recording_to_json(const std::string& filename){
+    ControllerRecordingReader reader(filename);
+    ControllerClass controller_class = reader.controller_class();
+    bool joycon = is_joycon(controller_class);
+
+    JsonArray history;
+    ControllerRecordingEntry entry;
+    while (reader.next(entry)){
+        JsonObject obj;
+        obj["is_neutral"] = entry.is_neutral;
+        if (!entry.is_neutral){
+            obj["buttons"] = button_to_string(entry.buttons);
+            if (joycon){
+                obj["joystick_x"] = entry.left_x;
+                obj["joystick_y"] = entry.left_y;
+            }else{
+                obj["dpad"] = dpad_to_string(entry.dpad);
+                obj["left_x"] = entry.left_x;
+                obj["left_y"] = entry.left_y;
+                obj["right_x"] = entry.right_x;
+                obj["right_y"] = entry.right_y;
+            }
+        }
+        obj["duration_in_ms"] = entry.duration_in_ms;
+        history.push_back(std::move(obj));
+    }
+
+    JsonObject json_result;
+    json_result["controller_class"] = CONTROLLER_CLASS_STRINGS().get_string(controller_class);
+    json_result["history"] = JsonValue(std::move(history));
+    return json_result;
+}
+
+void json_to_controller_recording(const JsonValue& json, const std::string& filename){
+    const JsonObject& obj = json.to_object_throw();
+    ControllerClass controller_class = CONTROLLER_CLASS_STRINGS().get_enum(obj.get_string_throw("controller_class"));
+    bool joycon = is_joycon(controller_class);
+    if (!joycon && controller_class != ControllerClass::NintendoSwitch_ProController){
+        throw ParseException("Unsupported controller class: " + obj.get_string_throw("controller_class"));
+    }
+
+    const JsonArray& history = obj.get_array_throw("history");
+
+    auto read_stick = [](const JsonObject& snapshot, const std::string& key){
+        int64_t value = snapshot.get_integer_throw(key);
+        if (value > STICK_MAX || value < STICK_MIN){
+            throw ParseException("x or y values are outside of 0-255.");
+        }
+        return (uint8_t)value;
+    };
+
+    ControllerRecordingWriter writer(filename, controller_class);
+    for (size_t i = 0; i < history.size(); i++){
+        const JsonObject& snapshot = history[i].to_object_throw();
+
+        ControllerRecordingEntry entry;
+        entry.duration_in_ms = snapshot.get_integer_throw("duration_in_ms");
+        entry.is_neutral = snapshot.get_boolean_throw("is_neutral");
+        if (!entry.is_neutral){
+            entry.buttons = string_to_button(snapshot.get_string_throw("buttons"));
+            if (joycon){
+                entry.left_x = read_stick(snapshot, "joystick_x");
+                entry.left_y = read_stick(snapshot, "joystick_y");
+            }else{
+                entry.dpad = string_to_dpad(snapshot.get_string_throw("dpad"));
+                entry.left_x = read_stick(snapshot, "left_x");
+                entry.left_y = read_stick(snapshot, "left_y");
+                entry.right_x = read_stick(snapshot, "right_x");
+                entry.right_y = read_stick(snapshot, "right_y");
+            }
+        }
+        writer.append(entry);
+    }
+    writer.close();
+}
+
+
+
+}
+}
@@ -0,0 +1,118 @@
+/*  Controller Recording
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Compact binary format for recorded controller sessions. Entries are
+ *  written as they happen and read back one at a time so that neither
+ *  recording nor playback needs to hold the whole session in memory.
+ *
+ *  Layout:
+ *      Header:
+ *          "PACR"                      4 bytes
+ *          Version                     1 byte
+ *          Controller class length     1 byte
+ *          Controller class            "CONTROLLER_CLASS_STRINGS()" slug
+ *
+ *      Entries: (repeated until end of file)
+ *          Flags                       1 byte  (see below)
+ *          Duration in ms              zigzag varint
+ *          Buttons                     varint      (if FLAG_BUTTONS)
+ *          Dpad                        1 byte      (if FLAG_DPAD)
+ *          Left X, Left Y              2 bytes     (if FLAG_LEFT_STICK)
+ *          Right X, Right Y            2 bytes     (if FLAG_RIGHT_STICK)
+ *
+ *  Fields are delta-encoded. Only the ones that differ from the previous
+ *  non-neutral entry are stored. Neutral entries store no fields.
+ *
+ */
+
+#ifndef PokemonAutomation_NintendoSwitch_ControllerRecording_H
+#define PokemonAutomation_NintendoSwitch_ControllerRecording_H
+
+#include <string>
+#include <fstream>
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Controllers/ControllerTypes.h"
+#include "NintendoSwitch/Controllers/NintendoSwitch_ControllerButtons.h"
+
+namespace PokemonAutomation{
+    class ControllerState;
+namespace NintendoSwitch{
+
+
+
+//  One step of a recording. Joycons use "left_x" and "left_y" for their only
+//  joystick.
+struct ControllerRecordingEntry{
+    bool is_neutral = true;
+    Button buttons = BUTTON_NONE;
+    DpadPosition dpad = DPAD_NONE;
+    uint8_t left_x = STICK_CENTER;
+    uint8_t left_y = STICK_CENTER;
+    uint8_t right_x = STICK_CENTER;
+    uint8_t right_y = STICK_CENTER;
+    int64_t duration_in_ms = 0;
+
+    //  Compare everything except the duration.
+    bool same_state(const ControllerRecordingEntry& x) const;
+};
+
+//  Returns a neutral entry if "state" isn't a Switch controller state.
+ControllerRecordingEntry make_recording_entry(const ControllerState& state);
+
+
+
+class ControllerRecordingWriter{
+public:
+    ControllerRecordingWriter(const std::string& filename, ControllerClass controller_class);
+
+    //  Write errors are reported by "close()".
+    void append(const ControllerRecordingEntry& entry);
+
+    //  Flush everything to disk. Throws if anything failed to write.
+    void close();
+
+private:
+    std::string m_filename;
+    std::ofstream m_file;
+    ControllerRecordingEntry m_previous;
+};
+
+
+
+class ControllerRecordingReader{
+public:
+    ControllerRecordingReader(const std::string& filename);
+
+    ControllerClass controller_class() const{ return m_controller_class; }
+
+    //  Read the next entry. Returns false at the end of the recording.
+    //  A truncated final entry (from a recording that was cut off) is treated
+    //  as the end.
+    bool next(ControllerRecordingEntry& entry);
+
+    //  Go back to the first entry.
+    void rewind();
+
+private:
+    std::string m_filename;
+    std::ifstream m_file;
+    ControllerClass m_controller_class;
+    std::streampos m_first_entry;
+    ControllerRecordingEntry m_previous;
+};
+
+
+//  Returns true if "filename" exists and starts with the recording header.
+bool is_controller_recording_file(const std::string& filename);
+
+
+//  Converters to and from the JSON format used by older recordings.
+JsonValue controller_recording_to_json(const std::string& filename);
+void json_to_controller_recording(const JsonValue& json, const std::string& filename);
+
+
+
+}
+}
+#endif
@@ -8,6 +8,7 @@
 #include "Common/Cpp/Json/JsonArray.h"
 #include "NintendoSwitch/Commands/NintendoSwitch_Commands_PushButtons.h"
 #include "NintendoSwitch/Controllers/NintendoSwitch_ProController.h"
+#include "NintendoSwitch/Controllers/SerialPABotBase/NintendoSwitch_SerialPABotBase_WiredController.h"
 #include "NintendoSwitch_RecordKeyboardController.h"
 #include "Controllers/ControllerTypeStrings.h"
 
@@ -44,6 +45,8 @@ RecordKeyboardController::RecordKeyboardController()
             {Mode::RECORD,   "record", "Record "},
             {Mode::REPLAY,  "replay", "Replay"},
             {Mode::CONVERT_JSON_TO_CODE,       "convert-to-code", "[For Developers] Convert json to code."},
+            {Mode::CONVERT_JSON_TO_BINARY,     "convert-json-to-binary", "Convert JSON recording to binary."},
+            {Mode::CONVERT_BINARY_TO_JSON,     "convert-binary-to-json", "Convert binary recording to JSON."},
         },
         LockMode::LOCK_WHILE_RUNNING,
         Mode::RECORD
@@ -51,7 +54,9 @@ RecordKeyboardController::RecordKeyboardController()
     , FILE_NAME(
         false,
         "<b>File name:</b><br>"
-        "Name of the JSON file to read/write.", 
+        "Name of the recording to read/write, without the extension. "
+        "New recordings are saved as a compact binary \".bin\" file. "
+        "Replay and convert-to-code use the \".bin\" file if there is one, otherwise the \".json\" file.", 
         LockMode::LOCK_WHILE_RUNNING, 
         "UserSettings/recording",
         "<name of JSON file>"
@@ -88,43 +93,77 @@ void RecordKeyboardController::program(SingleSwitchProgramEnvironment& env, Canc
     AbstractControllerContext context(scope, env.console.controller());
     ControllerClass controller_class = env.console.controller().controller_class();
 
-    if (MODE == Mode::RECORD){
-        // check if given file name already exists. If it does, throw an error so we don't overwrite it.
-        std::string output_json_filename = std::string(FILE_NAME) + ".json";
-        QFile file(QString::fromStdString(output_json_filename));
+    std::string binary_filename = std::string(FILE_NAME) + ".bin";
+    std::string json_filename = std::string(FILE_NAME) + ".json";
+
+    // throw an error if the given file name already exists, so we don't overwrite it.
+    auto check_not_exists = [](const std::string& filename){
+        QFile file(QString::fromStdString(filename));
         if (file.open(QFile::ReadOnly)){
-            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Given file name already exists. Choose a different file name.", output_json_filename);
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Given file name already exists. Choose a different file name.", filename);
         }
+    };
+
+    if (MODE == Mode::RECORD){
+        check_not_exists(binary_filename);
 
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_writer = std::make_unique<ControllerRecordingWriter>(binary_filename, controller_class);
+            m_has_snapshot = false;
+        }
         context.controller().add_keyboard_listener(*this);
 
         try{
             context.wait_until_cancel();
         }catch (ProgramCancelledException&){
+            context.controller().remove_keyboard_listener(*this);
 
-            JsonValue json = controller_history_to_json(env.console.logger(), controller_class);
-            json.dump(output_json_filename);
-            m_controller_history.clear();
+            std::unique_ptr<ControllerRecordingWriter> writer;
+            {
+                std::lock_guard<std::mutex> lg(m_lock);
+                writer = std::move(m_writer);
+            }
+            writer->close();
 
             if (GENERATE_CPP_CODE_AFTER_RECORDING){
-                json_to_cpp_code(env.console.logger(), json, FILE_NAME);
+                json_to_cpp_code(env.console.logger(), controller_recording_to_json(binary_filename), FILE_NAME);
             }
 
-            context.controller().remove_keyboard_listener(*this);
-            
             throw;
         }        
         
     }else if (MODE == Mode::REPLAY){
-        JsonValue json = load_json_file(std::string(FILE_NAME) + ".json");
-        json_to_pbf_actions(env, scope, json, controller_class, LOOP, WAIT);
+        if (is_controller_recording_file(binary_filename)){
+            recording_to_pbf_actions(env, scope, binary_filename, controller_class, LOOP, WAIT);
+        }else{
+            JsonValue json = load_json_file(json_filename);
+            json_to_pbf_actions(env, scope, json, controller_class, LOOP, WAIT);
+        }
 
 
     }else if (MODE == Mode::CONVERT_JSON_TO_CODE){
-        JsonValue json = load_json_file(std::string(FILE_NAME) + ".json");
+        JsonValue json = is_controller_recording_file(binary_filename)
+            ? controller_recording_to_json(binary_filename)
+            : load_json_file(json_filename);
         json_to_cpp_code(env.console.logger(), json, FILE_NAME);
 
 
+    }else if (MODE == Mode::CONVERT_JSON_TO_BINARY){
+        check_not_exists(binary_filename);
+        try{
+            json_to_controller_recording(load_json_file(json_filename), binary_filename);
+        }catch (ParseException& e){
+            env.log(e.message() + "\nJSON parsing error. Given JSON file doesn't match the expected format.", COLOR_RED);
+            throw ParseException(e.message() + "\nJSON parsing error. Given JSON file doesn't match the expected format.");
+        }
+
+
+    }else if (MODE == Mode::CONVERT_BINARY_TO_JSON){
+        check_not_exists(json_filename);
+        controller_recording_to_json(binary_filename).dump(json_filename);
+
+
     }
 
 }
@@ -308,6 +347,71 @@ void json_to_pbf_actions(SingleSwitchProgramEnvironment& env, CancellableScope&
 
 }
 
+namespace{
+
+void run_pro_controller_action(
+    ProControllerContext& context,
+    NonNeutralControllerField non_neutral_field,
+    Button button, 
+    DpadPosition dpad, 
+    uint8_t left_x, 
+    uint8_t left_y, 
+    uint8_t right_x, 
+    uint8_t right_y, 
+    int64_t duration_in_ms
+){
+    switch (non_neutral_field){
+    case NonNeutralControllerField::BUTTON:
+        pbf_press_button(context, button, Milliseconds(duration_in_ms), Milliseconds(0));
+        break;
+    case NonNeutralControllerField::DPAD:
+        pbf_press_dpad(context, dpad, Milliseconds(duration_in_ms), Milliseconds(0));
+        break;
+    case NonNeutralControllerField::LEFT_JOYSTICK:
+        pbf_move_left_joystick(context, left_x, left_y, Milliseconds(duration_in_ms), Milliseconds(0));
+        break;
+    case NonNeutralControllerField::RIGHT_JOYSTICK:
+        pbf_move_right_joystick(context, right_x, right_y, Milliseconds(duration_in_ms), Milliseconds(0));
+        break;
+    case NonNeutralControllerField::MULTIPLE:
+        pbf_controller_state(context, button, dpad, left_x, left_y, right_x, right_y, Milliseconds(duration_in_ms));
+        break;
+    case NonNeutralControllerField::NONE:
+        pbf_wait(context, Milliseconds(duration_in_ms));
+        break;
+    default:
+        throw ParseException("Unexpected NonNeutralControllerField enum.");
+    }            
+}
+
+void run_joycon_action(
+    JoyconContext& context,
+    NonNeutralControllerField non_neutral_field,
+    Button button, 
+    uint8_t x, 
+    uint8_t y, 
+    int64_t duration_in_ms
+){
+    switch (non_neutral_field){
+    case NonNeutralControllerField::BUTTON:
+        pbf_press_button(context, button, Milliseconds(duration_in_ms), Milliseconds(0));
+        break;
+    case NonNeutralControllerField::JOYSTICK:
+        pbf_move_joystick(context, x, y, Milliseconds(duration_in_ms), Milliseconds(0));
+        break;
+    case NonNeutralControllerField::MULTIPLE:
+        pbf_controller_state(context, button, x, y, Milliseconds(duration_in_ms));
+        break;
+    case NonNeutralControllerField::NONE:
+        pbf_wait(context, Milliseconds(duration_in_ms));
+        break;
+    default:
+        throw ParseException("Unexpected NonNeutralControllerField enum.");
+    }            
+}
+
+}
+
 void json_to_pbf_actions_pro_controller(ProControllerContext& context, const JsonArray& history, uint32_t num_loops, uint32_t seconds_wait_between_loops){
 
     for (uint32_t i = 0; i < num_loops; i++){
@@ -324,28 +428,7 @@ void json_to_pbf_actions_pro_controller(ProControllerContext& context, const Jso
                 uint8_t right_y, 
                 int64_t duration_in_ms
             ){
-                switch (non_neutral_field){
-                case NonNeutralControllerField::BUTTON:
-                    pbf_press_button(context, button, Milliseconds(duration_in_ms), Milliseconds(0));
-                    break;
-                case NonNeutralControllerField::DPAD:
-                    pbf_press_dpad(context, dpad, Milliseconds(duration_in_ms), Milliseconds(0));
-                    break;
-                case NonNeutralControllerField::LEFT_JOYSTICK:
-                    pbf_move_left_joystick(context, left_x, left_y, Milliseconds(duration_in_ms), Milliseconds(0));
-                    break;
-                case NonNeutralControllerField::RIGHT_JOYSTICK:
-                    pbf_move_right_joystick(context, right_x, right_y, Milliseconds(duration_in_ms), Milliseconds(0));
-                    break;
-                case NonNeutralControllerField::MULTIPLE:
-                    pbf_controller_state(context, button, dpad, left_x, left_y, right_x, right_y, Milliseconds(duration_in_ms));
-                    break;
-                case NonNeutralControllerField::NONE:
-                    pbf_wait(context, Milliseconds(duration_in_ms));
-                    break;
-                default:
-                    throw ParseException("Unexpected NonNeutralControllerField enum.");
-                }            
+                run_pro_controller_action(context, non_neutral_field, button, dpad, left_x, left_y, right_x, right_y, duration_in_ms);
             }
         );
 
@@ -366,22 +449,7 @@ void json_to_pbf_actions_joycon(JoyconContext& context, const JsonArray& history
                 uint8_t y, 
                 int64_t duration_in_ms
             ){
-                switch (non_neutral_field){
-                case NonNeutralControllerField::BUTTON:
-                    pbf_press_button(context, button, Milliseconds(duration_in_ms), Milliseconds(0));
-                    break;
-                case NonNeutralControllerField::JOYSTICK:
-                    pbf_move_joystick(context, x, y, Milliseconds(duration_in_ms), Milliseconds(0));
-                    break;
-                case NonNeutralControllerField::MULTIPLE:
-                    pbf_controller_state(context, button, x, y, Milliseconds(duration_in_ms));
-                    break;
-                case NonNeutralControllerField::NONE:
-                    pbf_wait(context, Milliseconds(duration_in_ms));
-                    break;
-                default:
-                    throw ParseException("Unexpected NonNeutralControllerField enum.");
-                }            
+                run_joycon_action(context, non_neutral_field, button, x, y, duration_in_ms);
             }
         );
 
@@ -390,6 +458,115 @@ void json_to_pbf_actions_joycon(JoyconContext& context, const JsonArray& history
 }
 
 
+std::vector<PABotBaseBenchmarkState> json_to_pabotbase_benchmark_workload(const JsonValue& json){
+    const JsonObject& obj = json.to_object_throw();
+
+    std::string controller_class_string = obj.get_string_throw("controller_class");
+    if (CONTROLLER_CLASS_STRINGS().get_enum(controller_class_string) != ControllerClass::NintendoSwitch_ProController){
+        throw ParseException("Only Pro Controller recordings can be replayed against the PABotBase emulator.");
+    }
+
+    std::vector<PABotBaseBenchmarkState> workload;
+
+    // the device takes at most 65535 ms per state, so split up longer ones.
+    auto append = [&](const pabb_NintendoSwitch2_WiredController_State& report, int64_t duration_in_ms){
+        while (duration_in_ms > 0){
+            uint16_t current = (uint16_t)std::min<int64_t>(duration_in_ms, 65535);
+            workload.emplace_back(PABotBaseBenchmarkState{current, report});
+            duration_in_ms -= current;
+        }
+    };
+
+    json_to_pro_controller_state(obj.get_array_throw("history"),
+        [&](int64_t duration_in_ms){
+            append(pabb_NintendoSwitch2_WiredController_State_NEUTRAL_STATE, duration_in_ms);
+        },
+        [&](NonNeutralControllerField non_neutral_field,
+            Button button, 
+            DpadPosition dpad, 
+            uint8_t left_x, 
+            uint8_t left_y, 
+            uint8_t right_x, 
+            uint8_t right_y, 
+            int64_t duration_in_ms
+        ){
+            SwitchControllerState state;
+            state.buttons = button;
+            state.dpad = dpad;
+            state.left_stick_x = left_x;
+            state.left_stick_y = left_y;
+            state.right_stick_x = right_x;
+            state.right_stick_y = right_y;
+            append(SerialPABotBase_WiredController::state_to_report(state), duration_in_ms);
+        }
+    );
+
+    return workload;
+}
+
+
+void recording_to_pbf_actions(SingleSwitchProgramEnvironment& env, CancellableScope& scope, const std::string& filename, ControllerClass controller_class, uint32_t num_loops, uint32_t seconds_wait_between_loops){
+    ControllerRecordingReader reader(filename);
+    if (reader.controller_class() != controller_class){
+        throw UserSetupError(env.logger(), "Controller class in the recording does not match your current selected controller.");
+    }
+
+    ControllerRecordingEntry entry;
+    switch (controller_class){
+    case ControllerClass::NintendoSwitch_ProController:
+    {
+        ProControllerContext context(scope, env.console.controller<ProController>());
+        for (uint32_t i = 0; i < num_loops; i++){
+            reader.rewind();
+            while (reader.next(entry)){
+                if (entry.is_neutral){
+                    pbf_wait(context, Milliseconds(entry.duration_in_ms));
+                    continue;
+                }
+                NonNeutralControllerField non_neutral_field = get_non_neutral_pro_controller_field(
+                    entry.buttons, entry.dpad, entry.left_x, entry.left_y, entry.right_x, entry.right_y
+                );
+                run_pro_controller_action(
+                    context, non_neutral_field,
+                    entry.buttons, entry.dpad, entry.left_x, entry.left_y, entry.right_x, entry.right_y,
+                    entry.duration_in_ms
+                );
+            }
+            pbf_wait(context, Seconds(seconds_wait_between_loops));
+        }
+        break;
+    }
+    case ControllerClass::NintendoSwitch_LeftJoycon:
+    case ControllerClass::NintendoSwitch_RightJoycon:
+    {
+        JoyconContext context(scope, env.console.controller<JoyconController>());
+        for (uint32_t i = 0; i < num_loops; i++){
+            reader.rewind();
+            while (reader.next(entry)){
+                if (entry.is_neutral){
+                    pbf_wait(context, Milliseconds(entry.duration_in_ms));
+                    continue;
+                }
+                NonNeutralControllerField non_neutral_field = get_non_neutral_joycon_controller_field(
+                    entry.buttons, entry.left_x, entry.left_y
+                );
+                run_joycon_action(
+                    context, non_neutral_field,
+                    entry.buttons, entry.left_x, entry.left_y,
+                    entry.duration_in_ms
+                );
+            }
+            pbf_wait(context, Seconds(seconds_wait_between_loops));
+        }
+        break;
+    }
+    default:
+        // do nothing if the ControllerClass is not one of the above.
+        break;
+    }
+}
+
+
 NonNeutralControllerField get_non_neutral_pro_controller_field(Button button, DpadPosition dpad, uint8_t left_x, uint8_t left_y, uint8_t right_x, uint8_t right_y){
     NonNeutralControllerField non_neutral_field = NonNeutralControllerField::NONE;
     int8_t num_non_neutral_fields = 0;
@@ -545,108 +722,79 @@ void json_to_joycon_state(
 
 }
 
-JsonValue RecordKeyboardController::controller_history_to_json(Logger& logger, ControllerClass controller_class){
-    if (m_controller_history.size() < 2){
-        // throw InternalProgramError(&logger, PA_CURRENT_FUNCTION, "RecordKeyboardController:: m_controller_history should have at least two entries, start and stop.");
-        logger.log("RecordKeyboardController:: We expected m_controller_history to have at least two entries, start and stop. Aborting.", COLOR_RED);
-        return JsonValue();
+void RecordKeyboardController::record_snapshot(WallClock time_stamp, const ControllerRecordingEntry& entry){
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (!m_writer){
+        return;
     }
-    
-    JsonArray json_array;
-    ControllerStateSnapshot* prev_snapshot = &m_controller_history[0]; // the previous non-duplicate snapshot
-    WallClock initial_time_stamp = m_controller_history[0].time_stamp;
-
-    for (size_t i = 1; i < m_controller_history.size(); i++){ // start at index i = 1, since prev_snapshot starts at i=0 and we continue when current == previous.
-        ControllerStateSnapshot& snapshot = m_controller_history[i];
-        WallClock time_stamp = snapshot.time_stamp;
-        JsonObject& controller_state = snapshot.controller_state;
-        
-        WallClock prev_time_stamp = prev_snapshot->time_stamp;
-        JsonObject& prev_controller_state = prev_snapshot->controller_state;
-
-        if (controller_state == prev_controller_state){
-            continue;
-        }
-        
-        // Normalize each time stamp relative to the initial time stamp, and round to milliseconds.
-        // When only considering the distance between adjacent timestamps, you end up with drift due to rounding from nanoseconds to milliseconds, 
-
-        // example:
-        // Timestamps           Diff only comparing adjacent                Total time since start
-        // 12:00 1us            1.4us -> 1ms                                0ms
-        // 12:00 1401us         1.4us -> 1ms                                1ms
-        // 12:00 2801us         1.4us -> 1ms                                2ms
-        // 12:00 4201us         1.4us -> 1ms                                3ms
-        // 12:00 5601us         1.4us -> 1ms                                4ms
-        // 12:00 7001us         1.4us -> 1ms                                5ms
-        // 12:00 8401us         1.4us -> 1ms                                6ms
-        // 12:00 9801us         1.4us -> 1ms                                7ms
-        // 12:00 11201us                                                    8ms
-        // total time elapsed: 11.2ms vs 8ms
-
-        // Normalized timestamps		Diff using normalized timestamps    Total time since start
-        // 0ms                          1ms                                 0ms
-        // 1.4ms -> 1ms                 2ms	                                1ms
-        // 2.8ms -> 3ms                 1ms                                 3ms
-        // 4.2ms -> 4ms                 2ms                                 4ms
-        // 5.6ms -> 6ms                 1ms                                 6ms
-        // 7.0ms -> 7ms                 1ms                                 7ms
-        // 8.4ms -> 8ms                 2ms                                 8ms
-        // 9.8ms -> 10ms                1ms                                 10ms
-        // 11.2ms -> 11ms                                                   11ms
-        // total time elapsed: 11.2ms vs 11ms
-
-
-        Milliseconds current_timestamp_time_since_start = 
-            std::chrono::round<Milliseconds>(std::chrono::duration_cast<std::chrono::nanoseconds>(time_stamp - initial_time_stamp)); // find the time difference as nanoseconds, then round to milliseconds
-        Milliseconds prev_timestamp_time_since_start = 
-            std::chrono::round<Milliseconds>(std::chrono::duration_cast<std::chrono::nanoseconds>(prev_time_stamp - initial_time_stamp)); 
-        Milliseconds elapsed_time = current_timestamp_time_since_start - prev_timestamp_time_since_start;
-        int64_t duration = elapsed_time.count();
-
-        // cout << std::to_string(duration) << endl;
-        // cout << prev_controller_state.dump() << endl;
-        JsonObject recording = prev_controller_state.clone();
-        recording["duration_in_ms"] = duration;
-        json_array.push_back(std::move(recording));
-        prev_snapshot = &snapshot; // update the previous non-duplicate snapshot
+    if (!m_has_snapshot){
+        m_has_snapshot = true;
+        m_initial_time_stamp = time_stamp;
+        m_prev_time_stamp = time_stamp;
+        m_prev_entry = entry;
+        return;
     }
-    
-    
-    JsonObject json_result;
-    json_result["controller_class"] = CONTROLLER_CLASS_STRINGS().get_string(controller_class);
-    json_result["history"] = JsonValue(std::move(json_array));
 
-    return json_result;
+    if (entry.same_state(m_prev_entry)){
+        return;
+    }
 
+    // Normalize each time stamp relative to the initial time stamp, and round to milliseconds.
+    // When only considering the distance between adjacent timestamps, you end up with drift due to rounding from nanoseconds to milliseconds, 
+
+    // example:
+    // Timestamps           Diff only comparing adjacent                Total time since start
+    // 12:00 1us            1.4us -> 1ms                                0ms
+    // 12:00 1401us         1.4us -> 1ms                                1ms
+    // 12:00 2801us         1.4us -> 1ms                                2ms
+    // 12:00 4201us         1.4us -> 1ms                                3ms
+    // 12:00 5601us         1.4us -> 1ms                                4ms
+    // 12:00 7001us         1.4us -> 1ms                                5ms
+    // 12:00 8401us         1.4us -> 1ms                                6ms
+    // 12:00 9801us         1.4us -> 1ms                                7ms
+    // 12:00 11201us                                                    8ms
+    // total time elapsed: 11.2ms vs 8ms
+
+    // Normalized timestamps		Diff using normalized timestamps    Total time since start
+    // 0ms                          1ms                                 0ms
+    // 1.4ms -> 1ms                 2ms	                                1ms
+    // 2.8ms -> 3ms                 1ms                                 3ms
+    // 4.2ms -> 4ms                 2ms                                 4ms
+    // 5.6ms -> 6ms                 1ms                                 6ms
+    // 7.0ms -> 7ms                 1ms                                 7ms
+    // 8.4ms -> 8ms                 2ms                                 8ms
+    // 9.8ms -> 10ms                1ms                                 10ms
+    // 11.2ms -> 11ms                                                   11ms
+    // total time elapsed: 11.2ms vs 11ms
+
+
+    Milliseconds current_timestamp_time_since_start = 
+        std::chrono::round<Milliseconds>(std::chrono::duration_cast<std::chrono::nanoseconds>(time_stamp - m_initial_time_stamp)); // find the time difference as nanoseconds, then round to milliseconds
+    Milliseconds prev_timestamp_time_since_start = 
+        std::chrono::round<Milliseconds>(std::chrono::duration_cast<std::chrono::nanoseconds>(m_prev_time_stamp - m_initial_time_stamp)); 
+    Milliseconds elapsed_time = current_timestamp_time_since_start - prev_timestamp_time_since_start;
+
+    // the previous state is now complete. write it out right away so that
+    // nothing accumulates in memory.
+    ControllerRecordingEntry recording = m_prev_entry;
+    recording.duration_in_ms = elapsed_time.count();
+    m_writer->append(recording);
+
+    m_prev_time_stamp = time_stamp;
+    m_prev_entry = entry; // update the previous non-duplicate snapshot
 }
 
 
 void RecordKeyboardController::on_keyboard_command_sent(WallClock time_stamp, const ControllerState& state){
     cout << "keyboard_command_sent" << endl;
-    JsonObject serialized_state = state.serialize_state();
-    cout << serialized_state.dump(0) << endl;
-    
-    ControllerStateSnapshot state_snapshot = {
-        time_stamp,
-        std::move(serialized_state)
-    };
-    m_controller_history.emplace_back(std::move(state_snapshot));
+    record_snapshot(time_stamp, make_recording_entry(state));
 }
 void RecordKeyboardController::on_keyboard_command_stopped(WallClock time_stamp){
     cout << "keyboard_command_stopped" << endl;
-    JsonObject obj;
-    obj["is_neutral"] = true;
-
-    ControllerStateSnapshot state_snapshot = {
-        time_stamp, 
-        std::move(obj)
-    };
-    m_controller_history.emplace_back(std::move(state_snapshot));
+    record_snapshot(time_stamp, ControllerRecordingEntry());
 }
 
 
-
 }
 }
 
@@ -8,13 +8,17 @@
 #define PokemonAutomation_NintendoSwitch_RecordKeyboardController_H
 
 #include <functional>
+#include <memory>
+#include <mutex>
 #include "Common/Cpp/Json/JsonObject.h"
 #include "Common/Cpp/Options/BooleanCheckBoxOption.h"
 #include "Common/Cpp/Options/SimpleIntegerOption.h"
 #include "Common/Cpp/Options/StringOption.h"
 #include "NintendoSwitch/Controllers/NintendoSwitch_Joycon.h"
 #include "Controllers/KeyboardInput/KeyboardInput.h"
+#include "Controllers/SerialPABotBase/Connection/PABotBaseEmulatorBenchmark.h"
 #include "NintendoSwitch/NintendoSwitch_SingleSwitchProgram.h"
+#include "NintendoSwitch_ControllerRecording.h"
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -72,6 +76,12 @@ void json_to_pbf_actions(SingleSwitchProgramEnvironment& env, CancellableScope&
 void json_to_pbf_actions_pro_controller(ProControllerContext& context, const JsonArray& history, uint32_t num_loops, uint32_t seconds_wait_between_loops);
 void json_to_pbf_actions_joycon(JoyconContext& context, const JsonArray& history, uint32_t num_loops, uint32_t seconds_wait_between_loops);
 
+// same as above, but streams the actions from a binary recording instead of loading it all at once.
+void recording_to_pbf_actions(SingleSwitchProgramEnvironment& env, CancellableScope& scope, const std::string& filename, ControllerClass controller_class, uint32_t num_loops, uint32_t seconds_wait_between_loops);
+
+// given the json of a Pro Controller recording, output the wired controller states to replay it against the PABotBase emulator.
+std::vector<PABotBaseBenchmarkState> json_to_pabotbase_benchmark_workload(const JsonValue& json);
+
 class RecordKeyboardController_Descriptor : public SingleSwitchProgramDescriptor{
 public:
     RecordKeyboardController_Descriptor();
@@ -89,16 +99,16 @@ public:
 
 private:
     // whenever a keyboard command is sent/stopped: 
-    // add to m_controller_history the time_stamp and the ControllerState serialized to JSON.
+    // pass the time_stamp and the ControllerState to record_snapshot().
     virtual void on_keyboard_command_sent(WallClock time_stamp, const ControllerState& state) override;
     virtual void on_keyboard_command_stopped(WallClock time_stamp) override;
 
-    // convert m_controller_history to json
-    // remove adjacent duplicate controller states.
-    JsonValue controller_history_to_json(Logger& logger, ControllerClass controller_class);
+    // write the previous snapshot to m_writer once its duration is known.
+    // adjacent duplicate controller states are merged.
+    void record_snapshot(WallClock time_stamp, const ControllerRecordingEntry& entry);
 
 
-    // Examples for JsonObject controller_state:
+    // Examples of each entry in the JSON format. (see controller_recording_to_json())
     // ProControllerState:
         // {
         //     "is_neutral": false
@@ -120,16 +130,14 @@ private:
         // {
         //     "is_neutral": true
         // }
-    struct ControllerStateSnapshot {
-        WallClock time_stamp;
-        JsonObject controller_state;
-    };
 
 private:
     enum class Mode{
         RECORD,
         REPLAY,
         CONVERT_JSON_TO_CODE,
+        CONVERT_JSON_TO_BINARY,
+        CONVERT_BINARY_TO_JSON,
     };
     EnumDropdownOption<Mode> MODE;
     StringOption FILE_NAME;
@@ -137,7 +145,14 @@ private:
     SimpleIntegerOption<uint32_t> WAIT;
     BooleanCheckBoxOption GENERATE_CPP_CODE_AFTER_RECORDING;
 
-    std::vector<ControllerStateSnapshot> m_controller_history;
+    // the recording in progress. protected by m_lock since the keyboard
+    // listener runs on a different thread.
+    std::mutex m_lock;
+    std::unique_ptr<ControllerRecordingWriter> m_writer;
+    bool m_has_snapshot = false;
+    WallClock m_initial_time_stamp;
+    WallClock m_prev_time_stamp;
+    ControllerRecordingEntry m_prev_entry;
     
 
 };
@@ -295,9 +295,13 @@ void detect_shiny_battle(
         );
     }
 
-    std::vector<PeriodicInferenceCallback> callbacks = {{tracker}};
+    //  Critical: The sparkles and the shiny sound only last a moment.
+    //  Running these less often can miss them entirely.
+    std::vector<PeriodicInferenceCallback> callbacks = {
+        {tracker, std::chrono::milliseconds(0), InferencePriority::CRITICAL}
+    };
     if (use_shiny_sound){
-        callbacks.emplace_back(*shiny_sound_detector);
+        callbacks.emplace_back(*shiny_sound_detector, std::chrono::milliseconds(0), InferencePriority::CRITICAL);
     }
     int result = wait_until(stream, scope, timeout, callbacks);
     if (result < 0){
@@ -12,7 +12,7 @@
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonTools/Images/ImageFilter.h"
 #include "CommonTools/Images/BinaryImage_FilterRgb32.h"
-#include "CommonTools/ImageMatch/WaterfillTemplateMatcher.h"
+#include "CommonTools/ImageMatch/WaterfillTemplateMatcherSet.h"
 #include "PokemonLA/Inference/Objects/PokemonLA_ButtonDetector.h"
 #include "PokemonLA_MountDetector.h"
 
@@ -33,6 +33,17 @@ public:
 };
 
 
+//  (+), (<), (>) in that order.
+const ImageMatch::WaterfillTemplateMatcherSet& MOUNT_BUTTON_MATCHERS(){
+    static ImageMatch::WaterfillTemplateMatcherSet matchers({
+        &ButtonMatcher::Plus(),
+        &ButtonMatcher::ArrowLeft(),
+        &ButtonMatcher::ArrowRight(),
+    });
+    return matchers;
+}
+
+
 #if 1
 
 ImageRGB32 make_MountMatcher2Image(const char* path){
@@ -53,24 +64,25 @@ ImageRGB32 make_MountMatcher2Image(const char* path){
     double rmsd_arrowR = 99999;
 
 
+    const ImageMatch::WaterfillTemplateMatcherSet& button_matchers = MOUNT_BUTTON_MATCHERS();
+    std::vector<double> button_rmsds;
+
     WaterfillObject object;
     while (finder->find_next(object, false)){
         ImageViewRGB32 cropped = extract_box_reference(image, object);
 //        cropped.save("test-" + std::to_string(c++) + ".png");
 
-        double current_rmsd_plus = ButtonMatcher::Plus().rmsd_precropped(image.size(), cropped, object);
-        if (rmsd_plus > current_rmsd_plus){
-            rmsd_plus = current_rmsd_plus;
+        button_matchers.rmsd_precropped(button_rmsds, image.size(), cropped, object);
+        if (rmsd_plus > button_rmsds[0]){
+            rmsd_plus = button_rmsds[0];
             plus = object;
         }
-        double current_rmsd_arrowL = ButtonMatcher::ArrowLeft().rmsd_precropped(image.size(), cropped, object);
-        if (rmsd_arrowL > current_rmsd_arrowL){
-            rmsd_arrowL = current_rmsd_arrowL;
+        if (rmsd_arrowL > button_rmsds[1]){
+            rmsd_arrowL = button_rmsds[1];
             arrowL = object;
         }
-        double current_rmsd_arrowR = ButtonMatcher::ArrowRight().rmsd_precropped(image.size(), cropped, object);
-        if (rmsd_arrowR > current_rmsd_arrowR){
-            rmsd_arrowR = current_rmsd_arrowR;
+        if (rmsd_arrowR > button_rmsds[2]){
+            rmsd_arrowR = button_rmsds[2];
             arrowR = object;
             continue;
         }
@@ -208,6 +220,26 @@ public:
 };
 
 
+//  Wyrdeer, Ursaluna, Basculegion, Sneasler, Braviary in that order.
+const ImageMatch::WaterfillTemplateMatcherSet& MOUNT_OFF_MATCHERS(){
+    static ImageMatch::WaterfillTemplateMatcherSet matchers({
+        &MountWyrdeerMatcher::off(),
+        &MountUrsalunaMatcher::off(),
+        &MountBasculegionMatcher::off(),
+        &MountSneaslerMatcher::off(),
+        &MountBraviaryMatcher::off(),
+    });
+    return matchers;
+}
+const MountState MOUNT_OFF_STATES[] = {
+    MountState::WYRDEER_OFF,
+    MountState::URSALUNA_OFF,
+    MountState::BASCULEGION_OFF,
+    MountState::SNEASLER_OFF,
+    MountState::BRAVIARY_OFF,
+};
+
+
 
 
 
@@ -391,6 +423,11 @@ MountState MountDetector::detect(const ImageViewRGB32& screen) const{
     double rmsd_plus = 99999;
     double rmsd_arrowL = 99999;
     double rmsd_arrowR = 99999;
+    const ImageMatch::WaterfillTemplateMatcherSet& button_matchers = MOUNT_BUTTON_MATCHERS();
+    const ImageMatch::WaterfillTemplateMatcherSet& off_matchers = MOUNT_OFF_MATCHERS();
+    std::vector<double> button_rmsds;
+    std::vector<double> filtered_rmsds;
+    std::vector<double> direct_rmsds;
     auto session = make_WaterfillSession();
     {
         std::vector<MountDetectorFilteredImage> filtered_images = run_filters(
@@ -430,22 +467,18 @@ MountState MountDetector::detect(const ImageViewRGB32& screen) const{
 
 
                 //  Read the buttons.
-                double current_rmsd_plus = ButtonMatcher::Plus().rmsd_precropped(screen.size(), cropped, object);
-                if (rmsd_plus > current_rmsd_plus){
-                    rmsd_plus = current_rmsd_plus;
+                button_matchers.rmsd_precropped(button_rmsds, screen.size(), cropped, object);
+                if (rmsd_plus > button_rmsds[0]){
+                    rmsd_plus = button_rmsds[0];
                     plus = object;
                 }
-//                cout << "Arrow (left)" << endl;
-                double current_rmsd_arrowL = ButtonMatcher::ArrowLeft().rmsd_precropped(screen.size(), cropped, object);
-                if (rmsd_arrowL > current_rmsd_arrowL){
-                    rmsd_arrowL = current_rmsd_arrowL;
+                if (rmsd_arrowL > button_rmsds[1]){
+                    rmsd_arrowL = button_rmsds[1];
                     arrowL = object;
                 }
-//                cout << "Arrow (right)" << endl;
-                double current_rmsd_arrowR = ButtonMatcher::ArrowRight().rmsd_precropped(screen.size(), cropped, object);
-//                cout << "rmsd_arrowR = " << rmsd_arrowR << endl;
-                if (rmsd_arrowR > current_rmsd_arrowR){
-                    rmsd_arrowR = current_rmsd_arrowR;
+//                cout << "rmsd_arrowR = " << button_rmsds[2] << endl;
+                if (rmsd_arrowR > button_rmsds[2]){
+                    rmsd_arrowR = button_rmsds[2];
                     arrowR = object;
                 }
 
@@ -459,16 +492,12 @@ MountState MountDetector::detect(const ImageViewRGB32& screen) const{
 
                 ImageViewRGB32 filtered_cropped = extract_box_reference(filtered.image, object);
 #if 1
-                candidates.add_filtered(MountWyrdeerMatcher      ::off().rmsd_precropped(screen.size(), filtered_cropped, object), MountState::WYRDEER_OFF);
-                candidates.add_direct  (MountWyrdeerMatcher      ::off().rmsd_precropped(screen.size(), cropped         , object), MountState::WYRDEER_OFF);
-                candidates.add_filtered(MountUrsalunaMatcher     ::off().rmsd_precropped(screen.size(), filtered_cropped, object), MountState::URSALUNA_OFF);
-                candidates.add_direct  (MountUrsalunaMatcher     ::off().rmsd_precropped(screen.size(), cropped         , object), MountState::URSALUNA_OFF);
-                candidates.add_filtered(MountBasculegionMatcher  ::off().rmsd_precropped(screen.size(), filtered_cropped, object), MountState::BASCULEGION_OFF);
-                candidates.add_direct  (MountBasculegionMatcher  ::off().rmsd_precropped(screen.size(), cropped         , object), MountState::BASCULEGION_OFF);
-                candidates.add_filtered(MountSneaslerMatcher     ::off().rmsd_precropped(screen.size(), filtered_cropped, object), MountState::SNEASLER_OFF);
-                candidates.add_direct  (MountSneaslerMatcher     ::off().rmsd_precropped(screen.size(), cropped         , object), MountState::SNEASLER_OFF);
-                candidates.add_filtered(MountBraviaryMatcher     ::off().rmsd_precropped(screen.size(), filtered_cropped, object), MountState::BRAVIARY_OFF);
-                candidates.add_direct  (MountBraviaryMatcher     ::off().rmsd_precropped(screen.size(), cropped         , object), MountState::BRAVIARY_OFF);
+                off_matchers.rmsd_precropped(filtered_rmsds, screen.size(), filtered_cropped, object);
+                off_matchers.rmsd_precropped(direct_rmsds, screen.size(), cropped, object);
+                for (size_t c = 0; c < off_matchers.size(); c++){
+                    candidates.add_filtered(filtered_rmsds[c], MOUNT_OFF_STATES[c]);
+                    candidates.add_direct  (direct_rmsds[c], MOUNT_OFF_STATES[c]);
+                }
 #endif
 
             }
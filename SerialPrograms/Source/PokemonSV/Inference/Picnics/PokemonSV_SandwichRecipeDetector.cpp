@@ -4,13 +4,13 @@
  *
  */
 
-#include <opencv2/imgproc.hpp>
 #include "Common/Cpp/AbstractLogger.h"
 #include "Common/Cpp/Containers/FixedLimitVector.tpp"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
-#include "CommonTools/Images/ImageFilter.h"
+#include "CommonTools/Images/BinaryImage_FilterRgb32.h"
 #include "CommonTools/OCR/OCR_NumberReader.h"
 #include "PokemonSV_SandwichRecipeDetector.h"
 
@@ -45,35 +45,22 @@ void SandwichRecipeNumberDetector::detect_recipes(const ImageViewRGB32& screen,
     for(int i = 0; i < 6; i++){
         auto cropped_image = extract_box_reference(screen, m_id_boxes[i]);
 
-        const bool invert_blackwhite = true;
-        ImageRGB32 filterd_image = to_blackwhite_rgb32_range(
+        //  The digits are white.
+        PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(
             cropped_image,
-            invert_blackwhite,
             combine_rgb(180, 180, 180), combine_rgb(255, 255, 255)
         );
 
-        // filterd_image.save("./tmp_fil_" + std::to_string(i) + ".png");
-
-        ImageRGB32 dilated_image(filterd_image.width(), filterd_image.height());
-
         if (screen.width() >= 1280){
-            const int dilation_type = cv::MORPH_ELLIPSE;
-            const int dilation_size = 1;
-
-            cv::Mat element = cv::getStructuringElement(dilation_type,
-                cv::Size(2*dilation_size + 1, 2*dilation_size+1),
-                cv::Point(dilation_size, dilation_size));
-
-            // filterd_image.save("./tmp_" + std::to_string(i) + ".png");
-            
-            cv::Mat filtered_image_mat(static_cast<int>(filterd_image.height()), static_cast<int>(filterd_image.width()), CV_8UC4, (void*)filterd_image.data(), filterd_image.bytes_per_row());
-            
-            cv::Mat dilated_image_mat(static_cast<int>(dilated_image.height()), static_cast<int>(dilated_image.width()), CV_8UC4, (void*)dilated_image.data(), dilated_image.bytes_per_row());
-            cv::dilate(filtered_image_mat, dilated_image_mat, element);
-        }else{
-            dilated_image = filterd_image.copy();
+            //  Same as dilating the white background.
+            Kernels::binary_erode(matrix, Kernels::BinaryStructuringElement::ellipse(3, 3));
         }
 
+        //  OCR wants black text on white.
+        ImageRGB32 dilated_image(matrix.width(), matrix.height());
+        dilated_image.fill(0xffffffff);
+        filter_by_mask(matrix, dilated_image, Color(0xff000000), false);
+
         // dilated_image.save("./tmp_dil_" + std::to_string(i) + ".png");
 
         const int number = OCR::read_number(m_logger, dilated_image);
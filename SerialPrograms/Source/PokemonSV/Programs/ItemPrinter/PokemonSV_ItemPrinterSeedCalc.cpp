@@ -235,13 +235,6 @@ const char* item_id_to_slug(int item_id){
     }
 }
 
-struct ItemPrinterItemData{
-    const char* slug;
-    uint16_t weight;
-    uint8_t min_quantity;
-    uint8_t max_quantity;
-};
-
 std::vector<ItemPrinterItemData> make_item_prize_list(){
     //  This is taken from:
     //      https://github.com/kwsch/ItemPrinterDeGacha/blob/main/ItemPrinterDeGacha.Core/Resources/item_table_array.json
@@ -349,20 +342,17 @@ std::vector<const ItemPrinterItemData*> make_ball_prize_table(){
 }
 
 
-enum class PrintMode{
-    Regular = 0,
-    ItemBonus = 1,
-    BallBonus = 2,
-};
-
-
-std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
+const std::vector<const ItemPrinterItemData*>& prize_table(PrintMode mode){
     static const std::vector<const ItemPrinterItemData*> ITEM_TABLE = make_item_prize_table();
     static const std::vector<const ItemPrinterItemData*> BALL_TABLE = make_ball_prize_table();
-
-    const std::vector<const ItemPrinterItemData*>& table = mode == PrintMode::BallBonus
+    return mode == PrintMode::BallBonus
         ? BALL_TABLE
         : ITEM_TABLE;
+}
+
+
+std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
+    const std::vector<const ItemPrinterItemData*>& table = prize_table(mode);
 
     Pokemon::Xoroshiro128Plus rand(seed, 0x82A2B175229D6A5B);
 
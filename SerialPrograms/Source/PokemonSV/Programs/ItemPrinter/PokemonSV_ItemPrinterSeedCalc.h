@@ -12,6 +12,7 @@
 #ifndef PokemonAutomation_PokemonSV_ItemPrinterSeedCalc_H
 #define PokemonAutomation_PokemonSV_ItemPrinterSeedCalc_H
 
+#include <vector>
 #include "PokemonSV_ItemPrinterDatabase.h"
 
 namespace PokemonAutomation{
@@ -20,6 +21,24 @@ namespace PokemonSV{
 namespace ItemPrinter{
 
 
+enum class PrintMode{
+    Regular = 0,
+    ItemBonus = 1,
+    BallBonus = 2,
+};
+
+struct ItemPrinterItemData{
+    const char* slug;
+    uint16_t weight;
+    uint8_t min_quantity;
+    uint8_t max_quantity;
+};
+
+//  The item roll picks one of these slots. Each slot points to the prize it
+//  lands on. Both tables have the same size.
+const std::vector<const ItemPrinterItemData*>& prize_table(PrintMode mode);
+
+
 DateSeed calculate_seed_prizes(int64_t seed);
 
 
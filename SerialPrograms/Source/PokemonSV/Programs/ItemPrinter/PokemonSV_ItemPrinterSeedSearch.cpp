@@ -0,0 +1,174 @@
+/*  Item Printer Seed Search
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
+#include "PokemonSV_ItemPrinterSeedSearch_Core.h"
+#include "PokemonSV_ItemPrinterSeedSearch.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+void item_printer_seed_prizes_Default(
+    uint16_t* prizes,
+    int64_t first_seed, size_t count,
+    const uint32_t* table, size_t table_size,
+    bool regular_mode
+);
+void item_printer_seed_prizes_x64_AVX2(
+    uint16_t* prizes,
+    int64_t first_seed, size_t count,
+    const uint32_t* table, size_t table_size,
+    bool regular_mode
+);
+void item_printer_seed_prizes_x64_AVX512(
+    uint16_t* prizes,
+    int64_t first_seed, size_t count,
+    const uint32_t* table, size_t table_size,
+    bool regular_mode
+);
+
+using SeedPrizesFunction = void (*)(
+    uint16_t* prizes,
+    int64_t first_seed, size_t count,
+    const uint32_t* table, size_t table_size,
+    bool regular_mode
+);
+SeedPrizesFunction item_printer_seed_prizes_function(){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        return item_printer_seed_prizes_x64_AVX512;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return item_printer_seed_prizes_x64_AVX2;
+    }
+#endif
+    return item_printer_seed_prizes_Default;
+}
+
+
+
+std::vector<int64_t> search_item_printer_seeds(
+    ComputationThreadPool& thread_pool,
+    const ItemPrinterSeedSearchQuery& query,
+    int64_t first_seed, int64_t last_seed,
+    size_t max_results
+){
+    std::vector<int64_t> ret;
+    if (first_seed > last_seed || max_results == 0){
+        return ret;
+    }
+
+    //  Pack the prize table. Prizes are numbered in order of first appearance.
+    const std::vector<const ItemPrinterItemData*>& prize_list = prize_table(query.mode);
+    std::vector<const ItemPrinterItemData*> prizes;
+    std::vector<uint32_t> table;
+    table.reserve(prize_list.size());
+    for (const ItemPrinterItemData* item : prize_list){
+        auto iter = std::find(prizes.begin(), prizes.end(), item);
+        if (iter == prizes.end()){
+            prizes.emplace_back(item);
+            iter = prizes.end() - 1;
+        }
+        if ((int)item->max_quantity - (int)item->min_quantity + 1 > 128){
+            throw InternalProgramError(
+                nullptr, PA_CURRENT_FUNCTION,
+                "Quantity range is too large: " + std::string(item->slug)
+            );
+        }
+        table.emplace_back(pack_seed_search_slot(
+            (uint16_t)(iter - prizes.begin()),
+            item->min_quantity, item->max_quantity
+        ));
+    }
+
+    //  Prize index -> minimum count. A target that can't be printed in this
+    //  mode can never be met.
+    std::vector<std::pair<uint16_t, uint8_t>> requirements;
+    for (const auto& item : query.min_prizes){
+        if (item.second == 0){
+            continue;
+        }
+        auto iter = std::find_if(
+            prizes.begin(), prizes.end(),
+            [&](const ItemPrinterItemData* x){ return item.first == x->slug; }
+        );
+        if (iter == prizes.end()){
+            return ret;
+        }
+        requirements.emplace_back((uint16_t)(iter - prizes.begin()), item.second);
+    }
+
+    const size_t jobs = std::min((size_t)query.jobs, SEED_SEARCH_PRIZES);
+    const SeedPrizesFunction seed_prizes = item_printer_seed_prizes_function();
+    const bool regular_mode = query.mode == PrintMode::Regular;
+
+    //  Each block keeps its own results so the merge is in seed order and
+    //  doesn't depend on which thread ran what.
+    const size_t BLOCK_SIZE = (size_t)1 << 16;
+    size_t total = (size_t)(last_seed - first_seed) + 1;
+    std::vector<std::vector<int64_t>> block_results((total + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+    thread_pool.parallel_for_range(
+        [&](size_t start, size_t end){
+            std::vector<uint16_t> seed_prizes_buffer((end - start) * SEED_SEARCH_PRIZES);
+            std::vector<uint8_t> counts(prizes.size());
+            seed_prizes(
+                seed_prizes_buffer.data(),
+                first_seed + (int64_t)start, end - start,
+                table.data(), table.size(),
+                regular_mode
+            );
+
+            std::vector<int64_t>& results = block_results[start / BLOCK_SIZE];
+            const uint16_t* current = seed_prizes_buffer.data();
+            for (size_t c = start; c < end; c++, current += SEED_SEARCH_PRIZES){
+                for (const auto& requirement : requirements){
+                    counts[requirement.first] = 0;
+                }
+                for (size_t p = 0; p < jobs; p++){
+                    counts[current[p]]++;
+                }
+                bool ok = true;
+                for (const auto& requirement : requirements){
+                    ok &= counts[requirement.first] >= requirement.second;
+                }
+                if (!ok){
+                    continue;
+                }
+                results.emplace_back(first_seed + (int64_t)c);
+                if (results.size() >= max_results){
+                    return;
+                }
+            }
+        },
+        0, total, BLOCK_SIZE
+    );
+
+    for (const std::vector<int64_t>& results : block_results){
+        for (int64_t seed : results){
+            if (ret.size() >= max_results){
+                return ret;
+            }
+            ret.emplace_back(seed);
+        }
+    }
+    return ret;
+}
+
+
+
+}
+}
+}
+}
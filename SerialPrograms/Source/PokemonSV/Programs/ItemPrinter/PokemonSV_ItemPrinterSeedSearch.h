@@ -0,0 +1,65 @@
+/*  Item Printer Seed Search
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Search a range of seeds for ones whose prizes contain a target set of
+ *  items. Seeds are the date the print is started at, in seconds since epoch.
+ *  (see "to_seconds_since_epoch()")
+ *
+ *  The prizes are computed the same way as "calculate_seed_prizes()", but with
+ *  many seeds per vector and many vectors in parallel.
+ *
+ *      Nothing in the programs calls this yet. Auto Mode in "ItemPrinterRNG"
+ *  still takes its seeds from "ItemPrinter_AllOptions()". Those seeds were
+ *  picked so that the seeds within +/- 2 seconds don't trigger a bonus, and
+ *  "quantity_obtained" assumes that the bonus is active. A query can't express
+ *  either of those yet. Until it can, this is for building and checking that
+ *  table offline.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSV_ItemPrinterSeedSearch_H
+#define PokemonAutomation_PokemonSV_ItemPrinterSeedSearch_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "PokemonSV_ItemPrinterTools.h"
+#include "PokemonSV_ItemPrinterSeedCalc.h"
+
+namespace PokemonAutomation{
+    class ComputationThreadPool;
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+struct ItemPrinterSeedSearchQuery{
+    PrintMode mode = PrintMode::Regular;
+
+    //  Only the prizes of this many jobs are counted.
+    ItemPrinterJobs jobs = ItemPrinterJobs::Jobs_10;
+
+    //  Item slug -> Minimum # of prizes that must be that item.
+    //  A seed matches if all of these are met.
+    std::map<std::string, uint8_t> min_prizes;
+};
+
+
+//  Search seeds [first_seed, last_seed]. Returns the matching seeds in
+//  increasing order. Stops at "max_results" matches.
+std::vector<int64_t> search_item_printer_seeds(
+    ComputationThreadPool& thread_pool,
+    const ItemPrinterSeedSearchQuery& query,
+    int64_t first_seed, int64_t last_seed,
+    size_t max_results = 1000
+);
+
+
+
+}
+}
+}
+}
+#endif
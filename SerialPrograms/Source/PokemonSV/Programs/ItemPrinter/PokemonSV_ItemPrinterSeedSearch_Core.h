@@ -0,0 +1,116 @@
+/*  Item Printer Seed Search Core
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Compute the prizes of many consecutive seeds at once. This is the same
+ *  logic as "calculate_prizes()" in "PokemonSV_ItemPrinterSeedCalc.cpp", but
+ *  run on one seed per RNG lane and returning prize indices instead of slugs.
+ *
+ *  This header is included by each instruction set's translation unit.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSV_ItemPrinterSeedSearch_Core_H
+#define PokemonAutomation_PokemonSV_ItemPrinterSeedSearch_Core_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+const size_t SEED_SEARCH_PRIZES = 10;
+
+//  Packed slot of "prize_table()":
+//      Bits  0-15: Index of the prize.
+//      Bits 16-23: Bound of the quantity roll. Zero if there is no quantity roll.
+//      Bits 24-31: Power-of-two mask of the quantity roll.
+inline uint32_t pack_seed_search_slot(uint16_t prize_index, uint8_t min_quantity, uint8_t max_quantity){
+    if (min_quantity == max_quantity){
+        return prize_index;
+    }
+    uint32_t bound = (uint32_t)max_quantity - min_quantity + 1;
+    uint32_t power = 1;
+    while (power < bound){
+        power *= 2;
+    }
+    return prize_index | (bound << 16) | ((power - 1) << 24);
+}
+
+
+//  Write the prize indices of seeds [first_seed, first_seed + count) to
+//  "prizes[seed * SEED_SEARCH_PRIZES + prize]".
+template <typename Lanes>
+PA_FORCE_INLINE void item_printer_seed_prizes(
+    uint16_t* prizes,
+    int64_t first_seed, size_t count,
+    const uint32_t* table, size_t table_size,
+    bool regular_mode
+){
+    using Vector = typename Lanes::Vector;
+    using Mask = typename Lanes::Mask;
+
+    uint64_t table_power = 1;
+    while (table_power < table_size){
+        table_power *= 2;
+    }
+
+    const Vector ONE            = Lanes::broadcast(1);
+    const Vector BONUS_CHANCE   = Lanes::broadcast(20);
+    const Vector BONUS_BOUND    = Lanes::broadcast(1000);
+    const Vector BONUS_MASK     = Lanes::broadcast(1023);
+    const Vector TABLE_BOUND    = Lanes::broadcast(table_size);
+    const Vector TABLE_MASK     = Lanes::broadcast(table_power - 1);
+    const Vector MODE_BOUND     = Lanes::broadcast(2);
+    const Vector BYTE_MASK      = Lanes::broadcast(0xff);
+    const Vector PRIZE_MASK     = Lanes::broadcast(0xffff);
+
+    for (size_t c = 0; c < count; c += Lanes::LANES){
+        uint64_t seeds[Lanes::LANES];
+        for (size_t l = 0; l < Lanes::LANES; l++){
+            seeds[l] = (uint64_t)(first_seed + (int64_t)(c + l));
+        }
+        Lanes rand(seeds, 0x82A2B175229D6A5B);
+
+        //  Lanes that can still roll into a bonus mode.
+        Mask bonus_pending = regular_mode ? Lanes::mask_all() : Lanes::mask_none();
+
+        uint64_t block[SEED_SEARCH_PRIZES][Lanes::LANES];
+        for (size_t p = 0; p < SEED_SEARCH_PRIZES; p++){
+            Vector roll = rand.next_int(BONUS_BOUND, BONUS_MASK);
+            Vector slot = rand.next_int(TABLE_BOUND, TABLE_MASK);
+
+            Vector entry = Lanes::gather_u32(table, slot);
+            Vector quantity_bound = Lanes::bitwise_and(Lanes::template shift_right<16>(entry), BYTE_MASK);
+            Vector quantity_mask = Lanes::template shift_right<24>(entry);
+            rand.next_int(Lanes::cmplt(ONE, quantity_bound), quantity_bound, quantity_mask);
+
+            Mask bonus = Lanes::mask_and(bonus_pending, Lanes::cmplt(roll, BONUS_CHANCE));
+            rand.next_int(bonus, MODE_BOUND, ONE);
+            bonus_pending = Lanes::mask_andnot(bonus, bonus_pending);
+
+            Lanes::store(block[p], Lanes::bitwise_and(entry, PRIZE_MASK));
+        }
+
+        size_t lanes = std::min(Lanes::LANES, count - c);
+        for (size_t l = 0; l < lanes; l++){
+            for (size_t p = 0; p < SEED_SEARCH_PRIZES; p++){
+                prizes[p] = (uint16_t)block[p][l];
+            }
+            prizes += SEED_SEARCH_PRIZES;
+        }
+    }
+}
+
+
+
+}
+}
+}
+}
+#endif
@@ -0,0 +1,35 @@
+/*  Item Printer Seed Search (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Kernels/Random/Kernels_Xoroshiro128PlusLanes_Default.h"
+#include "PokemonSV_ItemPrinterSeedSearch_Core.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+void item_printer_seed_prizes_Default(
+    uint16_t* prizes,
+    int64_t first_seed, size_t count,
+    const uint32_t* table, size_t table_size,
+    bool regular_mode
+){
+    item_printer_seed_prizes<Kernels::Xoroshiro128PlusLanes_Default>(
+        prizes,
+        first_seed, count,
+        table, table_size,
+        regular_mode
+    );
+}
+
+
+}
+}
+}
+}
+
@@ -0,0 +1,37 @@
+/*  Item Printer Seed Search (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include "Kernels/Random/Kernels_Xoroshiro128PlusLanes_x64_AVX2.h"
+#include "PokemonSV_ItemPrinterSeedSearch_Core.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+void item_printer_seed_prizes_x64_AVX2(
+    uint16_t* prizes,
+    int64_t first_seed, size_t count,
+    const uint32_t* table, size_t table_size,
+    bool regular_mode
+){
+    item_printer_seed_prizes<Kernels::Xoroshiro128PlusLanes_x64_AVX2>(
+        prizes,
+        first_seed, count,
+        table, table_size,
+        regular_mode
+    );
+}
+
+
+}
+}
+}
+}
+#endif
@@ -133,9 +133,11 @@ ShinyDetectionResult detect_shiny_battle(
     std::chrono::seconds timeout
 ){
     ShinyEncounterTracker tracker(stream.logger(), stream.overlay(), battle_settings);
+
+    //  Critical: The sparkles only last a moment. Skipped frames are lost sparkles.
     int result = wait_until(
         stream, scope, timeout,
-        {{tracker}}
+        {{tracker, std::chrono::milliseconds(0), InferencePriority::CRITICAL}}
     );
     if (result < 0){
         stream.log("ShinyDetector: Battle menu not found after timeout.", COLOR_RED);
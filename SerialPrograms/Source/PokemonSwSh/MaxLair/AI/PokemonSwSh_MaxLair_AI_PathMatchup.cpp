@@ -4,6 +4,7 @@
  *
  */
 
+#include <algorithm>
 #include <map>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
@@ -20,15 +21,34 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+const size_t POKEMON_TYPE_COUNT = (size_t)PokemonType::FAIRY + 1;
+
+
 struct PathMatchDatabase{
-    std::map<PokemonType, std::set<std::string>> rentals_by_type;
-    std::map<std::string, std::map<PokemonType, double>> type_vs_boss;
+    //  The rentals of each type are stored back-to-back and sorted.
+    //  The rentals of type T are [rental_offsets[T], rental_offsets[T + 1]).
+    std::vector<std::string> rentals;
+    size_t rental_offsets[POKEMON_TYPE_COUNT + 1] = {};
+
+    std::map<std::string, size_t> boss_ids;
+
+    //  [boss id * POKEMON_TYPE_COUNT + PokemonType]
+    std::vector<double> type_vs_boss;
 
     static const PathMatchDatabase& instance(){
         static PathMatchDatabase database;
         return database;
     }
 
+    //  Row of "type_vs_boss" indexed by PokemonType.
+    const double* boss_row(const std::string& boss_slug) const{
+        auto iter = boss_ids.find(boss_slug);
+        if (iter == boss_ids.end()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss_slug);
+        }
+        return type_vs_boss.data() + iter->second * POKEMON_TYPE_COUNT;
+    }
+
 private:
     PathMatchDatabase(){
         std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/path_tree.json";
@@ -36,23 +56,37 @@ private:
         JsonObject& root = json.to_object_throw(path);
 
         {
+            //  Group the rentals by type. (POKEMON_TYPE_SLUGS() isn't in enum order.)
+            std::vector<std::vector<std::string>> by_type(POKEMON_TYPE_COUNT);
             JsonObject& obj = root.get_object_throw("rental_by_type", path);
             for (const auto& type : POKEMON_TYPE_SLUGS()){
                 if (type.first == PokemonType::NONE){
                     continue;
                 }
                 JsonArray& array = obj.get_array_throw(type.second, path);
-                std::set<std::string>& set = rentals_by_type[type.first];
+                std::vector<std::string>& list = by_type[(size_t)type.first];
                 for (auto& item : array){
-                    std::string& str = item.to_string_throw(path);
-                    set.insert(std::move(str));
+                    list.emplace_back(std::move(item.to_string_throw(path)));
                 }
+                std::sort(list.begin(), list.end());
+                list.erase(std::unique(list.begin(), list.end()), list.end());
             }
+            for (size_t type = 0; type < POKEMON_TYPE_COUNT; type++){
+                rental_offsets[type] = rentals.size();
+                for (std::string& rental : by_type[type]){
+                    rentals.emplace_back(std::move(rental));
+                }
+            }
+            rental_offsets[POKEMON_TYPE_COUNT] = rentals.size();
         }
 
         JsonObject& node = root.get_object_throw("base_node", path).get_object_throw("hash_table");
         for (auto& item : node){
-            std::map<PokemonType, double>& boss = type_vs_boss[item.first];
+            boss_ids.emplace(item.first, boss_ids.size());
+        }
+        type_vs_boss.resize(boss_ids.size() * POKEMON_TYPE_COUNT, 0);
+        for (auto& item : node){
+            double* row = type_vs_boss.data() + boss_ids[item.first] * POKEMON_TYPE_COUNT;
 
             JsonObject& obj = item.second.to_object_throw(path).get_object_throw("hash_table", path);
 
@@ -60,55 +94,86 @@ private:
                 if (type.first == PokemonType::NONE){
                     continue;
                 }
-                boss[type.first] = obj.get_double_throw(type.second, path);
+                row[(size_t)type.first] = obj.get_double_throw(type.second, path);
             }
         }
     }
+};
+
+
+//  Average type-vs-boss score over all bosses of each type. This is used when
+//  only the boss type is known.
+//
+//  This is built the first time it is needed, not when the path table is
+//  loaded. Building it looks up every boss, and a missing boss should only
+//  fail the searches that need the average.
+struct BossTypeAverages{
+    //  [boss PokemonType * POKEMON_TYPE_COUNT + PokemonType]
+    //  PokemonType::NONE averages over all bosses.
+    std::vector<double> table;
+
+    static const BossTypeAverages& instance(){
+        static BossTypeAverages averages;
+        return averages;
+    }
 
+    const double* boss_type_row(PokemonType boss_type) const{
+        if ((size_t)boss_type >= POKEMON_TYPE_COUNT){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)boss_type));
+        }
+        return table.data() + (size_t)boss_type * POKEMON_TYPE_COUNT;
+    }
 
+private:
+    BossTypeAverages(){
+        using namespace papkmnlib;
+        const PathMatchDatabase& database = PathMatchDatabase::instance();
+        table.resize(POKEMON_TYPE_COUNT * POKEMON_TYPE_COUNT, 0);
+        for (size_t boss_type = 0; boss_type < POKEMON_TYPE_COUNT; boss_type++){
+            double* sum = table.data() + boss_type * POKEMON_TYPE_COUNT;
+            Type pkmnlib_type = serial_type_to_pkmnlib((PokemonType)boss_type);
+            size_t count = 0;
+            for (const auto& item : all_bosses_by_dex()){
+                const Pokemon& boss = get_pokemon(item.second);
+                if (boss_type != (size_t)PokemonType::NONE && !boss.has_type(pkmnlib_type)){
+                    continue;
+                }
+                const double* row = database.boss_row(boss.name());
+                for (size_t type = 0; type < POKEMON_TYPE_COUNT; type++){
+                    sum[type] += row[type];
+                }
+                count++;
+            }
+            for (size_t type = 0; type < POKEMON_TYPE_COUNT; type++){
+                sum[type] /= (double)count;
+            }
+        }
+    }
 };
 
 
-const std::set<std::string>& rentals_by_type(PokemonType type){
+std::span<const std::string> rentals_by_type(PokemonType type){
     const PathMatchDatabase& database = PathMatchDatabase::instance();
-    auto iter = database.rentals_by_type.find(type);
-    if (iter == database.rentals_by_type.end()){
+    if (type == PokemonType::NONE || (size_t)type >= POKEMON_TYPE_COUNT){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
     }
-    return iter->second;
+    size_t begin = database.rental_offsets[(size_t)type];
+    size_t end = database.rental_offsets[(size_t)type + 1];
+    return std::span<const std::string>(database.rentals.data() + begin, end - begin);
 }
 
 double type_vs_boss(PokemonType type, const std::string& boss_slug){
     const PathMatchDatabase& database = PathMatchDatabase::instance();
-
-    auto iter0 = database.type_vs_boss.find(boss_slug);
-    if (iter0 == database.type_vs_boss.end()){
-        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss_slug);
-    }
-
-    auto iter1 = iter0->second.find(type);
-    if (iter1 == iter0->second.end()){
+    if (type == PokemonType::NONE || (size_t)type >= POKEMON_TYPE_COUNT){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
     }
-
-    return iter1->second;
+    return database.boss_row(boss_slug)[(size_t)type];
 }
 double type_vs_boss(PokemonType type, PokemonType boss_type){
-    using namespace papkmnlib;
-
-    Type pkmnlib_type = serial_type_to_pkmnlib(boss_type);
-
-    double weight = 0;
-    size_t count = 0;
-    for (const auto& item : all_bosses_by_dex()){
-        const Pokemon& boss = get_pokemon(item.second);
-        if (boss_type == PokemonType::NONE || boss.has_type(pkmnlib_type)){
-            weight += type_vs_boss(type, boss.name());
-            count++;
-        }
+    if (type == PokemonType::NONE || (size_t)type >= POKEMON_TYPE_COUNT){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
     }
-
-    return weight / (double)count;
+    return BossTypeAverages::instance().boss_type_row(boss_type)[(size_t)type];
 }
 
 
@@ -227,8 +292,8 @@ std::vector<std::vector<PathNode>> generate_paths(
 }
 
 
-template <typename Boss>
-double evaluate_path(const Boss& boss, const std::vector<PathNode>& path){
+//  "type_scores" is a row of type-vs-boss scores indexed by PokemonType.
+double evaluate_path(const double* type_scores, const std::vector<PathNode>& path){
     if (path.size() > 3){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Path is longer than 3: " + std::to_string(path.size()));
     }
@@ -238,7 +303,11 @@ double evaluate_path(const Boss& boss, const std::vector<PathNode>& path){
     size_t battle_index = 3 - path.size();
     size_t node_index = 0;
     for (; battle_index < 3; node_index++, battle_index++){
-        weight += type_vs_boss(path[node_index].type, boss) * weights[battle_index];
+        PokemonType type = path[node_index].type;
+        if (type == PokemonType::NONE || (size_t)type >= POKEMON_TYPE_COUNT){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
+        }
+        weight += type_scores[(size_t)type] * weights[battle_index];
     }
     return weight;
 }
@@ -262,15 +331,15 @@ std::vector<PathNode> select_path(
         return {};
     }
 
+    //  Resolve the boss once. Every path is then scored from the same row.
+    const double* type_scores = boss.empty()
+        ? BossTypeAverages::instance().boss_type_row(pathmap.boss)
+        : PathMatchDatabase::instance().boss_row(boss);
+
     std::multimap<double, std::vector<PathNode>, std::greater<double>> rank;
-    if (boss.empty()){
-        for (const std::vector<PathNode>& path : paths){
-            rank.emplace(evaluate_path(pathmap.boss, path), path);
-        }
-    }else{
-        for (const std::vector<PathNode>& path : paths){
-            rank.emplace(evaluate_path(boss, path), path);
-        }
+    for (std::vector<PathNode>& path : paths){
+        double score = evaluate_path(type_scores, path);
+        rank.emplace(score, std::move(path));
     }
     std::string str = "Available Paths:\n";
     for (const auto& path : rank){
@@ -7,8 +7,9 @@
 #ifndef PokemonAutomation_PokemonSwSh_MaxLair_AI_PathMatchup_H
 #define PokemonAutomation_PokemonSwSh_MaxLair_AI_PathMatchup_H
 
+#include <span>
+#include <string>
 #include <vector>
-#include <set>
 #include "CommonFramework/Logging/Logger.h"
 #include "Pokemon/Pokemon_Types.h"
 #include "PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_State.h"
@@ -20,7 +21,8 @@ namespace MaxLairInternal{
 using namespace Pokemon;
 
 
-const std::set<std::string>& rentals_by_type(PokemonType type);
+//  Sorted. No duplicates.
+std::span<const std::string> rentals_by_type(PokemonType type);
 double type_vs_boss(PokemonType type, const std::string& boss_slug);
 double type_vs_boss(PokemonType type, PokemonType boss_type);
 
@@ -4,6 +4,8 @@
  *
  */
 
+#include <cmath>
+#include <limits>
 #include <map>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
@@ -20,23 +22,41 @@ namespace MaxLairInternal{
 
 
 struct MatchupDatabase{
-    std::map<std::string, std::map<std::string, double>> map;
+    std::map<std::string, size_t> rental_ids;
+    std::map<std::string, size_t> boss_ids;
+
+    //  [rental id * boss count + boss id]
+    //  Missing entries are NaN.
+    std::vector<double> table;
 
     static const MatchupDatabase& instance(){
         static MatchupDatabase database;
         return database;
     }
 
-    double get(const std::string& rental, const std::string& boss) const{
-        auto iter0 = map.find(rental);
-        if (iter0 == map.end()){
+    size_t rental_id(const std::string& rental) const{
+        auto iter = rental_ids.find(rental);
+        if (iter == rental_ids.end()){
             throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Rental not found: " + rental);
         }
-        auto iter1 = iter0->second.find(boss);
-        if (iter1 == iter0->second.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + rental);
+        return iter->second;
+    }
+    size_t boss_id(const std::string& boss) const{
+        auto iter = boss_ids.find(boss);
+        if (iter == boss_ids.end()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + boss);
         }
-        return iter1->second;
+        return iter->second;
+    }
+    double get(size_t rental, size_t boss) const{
+        double value = table[rental * boss_ids.size() + boss];
+        if (std::isnan(value)){
+            throw InternalProgramError(
+                nullptr, PA_CURRENT_FUNCTION,
+                "Matchup not found: " + std::to_string(rental) + " vs. " + std::to_string(boss)
+            );
+        }
+        return value;
     }
 
 private:
@@ -44,32 +64,93 @@ private:
         std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/boss_matchup_LUT.json";
         JsonValue json = load_json_file(path);
         JsonObject& root = json.to_object_throw(path);
+
+        //  Intern the slugs first so the table can be allocated flat.
+        for (auto& item0 : root){
+            rental_ids.emplace(item0.first, rental_ids.size());
+            JsonObject& obj = item0.second.to_object_throw(path);
+            for (auto& item1 : obj){
+                boss_ids.emplace(item1.first, boss_ids.size());
+            }
+        }
+
+        const size_t bosses = boss_ids.size();
+        table.resize(rental_ids.size() * bosses, std::numeric_limits<double>::quiet_NaN());
         for (auto& item0 : root){
-            std::map<std::string, double>& sub = map[item0.first];
+            double* row = table.data() + rental_ids[item0.first] * bosses;
             JsonObject& obj = item0.second.to_object_throw(path);
             for (auto& item1 : obj){
-                sub[item1.first] = item1.second.to_double_throw(path);
+                row[boss_ids[item1.first]] = item1.second.to_double_throw(path);
+            }
+        }
+    }
+};
+
+
+//  Average matchup of all the rentals against each boss. This is used when
+//  the rental is not known yet.
+//
+//  This is built the first time it is needed, not when the matchup table is
+//  loaded. Building it looks up every rental, and a missing rental should
+//  only fail the searches that need the average.
+struct RentalAverages{
+    //  [boss id] Missing matchups make the average NaN.
+    std::vector<double> average_rental;
+
+    static const RentalAverages& instance(){
+        static RentalAverages averages;
+        return averages;
+    }
+
+    double get(size_t boss) const{
+        double value = average_rental[boss];
+        if (std::isnan(value)){
+            throw InternalProgramError(
+                nullptr, PA_CURRENT_FUNCTION,
+                "Matchup not found for all rentals vs. " + std::to_string(boss)
+            );
+        }
+        return value;
+    }
+
+private:
+    RentalAverages(){
+        const MatchupDatabase& database = MatchupDatabase::instance();
+        const size_t bosses = database.boss_ids.size();
+        const auto& rentals = papkmnlib::all_rental_pokemon();
+        average_rental.resize(bosses, 0);
+        for (const auto& rental : rentals){
+            const double* row = database.table.data() + database.rental_id(rental.first) * bosses;
+            for (size_t b = 0; b < bosses; b++){
+                average_rental[b] += row[b];
             }
         }
+        for (double& value : average_rental){
+            value /= rentals.size();
+        }
     }
 };
 
 double rental_vs_boss_matchup(const std::string& rental, const std::string& boss){
-    return MatchupDatabase::instance().get(rental, boss);
+    const MatchupDatabase& database = MatchupDatabase::instance();
+    return database.get(database.rental_id(rental), database.boss_id(boss));
 }
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses){
     using namespace papkmnlib;
 
+    const MatchupDatabase& database = MatchupDatabase::instance();
+    size_t rental_id = database.rental_id(rental);
+
     double score = 0;
     if (bosses.empty()){
         const auto& all_bosses = all_boss_pokemon();
         for (const auto& boss : all_bosses){
-            score += rental_vs_boss_matchup(rental, boss.second.name());
+            score += database.get(rental_id, database.boss_id(boss.second.name()));
         }
-        score /= bosses.size();
+        score /= all_bosses.size();
     }else{
         for (const std::string& boss : bosses){
-            score += rental_vs_boss_matchup(rental, boss);
+            score += database.get(rental_id, database.boss_id(boss));
         }
         score /= bosses.size();
     }
@@ -77,6 +158,39 @@ double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::
 }
 
 
+size_t rental_matchup_id(const std::string& rental){
+    return MatchupDatabase::instance().rental_id(rental);
+}
+size_t boss_matchup_id(const std::string& boss){
+    return MatchupDatabase::instance().boss_id(boss);
+}
+double rental_vs_boss_matchup(size_t rental_id, size_t boss_id){
+    return MatchupDatabase::instance().get(rental_id, boss_id);
+}
+double rental_vs_boss_matchup(size_t rental_id, const std::vector<size_t>& boss_ids){
+    if (boss_ids.empty()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss list cannot be empty.");
+    }
+    const MatchupDatabase& database = MatchupDatabase::instance();
+    double score = 0;
+    for (size_t boss_id : boss_ids){
+        score += database.get(rental_id, boss_id);
+    }
+    return score / boss_ids.size();
+}
+double average_rental_vs_boss_matchup(const std::vector<size_t>& boss_ids){
+    if (boss_ids.empty()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss list cannot be empty.");
+    }
+    const RentalAverages& averages = RentalAverages::instance();
+    double score = 0;
+    for (size_t boss_id : boss_ids){
+        score += averages.get(boss_id);
+    }
+    return score / boss_ids.size();
+}
+
+
 
 
 
@@ -20,6 +20,21 @@ double rental_vs_boss_matchup(const std::string& rental, const std::string& boss
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses);
 
 
+//  Dense ids into the matchup table. Resolve the slugs once and use the id
+//  overloads inside loops to avoid string lookups.
+size_t rental_matchup_id(const std::string& rental);
+size_t boss_matchup_id(const std::string& boss);
+
+double rental_vs_boss_matchup(size_t rental_id, size_t boss_id);
+
+//  Average matchup of a rental against all the bosses in "boss_ids".
+double rental_vs_boss_matchup(size_t rental_id, const std::vector<size_t>& boss_ids);
+
+//  Average matchup of all the rentals against all the bosses in "boss_ids".
+//  This is the expected matchup of a rental that is not yet known.
+double average_rental_vs_boss_matchup(const std::vector<size_t>& boss_ids);
+
+
 
 }
 }
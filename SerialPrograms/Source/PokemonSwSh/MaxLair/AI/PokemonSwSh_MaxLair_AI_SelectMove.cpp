@@ -60,6 +60,7 @@ std::pair<uint8_t, bool> select_move_ai(
 
     //  No dmax.
     if (state.players[player_index].dmax_turns_left <= 0){
+        MoveScorer scorer(*self, boss, teammates_v, field);
         for (size_t c = 0; c < self->num_moves(); c++){
             if (self->pp(c) <= 0){
                 continue;
@@ -67,7 +68,7 @@ std::pair<uint8_t, bool> select_move_ai(
             if (state.players[player_index].move_blocked[c]){
                 continue;
             }
-            double score = calc_move_score(*self, boss, teammates_v, c, field);
+            double score = scorer.score(c);
             rank.emplace(
                 score,
                 std::pair<uint8_t, bool>{(uint8_t)c, false}
@@ -78,6 +79,7 @@ std::pair<uint8_t, bool> select_move_ai(
     //  Dmax
     self->set_is_dynamax(true);
     if (state.players[player_index].dmax_turns_left > 0 || state.players[player_index].can_dmax){
+        MoveScorer scorer(*self, boss, teammates_v, field);
         for (size_t c = 0; c < self->num_moves(); c++){
             if (self->pp(c) <= 0){
                 continue;
@@ -85,7 +87,7 @@ std::pair<uint8_t, bool> select_move_ai(
             if (state.players[player_index].move_blocked[c]){
                 continue;
             }
-            double score = calc_move_score(*self, boss, teammates_v, c, field);
+            double score = scorer.score(c);
             rank.emplace(
                 score,
                 std::pair<uint8_t, bool>{(uint8_t)c, true}
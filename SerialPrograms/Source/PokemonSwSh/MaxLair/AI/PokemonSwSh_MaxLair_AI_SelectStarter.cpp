@@ -38,18 +38,18 @@ int8_t select_starter(
         return 0;
     }
 
+    std::vector<size_t> boss_ids;
+    for (const Pokemon* boss : bosses){
+        boss_ids.emplace_back(boss_matchup_id(boss->name()));
+    }
+
     std::multimap<double, uint8_t, std::greater<double>> rank;
     for (uint8_t c = 0; c < 3; c++){
         if (options[c].empty()){
             continue;
         }
 //        const Pokemon& rental = get_pokemon(options[c]);
-        double score = 0;
-        for (const Pokemon* boss : bosses){
-//            score += evaluate_matchup(rental, *boss, {}, 4);
-            score += rental_vs_boss_matchup(options[c], boss->name());
-        }
-        score /= bosses.size();
+        double score = rental_vs_boss_matchup(rental_matchup_id(options[c]), boss_ids);
         rank.emplace(score, c);
     }
     if (rank.empty()){
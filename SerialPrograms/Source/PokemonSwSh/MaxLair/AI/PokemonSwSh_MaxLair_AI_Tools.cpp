@@ -91,30 +91,24 @@ std::vector<const papkmnlib::Pokemon*> get_boss_candidates(const GlobalState& st
 
 
 
-double rental_vs_boss_matchup(const std::string& rental, const std::vector<const papkmnlib::Pokemon*>& bosses){
-    using namespace papkmnlib;
-
+std::vector<size_t> boss_matchup_ids(const std::vector<const papkmnlib::Pokemon*>& bosses){
     if (bosses.empty()){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss list cannot be empty.");
     }
-    double score = 0;
-    if (rental.empty()){
-        for (const Pokemon* boss : bosses){
-            for (const auto& candidate : all_rental_pokemon()){
-                score += rental_vs_boss_matchup(candidate.first, boss->name());
-            }
-        }
-        score /= bosses.size() * all_rental_pokemon().size();
-    }else{
-        for (const Pokemon* boss : bosses){
-            score += rental_vs_boss_matchup(rental, boss->name());
-        }
-        score /= bosses.size();
+    std::vector<size_t> ids;
+    ids.reserve(bosses.size());
+    for (const papkmnlib::Pokemon* boss : bosses){
+        ids.emplace_back(boss_matchup_id(boss->name()));
     }
-    return score;
+    return ids;
 }
-double rental_vs_boss_matchup(const papkmnlib::Pokemon* rental, const std::vector<const papkmnlib::Pokemon*>& bosses){
-    return rental_vs_boss_matchup(rental == nullptr ? "" : rental->name(), bosses);
+
+//  An unknown rental (null) scores as the average of all rentals.
+double rental_vs_boss_matchup(const papkmnlib::Pokemon* rental, const std::vector<size_t>& boss_ids){
+    if (rental == nullptr){
+        return average_rental_vs_boss_matchup(boss_ids);
+    }
+    return rental_vs_boss_matchup(rental_matchup_id(rental->name()), boss_ids);
 }
 
 
@@ -129,9 +123,11 @@ double evaluate_hypothetical_team(
 
     uint8_t lives = 4;
 
+    std::vector<size_t> boss_ids = boss_matchup_ids(boss_candidates_on_path);
+
     double total = 0;
     for (size_t c = 0; c < 4; c++){
-        double score = rental_vs_boss_matchup(team[c], boss_candidates_on_path);
+        double score = rental_vs_boss_matchup(team[c], boss_ids);
 
         //  Adjust for HP.
         if (team[c] != nullptr){
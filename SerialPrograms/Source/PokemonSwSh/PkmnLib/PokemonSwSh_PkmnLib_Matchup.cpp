@@ -61,81 +61,92 @@ double calc_average_damage(
     return totalDamage / count;
 }
 
-double calc_move_score(
-    const Pokemon& attacker, Pokemon defender,
+MoveScorer::MoveScorer(
+    const Pokemon& attacker, const Pokemon& defender_in,
     const std::vector<const Pokemon*>& teammates,
-    size_t moveIdx, const Field& field
-){
-    // this function is different than the one above
-    // it will give a score for a single move based on several different factors
-
-    // get the move object based on the move index
-
-    // first start by calculating damage based on the attacker
-    // no on multiple targets since we're only hitting the boss
-    // TODO: set defender to dynamax?
-    double damageScore = damage_score(attacker, defender, moveIdx, field, false) / 2.0;
-
-    // TODO: make sure the defender and attacker aren't in the teammates list
+    const Field& field
+)
+    : m_attacker(attacker)
+    , m_defender(defender_in)
+    , m_field(field)
+{
+    Pokemon defender = defender_in;
 
     // fudge factor is available based on AI decisions
     double fudgeFactor = 1.5;
     std::vector<const Pokemon*> tempDefenderList{&defender};
     // calculate the damage the teammates do against the boss
-    damageScore += (1.5 * fudgeFactor) * calc_average_damage(teammates, tempDefenderList, field, false);
+    m_teammate_damage = (1.5 * fudgeFactor) * calc_average_damage(teammates, tempDefenderList, field, false);
 
     // TODO: implement status moves contributions, since all NonVolatile ones are pretty good
 
     // estimate potential received damage
-    double receivedDamage = 0.0;
     double receivedRegularDamage = 0.0;
+    double receivedRegularDamageWideGuard = 0.0;
     double receivedMaxMoveDamage = 0.0;
     double maxMoveProbability = 0.3; // TODO: we need hard data for this guy eventually
     size_t defenderNumMoves = defender.num_moves();
 
-    // get the attacker move
-    const Move& attackerMove = attacker.move(moveIdx);
-
-    bool originalDefenderDynamax = defender.is_dynamax();
     // first calculate damage from regular moves
     defender.set_is_dynamax(false);
-    // replace it
-    tempDefenderList[0] = &defender;
 
     //  Disable the dmax HP bonus for this calculation. This actively hurts
     //  multiplayer mode where other players can dmax.
 //    double dmax_hp_ratio = attacker.is_dynamax() ? 2.0 : 1.0;
     double dmax_hp_ratio = 1.0;
 
+    //  The boss's damage against the teammates does not depend on which
+    //  boss move is being considered. Compute it once per target mode.
+    double teammateSpreadDamage = calc_average_damage(tempDefenderList, teammates, field, true);
+    double teammateSingleDamage = calc_average_damage(tempDefenderList, teammates, field, false);
+
     // iterate through defender moves for non-dynamax
     for (size_t ii = 0; ii < defenderNumMoves; ii++){
         const Move& defenderMove = defender.move(ii);
         // NOTE: original function in python also checked to make sure we aren't dynamax, we already did that
         if (defenderMove.is_spread()){
-            if (attackerMove != "wide-guard" || attacker.is_dynamax()){
-                receivedRegularDamage += damage_score(defender, attacker, ii, field, true) / defenderNumMoves;
-                receivedRegularDamage += 3 * calc_average_damage(tempDefenderList, teammates, field, true) / defenderNumMoves;
-            }
+            //  Blocked if the attacker uses wide guard while not dynamaxed.
+            receivedRegularDamage += damage_score(defender, attacker, ii, field, true) / defenderNumMoves;
+            receivedRegularDamage += 3 * teammateSpreadDamage / defenderNumMoves;
         }else{
-            receivedRegularDamage += 0.25 * damage_score(defender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
-            receivedRegularDamage += 0.75 * calc_average_damage(tempDefenderList, teammates, field, false) / defenderNumMoves;
+            double damage = 0.25 * damage_score(defender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
+            receivedRegularDamage += damage;
+            receivedRegularDamageWideGuard += damage;
+            damage = 0.75 * teammateSingleDamage / defenderNumMoves;
+            receivedRegularDamage += damage;
+            receivedRegularDamageWideGuard += damage;
         }
     }
 //    cout << "receivedRegularDamage = " << receivedRegularDamage << endl;
 
     // then set up for max moves
     defender.set_is_dynamax(true);
-    tempDefenderList[0] = &defender;
+    double teammateMaxMoveDamage = calc_average_damage(tempDefenderList, teammates, field, false);
     for (size_t ii = 0; ii < defenderNumMoves; ii++){
         receivedMaxMoveDamage += 0.25 * damage_score(defender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
-        receivedMaxMoveDamage += 0.75 * calc_average_damage(tempDefenderList, teammates, field, false) / defenderNumMoves;
+        receivedMaxMoveDamage += 0.75 * teammateMaxMoveDamage / defenderNumMoves;
     }
 //    cout << "receivedMaxMoveDamage = " << receivedMaxMoveDamage << endl;
 
-    // at the end restore defender dynamax state
-    defender.set_is_dynamax(originalDefenderDynamax);
+    m_received_damage = receivedRegularDamage * (1 - maxMoveProbability) + receivedMaxMoveDamage * maxMoveProbability;
+    m_received_damage_wide_guard = receivedRegularDamageWideGuard * (1 - maxMoveProbability) + receivedMaxMoveDamage * maxMoveProbability;
+}
 
-    receivedDamage = receivedRegularDamage * (1 - maxMoveProbability) + receivedMaxMoveDamage * maxMoveProbability;
+double MoveScorer::score(size_t moveIdx) const{
+    // first start by calculating damage based on the attacker
+    // no on multiple targets since we're only hitting the boss
+    // TODO: set defender to dynamax?
+    double damageScore = damage_score(m_attacker, m_defender, moveIdx, m_field, false) / 2.0;
+
+    // TODO: make sure the defender and attacker aren't in the teammates list
+
+    damageScore += m_teammate_damage;
+
+    // get the attacker move
+    const Move& attackerMove = m_attacker.move(moveIdx);
+    double receivedDamage = attackerMove != "wide-guard" || m_attacker.is_dynamax()
+        ? m_received_damage
+        : m_received_damage_wide_guard;
 
     // failsafe in case received damage is very small (or zero!), don't want to blow it up to infinity
     if (receivedDamage < 0.0001){
@@ -147,6 +158,15 @@ double calc_move_score(
     return score;
 }
 
+
+double calc_move_score(
+    const Pokemon& attacker, Pokemon defender,
+    const std::vector<const Pokemon*>& teammates,
+    size_t moveIdx, const Field& field
+){
+    return MoveScorer(attacker, defender, teammates, field).score(moveIdx);
+}
+
 void select_best_move(
     const Pokemon& attacker, const Pokemon& defender, const Field& field,
     const std::vector<const Pokemon*>& teammates,
@@ -159,10 +179,12 @@ void select_best_move(
 
     double score = 0.0;
 
+    MoveScorer scorer(attacker, defender, teammates, field);
+
     // now iterate through the moves
     for (size_t ii = 0; ii < attacker.num_moves(); ii++){
         if (attacker.pp(ii) > 0){
-            score = calc_move_score(attacker, defender, teammates, ii, field);
+            score = scorer.score(ii);
             if (score > bestMoveScore){
                 bestIndex = ii;
                 bestMoveScore = score;
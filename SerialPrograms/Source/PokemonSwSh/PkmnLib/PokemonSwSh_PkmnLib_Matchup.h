@@ -28,6 +28,38 @@ double calc_move_score(
     const std::vector<const Pokemon*>& teammates,
     size_t moveIdx, const Field& field
 );
+
+//  Batched version of calc_move_score() for scoring all the moves of one
+//  attacker against one defender.
+//
+//  Everything that does not depend on the attacker's move (teammate damage
+//  and the damage the attacker expects to receive) is computed once in the
+//  constructor. Each score() is then a single damage_score() call.
+//
+//  The attacker, defender and field are referenced, not copied. They must
+//  not be modified (including the dynamax state) while this object is used.
+class MoveScorer{
+public:
+    MoveScorer(
+        const Pokemon& attacker, const Pokemon& defender,
+        const std::vector<const Pokemon*>& teammates,
+        const Field& field
+    );
+
+    //  Same result as calc_move_score() for this move.
+    double score(size_t moveIdx) const;
+
+private:
+    const Pokemon& m_attacker;
+    const Pokemon& m_defender;
+    const Field& m_field;
+
+    double m_teammate_damage;
+
+    //  Expected received damage. Wide guard blocks the regular spread moves.
+    double m_received_damage;
+    double m_received_damage_wide_guard;
+};
 void select_best_move(
     const Pokemon& attacker, const Pokemon& defender, const Field& field,
     const std::vector<const Pokemon*>& teammates,
@@ -5,16 +5,36 @@
  */
 
 
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <vector>
+#include <random>
+#include <filesystem>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CancellableScope.h"
+#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
+#include "Common/Cpp/Concurrency/PeriodicExecutor.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/AudioPipeline/AudioConstants.h"
+#include "CommonFramework/AudioPipeline/Tools/AudioResampler.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/VideoPipeline/Backends/DisplayFrameLimiter.h"
+#include "CommonFramework/VideoPipeline/VideoSources/VideoSource_StillImage.h"
+#include "CommonTools/InferencePivots/InferenceProfiler.h"
+#include "CommonTools/InferencePivots/VisualInferencePivot.h"
 #include "CommonTools/VisualDetectors/BlackBorderDetector.h"
 #include "CommonFramework_Tests.h"
 #include "TestUtils.h"
 
 
-//#include <iostream>
-//using std::cout;
-//using std::cerr;
-//using std::endl;
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
 
 namespace PokemonAutomation{
 
@@ -29,4 +49,500 @@ int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool t
 }
 
 
+namespace{
+
+//  Serve the snapshots of a video source straight to inference, the same way
+//  the video session does when the video isn't shown.
+class VideoSourceFeed : public VideoFeed{
+public:
+    VideoSourceFeed(VideoSource& source)
+        : m_source(source)
+    {}
+
+    virtual void add_frame_listener(VideoFrameListener& listener) override{
+        m_source.add_source_frame_listener(listener);
+    }
+    virtual void remove_frame_listener(VideoFrameListener& listener) override{
+        m_source.remove_source_frame_listener(listener);
+    }
+    virtual void reset() override{}
+
+    virtual VideoSnapshot snapshot_latest_blocking() override{
+        return m_source.snapshot_latest_blocking();
+    }
+    virtual VideoSnapshot snapshot_recent_nonblocking(WallClock min_time) override{
+        return m_source.snapshot_recent_nonblocking(min_time);
+    }
+
+    virtual double fps_source() const override{ return 0; }
+    virtual double fps_display() const override{ return 0; }
+
+private:
+    VideoSource& m_source;
+};
+
+//  Stops the inference after it has seen "runs" frames.
+class FrameCountCallback : public VisualInferenceCallback{
+public:
+    FrameCountCallback(size_t width, size_t height, size_t runs)
+        : VisualInferenceCallback("FrameCountCallback")
+        , m_width(width)
+        , m_height(height)
+        , m_runs(runs)
+    {}
+
+    virtual void make_overlays(VideoOverlaySet& items) const override{}
+    virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override{
+        if (frame.width() != m_width || frame.height() != m_height){
+            m_wrong_size++;
+        }
+        return ++m_seen >= m_runs;
+    }
+
+    size_t seen() const{ return m_seen.load(); }
+    size_t wrong_size() const{ return m_wrong_size.load(); }
+
+private:
+    const size_t m_width;
+    const size_t m_height;
+    const size_t m_runs;
+    std::atomic<size_t> m_seen{0};
+    std::atomic<size_t> m_wrong_size{0};
+};
+
+}
+
+
+int test_CommonFramework_StillImageInference(const std::string& test_path){
+    Logger& logger = global_logger_command_line();
+
+    const Resolution resolution(1280, 720);
+    VideoSource_StillImage source(logger, test_path, resolution);
+    VideoSourceFeed feed(source);
+
+    //  No display widget is ever made. The frames must still be there.
+    VideoSnapshot snapshot = feed.snapshot();
+    if (!snapshot){
+        cerr << "Error: still image source has no frame: " << test_path << endl;
+        return 1;
+    }
+    TEST_RESULT_EQUAL(snapshot->width(), resolution.width);
+    TEST_RESULT_EQUAL(snapshot->height(), resolution.height);
+
+    const size_t RUNS = 10;
+    PeriodicExecutor executor([]{}, 1);
+    CancellableHolder<CancellableScope> holder;
+    CancellableScope& scope = holder;
+    FrameCountCallback callback(resolution.width, resolution.height, RUNS);
+    std::atomic<InferenceCallback*> triggered(nullptr);
+    bool stopped = false;
+    {
+        VisualInferencePivot pivot(scope, feed, executor);
+        CancellableHolder<CancellableScope> subscope(scope);
+        pivot.add_callback(subscope, &triggered, callback, std::chrono::milliseconds(10));
+        try{
+            subscope.wait_for(std::chrono::seconds(10));
+        }catch (OperationCancelledException&){
+            stopped = true;
+        }
+        pivot.remove_callback(callback);
+        subscope.throw_if_cancelled_with_exception();
+    }
+
+    TEST_RESULT_COMPONENT_EQUAL(stopped, true, "stopped by the callback");
+    TEST_RESULT_COMPONENT_EQUAL(triggered.load() == &callback, true, "triggered callback");
+    TEST_RESULT_COMPONENT_EQUAL(callback.seen() >= RUNS, true, "# of frames seen");
+    TEST_RESULT_COMPONENT_EQUAL(callback.wrong_size(), (size_t)0, "# of frames with the wrong size");
+
+    return 0;
+}
+
+
+namespace{
+
+//  Feed "seconds" of frames at "source_fps" with up to "jitter" of timer noise
+//  and return how many get shown.
+size_t count_displayed_frames(
+    DisplayFrameLimiter& limiter,
+    double source_fps, uint8_t max_fps,
+    std::chrono::microseconds jitter, size_t seconds
+){
+    std::minstd_rand rng(0);
+    WallClock start = current_time();
+    size_t frames = (size_t)(source_fps * seconds);
+    size_t shown = 0;
+    for (size_t c = 0; c < frames; c++){
+        auto offset = std::chrono::microseconds((int64_t)(c * 1000000 / source_fps));
+        if (jitter.count() > 0){
+            offset += std::chrono::microseconds((int64_t)(rng() % (2 * jitter.count() + 1)) - jitter.count());
+        }
+        if (limiter.push_frame(start + offset, max_fps)){
+            shown++;
+        }
+    }
+    return shown;
+}
+
+}
+
+
+int test_CommonFramework_DisplayFrameLimiter(const std::string& test_path){
+    using std::chrono::microseconds;
+
+    //  No limit.
+    {
+        DisplayFrameLimiter limiter;
+        size_t shown = count_displayed_frames(limiter, 60, 0, microseconds(0), 10);
+        TEST_RESULT_EQUAL(shown, (size_t)600);
+    }
+
+    //  Half the source rate drops every other frame.
+    {
+        DisplayFrameLimiter limiter;
+        size_t shown = count_displayed_frames(limiter, 60, 30, microseconds(0), 10);
+        TEST_RESULT_EQUAL(shown, (size_t)300);
+    }
+
+    //  A source at the limit keeps every frame even with some jitter.
+    {
+        DisplayFrameLimiter limiter;
+        size_t shown = count_displayed_frames(limiter, 30, 30, microseconds(1000), 10);
+        TEST_RESULT_EQUAL(shown, (size_t)300);
+    }
+
+    //  Never more than the limit.
+    for (uint8_t max_fps : {(uint8_t)1, (uint8_t)24, (uint8_t)60, (uint8_t)255}){
+        DisplayFrameLimiter limiter;
+        size_t shown = count_displayed_frames(limiter, 1000, max_fps, microseconds(300), 10);
+        TEST_RESULT_COMPONENT_EQUAL(shown <= (size_t)max_fps * 10 * 10 / 9 + 1, true, "# of frames shown");
+        TEST_RESULT_COMPONENT_EQUAL(shown >= (size_t)max_fps * 10 * 8 / 10, true, "# of frames shown");
+    }
+
+    //  The first frame after a reset is always shown.
+    {
+        DisplayFrameLimiter limiter;
+        WallClock now = current_time();
+        TEST_RESULT_EQUAL(limiter.push_frame(now, 10), true);
+        TEST_RESULT_EQUAL(limiter.push_frame(now + std::chrono::milliseconds(1), 10), false);
+        limiter.reset();
+        TEST_RESULT_EQUAL(limiter.push_frame(now + std::chrono::milliseconds(2), 10), true);
+    }
+
+    return 0;
+}
+
+
+namespace{
+
+//  Resample one second of a sine tone in chunks of "chunk" input samples.
+std::vector<float> resample_tone(
+    size_t input_rate, size_t output_rate, double frequency, size_t chunk
+){
+    std::vector<float> input(input_rate);
+    for (size_t c = 0; c < input.size(); c++){
+        input[c] = (float)std::sin(2 * 3.14159265358979323846 * frequency * c / input_rate);
+    }
+    AudioResampler resampler(input_rate, output_rate);
+    std::vector<float> output;
+    for (size_t c = 0; c < input.size(); c += chunk){
+        resampler.push_samples(output, input.data() + c, std::min(chunk, input.size() - c));
+    }
+    return output;
+}
+
+}
+
+
+int test_CommonFramework_AudioResampler(const std::string& test_path){
+    const double PI = 3.14159265358979323846;
+    const size_t INPUT_RATE = 44100;
+    const size_t OUTPUT_RATE = AUDIO_FFT_SAMPLE_RATE;
+
+    //  The output must not depend on how the input is split up.
+    std::vector<float> whole = resample_tone(INPUT_RATE, OUTPUT_RATE, 1000, INPUT_RATE);
+    std::vector<float> split = resample_tone(INPUT_RATE, OUTPUT_RATE, 1000, 7);
+    TEST_RESULT_EQUAL(whole.size(), OUTPUT_RATE);
+    TEST_RESULT_EQUAL(split.size(), whole.size());
+    for (size_t c = 0; c < whole.size(); c++){
+        TEST_RESULT_APPROXIMATE(split[c], whole[c], 1e-6);
+    }
+
+    //  Tones below the input Nyquist come out unchanged, just delayed by half
+    //  of the 64 filter taps. (44100:48000 reduces to 147:160)
+    const double UP = 160;
+    const double DELAY = (UP * 64 - 1) / (2 * UP) / INPUT_RATE;
+    for (double frequency : {1000., 5000., 18000.}){
+        std::vector<float> output = resample_tone(INPUT_RATE, OUTPUT_RATE, frequency, 1000);
+        TEST_RESULT_EQUAL(output.size(), OUTPUT_RATE);
+
+        //  Skip the edges where the filter runs off the ends of the tone.
+        double max_error = 0;
+        for (size_t c = 1000; c + 1000 < output.size(); c++){
+            double t = (double)c / OUTPUT_RATE - DELAY;
+            double expected = std::sin(2 * PI * frequency * t);
+            max_error = std::max(max_error, std::fabs(output[c] - expected));
+        }
+        cout << "AudioResampler: " << frequency << " Hz, max error = " << max_error << endl;
+        TEST_RESULT_APPROXIMATE(max_error, 0.0, 1e-3);
+    }
+
+    //  Going down to 48kHz, a tone above the output Nyquist must be filtered
+    //  out instead of aliasing back in.
+    {
+        std::vector<float> output = resample_tone(96000, OUTPUT_RATE, 30000, 1000);
+        TEST_RESULT_EQUAL(output.size(), OUTPUT_RATE);
+        double peak = 0;
+        for (size_t c = 1000; c + 1000 < output.size(); c++){
+            peak = std::max(peak, (double)std::fabs(output[c]));
+        }
+        cout << "AudioResampler: 30000 Hz at 96000 Hz, peak = " << peak << endl;
+        TEST_RESULT_APPROXIMATE(peak, 0.0, 1e-2);
+    }
+
+    return 0;
+}
+
+
+namespace{
+
+//  Run "func(begin, end)" over [start, end) and check that every index was
+//  covered exactly once by valid blocks.
+int check_parallel_for_range(
+    ComputationThreadPool& pool,
+    size_t start, size_t end, size_t block_size
+){
+    std::vector<std::atomic<uint32_t>> counts(end);
+    std::atomic<size_t> bad_blocks(0);
+    pool.parallel_for_range(
+        [&](size_t s, size_t e){
+            if (s >= e || s < start || e > end){
+                bad_blocks++;
+                return;
+            }
+            for (; s < e; s++){
+                counts[s].fetch_add(1, std::memory_order_relaxed);
+            }
+        },
+        start, end, block_size
+    );
+    TEST_RESULT_COMPONENT_EQUAL(bad_blocks.load(), (size_t)0, "# of invalid blocks");
+    for (size_t c = 0; c < end; c++){
+        uint32_t expected = c < start ? 0 : 1;
+        if (counts[c].load() != expected){
+            cerr << "Index " << c << " of [" << start << ", " << end << ") with block size "
+                 << block_size << " ran " << counts[c].load() << " times." << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//  Parallel regions inside a parallel region.
+int check_nested_parallel_for_range(ComputationThreadPool& pool){
+    const size_t OUTER = 64;
+    const size_t INNER = 300;
+    std::vector<std::atomic<uint32_t>> counts(OUTER * INNER);
+    pool.parallel_for_range(
+        [&](size_t s, size_t e){
+            for (; s < e; s++){
+                size_t outer = s;
+                pool.parallel_for_range(
+                    [&counts, outer](size_t s1, size_t e1){
+                        for (; s1 < e1; s1++){
+                            counts[outer * INNER + s1].fetch_add(1, std::memory_order_relaxed);
+                        }
+                    },
+                    0, INNER, 7
+                );
+            }
+        },
+        0, OUTER, 1
+    );
+    for (size_t c = 0; c < counts.size(); c++){
+        if (counts[c].load() != 1){
+            cerr << "Nested index " << c << " ran " << counts[c].load() << " times." << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+}
+
+
+int test_CommonFramework_ParallelForRange(const std::string& test_path){
+    const size_t RANGES[][3] = {
+        //  start, end, block size
+        {0, 0, 0},
+        {5, 5, 1},
+        {0, 1, 0},
+        {0, 1000, 0},
+        {0, 1000, 1},
+        {3, 1000, 7},
+        {17, 10000, 64},
+        {0, 100, 1000},
+    };
+
+    for (size_t threads : {(size_t)1, (size_t)4}){
+        ComputationThreadPool pool([](){}, threads, threads);
+        for (const auto& range : RANGES){
+            if (check_parallel_for_range(pool, range[0], range[1], range[2]) != 0){
+                cerr << "Threads: " << threads << endl;
+                return 1;
+            }
+        }
+        for (size_t c = 0; c < 10; c++){
+            if (check_nested_parallel_for_range(pool) != 0){
+                cerr << "Threads: " << threads << endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+namespace{
+
+struct ChromeTrace{
+    std::map<int64_t, std::string> tracks;  //  tid -> name
+    std::vector<int64_t> tids;
+    std::vector<double> timestamps;
+    std::vector<double> durations;
+};
+ChromeTrace read_chrome_trace(const std::string& filename){
+    ChromeTrace ret;
+    JsonValue json = load_json_file(filename);
+    for (const JsonValue& item : json.to_object_throw(filename).get_array_throw("traceEvents", filename)){
+        const JsonObject& event = item.to_object_throw(filename);
+        const std::string& phase = event.get_string_throw("ph", filename);
+        if (phase == "M"){
+            if (event.get_string_throw("name", filename) == "thread_name"){
+                ret.tracks[event.get_integer_throw("tid", filename)] =
+                    event.get_object_throw("args", filename).get_string_throw("name", filename);
+            }
+            continue;
+        }
+        ret.tids.emplace_back(event.get_integer_throw("tid", filename));
+        ret.timestamps.emplace_back(event.get_double_throw("ts", filename));
+        ret.durations.emplace_back(event.get_double_throw("dur", filename));
+    }
+    return ret;
+}
+
+}
+
+
+int test_CommonFramework_InferenceProfiler(const std::string& test_path){
+    const std::string trace_file =
+        (std::filesystem::temp_directory_path() / "InferenceProfilerTest.json").string();
+    const size_t MAX_EVENTS = InferenceProfiler::MAX_TRACE_EVENTS;
+    const WallClock origin = current_time();
+
+    InferenceProfiler& profiler = InferenceProfiler::instance();
+    profiler.clear();
+
+    const uint64_t video = profiler.add_pivot("Video");
+    const uint64_t audio = profiler.add_pivot("Audio");
+    TEST_RESULT_COMPONENT_EQUAL(video != audio, true, "distinct pivot ids");
+
+    //  Histograms: Runs without a CPU time or snapshot age must not land in
+    //  those histograms.
+    for (size_t c = 0; c < 3; c++){
+        profiler.record(
+            video, "Detector",
+            origin, std::chrono::microseconds(100), WallDuration::min(),
+            std::chrono::microseconds(5000), std::chrono::microseconds(10)
+        );
+    }
+    {
+        std::vector<InferenceProfileStats> stats = profiler.stats();
+        TEST_RESULT_EQUAL(stats.size(), (size_t)1);
+        TEST_RESULT_EQUAL(stats[0].label, "Detector");
+        TEST_RESULT_COMPONENT_EQUAL(stats[0].wall_time.samples, (uint64_t)3, "wall time samples");
+        TEST_RESULT_COMPONENT_EQUAL(stats[0].cpu_time.samples, (uint64_t)0, "CPU time samples");
+        TEST_RESULT_COMPONENT_EQUAL(stats[0].snapshot_age.samples, (uint64_t)3, "snapshot age samples");
+        TEST_RESULT_COMPONENT_EQUAL(stats[0].queue_delay.samples, (uint64_t)3, "queue delay samples");
+        TEST_RESULT_COMPONENT_EQUAL(
+            std::chrono::duration_cast<std::chrono::microseconds>(stats[0].wall_time.max_error).count(),
+            100, "max wall time"
+        );
+        TEST_RESULT_COMPONENT_EQUAL(
+            std::chrono::duration_cast<std::chrono::microseconds>(stats[0].snapshot_age.max_error).count(),
+            5000, "max snapshot age"
+        );
+    }
+
+    //  A pivot that is gone keeps its track while its runs are still buffered.
+    profiler.clear();
+    profiler.record(
+        audio, "Sound",
+        origin, std::chrono::microseconds(1), WallDuration::min(),
+        WallDuration::min(), WallDuration::zero()
+    );
+    profiler.remove_pivot(audio);
+    {
+        TEST_RESULT_EQUAL(profiler.export_chrome_trace(trace_file), (size_t)1);
+        ChromeTrace trace = read_chrome_trace(trace_file);
+        TEST_RESULT_COMPONENT_EQUAL(trace.tracks.size(), (size_t)2, "# of tracks");
+        TEST_RESULT_COMPONENT_EQUAL(trace.tracks[(int64_t)video], "Video Pivot " + std::to_string(video), "video track");
+        TEST_RESULT_COMPONENT_EQUAL(trace.tracks[(int64_t)audio], "Audio Pivot " + std::to_string(audio), "audio track");
+        TEST_RESULT_COMPONENT_EQUAL(trace.tids.size(), (size_t)1, "# of runs");
+        TEST_RESULT_COMPONENT_EQUAL(trace.tids[0], (int64_t)audio, "run track");
+    }
+
+    //  Overfill the ring buffer. Run "c" starts at "c" ms and takes "c" us.
+    //  Only the newest runs survive and they must come out oldest first.
+    const size_t EXTRA = 10;
+    for (size_t c = 1; c <= MAX_EVENTS + EXTRA; c++){
+        profiler.record(
+            video, "Detector",
+            origin + std::chrono::milliseconds(c), std::chrono::microseconds(c), std::chrono::microseconds(c),
+            WallDuration::min(), WallDuration::zero()
+        );
+    }
+    {
+        TEST_RESULT_EQUAL(profiler.export_chrome_trace(trace_file), MAX_EVENTS);
+        ChromeTrace trace = read_chrome_trace(trace_file);
+
+        //  The audio run was overwritten so its track is gone too.
+        TEST_RESULT_COMPONENT_EQUAL(trace.tracks.size(), (size_t)1, "# of tracks");
+        TEST_RESULT_COMPONENT_EQUAL(trace.tracks.count((int64_t)video), (size_t)1, "video track");
+
+        TEST_RESULT_COMPONENT_EQUAL(trace.durations.size(), MAX_EVENTS, "# of runs");
+        for (size_t c = 0; c < MAX_EVENTS; c++){
+            double run = (double)(c + EXTRA + 1);
+            TEST_RESULT_COMPONENT_EQUAL(trace.tids[c], (int64_t)video, "run track");
+            TEST_RESULT_APPROXIMATE(trace.durations[c], run, 1e-3);
+
+            //  Timestamps are relative to the oldest run.
+            TEST_RESULT_APPROXIMATE(trace.timestamps[c], 1000. * (run - (EXTRA + 1)), 1e-3);
+        }
+    }
+
+    //  "clear()" drops everything except the tracks of live pivots.
+    const uint64_t gone = profiler.add_pivot("Video");
+    profiler.record(
+        gone, "Detector",
+        origin, std::chrono::microseconds(1), WallDuration::min(),
+        WallDuration::min(), WallDuration::zero()
+    );
+    profiler.remove_pivot(gone);
+    profiler.clear();
+    {
+        TEST_RESULT_EQUAL(profiler.stats().size(), (size_t)0);
+        TEST_RESULT_EQUAL(profiler.export_chrome_trace(trace_file), (size_t)0);
+        ChromeTrace trace = read_chrome_trace(trace_file);
+        TEST_RESULT_COMPONENT_EQUAL(trace.tracks.size(), (size_t)1, "# of tracks");
+        TEST_RESULT_COMPONENT_EQUAL(trace.tracks.count((int64_t)video), (size_t)1, "video track");
+    }
+
+    profiler.remove_pivot(video);
+    std::filesystem::remove(trace_file);
+
+    return 0;
+}
+
+
 }
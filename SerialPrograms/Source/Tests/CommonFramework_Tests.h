@@ -9,12 +9,30 @@
 #ifndef PokemonAutomation_Tests_CommonFramework_Tests_H
 #define PokemonAutomation_Tests_CommonFramework_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool target);
 
+// Test file is an image. Runs a video inference pivot on a still image video
+// source with no display.
+int test_CommonFramework_StillImageInference(const std::string& test_path);
+
+// Does not read the test file.
+int test_CommonFramework_DisplayFrameLimiter(const std::string& test_path);
+
+// Does not read the test file.
+int test_CommonFramework_AudioResampler(const std::string& test_path);
+
+// Does not read the test file.
+int test_CommonFramework_ParallelForRange(const std::string& test_path);
+
+// Does not read the test file.
+int test_CommonFramework_InferenceProfiler(const std::string& test_path);
+
 }
 
 #endif
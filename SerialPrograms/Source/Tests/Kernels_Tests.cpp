@@ -7,6 +7,7 @@
 
 #include "Common/Compiler.h"
 #include "Common/Cpp/Color.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "Common/Cpp/CpuId/CpuId.h"
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/BinaryImage.h"
@@ -23,10 +24,13 @@
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrixTile_64x4_Default.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrixTile_64xH_Default.h"
 #include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology.h"
 #include "Kernels/ImageFilters/Kernels_ImageFilter_Basic.h"
 #include "Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range.h"
 #include "Kernels/ImageFilters/RGB32_EuclideanDistance/Kernels_ImageFilter_RGB32_Euclidean.h"
 #include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h"
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.h"
@@ -34,7 +38,11 @@
 #include "Kernels_Tests.h"
 #include "TestUtils.h"
 
+#include <string.h>
+#include <cmath>
 #include <functional>
+#include <random>
+#include <vector>
 #include <iostream>
 using std::cout;
 using std::cerr;
@@ -75,6 +83,228 @@ int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image){
 }
 
 
+namespace{
+
+//  Plain scalar versions of "pixel_sum_sqr()" and "sum_sqr_deviation()" to
+//  check the vectorized kernels against.
+void pixel_sum_sqr_scalar(PixelSums& sums, const ImageViewRGB32& image, const ImageViewRGB32& alpha){
+    for (size_t y = 0; y < image.height(); y++){
+        for (size_t x = 0; x < image.width(); x++){
+            if (alpha.pixel(x, y) < 0x80000000){
+                continue;
+            }
+            Color pixel(image.pixel(x, y));
+            sums.count++;
+            sums.sumR += pixel.red();
+            sums.sumG += pixel.green();
+            sums.sumB += pixel.blue();
+            sums.sqrR += pixel.red() * pixel.red();
+            sums.sqrG += pixel.green() * pixel.green();
+            sums.sqrB += pixel.blue() * pixel.blue();
+        }
+    }
+}
+void sum_sqr_deviation_scalar(
+    uint64_t& count, uint64_t& sumsqrs,
+    const ImageViewRGB32& ref, const ImageViewRGB32& img,
+    SumSquareMode mode, uint32_t background
+){
+    for (size_t y = 0; y < ref.height(); y++){
+        for (size_t x = 0; x < ref.width(); x++){
+            uint32_t r = ref.pixel(x, y);
+            uint32_t i = img.pixel(x, y);
+            bool alphaR = r >= 0x80000000;
+            bool alphaI = i >= 0x80000000;
+            count += alphaR;
+            switch (mode){
+            case SumSquareMode::REFERENCE_ALPHA:
+                if (!alphaR){
+                    continue;
+                }
+                break;
+            case SumSquareMode::USE_BACKGROUND:
+                if (!alphaR){
+                    r = background;
+                }
+                break;
+            case SumSquareMode::ARBITRATE_ALPHAS:
+                if (!alphaR && !alphaI){
+                    continue;
+                }
+                if (alphaR != alphaI){
+                    sumsqrs += 3 * 255 * 255;
+                    continue;
+                }
+                break;
+            }
+            Color cr(r), ci(i);
+            int dr = cr.red() - ci.red();
+            int dg = cr.green() - ci.green();
+            int db = cr.blue() - ci.blue();
+            sumsqrs += dr*dr + dg*dg + db*db;
+        }
+    }
+}
+
+}
+
+
+int test_kernels_ImagePixelSumSqrDev(const ImageViewRGB32& image){
+    const size_t width = image.width(), height = image.height();
+    cout << "Testing sum_sqr_deviation(), image size " << width << " x " << height << endl;
+
+    //  Reference with a sprinkling of transparent pixels. The image to compare
+    //  against is a brightened copy with a different set of transparent pixels.
+    ImageRGB32 ref = image.copy();
+    ImageRGB32 img = image.copy();
+    scale_brightness(img.width(), img.height(), img.data(), img.bytes_per_row(), 1.1f, 0.95f, 1.05f);
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            ref.pixel(x, y) |= 0xff000000;
+            img.pixel(x, y) |= 0xff000000;
+            if ((x + y) % 7 == 0){
+                ref.pixel(x, y) &= 0x00ffffff;
+            }
+            if ((x * 3 + y) % 11 == 0){
+                img.pixel(x, y) &= 0x00ffffff;
+            }
+        }
+    }
+
+    const uint32_t background = 0xff204080;
+    const SumSquareMode MODES[] = {
+        SumSquareMode::REFERENCE_ALPHA,
+        SumSquareMode::USE_BACKGROUND,
+        SumSquareMode::ARBITRATE_ALPHAS,
+    };
+    const float SCALES[][3] = {
+        {1.00f, 1.00f, 1.00f},
+        {0.85f, 1.15f, 1.00f},
+        {1.15f, 0.90f, 0.87f},
+    };
+
+    auto run = [&](
+        uint64_t& count, uint64_t& sumsqrs,
+        const ImageViewRGB32& r, const ImageViewRGB32& i,
+        SumSquareMode mode
+    ){
+        switch (mode){
+        case SumSquareMode::REFERENCE_ALPHA:
+            sum_sqr_deviation(count, sumsqrs, r.width(), r.height(), r.data(), r.bytes_per_row(), i.data(), i.bytes_per_row());
+            break;
+        case SumSquareMode::USE_BACKGROUND:
+            sum_sqr_deviation(count, sumsqrs, r.width(), r.height(), r.data(), r.bytes_per_row(), i.data(), i.bytes_per_row(), background);
+            break;
+        case SumSquareMode::ARBITRATE_ALPHAS:
+            sum_sqr_deviation_masked(count, sumsqrs, r.width(), r.height(), r.data(), r.bytes_per_row(), i.data(), i.bytes_per_row());
+            break;
+        }
+    };
+    auto run_scaled = [&](
+        uint64_t& count, uint64_t& sumsqrs,
+        const ImageViewRGB32& r, const ImageViewRGB32& i,
+        SumSquareMode mode, const float* scale
+    ){
+        switch (mode){
+        case SumSquareMode::REFERENCE_ALPHA:
+            sum_sqr_deviation_scaled(
+                count, sumsqrs, r.width(), r.height(), r.data(), r.bytes_per_row(), i.data(), i.bytes_per_row(),
+                scale[0], scale[1], scale[2]
+            );
+            break;
+        case SumSquareMode::USE_BACKGROUND:
+            sum_sqr_deviation_scaled(
+                count, sumsqrs, r.width(), r.height(), r.data(), r.bytes_per_row(), i.data(), i.bytes_per_row(),
+                background, scale[0], scale[1], scale[2]
+            );
+            break;
+        case SumSquareMode::ARBITRATE_ALPHAS:
+            sum_sqr_deviation_masked_scaled(
+                count, sumsqrs, r.width(), r.height(), r.data(), r.bytes_per_row(), i.data(), i.bytes_per_row(),
+                scale[0], scale[1], scale[2]
+            );
+            break;
+        }
+    };
+
+    //  Every width up to 40 to cover all the left-over paths, then the full image.
+    std::vector<size_t> widths;
+    for (size_t w = 1; w <= std::min<size_t>(40, width); w++){
+        widths.emplace_back(w);
+    }
+    widths.emplace_back(width);
+
+    for (size_t w : widths){
+        ImagePixelBox box(0, 0, w, height);
+        ImageViewRGB32 r = extract_box_reference(ref, box);
+        ImageViewRGB32 i = extract_box_reference(img, box);
+
+        PixelSums expected_sums;
+        PixelSums sums;
+        pixel_sum_sqr_scalar(expected_sums, i, r);
+        pixel_sum_sqr(sums, w, height, i.data(), i.bytes_per_row(), r.data(), r.bytes_per_row());
+        TEST_RESULT_EQUAL(sums.count, expected_sums.count);
+        TEST_RESULT_EQUAL(sums.sumR, expected_sums.sumR);
+        TEST_RESULT_EQUAL(sums.sumG, expected_sums.sumG);
+        TEST_RESULT_EQUAL(sums.sumB, expected_sums.sumB);
+        TEST_RESULT_EQUAL(sums.sqrR, expected_sums.sqrR);
+        TEST_RESULT_EQUAL(sums.sqrG, expected_sums.sqrG);
+        TEST_RESULT_EQUAL(sums.sqrB, expected_sums.sqrB);
+
+        for (SumSquareMode mode : MODES){
+            //  Unscaled kernels against the scalar version.
+            uint64_t expected_count = 0, expected_sumsqrs = 0;
+            uint64_t count = 0, sumsqrs = 0;
+            sum_sqr_deviation_scalar(expected_count, expected_sumsqrs, r, i, mode, background);
+            run(count, sumsqrs, r, i, mode);
+            TEST_RESULT_EQUAL(count, expected_count);
+            TEST_RESULT_EQUAL(sumsqrs, expected_sumsqrs);
+
+            //  Fused kernels against scaling a copy first.
+            for (const float* scale : SCALES){
+                ImageRGB32 scaled_ref = r.copy();
+                scale_brightness(
+                    scaled_ref.width(), scaled_ref.height(),
+                    scaled_ref.data(), scaled_ref.bytes_per_row(),
+                    scale[0], scale[1], scale[2]
+                );
+                expected_count = expected_sumsqrs = 0;
+                count = sumsqrs = 0;
+                run(expected_count, expected_sumsqrs, scaled_ref, i, mode);
+                run_scaled(count, sumsqrs, r, i, mode, scale);
+                TEST_RESULT_EQUAL(count, expected_count);
+                TEST_RESULT_EQUAL(sumsqrs, expected_sumsqrs);
+            }
+        }
+    }
+    cout << "Results match." << endl;
+
+    const int num_iterations = 500;
+    const float* scale = SCALES[2];
+    auto time_start = current_time();
+    for (int c = 0; c < num_iterations; c++){
+        ImageRGB32 scaled_ref = ref.copy();
+        scale_brightness(
+            scaled_ref.width(), scaled_ref.height(),
+            scaled_ref.data(), scaled_ref.bytes_per_row(),
+            scale[0], scale[1], scale[2]
+        );
+        uint64_t count = 0, sumsqrs = 0;
+        run(count, sumsqrs, scaled_ref, img, SumSquareMode::ARBITRATE_ALPHAS);
+    }
+    auto time_mid = current_time();
+    for (int c = 0; c < num_iterations; c++){
+        uint64_t count = 0, sumsqrs = 0;
+        run_scaled(count, sumsqrs, ref, img, SumSquareMode::ARBITRATE_ALPHAS, scale);
+    }
+    auto time_end = current_time();
+    cout << "Copy + scale + diff: " << std::chrono::duration_cast<std::chrono::microseconds>(time_mid - time_start).count() / num_iterations << " us" << endl;
+    cout << "Fused scale + diff:  " << std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_mid).count() / num_iterations << " us" << endl;
+
+    return 0;
+}
+
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image){
 
     if (test_binary_matrix_tile() != 0){
@@ -942,6 +1172,333 @@ template<class Tile> int test_binary_matrix_tile_t(){
     return 0;
 }
 
+namespace{
+
+//  Brute force versions of the morphology operations on a plain array of
+//  pixels to check the packed kernels against.
+bool morphology_get(
+    const std::vector<char>& pixels, size_t width, size_t height,
+    ptrdiff_t x, ptrdiff_t y, bool outside
+){
+    if (x < 0 || y < 0 || x >= (ptrdiff_t)width || y >= (ptrdiff_t)height){
+        return outside;
+    }
+    return pixels[x + y * width] != 0;
+}
+std::vector<char> morphology_scalar(
+    const std::vector<char>& pixels, size_t width, size_t height,
+    const BinaryStructuringElement& element, bool dilate
+){
+    std::vector<char> ret(width * height);
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            bool set = !dilate;
+            for (size_t ey = 0; ey < element.height(); ey++){
+                for (size_t ex = 0; ex < element.width(); ex++){
+                    if (!element.get(ex, ey)){
+                        continue;
+                    }
+                    ptrdiff_t dx = (ptrdiff_t)ex - (ptrdiff_t)element.anchor_x();
+                    ptrdiff_t dy = (ptrdiff_t)ey - (ptrdiff_t)element.anchor_y();
+                    if (dilate){
+                        set = set || morphology_get(pixels, width, height, x - dx, y - dy, false);
+                    }else{
+                        set = set && morphology_get(pixels, width, height, x + dx, y + dy, true);
+                    }
+                }
+            }
+            ret[x + y * width] = set;
+        }
+    }
+    return ret;
+}
+
+}
+
+
+int test_kernels_BinaryMorphology(const std::string& test_path){
+    std::vector<BinaryMatrixType> types{BinaryMatrixType::i64x4_Default};
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        types.emplace_back(BinaryMatrixType::i64x8_x64_SSE42);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        types.emplace_back(BinaryMatrixType::i64x16_x64_AVX2);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        types.emplace_back(BinaryMatrixType::i64x32_x64_AVX512);
+        types.emplace_back(BinaryMatrixType::i64x64_x64_AVX512);
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        types.emplace_back(BinaryMatrixType::arm64x8_x64_NEON);
+    }
+#endif
+
+    //  Ellipses must match cv::getStructuringElement(MORPH_ELLIPSE, ...).
+    {
+        const std::pair<BinaryStructuringElement, BinaryStructuringElement> ELLIPSES[] = {
+            {BinaryStructuringElement::ellipse(1, 1), BinaryStructuringElement({"1"}, 0, 0)},
+            {BinaryStructuringElement::ellipse(5, 1), BinaryStructuringElement({"00100"}, 2, 0)},
+            {BinaryStructuringElement::ellipse(1, 3), BinaryStructuringElement({"1", "1", "1"}, 0, 1)},
+            {BinaryStructuringElement::ellipse(5, 5), BinaryStructuringElement({"00100", "11111", "11111", "11111", "00100"}, 2, 2)},
+            {BinaryStructuringElement::ellipse(7, 3), BinaryStructuringElement({"0001000", "1111111", "0001000"}, 3, 1)},
+            {BinaryStructuringElement::ellipse(3, 7), BinaryStructuringElement({"010", "111", "111", "111", "111", "111", "010"}, 1, 3)},
+        };
+        for (const auto& item : ELLIPSES){
+            if (item.first.dump() != item.second.dump()){
+                cerr << "Ellipse does not match OpenCV. Expected:" << endl << item.second.dump()
+                     << "Actual:" << endl << item.first.dump() << endl;
+                return 1;
+            }
+        }
+    }
+
+    const char* OPERATIONS[] = {"dilate", "erode", "open", "close", "hit-or-miss"};
+
+    //  Random sizes so that the edges land everywhere inside a tile.
+    std::mt19937 rng(1);
+    size_t tests = 0;
+    for (size_t iteration = 0; iteration < 300; iteration++){
+        const size_t width = 1 + rng() % 200;
+        const size_t height = 1 + rng() % 150;
+
+        const size_t element_width = 1 + rng() % 9;
+        const size_t element_height = 1 + rng() % 9;
+        BinaryStructuringElement element = BinaryStructuringElement::ellipse(element_width, element_height);
+        switch (rng() % 3){
+        case 0:
+            element = BinaryStructuringElement::rectangle(
+                element_width, element_height,
+                rng() % element_width, rng() % element_height
+            );
+            break;
+        case 1:
+            break;
+        default:
+            element = BinaryStructuringElement(
+                element_width, element_height,
+                rng() % element_width, rng() % element_height
+            );
+            for (size_t y = 0; y < element_height; y++){
+                for (size_t x = 0; x < element_width; x++){
+                    element.set(x, y, rng() % 2);
+                }
+            }
+        }
+        BinaryStructuringElement miss = BinaryStructuringElement::rectangle(1 + rng() % 4, 1 + rng() % 4);
+        for (size_t y = 0; y < miss.height(); y++){
+            for (size_t x = 0; x < miss.width(); x++){
+                miss.set(x, y, rng() % 3 == 0);
+            }
+        }
+
+        std::vector<char> pixels(width * height);
+        const uint32_t density = 2 + rng() % 5;
+        for (char& pixel : pixels){
+            pixel = rng() % density == 0;
+        }
+        std::vector<char> inverted(pixels.size());
+        for (size_t c = 0; c < pixels.size(); c++){
+            inverted[c] = !pixels[c];
+        }
+
+        std::vector<char> expected[5];
+        expected[0] = morphology_scalar(pixels, width, height, element, true);
+        expected[1] = morphology_scalar(pixels, width, height, element, false);
+        expected[2] = morphology_scalar(expected[1], width, height, element, true);
+        expected[3] = morphology_scalar(expected[0], width, height, element, false);
+        expected[4] = morphology_scalar(inverted, width, height, miss, false);
+        for (size_t c = 0; c < pixels.size(); c++){
+            expected[4][c] = expected[4][c] && expected[1][c];
+        }
+
+        for (BinaryMatrixType type : types){
+            for (size_t operation = 0; operation < 5; operation++){
+                auto matrix = make_PackedBinaryMatrix(type, width, height);
+                for (size_t y = 0; y < height; y++){
+                    for (size_t x = 0; x < width; x++){
+                        matrix->set(x, y, pixels[x + y * width]);
+                    }
+                }
+                switch (operation){
+                case 0: binary_dilate(*matrix, element); break;
+                case 1: binary_erode(*matrix, element); break;
+                case 2: binary_open(*matrix, element); break;
+                case 3: binary_close(*matrix, element); break;
+                default: binary_hit_or_miss(*matrix, element, miss); break;
+                }
+                tests++;
+
+                TEST_RESULT_EQUAL(matrix->width(), width);
+                TEST_RESULT_EQUAL(matrix->height(), height);
+                for (size_t y = 0; y < height; y++){
+                    for (size_t x = 0; x < width; x++){
+                        if (matrix->get(x, y) == (expected[operation][x + y * width] != 0)){
+                            continue;
+                        }
+                        cerr << "Error: binary_" << OPERATIONS[operation] << "(), matrix type " << (int)type
+                             << ", size " << width << " x " << height << ", pixel (" << x << ", " << y << ") is "
+                             << matrix->get(x, y) << " but should be " << (expected[operation][x + y * width] != 0) << "." << endl;
+                        cerr << "Element:" << endl << element.dump() << endl;
+                        return 1;
+                    }
+                }
+
+                //  The padding past the edges of the matrix must stay zero.
+                std::string tiles = matrix->dump_tiles();
+                size_t row = 0, col = 0;
+                for (char ch : tiles){
+                    if (ch == '\n'){
+                        row++;
+                        col = 0;
+                        continue;
+                    }
+                    if (ch == '1' && (col >= width || row >= height)){
+                        cerr << "Error: binary_" << OPERATIONS[operation] << "(), matrix type " << (int)type
+                             << ", size " << width << " x " << height << ", padding at (" << col << ", " << row << ") is set." << endl;
+                        return 1;
+                    }
+                    col++;
+                }
+            }
+        }
+    }
+
+    cout << "Binary morphology: " << tests << " tests passed on " << types.size() << " matrix types." << endl;
+    return 0;
+}
+
+
+
+
+namespace Kernels{
+namespace AbsFFT{
+    void fft_abs_Default(int k, size_t count, float* abs, float* real);
+    void fft_abs_x86_SSE41(int k, size_t count, float* abs, float* real);
+    void fft_abs_x86_AVX2(int k, size_t count, float* abs, float* real);
+    void fft_abs_x86_AVX512(int k, size_t count, float* abs, float* real);
+    void fft_abs_arm64_NEON(int k, size_t count, float* abs, float* real);
+}
+}
+
+namespace{
+
+//  |DFT| of the lower half of "real", computed directly in double precision.
+std::vector<double> abs_dft_naive(const float* real, size_t length){
+    const double PI = 3.14159265358979323846;
+    std::vector<double> cos_table(length);
+    std::vector<double> sin_table(length);
+    for (size_t c = 0; c < length; c++){
+        cos_table[c] = std::cos(2 * PI * c / length);
+        sin_table[c] = std::sin(2 * PI * c / length);
+    }
+    std::vector<double> ret(length / 2);
+    for (size_t f = 0; f < length / 2; f++){
+        double r = 0;
+        double i = 0;
+        size_t index = 0;
+        for (size_t t = 0; t < length; t++){
+            r += real[t] * cos_table[index];
+            i -= real[t] * sin_table[index];
+            index = (index + f) & (length - 1);
+        }
+        ret[f] = std::sqrt(r*r + i*i);
+    }
+    return ret;
+}
+
+}
+
+
+int test_kernels_AbsFFT(const std::string& test_path){
+    using namespace Kernels::AbsFFT;
+    using FFTFunction = void (*)(int k, size_t count, float* abs, float* real);
+
+    std::vector<std::pair<const char*, FFTFunction>> cores{{"Default", fft_abs_Default}};
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        cores.emplace_back("x86_SSE41", fft_abs_x86_SSE41);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        cores.emplace_back("x86_AVX2", fft_abs_x86_AVX2);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        cores.emplace_back("x86_AVX512", fft_abs_x86_AVX512);
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        cores.emplace_back("arm64_NEON", fft_abs_arm64_NEON);
+    }
+#endif
+
+    const size_t BATCH = 3;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    for (int k = 1; k <= 14; k++){
+        const size_t length = (size_t)1 << k;
+        const size_t count = k >= 5 ? BATCH : 1;
+
+        AlignedVector<float> input(length * count);
+        for (size_t c = 0; c < input.size(); c++){
+            input[c] = distribution(rng);
+        }
+
+        //  The error of a float FFT grows with the length and the input size.
+        const double tolerance = 1e-7 * k * std::sqrt((double)length);
+
+        std::vector<std::vector<double>> expected;
+        for (size_t b = 0; b < count; b++){
+            expected.emplace_back(abs_dft_naive(input.data() + b * length, length));
+        }
+
+        //  The scalar transform of every input on its own.
+        AlignedVector<float> scalar(length / 2 * count);
+        for (size_t b = 0; b < count; b++){
+            AlignedVector<float> real(length);
+            memcpy(real.data(), input.data() + b * length, length * sizeof(float));
+            fft_abs_Default(k, 1, scalar.data() + b * length / 2, real.data());
+        }
+
+        for (const auto& core : cores){
+            //  The transforms are destructive on the input.
+            AlignedVector<float> real(length * count);
+            memcpy(real.data(), input.data(), length * count * sizeof(float));
+            AlignedVector<float> abs(length / 2 * count);
+            core.second(k, count, abs.data(), real.data());
+
+            for (size_t b = 0; b < count; b++){
+                for (size_t f = 0; f < length / 2; f++){
+                    double actual = abs[b * length / 2 + f];
+                    double vs_naive = std::fabs(actual - expected[b][f]);
+                    double vs_scalar = std::fabs(actual - scalar[b * length / 2 + f]);
+                    if (vs_naive > tolerance || vs_scalar > tolerance){
+                        cerr << "AbsFFT " << core.first << ": k = " << k << ", transform = " << b
+                             << ", frequency = " << f << ", result = " << actual
+                             << ", naive = " << expected[b][f] << ", scalar = " << scalar[b * length / 2 + f] << endl;
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+
+    cout << "AbsFFT: " << cores.size() << " cores passed." << endl;
+    return 0;
+}
+
+
 int test_binary_matrix_tile(){
 #ifdef PA_AutoDispatch_arm64_20_M1
     if (test_binary_matrix_tile_t<BinaryTile_64x8_arm64_NEON>() != 0){
@@ -9,12 +9,16 @@
 #ifndef PokemonAutomation_Tests_Kernels_Tests_H
 #define PokemonAutomation_Tests_Kernels_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image);
 
+int test_kernels_ImagePixelSumSqrDev(const ImageViewRGB32& image);
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image);
 
 int test_kernels_FilterRGB32Range(const ImageViewRGB32& image);
@@ -31,6 +35,12 @@ int test_kernels_CompressRGB32ToBinaryEuclidean(const ImageViewRGB32& image);
 
 int test_kernels_Waterfill(const ImageViewRGB32& image);
 
+// Does not read the test file.
+int test_kernels_BinaryMorphology(const std::string& test_path);
+
+// Does not read the test file.
+int test_kernels_AbsFFT(const std::string& test_path);
+
 
 }
 
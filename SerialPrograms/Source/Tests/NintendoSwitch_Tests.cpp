@@ -5,12 +5,33 @@
  */
 
 
+#include <string.h>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <mutex>
+#include <condition_variable>
 #include "Common/Compiler.h"
+#include "Common/CRC32.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/RecursiveThrottler.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/SerialPABotBase/SerialPABotBase_Messages_NS2_WiredController.h"
+#include "Controllers/SerialPABotBase/SerialPABotBase.h"
+#include "Controllers/SerialPABotBase/SerialPABotBase_Routines_NS2_WiredController.h"
+#include "Controllers/SerialPABotBase/Connection/PABotBaseEmulator.h"
+#include "Controllers/SerialPABotBase/Connection/PABotBaseEmulatorBenchmark.h"
+#include "NintendoSwitch/Programs/NintendoSwitch_ControllerRecording.h"
+#include "NintendoSwitch/Programs/NintendoSwitch_RecordKeyboardController.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/Recording/StreamHistorySession.h"
+#include "NintendoSwitch/Controllers/NintendoSwitch_ControllerWithScheduler.h"
 #include "NintendoSwitch/Controllers/SerialPABotBase/NintendoSwitch_SerialPABotBase_WiredController.h"
 #include "NintendoSwitch/Inference/NintendoSwitch_UpdatePopupDetector.h"
 #include "NintendoSwitch_Tests.h"
@@ -48,5 +69,495 @@ int test_NintendoSwitch_UpdatePopupDetector(const ImageViewRGB32& image, bool ta
 }
 
 
+int test_NintendoSwitch_SerialPABotBase_StateBatch(const std::string& test_path){
+    using namespace SerialPABotBase;
+    using Header = pabb_Message_Command_NS2_WiredController_StateBatch_Header;
+    constexpr size_t REPORT_SIZE = sizeof(pabb_NintendoSwitch2_WiredController_State);
+
+    //  No released firmware speaks the batch command yet. None of the
+    //  supported firmware may turn on the batch path.
+    for (const auto& item : SUPPORTED_DEVICES()){
+        if (item.second >= PABB_PROTOCOL_VERSION_NS2_WIRED_CONTROLLER_STATE_BATCH){
+            cerr << "Supported firmware " << item.second << " would use the batch command." << endl;
+            return 1;
+        }
+    }
+
+    //  Mash a button while moving the sticks around.
+    std::minstd_rand rng(0);
+    std::vector<std::pair<uint16_t, pabb_NintendoSwitch2_WiredController_State>> states;
+    for (size_t c = 0; c < 1000; c++){
+        pabb_NintendoSwitch2_WiredController_State report = pabb_NintendoSwitch2_WiredController_State_NEUTRAL_STATE;
+        if (c % 2 == 0){
+            report.buttons0 = 0x04;
+        }
+        if (c % 7 == 0){
+            report.left_joystick_x = (uint8_t)rng();
+            report.right_joystick_y = (uint8_t)rng();
+        }
+        states.emplace_back((uint16_t)(rng() % 200), report);
+    }
+
+    //  Pack the states into as many batches as needed.
+    std::vector<BotBaseMessage> messages;
+    {
+        DeviceRequest_NS2_WiredController_ControllerStateBatch batch;
+        for (const auto& state : states){
+            if (batch.try_append(state.first, state.second)){
+                continue;
+            }
+            if (batch.size() == 0){
+                cerr << "A single state does not fit into an empty batch." << endl;
+                return 1;
+            }
+            messages.emplace_back(batch.message());
+            batch = DeviceRequest_NS2_WiredController_ControllerStateBatch();
+            batch.try_append(state.first, state.second);
+        }
+        messages.emplace_back(batch.message());
+    }
+
+    //  Decode them the same way the device does and compare.
+    size_t index = 0;
+    for (const BotBaseMessage& message : messages){
+        TEST_RESULT_EQUAL((int)message.type, PABB_MSG_COMMAND_NS2_WIRED_CONTROLLER_STATE_BATCH);
+        if (message.body.size() > PABB_NS2_WIRED_CONTROLLER_STATE_BATCH_MAX_BODY){
+            cerr << "Batch is larger than a packet: " << message.body.size() << endl;
+            return 1;
+        }
+
+        Header header;
+        memcpy(&header, message.body.data(), sizeof(Header));
+
+        //  Every batch starts over from the neutral state.
+        pabb_NintendoSwitch2_WiredController_State report = pabb_NintendoSwitch2_WiredController_State_NEUTRAL_STATE;
+        size_t offset = sizeof(Header);
+        for (uint8_t c = 0; c < header.count; c++, index++){
+            if (offset + sizeof(uint16_t) + 1 > message.body.size() || index >= states.size()){
+                cerr << "Batch is truncated." << endl;
+                return 1;
+            }
+            uint16_t milliseconds;
+            memcpy(&milliseconds, message.body.data() + offset, sizeof(uint16_t));
+            uint8_t changed = (uint8_t)message.body[offset + sizeof(uint16_t)];
+            offset += sizeof(uint16_t) + 1;
+            for (size_t b = 0; b < REPORT_SIZE; b++){
+                if (changed & (1 << b)){
+                    ((uint8_t*)&report)[b] = (uint8_t)message.body[offset++];
+                }
+            }
+
+            TEST_RESULT_EQUAL(milliseconds, states[index].first);
+            TEST_RESULT_EQUAL(
+                pabb_NintendoSwitch2_WiredController_State_equals(&report, &states[index].second),
+                true
+            );
+        }
+        TEST_RESULT_EQUAL(offset, message.body.size());
+    }
+    TEST_RESULT_EQUAL(index, states.size());
+
+    //  Delta encoding should fit several mashing states into one packet.
+    if (messages.size() * 4 > states.size()){
+        cerr << "Batches are too small: " << states.size() << " states in " << messages.size() << " batches." << endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+namespace{
+
+//  Returns the type of the first message the emulator sends back, or zero if
+//  nothing comes back in time.
+class FirstResponseListener : public StreamListener{
+public:
+    virtual void on_recv(const void* data, size_t bytes) override{
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_bytes.append((const char*)data, bytes);
+        m_cv.notify_all();
+    }
+    uint8_t wait(){
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_cv.wait_for(lg, std::chrono::seconds(5), [this]{ return m_bytes.size() >= 2; });
+        return m_bytes.size() >= 2 ? (uint8_t)m_bytes[1] : 0;
+    }
+
+private:
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::string m_bytes;
+};
+
+uint8_t emulator_response_to_state_batch(Logger& logger, uint32_t protocol_version){
+    SerialPABotBase::DeviceRequest_NS2_WiredController_ControllerStateBatch batch;
+    batch.try_append(100, pabb_NintendoSwitch2_WiredController_State_NEUTRAL_STATE);
+    BotBaseMessage message = batch.message();
+
+    std::string packet;
+    packet += (char)~(uint8_t)(PABB_PROTOCOL_OVERHEAD + message.body.size());
+    packet += (char)message.type;
+    packet += message.body;
+    packet += std::string(sizeof(uint32_t), 0);
+    pabb_crc32_write_to_message(&packet[0], packet.size());
+
+    PABotBaseEmulatorConfig config;
+    config.protocol_version = protocol_version;
+    PABotBaseEmulator emulator(logger, config);
+    FirstResponseListener listener;
+    emulator.add_listener(listener);
+    emulator.send(packet.data(), packet.size());
+    uint8_t type = listener.wait();
+    emulator.stop();
+    emulator.remove_listener(listener);
+    return type;
+}
+
+}
+
+int test_NintendoSwitch_PABotBaseEmulator(const std::string& test_path){
+    auto& logger = global_logger_command_line();
+
+    //  Batches must be rejected by firmware that predates them.
+    TEST_RESULT_EQUAL(
+        (int)emulator_response_to_state_batch(logger, PABB_PROTOCOL_VERSION_NS2_WIRED_CONTROLLER_STATE_BATCH - 1),
+        PABB_MSG_ERROR_INVALID_TYPE
+    );
+    TEST_RESULT_EQUAL(
+        (int)emulator_response_to_state_batch(logger, PABB_PROTOCOL_VERSION_NS2_WIRED_CONTROLLER_STATE_BATCH),
+        PABB_MSG_ACK_COMMAND
+    );
+
+    std::vector<PABotBaseBenchmarkState> workload = json_to_pabotbase_benchmark_workload(load_json_file(test_path));
+    if (workload.empty()){
+        cerr << "Recording is empty: " << test_path << endl;
+        return 1;
+    }
+
+    PABotBaseEmulatorConfig clean_link;
+    clean_link.protocol_version = PABB_PROTOCOL_VERSION_NS2_WIRED_CONTROLLER_STATE_BATCH;
+    clean_link.time_scale = 0;
+
+    PABotBaseEmulatorConfig lossy_link = clean_link;
+    lossy_link.jitter = Milliseconds(2);
+    lossy_link.loss_rate = 0.05;
+    lossy_link.random_seed = 1;
+    lossy_link.retransmit_delay = Milliseconds(20);
+
+    for (const PABotBaseEmulatorConfig* config : {&clean_link, &lossy_link}){
+        for (bool batched : {false, true}){
+            PABotBaseBenchmarkResults results = run_pabotbase_benchmark(
+                logger, *config, workload, batched, Milliseconds(20)
+            );
+            cout << (batched ? "Batched: " : "Unbatched: ") << results.to_str() << endl;
+
+            //  Every command must run exactly once, no matter what was lost.
+            TEST_RESULT_EQUAL(results.device.commands_executed, results.commands);
+            if (!batched){
+                TEST_RESULT_EQUAL(results.commands, workload.size());
+            }else if (workload.size() > 1 && results.commands >= workload.size()){
+                cerr << "Batching did not reduce the # of commands." << endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+namespace{
+
+std::string read_file_bytes(const std::string& filename){
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+void write_file_bytes(const std::string& filename, const std::string& bytes){
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), bytes.size());
+}
+
+int compare_recording_entries(
+    ControllerRecordingReader& reader,
+    const std::vector<ControllerRecordingEntry>& expected
+){
+    ControllerRecordingEntry entry;
+    for (size_t c = 0; c < expected.size(); c++){
+        if (!reader.next(entry)){
+            cerr << "Recording ended early at entry " << c << " of " << expected.size() << "." << endl;
+            return 1;
+        }
+        TEST_RESULT_EQUAL(entry.is_neutral, expected[c].is_neutral);
+        TEST_RESULT_EQUAL(entry.same_state(expected[c]), true);
+        TEST_RESULT_EQUAL(entry.duration_in_ms, expected[c].duration_in_ms);
+    }
+    TEST_RESULT_EQUAL(reader.next(entry), false);
+    return 0;
+}
+
+}
+
+int test_NintendoSwitch_ControllerRecording(const std::string& test_path){
+    const std::filesystem::path temp_folder = std::filesystem::temp_directory_path();
+    const std::string bin0 = (temp_folder / "ControllerRecordingTest-0.bin").string();
+    const std::string bin1 = (temp_folder / "ControllerRecordingTest-1.bin").string();
+
+    //  Random entries that change a few fields at a time.
+    std::minstd_rand rng(0);
+    std::vector<ControllerRecordingEntry> entries;
+    ControllerRecordingEntry current;
+    for (size_t c = 0; c < 5000; c++){
+        if (rng() % 4 == 0){
+            ControllerRecordingEntry neutral;
+            neutral.duration_in_ms = rng() % 1000;
+            entries.emplace_back(neutral);
+            continue;
+        }
+        current.is_neutral = false;
+        switch (rng() % 4){
+        case 0:
+            current.buttons = (Button)(rng() & (ButtonFlagType)VALID_PRO_CONTROLLER_BUTTONS);
+            break;
+        case 1:
+            current.dpad = (DpadPosition)(rng() % (DPAD_NONE + 1));
+            break;
+        case 2:
+            current.left_x = (uint8_t)rng();
+            current.left_y = (uint8_t)rng();
+            break;
+        case 3:
+            current.right_x = (uint8_t)rng();
+            current.right_y = (uint8_t)rng();
+            break;
+        }
+        current.duration_in_ms = rng() % 100000;
+        entries.emplace_back(current);
+    }
+
+    {
+        ControllerRecordingWriter writer(bin0, ControllerClass::NintendoSwitch_ProController);
+        for (const ControllerRecordingEntry& entry : entries){
+            writer.append(entry);
+        }
+        writer.close();
+    }
+    {
+        ControllerRecordingReader reader(bin0);
+        TEST_RESULT_EQUAL((int)reader.controller_class(), (int)ControllerClass::NintendoSwitch_ProController);
+        if (compare_recording_entries(reader, entries) != 0){
+            return 1;
+        }
+
+        //  Looped playback.
+        reader.rewind();
+        if (compare_recording_entries(reader, entries) != 0){
+            return 1;
+        }
+    }
+
+    //  A recording that was cut off mid-entry ends at the last whole entry.
+    {
+        std::string bytes = read_file_bytes(bin0);
+        bytes.pop_back();
+        write_file_bytes(bin1, bytes);
+
+        ControllerRecordingReader reader(bin1);
+        std::vector<ControllerRecordingEntry> expected(entries.begin(), entries.end() - 1);
+        if (compare_recording_entries(reader, expected) != 0){
+            return 1;
+        }
+    }
+
+    //  JSON -> binary -> JSON -> binary must give the same file.
+    {
+        JsonValue json = load_json_file(test_path);
+        json_to_controller_recording(json, bin0);
+        JsonValue round_trip = controller_recording_to_json(bin0);
+        json_to_controller_recording(round_trip, bin1);
+
+        TEST_RESULT_EQUAL(
+            round_trip.to_object_throw().get_array_throw("history").size(),
+            json.to_object_throw().get_array_throw("history").size()
+        );
+        if (read_file_bytes(bin0) != read_file_bytes(bin1)){
+            cerr << "Binary recordings differ after a round trip through JSON." << endl;
+            return 1;
+        }
+    }
+
+    std::filesystem::remove(bin0);
+    std::filesystem::remove(bin1);
+
+    return 0;
+}
+
+
+
+namespace{
+
+//  Records the controller state of every schedule entry instead of sending it.
+class ScheduleRecorder : public NintendoSwitch::ControllerWithScheduler{
+public:
+    ScheduleRecorder(Logger& logger)
+        : ControllerWithScheduler(logger)
+    {}
+
+    std::vector<std::pair<WallDuration, SwitchControllerState>> timeline;
+
+private:
+    virtual void execute_state(
+        const Cancellable* cancellable,
+        const SuperscalarScheduler::ScheduleEntry& entry
+    ) override{
+        SwitchControllerState state;
+        for (const SchedulerResource* resource : entry.state){
+            static_cast<const SwitchCommand*>(resource)->apply(state);
+        }
+        timeline.emplace_back(entry.duration, state);
+    }
+};
+
+bool same_state(const SwitchControllerState& x, const SwitchControllerState& y){
+    return x.buttons == y.buttons
+        && x.dpad == y.dpad
+        && x.left_stick_x == y.left_stick_x
+        && x.left_stick_y == y.left_stick_y
+        && x.right_stick_x == y.right_stick_x
+        && x.right_stick_y == y.right_stick_y
+        && memcmp(x.gyro, y.gyro, sizeof(x.gyro)) == 0;
+}
+
+//  Issue "count" random ssf commands. Holds are often longer than the delays
+//  so commands on different resources overlap, and the same few resources
+//  are reused so that busy resources stall and get retired.
+void issue_random_ssf(NintendoSwitch::ControllerWithScheduler& controller, uint32_t seed, size_t count){
+    static const Button BUTTONS[] = {BUTTON_A, BUTTON_B, BUTTON_X, BUTTON_ZL, BUTTON_A | BUTTON_B};
+    std::minstd_rand rng(seed);
+    for (size_t c = 0; c < count; c++){
+        Milliseconds delay = Milliseconds(8 * (rng() % 6));
+        Milliseconds hold = Milliseconds(8 * (rng() % 12));
+        Milliseconds cooldown = Milliseconds(8 * (rng() % 4));
+        switch (rng() % 6){
+        case 0:
+        case 1:
+            controller.issue_buttons(nullptr, delay, hold, cooldown, BUTTONS[rng() % 5]);
+            break;
+        case 2:
+            controller.issue_dpad(nullptr, delay, hold, cooldown, (DpadPosition)(rng() % DPAD_NONE));
+            break;
+        case 3:
+            controller.issue_left_joystick(nullptr, delay, hold, cooldown, (uint8_t)rng(), (uint8_t)rng());
+            break;
+        case 4:
+            controller.issue_right_joystick(nullptr, delay, hold, cooldown, (uint8_t)rng(), (uint8_t)rng());
+            break;
+        case 5:
+            controller.issue_mash_button(nullptr, Milliseconds(8 * (rng() % 20)), BUTTON_B);
+            break;
+        }
+    }
+}
+
+int compare_timelines(
+    const std::vector<std::pair<WallDuration, SwitchControllerState>>& expected,
+    const std::vector<std::pair<WallDuration, SwitchControllerState>>& actual
+){
+    TEST_RESULT_EQUAL(actual.size(), expected.size());
+    for (size_t c = 0; c < expected.size(); c++){
+        if (actual[c].first != expected[c].first || !same_state(actual[c].second, expected[c].second)){
+            cerr << "Timelines differ at entry " << c << "." << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+}
+
+int test_NintendoSwitch_SuperscalarScheduler(const std::string& test_path){
+    using namespace std::chrono_literals;
+    auto& logger = global_logger_command_line();
+
+    for (uint32_t seed = 1; seed <= 20; seed++){
+        //  The compiler goes out of scope before the replay. The schedule
+        //  must keep its own resources alive.
+        SuperscalarScheduler::Schedule compiled;
+        {
+            ProControllerScheduleCompiler compiler(logger);
+            ThrottleScope throttle(compiler.logging_throttler());
+            issue_random_ssf(compiler, seed, 100);
+            compiled = compiler.compile();
+        }
+
+        //  Issue everything live. A replay drains the pipeline first and the
+        //  compiled schedule ends with everything released.
+        ScheduleRecorder live(logger);
+        {
+            ThrottleScope throttle(live.logging_throttler());
+            issue_random_ssf(live, seed + 1000, 10);
+            live.issue_barrier(nullptr);
+            issue_random_ssf(live, seed, 100);
+            live.issue_barrier(nullptr);
+            issue_random_ssf(live, seed, 100);
+            live.issue_barrier(nullptr);
+            issue_random_ssf(live, seed + 2000, 10);
+            live.issue_barrier(nullptr);
+        }
+
+        //  Same thing with the middle part replayed twice from the compiled
+        //  schedule.
+        ScheduleRecorder replay(logger);
+        {
+            ThrottleScope throttle(replay.logging_throttler());
+            issue_random_ssf(replay, seed + 1000, 10);
+            replay.issue_compiled(nullptr, compiled);
+            replay.issue_compiled(nullptr, compiled);
+            issue_random_ssf(replay, seed + 2000, 10);
+            replay.issue_barrier(nullptr);
+        }
+
+        if (compare_timelines(live.timeline, replay.timeline) != 0){
+            cerr << "Seed: " << seed << endl;
+            return 1;
+        }
+    }
+
+    //  Resource ids are bounded.
+    {
+        SuperscalarScheduler scheduler(logger, 4ms);
+        SuperscalarScheduler::Schedule schedule;
+        scheduler.issue_to_resource(
+            schedule,
+            std::make_unique<SchedulerResource>(SuperscalarScheduler::MAX_RESOURCES - 1),
+            8ms, 16ms, 0ms
+        );
+        bool thrown = false;
+        try{
+            scheduler.issue_to_resource(
+                schedule,
+                std::make_unique<SchedulerResource>(SuperscalarScheduler::MAX_RESOURCES),
+                8ms, 16ms, 0ms
+            );
+        }catch (InternalProgramError&){
+            thrown = true;
+        }
+        TEST_RESULT_EQUAL(thrown, true);
+
+        //  The rejected issue must not have disturbed the pipeline.
+        scheduler.issue_finalize(schedule);
+        for (const SuperscalarScheduler::ScheduleEntry& entry : schedule){
+            TEST_RESULT_EQUAL(entry.state.size(), (size_t)1);
+            TEST_RESULT_EQUAL(entry.state[0]->id, SuperscalarScheduler::MAX_RESOURCES - 1);
+        }
+        TEST_RESULT_EQUAL(std::chrono::duration_cast<Milliseconds>(schedule.total_duration()).count(), 16);
+    }
+
+    return 0;
+}
+
+
 
 }
@@ -9,12 +9,26 @@
 #ifndef PokemonAutomation_Tests_NintendoSwitch_Tests_H
 #define PokemonAutomation_Tests_NintendoSwitch_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_NintendoSwitch_UpdatePopupDetector(const ImageViewRGB32& image, bool target);
 
+// Does not read the test file.
+int test_NintendoSwitch_SerialPABotBase_StateBatch(const std::string& test_path);
+
+// Test file is a Pro Controller recording in the JSON format of RecordKeyboardController.
+int test_NintendoSwitch_PABotBaseEmulator(const std::string& test_path);
+
+// Test file is a recording in the JSON format of RecordKeyboardController.
+int test_NintendoSwitch_ControllerRecording(const std::string& test_path);
+
+// Does not read the test file.
+int test_NintendoSwitch_SuperscalarScheduler(const std::string& test_path);
+
 }
 
 #endif
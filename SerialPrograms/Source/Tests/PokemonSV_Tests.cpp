@@ -14,6 +14,7 @@
 #include "TestUtils.h"
 
 #include "Common/Cpp/Containers/FixedLimitVector.tpp"
+#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "PokemonSV/Inference/Battles/PokemonSV_NormalBattleMenus.h"
 #include "PokemonSV/Inference/Boxes/PokemonSV_BoxDetection.h"
@@ -36,6 +37,8 @@
 #include "PokemonSV/Inference/Overworld/PokemonSV_OverworldDetector.h"
 #include "PokemonSV/Inference/Dialogs/PokemonSV_DialogDetector.h"
 #include "PokemonSV/Inference/PokemonSV_ESPEmotionDetector.h"
+#include "PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.h"
+#include "PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch.h"
 
 #include <iostream>
 using std::cout;
@@ -586,4 +589,98 @@ int test_pokemonSV_RecentlyBattledDetector(const ImageViewRGB32& image, bool tar
     return 0;
 }
 
+int test_pokemonSV_ItemPrinterSeedSearch(const std::string& test_path){
+    using namespace NintendoSwitch::PokemonSV::ItemPrinter;
+
+    //  A bit over 3 blocks of the search so that the block merge is covered.
+    const int64_t FIRST_SEED = 1704067200;  //  2024-01-01 00:00:00
+    const size_t SEEDS = 200000;
+    const int64_t LAST_SEED = FIRST_SEED + (int64_t)SEEDS - 1;
+
+    std::vector<DateSeed> reference;
+    reference.reserve(SEEDS);
+    for (size_t c = 0; c < SEEDS; c++){
+        reference.emplace_back(calculate_seed_prizes(FIRST_SEED + (int64_t)c));
+    }
+
+    ComputationThreadPool thread_pool([](){}, 0, 4);
+
+    const PrintMode MODES[] = {PrintMode::Regular, PrintMode::ItemBonus, PrintMode::BallBonus};
+    const ItemPrinterJobs JOBS[] = {ItemPrinterJobs::Jobs_1, ItemPrinterJobs::Jobs_5, ItemPrinterJobs::Jobs_10};
+    size_t queries = 0;
+    for (PrintMode mode : MODES){
+        auto prizes_of = [&](const DateSeed& seed) -> const std::array<std::string, 10>& {
+            switch (mode){
+            case PrintMode::ItemBonus:
+                return seed.item_bonus;
+            case PrintMode::BallBonus:
+                return seed.ball_bonus;
+            default:
+                return seed.regular;
+            }
+        };
+        for (ItemPrinterJobs jobs : JOBS){
+            //  Build the queries from the prizes of some of the seeds so that
+            //  every query has at least one match.
+            for (size_t probe = 12345; probe < SEEDS; probe += 45678){
+                const std::array<std::string, 10>& probe_prizes = prizes_of(reference[probe]);
+                std::map<std::string, uint8_t> counts;
+                for (size_t c = 0; c < (size_t)jobs; c++){
+                    counts[probe_prizes[c]]++;
+                }
+
+                ItemPrinterSeedSearchQuery query;
+                query.mode = mode;
+                query.jobs = jobs;
+                for (const auto& item : counts){
+                    //  Two targets at most. Requiring every prize would only
+                    //  ever match the probe.
+                    if (query.min_prizes.size() < 2){
+                        query.min_prizes.emplace(item.first, item.second);
+                    }
+                }
+
+                std::vector<int64_t> expected;
+                for (size_t c = 0; c < SEEDS; c++){
+                    const std::array<std::string, 10>& prizes = prizes_of(reference[c]);
+                    bool ok = true;
+                    for (const auto& item : query.min_prizes){
+                        size_t count = 0;
+                        for (size_t p = 0; p < (size_t)jobs; p++){
+                            count += prizes[p] == item.first;
+                        }
+                        ok &= count >= item.second;
+                    }
+                    if (ok){
+                        expected.emplace_back(FIRST_SEED + (int64_t)c);
+                    }
+                }
+
+                std::vector<int64_t> results = search_item_printer_seeds(
+                    thread_pool, query, FIRST_SEED, LAST_SEED, SEEDS
+                );
+                TEST_RESULT_COMPONENT_EQUAL(results.size(), expected.size(), "# of matches");
+                for (size_t c = 0; c < expected.size(); c++){
+                    TEST_RESULT_COMPONENT_EQUAL(results[c], expected[c], "match " + std::to_string(c));
+                }
+
+                //  A limited search must return the first matches.
+                results = search_item_printer_seeds(
+                    thread_pool, query, FIRST_SEED, LAST_SEED, 3
+                );
+                expected.resize(std::min<size_t>(expected.size(), 3));
+                TEST_RESULT_COMPONENT_EQUAL(results.size(), expected.size(), "# of limited matches");
+                for (size_t c = 0; c < expected.size(); c++){
+                    TEST_RESULT_COMPONENT_EQUAL(results[c], expected[c], "limited match " + std::to_string(c));
+                }
+
+                queries++;
+            }
+        }
+    }
+
+    cout << "Item Printer seed search matched the scalar prizes on " << queries << " queries." << endl;
+    return 0;
+}
+
 }
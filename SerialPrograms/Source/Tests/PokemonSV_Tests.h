@@ -66,6 +66,9 @@ int test_pokemonSV_SandwichPlateDetector(const ImageViewRGB32& image, const std:
 
 int test_pokemonSV_RecentlyBattledDetector(const ImageViewRGB32& image, bool target);
 
+// Does not read the test file.
+int test_pokemonSV_ItemPrinterSeedSearch(const std::string& test_path);
+
 }
 
 #endif
@@ -221,6 +221,7 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
 
 const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_ImageScaleBrightness", std::bind(image_void_detector_helper, test_kernels_ImageScaleBrightness, _1)},
+    {"Kernels_ImagePixelSumSqrDev", std::bind(image_void_detector_helper, test_kernels_ImagePixelSumSqrDev, _1)},
     {"Kernels_BinaryMatrix", std::bind(image_void_detector_helper, test_kernels_BinaryMatrix, _1)},
     {"Kernels_FilterRGB32Range", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Range, _1)},
     {"Kernels_FilterRGB32Euclidean", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Euclidean, _1)},
@@ -228,8 +229,19 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_FilterByMask", std::bind(image_void_detector_helper, test_kernels_FilterByMask, _1)},
     {"Kernels_CompressRGB32ToBinaryEuclidean", std::bind(image_void_detector_helper, test_kernels_CompressRGB32ToBinaryEuclidean, _1)},
     {"Kernels_Waterfill", std::bind(image_void_detector_helper, test_kernels_Waterfill, _1)},
+    {"Kernels_BinaryMorphology", test_kernels_BinaryMorphology},
+    {"Kernels_AbsFFT", test_kernels_AbsFFT},
     {"CommonFramework_BlackBorderDetector", std::bind(image_bool_detector_helper, test_CommonFramework_BlackBorderDetector, _1)},
+    {"CommonFramework_StillImageInference", test_CommonFramework_StillImageInference},
+    {"CommonFramework_DisplayFrameLimiter", test_CommonFramework_DisplayFrameLimiter},
+    {"CommonFramework_AudioResampler", test_CommonFramework_AudioResampler},
+    {"CommonFramework_ParallelForRange", test_CommonFramework_ParallelForRange},
+    {"CommonFramework_InferenceProfiler", test_CommonFramework_InferenceProfiler},
     {"NintendoSwitch_UpdatePopupDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_UpdatePopupDetector, _1)},
+    {"NintendoSwitch_SerialPABotBase_StateBatch", test_NintendoSwitch_SerialPABotBase_StateBatch},
+    {"NintendoSwitch_PABotBaseEmulator", test_NintendoSwitch_PABotBaseEmulator},
+    {"NintendoSwitch_ControllerRecording", test_NintendoSwitch_ControllerRecording},
+    {"NintendoSwitch_SuperscalarScheduler", test_NintendoSwitch_SuperscalarScheduler},
     {"PokemonSwSh_YCommMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_YCommMenuDetector, _1)},
     {"PokemonSwSh_MaxLair_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_MaxLair_BattleMenuDetector, _1)},
     {"PokemonSwSh_DialogTriangleDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_DialogTriangleDetector, _1)},
@@ -288,6 +300,7 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSV_MapFlyMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSV_MapFlyMenuDetector, _1)},
     {"PokemonSV_SandwichPlateDetector", std::bind(image_words_detector_helper, test_pokemonSV_SandwichPlateDetector, _1)},
     {"PokemonSV_RecentlyBattledDetector", std::bind(image_bool_detector_helper, test_pokemonSV_RecentlyBattledDetector, _1)},
+    {"PokemonSV_ItemPrinterSeedSearch", test_pokemonSV_ItemPrinterSeedSearch},
     {"PokemonLZA_NormalDialogBoxDetector", std::bind(image_bool_detector_helper, test_pokemonZLA_NormalDialogBoxDetector, _1)},
     {"PokemonLZA_FlatWhiteDialogDetector", std::bind(image_bool_detector_helper, test_pokemonLZA_FlatWhiteDialogDetector, _1)},
     {"PokemonLZA_BlueDialogDetector", std::bind(image_bool_detector_helper, test_pokemonLZA_BlueDialogDetector, _1)},
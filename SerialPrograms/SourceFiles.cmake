@@ -15,6 +15,7 @@ file(GLOB LIBRARY_SOURCES
     ../Common/CRC32.h
     ../Common/Compiler.h
     ../Common/ControllerStates/HID_Keyboard_State.h
+    ../Common/ControllerStates/NintendoSwitch2_WiredController_State.c
     ../Common/ControllerStates/NintendoSwitch2_WiredController_State.h
     ../Common/ControllerStates/NintendoSwitch_WirelessController_State.c
     ../Common/ControllerStates/NintendoSwitch_WirelessController_State.h
@@ -35,8 +36,11 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/Concurrency/ComputationThreadPoolCore.h
     ../Common/Cpp/Concurrency/FireForgetDispatcher.cpp
     ../Common/Cpp/Concurrency/FireForgetDispatcher.h
+    ../Common/Cpp/Concurrency/PeriodicExecutor.cpp
+    ../Common/Cpp/Concurrency/PeriodicExecutor.h
     ../Common/Cpp/Concurrency/PeriodicScheduler.cpp
     ../Common/Cpp/Concurrency/PeriodicScheduler.h
+    ../Common/Cpp/Concurrency/PreciseSleep.h
     ../Common/Cpp/Concurrency/ReverseLockGuard.h
     ../Common/Cpp/Concurrency/ScheduledTaskRunner.cpp
     ../Common/Cpp/Concurrency/ScheduledTaskRunner.h
@@ -79,6 +83,8 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/ExpressionEvaluator.h
     ../Common/Cpp/ImageResolution.cpp
     ../Common/Cpp/ImageResolution.h
+    ../Common/Cpp/JitterHistogram.cpp
+    ../Common/Cpp/JitterHistogram.h
     ../Common/Cpp/Json/JsonArray.cpp
     ../Common/Cpp/Json/JsonArray.h
     ../Common/Cpp/Json/JsonObject.cpp
@@ -278,6 +284,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.cpp
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.h
     Source/CommonFramework/AudioPipeline/Tools/AudioNormalization.h
+    Source/CommonFramework/AudioPipeline/Tools/AudioResampler.cpp
+    Source/CommonFramework/AudioPipeline/Tools/AudioResampler.h
     Source/CommonFramework/AudioPipeline/Tools/TimeSampleBuffer.cpp
     Source/CommonFramework/AudioPipeline/Tools/TimeSampleBuffer.h
     Source/CommonFramework/AudioPipeline/Tools/TimeSampleBufferReader.cpp
@@ -365,6 +373,7 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/Notifications/SenderNotificationTable.cpp
     Source/CommonFramework/Notifications/SenderNotificationTable.h
     Source/CommonFramework/Options/CheckForUpdatesOption.h
+    Source/CommonFramework/Options/Environment/PerformanceOptions.cpp
     Source/CommonFramework/Options/Environment/PerformanceOptions.h
     Source/CommonFramework/Options/Environment/ProcessPriorityOption.h
     Source/CommonFramework/Options/Environment/ProcessorLevelOption.cpp
@@ -432,6 +441,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/Tools/FileDownloader.h
     Source/CommonFramework/Tools/GlobalThreadPools.cpp
     Source/CommonFramework/Tools/GlobalThreadPools.h
+    Source/CommonFramework/Tools/ImageDumpWriter.cpp
+    Source/CommonFramework/Tools/ImageDumpWriter.h
     Source/CommonFramework/Tools/ProgramEnvironment.cpp
     Source/CommonFramework/Tools/ProgramEnvironment.h
     Source/CommonFramework/Tools/StatAccumulator.cpp
@@ -444,6 +455,7 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.5.h
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.cpp
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.h
+    Source/CommonFramework/VideoPipeline/Backends/DisplayFrameLimiter.h
     Source/CommonFramework/VideoPipeline/Backends/MediaServicesQt6.cpp
     Source/CommonFramework/VideoPipeline/Backends/MediaServicesQt6.h
     Source/CommonFramework/VideoPipeline/Backends/QCameraThread.h
@@ -452,6 +464,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/VideoPipeline/Backends/SnapshotManager.h
     Source/CommonFramework/VideoPipeline/Backends/VideoFrameQt.h
     Source/CommonFramework/VideoPipeline/CameraInfo.h
+    Source/CommonFramework/VideoPipeline/Stats/ControllerJitterStats.cpp
+    Source/CommonFramework/VideoPipeline/Stats/ControllerJitterStats.h
     Source/CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.cpp
     Source/CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.h
     Source/CommonFramework/VideoPipeline/Stats/MemoryUtilizationStats.cpp
@@ -533,6 +547,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/ImageMatch/SubObjectTemplateMatcher.h
     Source/CommonTools/ImageMatch/WaterfillTemplateMatcher.cpp
     Source/CommonTools/ImageMatch/WaterfillTemplateMatcher.h
+    Source/CommonTools/ImageMatch/WaterfillTemplateMatcherSet.cpp
+    Source/CommonTools/ImageMatch/WaterfillTemplateMatcherSet.h
     Source/CommonTools/Images/BinaryImage_FilterRgb32.cpp
     Source/CommonTools/Images/BinaryImage_FilterRgb32.h
     Source/CommonTools/Images/ColorClustering.cpp
@@ -556,6 +572,10 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/InferenceCallbacks/VisualInferenceCallback.h
     Source/CommonTools/InferencePivots/AudioInferencePivot.cpp
     Source/CommonTools/InferencePivots/AudioInferencePivot.h
+    Source/CommonTools/InferencePivots/InferenceBudget.cpp
+    Source/CommonTools/InferencePivots/InferenceBudget.h
+    Source/CommonTools/InferencePivots/InferenceProfiler.cpp
+    Source/CommonTools/InferencePivots/InferenceProfiler.h
     Source/CommonTools/InferencePivots/VisualInferencePivot.cpp
     Source/CommonTools/InferencePivots/VisualInferencePivot.h
     Source/CommonTools/InferenceThrottler.h
@@ -664,6 +684,10 @@ file(GLOB LIBRARY_SOURCES
     Source/Controllers/SerialPABotBase/Connection/PABotBase.h
     Source/Controllers/SerialPABotBase/Connection/PABotBaseConnection.cpp
     Source/Controllers/SerialPABotBase/Connection/PABotBaseConnection.h
+    Source/Controllers/SerialPABotBase/Connection/PABotBaseEmulator.cpp
+    Source/Controllers/SerialPABotBase/Connection/PABotBaseEmulator.h
+    Source/Controllers/SerialPABotBase/Connection/PABotBaseEmulatorBenchmark.cpp
+    Source/Controllers/SerialPABotBase/Connection/PABotBaseEmulatorBenchmark.h
     Source/Controllers/SerialPABotBase/SerialPABotBase.cpp
     Source/Controllers/SerialPABotBase/SerialPABotBase.h
     Source/Controllers/SerialPABotBase/SerialPABotBase_Connection.cpp
@@ -715,9 +739,13 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/AbsFFT/Kernels_AbsFFT.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_Default.h
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_arm64_NEON.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_x86_AVX2.h
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_x86_AVX512.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_x86_SSE41.h
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_arm64_NEON.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_x86_AVX2.h
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_x86_AVX512.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_x86_SSE41.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_BitReverse.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Butterflies.h
@@ -725,7 +753,9 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/AbsFFT/Kernels_AbsFFT_ComplexToAbs.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_ComplexVector.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_Default.cpp
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_arm64_NEON.cpp
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_x86_AVX2.cpp
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_x86_AVX512.cpp
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_x86_SSE41.cpp
     Source/Kernels/AbsFFT/Kernels_AbsFFT_FullTransform.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_FullTransform.tpp
@@ -737,6 +767,7 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/AudioStreamConversion/AudioStreamConversion.cpp
     Source/Kernels/AudioStreamConversion/AudioStreamConversion.h
     Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_Default.cpp
+    Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_arm64_NEON.cpp
     Source/Kernels/AudioStreamConversion/AudioStreamConversion_Core_x86_SSE41.cpp
     Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.cpp
     Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h
@@ -752,6 +783,15 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters_x64_AVX2.h
     Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters_x64_AVX512.h
     Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters_x64_SSE42.h
+    Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology.cpp
+    Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology.h
+    Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology_Core_64x16_x64_AVX2.cpp
+    Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology_Core_64x32_x64_AVX512.cpp
+    Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology_Core_64x4_Default.cpp
+    Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology_Core_64x64_x64_AVX512.cpp
+    Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology_Core_64x8_arm64_NEON.cpp
+    Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology_Core_64x8_x64_SSE42.cpp
+    Source/Kernels/BinaryImageFilters/Kernels_BinaryImage_Morphology_Routines.h
     Source/Kernels/BinaryImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range.h
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix.cpp
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix.h
@@ -828,10 +868,12 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_Default.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_arm64_NEON.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_x64_AVX2.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_x64_AVX512.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_x64_SSE41.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_Default.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_arm64_NEON.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX2.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX512.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_SSE41.cpp
@@ -845,6 +887,9 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/PartialWordAccess/Kernels_PartialWordAccess_arm64_NEON.h
     Source/Kernels/PartialWordAccess/Kernels_PartialWordAccess_x64_AVX2.h
     Source/Kernels/PartialWordAccess/Kernels_PartialWordAccess_x64_SSE41.h
+    Source/Kernels/Random/Kernels_Xoroshiro128PlusLanes_Default.h
+    Source/Kernels/Random/Kernels_Xoroshiro128PlusLanes_x64_AVX2.h
+    Source/Kernels/Random/Kernels_Xoroshiro128PlusLanes_x64_AVX512.h
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.cpp
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Core_Default.cpp
@@ -1060,6 +1105,8 @@ file(GLOB LIBRARY_SOURCES
     Source/NintendoSwitch/Programs/FastCodeEntry/NintendoSwitch_KeyboardEntryMappings.h
     Source/NintendoSwitch/Programs/FastCodeEntry/NintendoSwitch_NumberCodeEntry.cpp
     Source/NintendoSwitch/Programs/FastCodeEntry/NintendoSwitch_NumberCodeEntry.h
+    Source/NintendoSwitch/Programs/NintendoSwitch_ControllerRecording.cpp
+    Source/NintendoSwitch/Programs/NintendoSwitch_ControllerRecording.h
     Source/NintendoSwitch/Programs/NintendoSwitch_FriendCodeAdder.cpp
     Source/NintendoSwitch/Programs/NintendoSwitch_FriendCodeAdder.h
     Source/NintendoSwitch/Programs/NintendoSwitch_FriendDelete.cpp
@@ -1954,6 +2001,12 @@ file(GLOB LIBRARY_SOURCES
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterRNGTable.h
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.cpp
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.h
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch.cpp
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch.h
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch_Core.h
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch_Default.cpp
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch_x64_AVX2.cpp
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch_x64_AVX512.cpp
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterTools.cpp
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterTools.h
     Source/PokemonSV/Programs/PokemonSV_AreaZero.cpp